@@ -5,9 +5,21 @@ from __future__ import annotations
 
 from ._core import (  # type:ignore # isort:skip
   __doc__,
-  try_dot_env
+  try_dot_env,
+  check_dot_env,
+  DotEnvDiagnostic,
+  Environment,
+  enable_result_cache,
+  RecordBatch,
+  RecordBatchReader
 )
 
+from .dbapi import *  # noqa: F401,F403 # isort:skip
+from . import dbapi
+
 __version__ = '0.0.1'
 
-__all__ = ['__doc__', '__version__', 'try_dot_env']
+__all__ = [
+  '__doc__', '__version__', 'try_dot_env', 'check_dot_env', 'DotEnvDiagnostic',
+  'Environment', 'enable_result_cache', 'RecordBatch', 'RecordBatchReader', *dbapi.__all__
+]
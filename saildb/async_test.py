@@ -0,0 +1,126 @@
+"""Awaitable `Connection` & `Cursor` operation(s), of which one may be pending at a time"""
+
+from __future__ import annotations
+
+import os
+import tempfile
+import unittest
+from collections.abc import Callable
+
+import saildb
+
+ROW_COUNT = 10
+
+# Slow enough to still run on the executor once the awaitable is returned
+SLOW_QUERY = (
+  'WITH RECURSIVE ids(id) AS (SELECT 1 UNION ALL SELECT id + 1 FROM ids WHERE id < 3000000) '
+  'SELECT COUNT(*) FROM ids'
+)
+
+
+class AsyncTest(unittest.IsolatedAsyncioTestCase):
+  """A SQLite file opened through the host's driver manager, unless `SAILDB_TEST_CONNECTION` is set"""
+
+  def setUp(self) -> None:
+    self.connection_string = os.environ.get('SAILDB_TEST_CONNECTION', '')
+    if not self.connection_string:
+      directory = tempfile.TemporaryDirectory(dir=os.environ.get('TEST_TMPDIR'))
+      self.addCleanup(directory.cleanup)
+      self.connection_string = f"Driver=SQLite3;Database={os.path.join(directory.name, 'async.db')};"
+
+    try:
+      connection = saildb.connect(self.connection_string, autocommit=True)
+    except saildb.Error as err:
+      self.skipTest(f'Failed to connect to `{self.connection_string}`: {err}')
+
+    try:
+      cursor = connection.cursor()
+      cursor.execute('CREATE TABLE saildb_rows (id INTEGER, name VARCHAR(16))')
+      cursor.execute(
+        f'WITH RECURSIVE ids(id) AS (SELECT 1 UNION ALL SELECT id + 1 FROM ids WHERE id < {ROW_COUNT}) '
+        "INSERT INTO saildb_rows SELECT id, 'row-' || id FROM ids"
+      )
+    finally:
+      connection.close()
+
+  async def connect(self) -> saildb.Connection:
+    connection = await saildb.connect_async(self.connection_string)
+    self.addCleanup(connection.close)
+    return connection
+
+  def assertPending(self, call: Callable[[], object]) -> None:
+    with self.assertRaises(saildb.InterfaceError) as context:
+      call()
+
+    self.assertIn('pending', str(context.exception))
+
+  # Results
+
+  async def test_execute_async_resolves_to_cursor(self) -> None:
+    cursor = (await self.connect()).cursor()
+    self.assertIs(await cursor.execute_async('SELECT id FROM saildb_rows WHERE id <= ? ORDER BY id', (3,)), cursor)
+    self.assertEqual(await cursor.fetchall_async(), [(1,), (2,), (3,)])
+    self.assertEqual(await cursor.fetchall_async(), [])
+
+  async def test_fetchmany_async_takes_buffered_rows_first(self) -> None:
+    cursor = (await self.connect()).cursor()
+    await cursor.execute_async('SELECT id FROM saildb_rows ORDER BY id')
+    self.assertEqual(cursor.fetchone(), (1,))
+
+    cursor.arraysize = 4
+    self.assertEqual(await cursor.fetchmany_async(), [(2,), (3,), (4,), (5,)])
+    self.assertEqual(await cursor.fetchmany_async(10), [(id,) for id in range(6, ROW_COUNT + 1)])
+
+  async def test_failed_operation_rejects_future(self) -> None:
+    cursor = (await self.connect()).cursor()
+    with self.assertRaises(saildb.DatabaseError):
+      await cursor.execute_async('SELECT id FROM saildb_missing')
+
+    # No longer pending
+    cursor.execute('SELECT COUNT(*) FROM saildb_rows')
+    self.assertEqual(cursor.fetchone(), (ROW_COUNT,))
+
+  # Pending operation(s)
+
+  async def test_pending_cursor_rejects_other_operations(self) -> None:
+    cursor = (await self.connect()).cursor()
+    pending = cursor.execute_async(SLOW_QUERY)
+
+    # HY010, i.e. function sequence error
+    self.assertPending(lambda: cursor.execute('SELECT 1'))
+    self.assertPending(lambda: cursor.executemany('SELECT ?', [(1,), (2,)]))
+    self.assertPending(cursor.fetchone)
+    self.assertPending(lambda: cursor.fetchmany(1))
+    self.assertPending(cursor.fetchall)
+    self.assertPending(lambda: cursor.rowcount)
+    self.assertPending(cursor.close)
+
+    # Rejected before being submitted, so no second awaitable is created
+    self.assertPending(lambda: cursor.execute_async('SELECT 1'))
+    self.assertPending(cursor.fetchall_async)
+
+    # The pending operation is unaffected
+    self.assertIs(await pending, cursor)
+    self.assertEqual(await cursor.fetchall_async(), [(3000000,)])
+    cursor.close()
+
+  async def test_pending_operation_rejects_transaction_end(self) -> None:
+    connection = await self.connect()
+    cursor = connection.cursor()
+    pending = cursor.execute_async(SLOW_QUERY)
+
+    self.assertPending(connection.commit)
+    self.assertPending(connection.rollback)
+    self.assertPending(connection.close)
+    self.assertPending(lambda: setattr(connection, 'autocommit', True))
+    self.assertFalse(connection.closed)
+
+    await pending
+    self.assertEqual(cursor.fetchall(), [(3000000,)])
+    connection.commit()
+    connection.close()
+    self.assertTrue(cursor.closed)
+
+
+if __name__ == '__main__':
+  unittest.main()
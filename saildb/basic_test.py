@@ -9,3 +9,6 @@ if __name__ == '__main__':
 
   some_dot_env: str = saildb.try_dot_env("valueWithMixedInterpValues")
   print(some_dot_env)
+
+  diagnostics: list[saildb.DotEnvDiagnostic] = saildb.check_dot_env('resources/.saildb.env')
+  print(diagnostics)
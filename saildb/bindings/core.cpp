@@ -1,14 +1,37 @@
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 
+#include <arrow/api.h>
+#include <arrow/c/abi.h>
+#include <arrow/c/bridge.h>
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <variant>
+#include <type_traits>
 #include <string>
 #include <exception>
+#include <stdexcept>
 #include <filesystem>
 
 #include "sailc/wapi/wapi.hpp"
+#include "sailc/driver/Environment.hpp"
+#include "sailc/driver/ResultCache.hpp"
+#include "sailc/driver/ResultReader.hpp"
+#include "sailc/driver/PartitionedReader.hpp"
+#include "sailc/driver/SpillReader.hpp"
+
+#include "dbapi.hpp"
 
 #define STRINGIFY(x) #x
 #define MACRO_STRINGIFY(x) STRINGIFY(x)
 
+namespace py = pybind11;
+namespace wapi = saildb::wapi;
 namespace common = saildb::common;
 
 
@@ -22,6 +45,266 @@ std::string tryDotEnv(std::string keyname) {
   return value;
 }
 
+std::vector<wapi::DotEnv::Diagnostic> checkDotEnv(std::string fp, bool strict) {
+  const uint8_t flags = wapi::DotEnv::DIAGNOSTICS | (strict ? wapi::DotEnv::STRICT : 0);
+
+  wapi::DotEnv env(fp, flags);
+  return env.GetDiagnostics();
+}
+
+
+/*****  Arrow PyCapsule interface  *****/
+
+// Capsule destructor(s) release the structure unless a consumer has already moved it,
+// i.e. set its `release` callback to `NULL`
+template <typename T>
+void releaseArrowCapsule(PyObject* capsule) {
+  const char* name = PyCapsule_GetName(capsule);
+  auto* value = static_cast<T*>(PyCapsule_GetPointer(capsule, name));
+  if (value == nullptr) {
+    PyErr_WriteUnraisable(capsule);
+    return;
+  }
+
+  if (value->release != nullptr) {
+    value->release(value);
+  }
+
+  delete value;
+}
+
+template <typename T>
+py::capsule makeArrowCapsule(std::unique_ptr<T> value, const char* name) {
+  PyObject* capsule = PyCapsule_New(value.get(), name, &releaseArrowCapsule<T>);
+  if (capsule == nullptr) {
+    throw py::error_already_set();
+  }
+
+  value.release();
+  return py::reinterpret_steal<py::capsule>(capsule);
+}
+
+void throwIfError(const arrow::Status& status) {
+  if (!status.ok()) {
+    throw std::runtime_error(status.ToString());
+  }
+}
+
+py::capsule exportSchema(const arrow::Schema& schema) {
+  auto out = std::make_unique<ArrowSchema>();
+  out->release = nullptr;
+  throwIfError(arrow::ExportSchema(schema, out.get()));
+
+  return makeArrowCapsule(std::move(out), "arrow_schema");
+}
+
+py::tuple exportRecordBatch(const arrow::RecordBatch& batch) {
+  auto schema = std::make_unique<ArrowSchema>();
+  auto array = std::make_unique<ArrowArray>();
+  schema->release = nullptr;
+  array->release = nullptr;
+  throwIfError(arrow::ExportRecordBatch(batch, array.get(), schema.get()));
+
+  return py::make_tuple(
+    makeArrowCapsule(std::move(schema), "arrow_schema"),
+    makeArrowCapsule(std::move(array), "arrow_array")
+  );
+}
+
+// The stream shares the reader; batch(es) are produced by the consumer's call(s) to `get_next`,
+// which hold no reference to Python object(s) & so may run without the GIL
+py::capsule exportRecordBatchStream(std::shared_ptr<arrow::RecordBatchReader> reader) {
+  auto out = std::make_unique<ArrowArrayStream>();
+  out->release = nullptr;
+  throwIfError(arrow::ExportRecordBatchReader(std::move(reader), out.get()));
+
+  return makeArrowCapsule(std::move(out), "arrow_array_stream");
+}
+
+std::shared_ptr<arrow::RecordBatch> readNextBatch(arrow::RecordBatchReader& reader) {
+  std::shared_ptr<arrow::RecordBatch> batch;
+  arrow::Status status;
+  {
+    py::gil_scoped_release release;
+    status = reader.ReadNext(&batch);
+  }
+
+  throwIfError(status);
+  return batch;
+}
+
+std::shared_ptr<arrow::RecordBatchReader> readQuery(
+  saildb::Environment& environment,
+  const std::string& connectionString,
+  const std::string& query,
+  size_t rowArraySize,
+  int64_t batchSize,
+  bool cache,
+  int64_t memoryBudget,
+  const std::filesystem::path& spillDirectory
+) {
+  saildb::ReaderOptions options;
+  options.rowArraySize = rowArraySize;
+  options.batchSize = batchSize;
+  options.memoryBudget = memoryBudget;
+  options.spillDirectory = spillDirectory;
+
+  // Checkout, execution & description may block on the server
+  py::gil_scoped_release release;
+  return environment.Read(connectionString, query, std::move(options), cache);
+}
+
+// Resolved with a reader of the whole result, read on the environment's executor so that iterating it doesn't block the loop;
+// batch(es) beyond `memoryBudget` are spilled to disk rather than held in memory
+py::object readQueryAsync(
+  std::shared_ptr<saildb::Environment> environment,
+  std::string connectionString,
+  std::string query,
+  size_t rowArraySize,
+  int64_t batchSize,
+  bool cache,
+  int64_t memoryBudget,
+  std::filesystem::path spillDirectory
+) {
+  saildb::ReaderOptions options;
+  options.rowArraySize = rowArraySize;
+  options.batchSize = batchSize;
+
+  // Applied here rather than by `Read`, as the whole result is read ahead before resolving
+  if (memoryBudget <= 0) {
+    memoryBudget = std::numeric_limits<int64_t>::max();
+  }
+
+  saildb::Executor& executor = *environment->GetExecutor();
+  return submitAsync(executor, [
+    environment,
+    connectionString = std::move(connectionString),
+    query = std::move(query),
+    options,
+    cache,
+    memoryBudget,
+    spillDirectory = std::move(spillDirectory)
+  ]() -> AsyncCompletion {
+    auto reader = saildb::SpillReader::Create(environment->Read(connectionString, query, options, cache), memoryBudget, spillDirectory);
+    throwIfError(reader->Wait());
+
+    return [reader = std::shared_ptr<arrow::RecordBatchReader>(std::move(reader))]() { return py::cast(reader); };
+  });
+}
+
+void enableResultCache(
+  saildb::Environment& environment,
+  const std::filesystem::path& directory,
+  double ttl,
+  uint64_t maxBytes,
+  const std::string& compression
+) {
+  saildb::ResultCacheOptions options;
+  options.directory = directory;
+  options.ttl = std::chrono::seconds(static_cast<int64_t>(ttl));
+  options.maxBytes = maxBytes;
+
+  if (compression == "lz4") {
+    options.compression = saildb::ResultCompression::Lz4;
+  } else if (compression == "zstd") {
+    options.compression = saildb::ResultCompression::Zstd;
+  } else if (compression != "none") {
+    throw py::value_error("Expected a compression of 'none', 'lz4' or 'zstd', got '" + compression + "'");
+  }
+
+  // Scans the directory
+  py::gil_scoped_release release;
+  environment.EnableResultCache(std::move(options));
+}
+
+py::object getResultCacheStats(const saildb::Environment& environment) {
+  const std::shared_ptr<saildb::ResultCache> cache = environment.GetResultCache();
+  if (!cache) {
+    return py::none();
+  }
+
+  py::dict result;
+  result["directory"] = cache->GetOptions().directory;
+  result["size"] = cache->GetSize();
+  result["bytes"] = cache->GetBytes();
+  result["max_bytes"] = cache->GetOptions().maxBytes;
+  result["hits"] = cache->GetHits();
+  result["misses"] = cache->GetMisses();
+  result["evictions"] = cache->GetEvictions();
+  return result;
+}
+
+py::dict getPoolStats(saildb::Environment& environment, const std::string& connectionString) {
+  const std::shared_ptr<saildb::ConnectionPool> pool = environment.GetPool(connectionString);
+
+  py::dict result;
+  result["open"] = pool->GetOpenCount();
+  result["idle"] = pool->GetIdleCount();
+  result["max_size"] = pool->GetOptions().maxSize;
+  return result;
+}
+
+saildb::PartitionBound toPartitionBound(py::handle value) {
+  const saildb::Parameter parameter = toParameter(value, py::module_::import("decimal").attr("Decimal"));
+
+  return std::visit([&value](const auto& bound) -> saildb::PartitionBound {
+    using T = std::decay_t<decltype(bound)>;
+    if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double> || std::is_same_v<T, SQL_DATE_STRUCT> || std::is_same_v<T, SQL_TIMESTAMP_STRUCT>) {
+      return bound;
+    } else {
+      throw py::type_error(common::concatTo<std::string>(
+        "Expected an int, float, date or datetime partition bound, got ",
+        py::str(value.get_type().attr("__name__")).cast<std::string>()
+      ));
+    }
+  }, parameter);
+}
+
+std::shared_ptr<arrow::RecordBatchReader> readPartitioned(
+  saildb::Environment& environment,
+  const std::string& connectionString,
+  const std::string& query,
+  const std::string& column,
+  size_t partitions,
+  py::object lowerBound,
+  py::object upperBound,
+  const std::string& strategy,
+  size_t parallelism,
+  bool ordered,
+  size_t rowArraySize,
+  int64_t batchSize,
+  int64_t memoryBudget,
+  const std::filesystem::path& spillDirectory
+) {
+  saildb::PartitionOptions options;
+  options.column = column;
+  options.partitionCount = partitions;
+  options.parallelism = parallelism;
+  options.isOrdered = ordered;
+  options.reader.rowArraySize = rowArraySize;
+  options.reader.batchSize = batchSize;
+  options.reader.memoryBudget = memoryBudget;
+  options.reader.spillDirectory = spillDirectory;
+
+  if (strategy == "modulo") {
+    options.strategy = saildb::PartitionStrategy::Modulo;
+  } else if (strategy == "range") {
+    if (lowerBound.is_none() || upperBound.is_none()) {
+      throw py::value_error("Range partitioning expects both lower_bound & upper_bound");
+    }
+
+    options.strategy = saildb::PartitionStrategy::Range;
+    options.lowerBound = toPartitionBound(lowerBound);
+    options.upperBound = toPartitionBound(upperBound);
+  } else {
+    throw py::value_error("Expected a strategy of 'range' or 'modulo', got '" + strategy + "'");
+  }
+
+  // Checkout, execution & description of the first partition may block on the server
+  py::gil_scoped_release release;
+  return environment.ReadPartitioned(connectionString, query, std::move(options));
+}
+
 
 PYBIND11_MODULE(_core, m) {
   #ifdef PKG_NAME
@@ -39,4 +322,167 @@ PYBIND11_MODULE(_core, m) {
 	m.doc() = "Some documentation";
 
 	m.def("try_dot_env", &tryDotEnv, "Some method doc");
+
+	py::class_<wapi::DotEnv::Diagnostic>(m, "DotEnvDiagnostic")
+		.def_readonly("line", &wapi::DotEnv::Diagnostic::line)
+		.def_readonly("column", &wapi::DotEnv::Diagnostic::column)
+		.def_readonly("layer", &wapi::DotEnv::Diagnostic::layer)
+		.def_property_readonly("issue", [](const wapi::DotEnv::Diagnostic& diagnostic) {
+			return std::string(wapi::DotEnv::GetIssueName(diagnostic.issue));
+		})
+		.def("__repr__", [](const wapi::DotEnv::Diagnostic& diagnostic) {
+			return common::concatTo<std::string>(
+				"<DotEnvDiagnostic ", wapi::DotEnv::GetIssueName(diagnostic.issue),
+				" at ", diagnostic.line, ":", diagnostic.column, ">"
+			);
+		});
+
+	m.def(
+		"check_dot_env",
+		&checkDotEnv,
+		"Parses a .env file & returns the issue(s) found, or raises on the first if strict",
+		py::arg("fp"),
+		py::arg("strict") = false
+	);
+
+	// Arrow result(s), exposed through the PyCapsule interface so that consumer(s), e.g. pyarrow,
+	// polars & pandas, adopt the buffer(s) without copying
+	py::class_<arrow::RecordBatch, std::shared_ptr<arrow::RecordBatch>>(m, "RecordBatch")
+		.def_property_readonly("num_rows", &arrow::RecordBatch::num_rows)
+		.def_property_readonly("num_columns", &arrow::RecordBatch::num_columns)
+		.def("__arrow_c_schema__", [](const arrow::RecordBatch& batch) {
+			return exportSchema(*batch.schema());
+		})
+		.def("__arrow_c_array__", [](const arrow::RecordBatch& batch, py::object requestedSchema) {
+			return exportRecordBatch(batch);
+		}, py::arg("requested_schema") = py::none())
+		.def("__len__", &arrow::RecordBatch::num_rows);
+
+	py::class_<arrow::RecordBatchReader, std::shared_ptr<arrow::RecordBatchReader>>(m, "RecordBatchReader")
+		.def("__arrow_c_schema__", [](const arrow::RecordBatchReader& reader) {
+			return exportSchema(*reader.schema());
+		})
+		.def("__arrow_c_stream__", [](std::shared_ptr<arrow::RecordBatchReader> reader, py::object requestedSchema) {
+			return exportRecordBatchStream(std::move(reader));
+		}, py::arg("requested_schema") = py::none(), "Exports the remaining batch(es) as an `ArrowArrayStream`, consuming the reader")
+		.def("read_next_batch", [](arrow::RecordBatchReader& reader) {
+			auto batch = readNextBatch(reader);
+			if (!batch) {
+				throw py::stop_iteration();
+			}
+
+			return batch;
+		})
+		.def("__iter__", [](py::object self) { return self; })
+		.def("__next__", [](arrow::RecordBatchReader& reader) {
+			auto batch = readNextBatch(reader);
+			if (!batch) {
+				throw py::stop_iteration();
+			}
+
+			return batch;
+		})
+		.def("close", [](arrow::RecordBatchReader& reader) {
+			throwIfError(reader.Close());
+		});
+
+	py::class_<saildb::Environment, std::shared_ptr<saildb::Environment>>(m, "Environment")
+		.def_static("create", [pkgname]() {
+			return saildb::Environment::Create(pkgname);
+		})
+		.def_property_readonly("service_name", &saildb::Environment::GetServiceName)
+		.def(
+			"read",
+			&readQuery,
+			"Executes a query on a pooled connection, returning a reader of its result as Arrow record batch(es); a non-zero "
+			"`memory_budget` reads ahead of the consumer, spilling batch(es) beyond it to a file in `spill_directory`",
+			py::arg("connection_string"),
+			py::arg("query"),
+			py::arg("row_array_size") = saildb::ReaderOptions().rowArraySize,
+			py::arg("batch_size") = saildb::ReaderOptions().batchSize,
+			py::arg("cache") = false,
+			py::arg("memory_budget") = saildb::ReaderOptions().memoryBudget,
+			py::arg("spill_directory") = saildb::ReaderOptions().spillDirectory
+		)
+		.def(
+			"read_async",
+			&readQueryAsync,
+			"Awaitable `read`; checkout, execution & fetch run on the environment's executor without the GIL, so the awaiting "
+			"loop isn't blocked. Cancellation only discards the result, as the driver call can't be interrupted",
+			py::arg("connection_string"),
+			py::arg("query"),
+			py::arg("row_array_size") = saildb::ReaderOptions().rowArraySize,
+			py::arg("batch_size") = saildb::ReaderOptions().batchSize,
+			py::arg("cache") = false,
+			py::arg("memory_budget") = saildb::ReaderOptions().memoryBudget,
+			py::arg("spill_directory") = saildb::ReaderOptions().spillDirectory
+		)
+		.def(
+			"read_partitioned",
+			&readPartitioned,
+			"Reads a query as partition(s) of `column` on concurrent pooled connection(s), merged into a single reader",
+			py::arg("connection_string"),
+			py::arg("query"),
+			py::arg("column"),
+			py::arg("partitions") = saildb::PartitionOptions().partitionCount,
+			py::arg("lower_bound") = py::none(),
+			py::arg("upper_bound") = py::none(),
+			py::arg("strategy") = "range",
+			py::arg("parallelism") = 0,
+			py::arg("ordered") = false,
+			py::arg("row_array_size") = saildb::ReaderOptions().rowArraySize,
+			py::arg("batch_size") = saildb::ReaderOptions().batchSize,
+			py::arg("memory_budget") = saildb::ReaderOptions().memoryBudget,
+			py::arg("spill_directory") = saildb::ReaderOptions().spillDirectory
+		)
+		.def(
+			"connect",
+			&saildb::Environment::Connect,
+			"Opens a DB-API connection on a pooled connection",
+			py::arg("connection_string"),
+			py::arg("autocommit") = false,
+			py::call_guard<py::gil_scoped_release>()
+		)
+		.def(
+			"enable_result_cache",
+			&enableResultCache,
+			"Caches the result(s) of read(s) & cursor(s) that opt in as Arrow IPC file(s) under `directory`, served "
+			"memory-mapped until `ttl` second(s) old; the least recently used are evicted beyond `max_bytes`",
+			py::arg("directory"),
+			py::arg("ttl") = static_cast<double>(saildb::ResultCacheOptions().ttl.count()),
+			py::arg("max_bytes") = saildb::ResultCacheOptions().maxBytes,
+			py::arg("compression") = "none"
+		)
+		.def("disable_result_cache", &saildb::Environment::DisableResultCache)
+		.def("clear_result_cache", [](saildb::Environment& environment) {
+			if (const auto cache = environment.GetResultCache()) {
+				py::gil_scoped_release release;
+				cache->Clear();
+			}
+		}, "Removes every cached result of the cache's directory")
+		.def_property_readonly("result_cache", &getResultCacheStats, "Counter(s) of the result cache, or `None` unless enabled")
+		.def("pool_stats", &getPoolStats, "Counter(s) of the given partition's pool, created on first use", py::arg("connection_string"))
+		.def("evict_idle", &saildb::Environment::EvictIdle, py::call_guard<py::gil_scoped_release>())
+		.def("clear", &saildb::Environment::Clear, py::call_guard<py::gil_scoped_release>());
+
+	// Module-level `connect` shares a single environment, created on first use
+	const auto environment = [pkgname]() {
+		static std::shared_ptr<saildb::Environment> environment = saildb::Environment::Create(pkgname);
+		return environment;
+	};
+
+	m.def(
+		"enable_result_cache",
+		[environment](const std::filesystem::path& directory, double ttl, uint64_t maxBytes, const std::string& compression) {
+			enableResultCache(*environment(), directory, ttl, maxBytes, compression);
+		},
+		"Enables the result cache of the shared environment, see `Environment.enable_result_cache`; "
+		"cursor(s) opt in by `Connection.cursor(result_cache=True)`",
+		py::arg("directory"),
+		py::arg("ttl") = static_cast<double>(saildb::ResultCacheOptions().ttl.count()),
+		py::arg("max_bytes") = saildb::ResultCacheOptions().maxBytes,
+		py::arg("compression") = "none"
+	);
+
+	bindDbApi(m, environment);
 }
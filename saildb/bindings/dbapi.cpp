@@ -0,0 +1,1229 @@
+#include "dbapi.hpp"
+
+#include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
+#include <datetime.h>
+
+#include <arrow/api.h>
+#include <arrow/c/abi.h>
+#include <arrow/c/bridge.h>
+#include <arrow/array/concatenate.h>
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <optional>
+#include <vector>
+#include <variant>
+#include <cstring>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <filesystem>
+
+#include "sailc/driver/Odbc.hpp"
+#include "sailc/driver/Cursor.hpp"
+#include "sailc/driver/Connection.hpp"
+
+namespace py = pybind11;
+namespace odbc = saildb::odbc;
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Exceptions                        *
+ *                                                          *
+ ************************************************************/
+
+// Owned by the module; never released, as translator(s) may run until finalization
+struct ErrorTypes {
+  PyObject* Warning;
+  PyObject* Error;
+  PyObject* InterfaceError;
+  PyObject* DatabaseError;
+  PyObject* DataError;
+  PyObject* OperationalError;
+  PyObject* IntegrityError;
+  PyObject* InternalError;
+  PyObject* ProgrammingError;
+  PyObject* NotSupportedError;
+};
+
+ErrorTypes errorTypes;
+
+PyObject* defineErrorType(py::module_& m, const char* name, PyObject* base) {
+  const std::string qualifiedName = std::string(PyModule_GetName(m.ptr())).append(".").append(name);
+
+  PyObject* type = PyErr_NewException(qualifiedName.c_str(), base, nullptr);
+  if (type == nullptr) {
+    throw py::error_already_set();
+  }
+
+  Py_INCREF(type);
+  m.add_object(name, py::reinterpret_steal<py::object>(type));
+  return type;
+}
+
+// Classifies an ODBC error by its SQLSTATE, see PEP 249's exception hierarchy
+PyObject* getErrorType(const std::string& state) {
+  const std::string_view code(state);
+  const std::string_view group = code.substr(0, 2);
+
+  if (code == "HY010" || code == "08003" || group == "IM") {
+    return code == "IM001" ? errorTypes.NotSupportedError : errorTypes.InterfaceError;
+  } else if (code == "HY105") {
+    return errorTypes.ProgrammingError;
+  } else if (code == "HYC00") {
+    return errorTypes.NotSupportedError;
+  } else if (group == "08" || group == "40" || code.substr(0, 3) == "HYT" || code == "HY001" || code == "HY008") {
+    return errorTypes.OperationalError;
+  } else if (group == "22") {
+    return errorTypes.DataError;
+  } else if (group == "23") {
+    return errorTypes.IntegrityError;
+  } else if (group == "07" || group == "21" || group == "24" || group == "25" || group == "3D" || group == "3F" || group == "42" || group == "44") {
+    return errorTypes.ProgrammingError;
+  } else if (group == "HY" && code != "HY000") {
+    return errorTypes.InternalError;
+  }
+
+  return errorTypes.DatabaseError;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Conversion                        *
+ *                                                          *
+ ************************************************************/
+
+saildb::Parameter toParameter(py::handle value, const py::object& decimalType) {
+  PyObject* object = value.ptr();
+
+  if (object == Py_None) {
+    return std::monostate();
+  } else if (PyBool_Check(object)) {
+    return object == Py_True;
+  } else if (PyLong_Check(object)) {
+    int isOverflow = 0;
+    const long long result = PyLong_AsLongLongAndOverflow(object, &isOverflow);
+    if (isOverflow != 0) {
+      // Left to the driver to convert, e.g. to DECIMAL
+      return py::str(value).cast<std::string>();
+    }
+
+    return static_cast<int64_t>(result);
+  } else if (PyFloat_Check(object)) {
+    return PyFloat_AS_DOUBLE(object);
+  } else if (PyUnicode_Check(object)) {
+    return value.cast<std::string>();
+  } else if (PyBytes_Check(object) || PyByteArray_Check(object) || PyMemoryView_Check(object)) {
+    const py::buffer_info info = py::reinterpret_borrow<py::buffer>(value).request();
+    const auto* data = static_cast<const uint8_t*>(info.ptr);
+    return std::vector<uint8_t>(data, data + info.size * info.itemsize);
+  } else if (PyDateTime_Check(object)) {
+    SQL_TIMESTAMP_STRUCT result{};
+    result.year = static_cast<SQLSMALLINT>(PyDateTime_GET_YEAR(object));
+    result.month = static_cast<SQLUSMALLINT>(PyDateTime_GET_MONTH(object));
+    result.day = static_cast<SQLUSMALLINT>(PyDateTime_GET_DAY(object));
+    result.hour = static_cast<SQLUSMALLINT>(PyDateTime_DATE_GET_HOUR(object));
+    result.minute = static_cast<SQLUSMALLINT>(PyDateTime_DATE_GET_MINUTE(object));
+    result.second = static_cast<SQLUSMALLINT>(PyDateTime_DATE_GET_SECOND(object));
+    result.fraction = static_cast<SQLUINTEGER>(PyDateTime_DATE_GET_MICROSECOND(object)) * 1000;
+    return result;
+  } else if (PyDate_Check(object)) {
+    SQL_DATE_STRUCT result{};
+    result.year = static_cast<SQLSMALLINT>(PyDateTime_GET_YEAR(object));
+    result.month = static_cast<SQLUSMALLINT>(PyDateTime_GET_MONTH(object));
+    result.day = static_cast<SQLUSMALLINT>(PyDateTime_GET_DAY(object));
+    return result;
+  } else if (PyTime_Check(object)) {
+    SQL_TIME_STRUCT result{};
+    result.hour = static_cast<SQLUSMALLINT>(PyDateTime_TIME_GET_HOUR(object));
+    result.minute = static_cast<SQLUSMALLINT>(PyDateTime_TIME_GET_MINUTE(object));
+    result.second = static_cast<SQLUSMALLINT>(PyDateTime_TIME_GET_SECOND(object));
+    return result;
+  } else if (py::isinstance(value, decimalType)) {
+    return py::str(value).cast<std::string>();
+  }
+
+  throw odbc::Error("HY105", std::string("Unsupported parameter type: ").append(py::str(value.get_type().attr("__name__"))));
+}
+
+std::vector<saildb::Parameter> toParameters(py::handle parameters, const py::object& decimalType) {
+  std::vector<saildb::Parameter> result;
+  if (parameters.is_none()) {
+    return result;
+  }
+
+  if (!py::isinstance<py::sequence>(parameters) || py::isinstance<py::str>(parameters)) {
+    throw odbc::Error("07002", "Expected a sequence of parameter(s), paramstyle is 'qmark'");
+  }
+
+  const py::sequence values = py::reinterpret_borrow<py::sequence>(parameters);
+  result.reserve(values.size());
+  for (py::handle value : values) {
+    result.push_back(toParameter(value, decimalType));
+  }
+
+  return result;
+}
+
+// Splits day(s) since the epoch into a civil date
+std::chrono::year_month_day toCivil(int64_t days) {
+  return std::chrono::year_month_day(std::chrono::sys_days(std::chrono::days(days)));
+}
+
+PyObject* toDate(int64_t days) {
+  const auto date = ::toCivil(days);
+  return PyDate_FromDate(static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()));
+}
+
+PyObject* toTime(int64_t microseconds) {
+  const int64_t seconds = microseconds / 1'000'000;
+  return PyTime_FromTime(
+    static_cast<int>(seconds / 3600), static_cast<int>(seconds / 60 % 60), static_cast<int>(seconds % 60),
+    static_cast<int>(microseconds % 1'000'000)
+  );
+}
+
+PyObject* toDateTime(int64_t microseconds) {
+  constexpr int64_t MICROSECONDS_PER_DAY = 86'400'000'000;
+
+  // Floored, as instant(s) before the epoch are negative
+  int64_t days = microseconds / MICROSECONDS_PER_DAY;
+  int64_t remainder = microseconds % MICROSECONDS_PER_DAY;
+  if (remainder < 0) {
+    remainder += MICROSECONDS_PER_DAY;
+    days -= 1;
+  }
+
+  const auto date = ::toCivil(days);
+  const int64_t seconds = remainder / 1'000'000;
+  return PyDateTime_FromDateAndTime(
+    static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()),
+    static_cast<int>(seconds / 3600), static_cast<int>(seconds / 60 % 60), static_cast<int>(seconds % 60),
+    static_cast<int>(remainder % 1'000'000)
+  );
+}
+
+int64_t toMicroseconds(int64_t value, arrow::TimeUnit::type unit) {
+  switch (unit) {
+    case arrow::TimeUnit::SECOND: return value * 1'000'000;
+    case arrow::TimeUnit::MILLI: return value * 1'000;
+    case arrow::TimeUnit::MICRO: return value;
+    case arrow::TimeUnit::NANO: return value / 1'000;
+  }
+
+  return value;
+}
+
+// Fills column `column` of each row tuple; value(s) are created column by column so that
+// the type is resolved once per column rather than per cell
+template <typename Fn>
+void fillColumn(const py::list& rows, const arrow::Array& array, Py_ssize_t column, Fn&& toValue) {
+  const int64_t length = array.length();
+  for (int64_t i = 0; i < length; ++i) {
+    PyObject* value;
+    if (array.IsNull(i)) {
+      Py_INCREF(Py_None);
+      value = Py_None;
+    } else {
+      value = toValue(i);
+      if (value == nullptr) {
+        throw py::error_already_set();
+      }
+    }
+
+    PyTuple_SET_ITEM(PyList_GET_ITEM(rows.ptr(), i), column, value);
+  }
+}
+
+void appendRows(py::list& output, const arrow::RecordBatch& batch, const py::object& decimalType) {
+  const int64_t rowCount = batch.num_rows();
+  const int columnCount = batch.num_columns();
+
+  py::list rows(rowCount);
+  for (int64_t i = 0; i < rowCount; ++i) {
+    PyObject* row = PyTuple_New(columnCount);
+    if (row == nullptr) {
+      throw py::error_already_set();
+    }
+
+    PyList_SET_ITEM(rows.ptr(), i, row);
+  }
+
+  for (int j = 0; j < columnCount; ++j) {
+    const arrow::Array& array = *batch.column(j);
+
+    switch (array.type_id()) {
+      case arrow::Type::BOOL: {
+        const auto& values = static_cast<const arrow::BooleanArray&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) { return PyBool_FromLong(values.Value(i)); });
+      } break;
+
+      case arrow::Type::INT16: {
+        const auto& values = static_cast<const arrow::Int16Array&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) { return PyLong_FromLong(values.Value(i)); });
+      } break;
+
+      case arrow::Type::INT32: {
+        const auto& values = static_cast<const arrow::Int32Array&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) { return PyLong_FromLong(values.Value(i)); });
+      } break;
+
+      case arrow::Type::INT64: {
+        const auto& values = static_cast<const arrow::Int64Array&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) { return PyLong_FromLongLong(values.Value(i)); });
+      } break;
+
+      case arrow::Type::FLOAT: {
+        const auto& values = static_cast<const arrow::FloatArray&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) { return PyFloat_FromDouble(values.Value(i)); });
+      } break;
+
+      case arrow::Type::DOUBLE: {
+        const auto& values = static_cast<const arrow::DoubleArray&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) { return PyFloat_FromDouble(values.Value(i)); });
+      } break;
+
+      case arrow::Type::STRING: {
+        const auto& values = static_cast<const arrow::StringArray&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) {
+          const std::string_view value = values.GetView(i);
+          return PyUnicode_DecodeUTF8(value.data(), static_cast<Py_ssize_t>(value.size()), nullptr);
+        });
+      } break;
+
+      case arrow::Type::BINARY: {
+        const auto& values = static_cast<const arrow::BinaryArray&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) {
+          const std::string_view value = values.GetView(i);
+          return PyBytes_FromStringAndSize(value.data(), static_cast<Py_ssize_t>(value.size()));
+        });
+      } break;
+
+      case arrow::Type::DECIMAL128: {
+        const auto& values = static_cast<const arrow::Decimal128Array&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) {
+          return decimalType(values.FormatValue(i)).release().ptr();
+        });
+      } break;
+
+      case arrow::Type::DATE32: {
+        const auto& values = static_cast<const arrow::Date32Array&>(array);
+        ::fillColumn(rows, array, j, [&](int64_t i) { return ::toDate(values.Value(i)); });
+      } break;
+
+      case arrow::Type::TIME32: {
+        const auto& values = static_cast<const arrow::Time32Array&>(array);
+        const auto unit = static_cast<const arrow::Time32Type&>(*array.type()).unit();
+        ::fillColumn(rows, array, j, [&](int64_t i) { return ::toTime(::toMicroseconds(values.Value(i), unit)); });
+      } break;
+
+      case arrow::Type::TIMESTAMP: {
+        const auto& values = static_cast<const arrow::TimestampArray&>(array);
+        const auto unit = static_cast<const arrow::TimestampType&>(*array.type()).unit();
+        ::fillColumn(rows, array, j, [&](int64_t i) { return ::toDateTime(::toMicroseconds(values.Value(i), unit)); });
+      } break;
+
+      default: {
+        ::fillColumn(rows, array, j, [&](int64_t i) {
+          auto scalar = array.GetScalar(i);
+          return py::str(scalar.ok() ? scalar.ValueUnsafe()->ToString() : std::string()).release().ptr();
+        });
+      } break;
+    }
+  }
+
+  for (py::handle row : rows) {
+    output.append(row);
+  }
+}
+
+py::object getTypeCode(const arrow::DataType& type, const py::object& decimalType) {
+  const py::module_ builtins = py::module_::import("builtins");
+  const py::module_ datetime = py::module_::import("datetime");
+
+  switch (type.id()) {
+    case arrow::Type::BOOL: return builtins.attr("bool");
+    case arrow::Type::INT16:
+    case arrow::Type::INT32:
+    case arrow::Type::INT64: return builtins.attr("int");
+    case arrow::Type::FLOAT:
+    case arrow::Type::DOUBLE: return builtins.attr("float");
+    case arrow::Type::DECIMAL128: return decimalType;
+    case arrow::Type::DATE32: return datetime.attr("date");
+    case arrow::Type::TIME32: return datetime.attr("time");
+    case arrow::Type::TIMESTAMP: return datetime.attr("datetime");
+    case arrow::Type::BINARY: return builtins.attr("bytes");
+    default: return builtins.attr("str");
+  }
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                     Bulk parameter(s)                    *
+ *                                                          *
+ ************************************************************/
+
+template <typename T>
+T unwrapArrow(arrow::Result<T> result) {
+  if (!result.ok()) {
+    throw odbc::Error("HY000", result.status().message());
+  }
+
+  return std::move(result).ValueUnsafe();
+}
+
+void unwrapArrow(const arrow::Status& status) {
+  if (!status.ok()) {
+    throw odbc::Error("HY000", status.message());
+  }
+}
+
+template <typename T>
+T* getCapsulePointer(py::handle capsule, const char* name) {
+  auto* value = static_cast<T*>(PyCapsule_GetPointer(capsule.ptr(), name));
+  if (value == nullptr) {
+    throw py::error_already_set();
+  }
+
+  return value;
+}
+
+// Day(s) since the epoch of a civil date
+int64_t fromCivil(const SQL_DATE_STRUCT& value) {
+  const std::chrono::year_month_day date{
+    std::chrono::year{value.year},
+    std::chrono::month{value.month},
+    std::chrono::day{value.day}
+  };
+
+  return std::chrono::sys_days(date).time_since_epoch().count();
+}
+
+template <typename Builder, typename Fn>
+std::shared_ptr<arrow::Array> buildArray(Builder& builder, const std::vector<saildb::Parameter>& values, Fn&& toValue) {
+  ::unwrapArrow(builder.Reserve(static_cast<int64_t>(values.size())));
+  for (const saildb::Parameter& value : values) {
+    if (std::holds_alternative<std::monostate>(value)) {
+      ::unwrapArrow(builder.AppendNull());
+    } else {
+      ::unwrapArrow(builder.Append(toValue(value)));
+    }
+  }
+
+  std::shared_ptr<arrow::Array> result;
+  ::unwrapArrow(builder.Finish(&result));
+  return result;
+}
+
+// Column of Python value(s) as an Arrow array, or `nullptr` if its value(s) differ in type;
+// integer(s) are widened where mixed with float(s)
+std::shared_ptr<arrow::Array> toArrowArray(const std::vector<saildb::Parameter>& values) {
+  size_t kind = 0;
+  for (const saildb::Parameter& value : values) {
+    const size_t index = value.index();
+    if (index == 0 || index == kind) {
+      continue;
+    }
+
+    const bool isNumeric = (index == 2 || index == 3) && (kind == 2 || kind == 3);
+    if (kind != 0 && !isNumeric) {
+      return nullptr;
+    }
+
+    kind = isNumeric ? 3 : index;
+  }
+
+  arrow::MemoryPool* pool = arrow::default_memory_pool();
+  switch (kind) {
+    case 0: {
+      return std::make_shared<arrow::NullArray>(static_cast<int64_t>(values.size()));
+    }
+
+    case 1: {
+      arrow::BooleanBuilder builder(pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) { return std::get<bool>(value); });
+    }
+
+    case 2: {
+      arrow::Int64Builder builder(pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) { return std::get<int64_t>(value); });
+    }
+
+    case 3: {
+      arrow::DoubleBuilder builder(pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) {
+        return std::holds_alternative<double>(value) ? std::get<double>(value) : static_cast<double>(std::get<int64_t>(value));
+      });
+    }
+
+    case 4: {
+      arrow::StringBuilder builder(pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) -> const std::string& { return std::get<std::string>(value); });
+    }
+
+    case 5: {
+      arrow::BinaryBuilder builder(pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) {
+        const auto& bytes = std::get<std::vector<uint8_t>>(value);
+        return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+      });
+    }
+
+    case 6: {
+      arrow::Date32Builder builder(pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) {
+        return static_cast<int32_t>(::fromCivil(std::get<SQL_DATE_STRUCT>(value)));
+      });
+    }
+
+    case 7: {
+      arrow::Time32Builder builder(arrow::time32(arrow::TimeUnit::SECOND), pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) {
+        const auto& time = std::get<SQL_TIME_STRUCT>(value);
+        return static_cast<int32_t>(time.hour*3600 + time.minute*60 + time.second);
+      });
+    }
+
+    default: {
+      arrow::TimestampBuilder builder(arrow::timestamp(arrow::TimeUnit::MICRO), pool);
+      return ::buildArray(builder, values, [](const saildb::Parameter& value) {
+        const auto& timestamp = std::get<SQL_TIMESTAMP_STRUCT>(value);
+        const int64_t days = ::fromCivil(SQL_DATE_STRUCT{timestamp.year, timestamp.month, timestamp.day});
+        const int64_t seconds = days*86'400 + timestamp.hour*3600 + timestamp.minute*60 + timestamp.second;
+        return seconds*1'000'000 + timestamp.fraction / 1000;
+      });
+    }
+  }
+}
+
+// Copies a contiguous, one-dimensional buffer of number(s), e.g. a NumPy array; `nullptr` if the
+// layout or format isn't supported
+std::shared_ptr<arrow::Array> fromBuffer(const py::buffer_info& info) {
+  if (info.ndim != 1 || info.strides[0] != info.itemsize || info.format.empty()) {
+    return nullptr;
+  }
+
+  // Native or little-endian only, i.e. without a `>` or `!` prefix
+  const char prefix = info.format.front();
+  if (info.format.size() > 2 || (info.format.size() == 2 && prefix != '@' && prefix != '=' && prefix != '<')) {
+    return nullptr;
+  }
+
+  const char code = info.format.back();
+  const int64_t length = static_cast<int64_t>(info.size);
+
+  if (code == '?') {
+    const auto* values = static_cast<const uint8_t*>(info.ptr);
+
+    arrow::BooleanBuilder builder;
+    ::unwrapArrow(builder.Reserve(length));
+    for (int64_t i = 0; i < length; ++i) {
+      builder.UnsafeAppend(values[i] != 0);
+    }
+
+    std::shared_ptr<arrow::Array> result;
+    ::unwrapArrow(builder.Finish(&result));
+    return result;
+  }
+
+  std::shared_ptr<arrow::DataType> type;
+  switch (code) {
+    case 'b': case 'h': case 'i': case 'l': case 'q':
+      type = info.itemsize == 1 ? arrow::int8() : info.itemsize == 2 ? arrow::int16() : info.itemsize == 4 ? arrow::int32() : arrow::int64();
+      break;
+    case 'B': case 'H': case 'I': case 'L': case 'Q':
+      type = info.itemsize == 1 ? arrow::uint8() : info.itemsize == 2 ? arrow::uint16() : info.itemsize == 4 ? arrow::uint32() : arrow::uint64();
+      break;
+    case 'f':
+      type = arrow::float32();
+      break;
+    case 'd':
+      type = arrow::float64();
+      break;
+    default:
+      return nullptr;
+  }
+
+  // Copied, as the exporter's buffer may only be released while holding the GIL
+  const int64_t size = length * static_cast<int64_t>(info.itemsize);
+  std::shared_ptr<arrow::Buffer> buffer = ::unwrapArrow(arrow::AllocateBuffer(size));
+  std::memcpy(buffer->mutable_data(), info.ptr, static_cast<size_t>(size));
+
+  return arrow::MakeArray(arrow::ArrayData::Make(std::move(type), length, {nullptr, std::move(buffer)}, 0));
+}
+
+// Column of a mapping, i.e. an Arrow array, a buffer of number(s) or a sequence of Python value(s)
+std::shared_ptr<arrow::Array> toArrowColumn(py::handle column, const py::object& decimalType) {
+  if (py::hasattr(column, "__arrow_c_array__")) {
+    const py::tuple capsules = column.attr("__arrow_c_array__")();
+    return ::unwrapArrow(arrow::ImportArray(
+      ::getCapsulePointer<ArrowArray>(capsules[1], "arrow_array"),
+      ::getCapsulePointer<ArrowSchema>(capsules[0], "arrow_schema")
+    ));
+  }
+
+  if (py::hasattr(column, "__arrow_c_stream__")) {
+    const py::object capsule = column.attr("__arrow_c_stream__")();
+    const auto chunked = ::unwrapArrow(arrow::ImportChunkedArray(::getCapsulePointer<ArrowArrayStream>(capsule, "arrow_array_stream")));
+    if (chunked->num_chunks() == 1) {
+      return chunked->chunk(0);
+    }
+
+    return chunked->num_chunks() == 0
+      ? ::unwrapArrow(arrow::MakeEmptyArray(chunked->type()))
+      : ::unwrapArrow(arrow::Concatenate(chunked->chunks()));
+  }
+
+  if (PyObject_CheckBuffer(column.ptr()) && !PyBytes_Check(column.ptr()) && !PyByteArray_Check(column.ptr())) {
+    if (auto result = ::fromBuffer(py::reinterpret_borrow<py::buffer>(column).request())) {
+      return result;
+    }
+  }
+
+  std::vector<saildb::Parameter> values;
+  for (py::handle value : py::reinterpret_borrow<py::iterable>(column)) {
+    values.push_back(::toParameter(value, decimalType));
+  }
+
+  auto result = ::toArrowArray(values);
+  if (!result) {
+    throw odbc::Error("HY105", "Expected the value(s) of each parameter column to share a type");
+  }
+
+  return result;
+}
+
+// Parameter set(s) given as Arrow data, i.e. via the PyCapsule interface, or as a mapping of column(s);
+// `nullptr` if given as row(s)
+std::shared_ptr<arrow::RecordBatchReader> fromColumns(py::handle parameters, const py::object& decimalType) {
+  if (py::hasattr(parameters, "__arrow_c_stream__")) {
+    const py::object capsule = parameters.attr("__arrow_c_stream__")();
+    return ::unwrapArrow(arrow::ImportRecordBatchReader(::getCapsulePointer<ArrowArrayStream>(capsule, "arrow_array_stream")));
+  }
+
+  if (py::hasattr(parameters, "__arrow_c_array__")) {
+    const py::tuple capsules = parameters.attr("__arrow_c_array__")();
+    auto batch = ::unwrapArrow(arrow::ImportRecordBatch(
+      ::getCapsulePointer<ArrowArray>(capsules[1], "arrow_array"),
+      ::getCapsulePointer<ArrowSchema>(capsules[0], "arrow_schema")
+    ));
+
+    return ::unwrapArrow(arrow::RecordBatchReader::Make({std::move(batch)}));
+  }
+
+  if (!PyDict_Check(parameters.ptr())) {
+    return nullptr;
+  }
+
+  arrow::FieldVector fields;
+  arrow::ArrayVector columns;
+  for (auto [key, column] : py::reinterpret_borrow<py::dict>(parameters)) {
+    columns.push_back(::toArrowColumn(column, decimalType));
+    fields.push_back(arrow::field(py::str(key).cast<std::string>(), columns.back()->type()));
+
+    if (columns.back()->length() != columns.front()->length()) {
+      throw odbc::Error("07002", "Expected parameter column(s) of equal length");
+    }
+  }
+
+  const int64_t length = columns.empty() ? 0 : columns.front()->length();
+  auto batch = arrow::RecordBatch::Make(arrow::schema(std::move(fields)), length, std::move(columns));
+  return ::unwrapArrow(arrow::RecordBatchReader::Make({std::move(batch)}));
+}
+
+// Row(s) of parameter(s) transposed into Arrow column(s), or `nullptr` if a column's value(s) differ in type
+std::shared_ptr<arrow::RecordBatchReader> fromRows(const py::list& rows, const py::object& decimalType) {
+  std::vector<std::vector<saildb::Parameter>> values;
+  for (py::handle row : rows) {
+    std::vector<saildb::Parameter> parameters = ::toParameters(row, decimalType);
+    if (values.empty()) {
+      values.resize(parameters.size());
+    } else if (parameters.size() != values.size()) {
+      throw odbc::Error("07002", "Expected each parameter set to be of equal length");
+    }
+
+    for (size_t i = 0; i < parameters.size(); ++i) {
+      values[i].push_back(std::move(parameters[i]));
+    }
+  }
+
+  arrow::FieldVector fields;
+  arrow::ArrayVector columns;
+  for (size_t i = 0; i < values.size(); ++i) {
+    auto column = ::toArrowArray(values[i]);
+    if (!column) {
+      return nullptr;
+    }
+
+    fields.push_back(arrow::field(std::to_string(i + 1), column->type()));
+    columns.push_back(std::move(column));
+  }
+
+  auto batch = arrow::RecordBatch::Make(arrow::schema(std::move(fields)), static_cast<int64_t>(py::len(rows)), std::move(columns));
+  return ::unwrapArrow(arrow::RecordBatchReader::Make({std::move(batch)}));
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Async                           *
+ *                                                          *
+ ************************************************************/
+
+std::shared_ptr<py::object> makeShared(py::object value) {
+  return std::shared_ptr<py::object>(new py::object(std::move(value)), [](py::object* object) {
+    // Leaked once the interpreter is finalized
+    if (!Py_IsInitialized()) {
+      (void)object->release();
+      delete object;
+      return;
+    }
+
+    py::gil_scoped_acquire acquire;
+    delete object;
+  });
+}
+
+// Python exception of `error`, as translated by the registered translator(s)
+py::object toPyError(std::exception_ptr error) {
+  try {
+    py::cpp_function([error]() { std::rethrow_exception(error); })();
+  } catch (py::error_already_set& e) {
+    return e.value();
+  }
+
+  return py::none();
+}
+
+// Run on the future's loop; a cancelled future only discards the result, as the driver call can't be interrupted
+void resolveFuture(py::object future, py::object result, py::object error) {
+  if (future.attr("done")().cast<bool>()) {
+    return;
+  }
+
+  if (error.is_none()) {
+    future.attr("set_result")(result);
+  } else {
+    future.attr("set_exception")(error);
+  }
+}
+
+py::object submitAsync(saildb::Executor& executor, std::function<AsyncCompletion()> task) {
+  py::object loop = py::module_::import("asyncio").attr("get_running_loop")();
+  py::object future = loop.attr("create_future")();
+
+  auto state = ::makeShared(py::make_tuple(loop, future));
+  executor.Submit([state, task = std::move(task)]() mutable {
+    AsyncCompletion completion;
+    std::exception_ptr error;
+    try {
+      completion = task();
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    py::gil_scoped_acquire acquire;
+
+    py::object result = py::none(), exception = py::none();
+    if (error) {
+      exception = ::toPyError(error);
+    } else {
+      try {
+        result = completion();
+      } catch (py::error_already_set& e) {
+        exception = e.value();
+      } catch (...) {
+        exception = ::toPyError(std::current_exception());
+      }
+    }
+
+    // Capture(s) are released while the GIL is held, so that the worker needn't acquire it once the
+    // future may resolve, e.g. if its owner releases the executor meanwhile
+    completion = nullptr;
+    task = nullptr;
+
+    try {
+      const py::tuple context = py::reinterpret_borrow<py::tuple>(*state);
+      context[0].attr("call_soon_threadsafe")(py::cpp_function(&::resolveFuture), context[1], result, exception);
+    } catch (py::error_already_set& e) {
+      // e.g. the loop was closed meanwhile
+      e.discard_as_unraisable("submitAsync");
+    }
+
+    state.reset();
+  });
+
+  return future;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Cursor                          *
+ *                                                          *
+ ************************************************************/
+
+/*
+ * Python-facing cursor; row(s) taken one at a time, e.g. by `fetchone` or iteration, are
+ * converted in chunk(s) of `arraysize` row(s) or more
+ */
+class PyCursor {
+  public:
+    static constexpr const int64_t MIN_CHUNK_SIZE = 256;
+
+  public:
+    PyCursor(std::shared_ptr<saildb::Cursor> cursor)
+      : m_cursor(std::move(cursor)), m_decimalType(py::module_::import("decimal").attr("Decimal")) { };
+
+  public:
+    void Execute(const std::string& operation, py::handle parameters) {
+      ensureIdle();
+      std::vector<saildb::Parameter> values = ::toParameters(parameters, m_decimalType);
+      reset();
+
+      py::gil_scoped_release release;
+      m_cursor->Execute(operation, values);
+    }
+
+    // Array-bound where the parameter set(s) are Arrow data, column(s) or row(s) whose column(s) share a type;
+    // otherwise executed row by row
+    void ExecuteMany(const std::string& operation, py::handle sequence, const saildb::BulkOptions& options) {
+      ensureIdle();
+      reset();
+
+      std::shared_ptr<arrow::RecordBatchReader> reader = ::fromColumns(sequence, m_decimalType);
+      if (!reader) {
+        const py::list rows(sequence);
+        if (rows.empty()) {
+          m_rowCount = 0;
+          return;
+        }
+
+        reader = ::fromRows(rows, m_decimalType);
+        if (!reader) {
+          executeRows(operation, rows);
+          return;
+        }
+      }
+
+      // The reader outlives the release, as imported buffer(s) may be released by Python
+      py::gil_scoped_release release;
+      m_cursor->ExecuteMany(operation, *reader, options);
+    }
+
+    py::bytes GetRowStatus() const {
+      ensureIdle();
+      const auto& status = m_cursor->GetRowStatus();
+      return py::bytes(reinterpret_cast<const char*>(status.data()), status.size());
+    }
+
+    py::object FetchOne() {
+      ensureIdle();
+      if (m_index >= m_pending.size() && !fill(std::max<int64_t>(static_cast<int64_t>(m_cursor->GetArraySize()), MIN_CHUNK_SIZE))) {
+        return py::none();
+      }
+
+      return m_pending[m_index++];
+    }
+
+    py::list FetchMany(int64_t size) {
+      ensureIdle();
+      py::list result;
+      take(result, size);
+
+      while (static_cast<int64_t>(py::len(result)) < size) {
+        auto batch = fetch(size - static_cast<int64_t>(py::len(result)));
+        if (!batch) {
+          break;
+        }
+
+        ::appendRows(result, *batch, m_decimalType);
+      }
+
+      return result;
+    }
+
+    py::list FetchAll() {
+      return FetchMany(std::numeric_limits<int64_t>::max());
+    }
+
+    py::object GetDescription() const {
+      ensureIdle();
+      const auto schema = m_cursor->GetSchema();
+      if (!schema) {
+        return py::none();
+      }
+
+      py::list result;
+      for (const auto& field : schema->fields()) {
+        py::object precision = py::none(), scale = py::none();
+        if (field->type()->id() == arrow::Type::DECIMAL128) {
+          const auto& type = static_cast<const arrow::Decimal128Type&>(*field->type());
+          precision = py::int_(type.precision());
+          scale = py::int_(type.scale());
+        }
+
+        result.append(py::make_tuple(
+          field->name(), ::getTypeCode(*field->type(), m_decimalType),
+          py::none(), py::none(), precision, scale, field->nullable()
+        ));
+      }
+
+      return result;
+    }
+
+    int64_t GetRowCount() const {
+      ensureIdle();
+      return m_rowCount.value_or(m_cursor->GetRowCount());
+    }
+
+    void Close() {
+      ensureIdle();
+      reset();
+
+      py::gil_scoped_release release;
+      m_cursor->Close();
+    }
+
+    // Resolved with the cursor once executed
+    py::object ExecuteAsync(py::object self, std::string operation, py::handle parameters) {
+      ensureIdle();
+      std::vector<saildb::Parameter> values = ::toParameters(parameters, m_decimalType);
+      reset();
+
+      return submit(std::move(self), [cursor = m_cursor, operation = std::move(operation), values = std::move(values)]() -> Completion {
+        cursor->Execute(operation, values);
+        return [](PyCursor&, py::object self) { return self; };
+      });
+    }
+
+    // Resolved with up to `size` row(s); the result set is read on the executor, its row(s) are
+    // converted on the loop
+    py::object FetchManyAsync(py::object self, int64_t size) {
+      ensureIdle();
+
+      const int64_t buffered = static_cast<int64_t>(m_pending.size() - m_index);
+      return submit(std::move(self), [cursor = m_cursor, size, remaining = size - std::min(size, buffered)]() -> Completion {
+        std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+        for (int64_t count = 0; count < remaining;) {
+          auto batch = cursor->Fetch(remaining - count);
+          if (!batch) {
+            break;
+          }
+
+          count += batch->num_rows();
+          batches.push_back(std::move(batch));
+        }
+
+        return [size, batches = std::move(batches)](PyCursor& owner, py::object) -> py::object {
+          py::list result;
+          owner.take(result, size);
+          for (const auto& batch : batches) {
+            ::appendRows(result, *batch, owner.m_decimalType);
+          }
+
+          return result;
+        };
+      });
+    }
+
+    const std::shared_ptr<saildb::Cursor>& Get() const { return m_cursor; }
+
+  private:
+    // Converts the result of an operation run on the executor, with the GIL held
+    using Completion = std::function<py::object(PyCursor& owner, py::object self)>;
+
+    // The cursor is pending until the task completes, also if the future is cancelled beforehand; its
+    // connection only until the task has run, so that it may be closed as soon as the future resolves
+    py::object submit(py::object self, std::function<Completion()> task) {
+      const std::shared_ptr<saildb::Connection>& connection = m_cursor->GetConnection();
+      saildb::Executor& executor = *connection->GetExecutor();
+      auto operation = std::make_shared<saildb::Connection::Operation>(connection->BeginOperation());
+      auto owner = ::makeShared(std::move(self));
+
+      m_isPending = true;
+      try {
+        return ::submitAsync(executor, [owner, operation, task = std::move(task)]() mutable -> AsyncCompletion {
+          Completion completion;
+          std::exception_ptr error;
+          try {
+            completion = task();
+          } catch (...) {
+            error = std::current_exception();
+          }
+          operation.reset();
+
+          return [owner, completion = std::move(completion), error]() -> py::object {
+            PyCursor& cursor = owner->cast<PyCursor&>();
+            cursor.m_isPending = false;
+
+            if (error) {
+              std::rethrow_exception(error);
+            }
+
+            return completion(cursor, *owner);
+          };
+        });
+      } catch (...) {
+        m_isPending = false;
+        throw;
+      }
+    }
+
+    void ensureIdle() const {
+      if (m_isPending) {
+        throw odbc::Error("HY010", "Cursor has a pending asynchronous operation");
+      }
+    }
+
+    void executeRows(const std::string& operation, const py::list& rows) {
+      int64_t rowCount = 0;
+      for (py::handle parameters : rows) {
+        Execute(operation, parameters);
+        rowCount += std::max<int64_t>(m_cursor->GetRowCount(), 0);
+      }
+
+      m_rowCount = rowCount;
+    }
+
+    std::shared_ptr<arrow::RecordBatch> fetch(int64_t maxRows) {
+      py::gil_scoped_release release;
+      return m_cursor->Fetch(maxRows);
+    }
+
+    bool fill(int64_t size) {
+      m_pending = py::list();
+      m_index = 0;
+
+      auto batch = fetch(size);
+      if (!batch) {
+        return false;
+      }
+
+      ::appendRows(m_pending, *batch, m_decimalType);
+      return m_pending.size() > 0;
+    }
+
+    void take(py::list& output, int64_t size) {
+      while (m_index < m_pending.size() && static_cast<int64_t>(py::len(output)) < size) {
+        output.append(m_pending[m_index++]);
+      }
+    }
+
+    void reset() {
+      m_pending = py::list();
+      m_index = 0;
+      m_rowCount.reset();
+    }
+
+  private:
+    std::shared_ptr<saildb::Cursor> m_cursor;
+    py::object m_decimalType;
+
+    py::list m_pending;
+    size_t m_index{0};
+    std::optional<int64_t> m_rowCount;
+    bool m_isPending{false};
+};
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Bindings                         *
+ *                                                          *
+ ************************************************************/
+
+void bindDbApi(py::module_& m, std::function<std::shared_ptr<saildb::Environment>()> environment) {
+	PyDateTime_IMPORT;
+	if (PyDateTimeAPI == nullptr) {
+		throw py::error_already_set();
+	}
+
+	errorTypes.Warning = defineErrorType(m, "Warning", PyExc_Exception);
+	errorTypes.Error = defineErrorType(m, "Error", PyExc_Exception);
+	errorTypes.InterfaceError = defineErrorType(m, "InterfaceError", errorTypes.Error);
+	errorTypes.DatabaseError = defineErrorType(m, "DatabaseError", errorTypes.Error);
+	errorTypes.DataError = defineErrorType(m, "DataError", errorTypes.DatabaseError);
+	errorTypes.OperationalError = defineErrorType(m, "OperationalError", errorTypes.DatabaseError);
+	errorTypes.IntegrityError = defineErrorType(m, "IntegrityError", errorTypes.DatabaseError);
+	errorTypes.InternalError = defineErrorType(m, "InternalError", errorTypes.DatabaseError);
+	errorTypes.ProgrammingError = defineErrorType(m, "ProgrammingError", errorTypes.DatabaseError);
+	errorTypes.NotSupportedError = defineErrorType(m, "NotSupportedError", errorTypes.DatabaseError);
+
+	py::register_exception_translator([](std::exception_ptr error) {
+		try {
+			if (error) {
+				std::rethrow_exception(error);
+			}
+		} catch (const odbc::Error& e) {
+			PyErr_SetString(getErrorType(e.GetState()), e.what());
+		}
+	});
+
+	py::class_<saildb::Connection, std::shared_ptr<saildb::Connection>>(m, "Connection")
+		.def("cursor", [](saildb::Connection& connection, bool resultCache, int64_t memoryBudget, const std::filesystem::path& spillDirectory) {
+			saildb::CursorOptions options;
+			options.useResultCache = resultCache;
+			options.reader.memoryBudget = memoryBudget;
+			options.reader.spillDirectory = spillDirectory;
+
+			return std::make_shared<PyCursor>(connection.CreateCursor(std::move(options)));
+		},
+		"`result_cache` serves the cursor's result set(s) from the environment's result cache, if enabled; a non-zero `memory_budget` "
+		"reads each result set ahead of the fetch(es), spilling batch(es) beyond it to a file in `spill_directory`",
+		py::arg("result_cache") = false,
+		py::arg("memory_budget") = saildb::ReaderOptions().memoryBudget,
+		py::arg("spill_directory") = saildb::ReaderOptions().spillDirectory)
+		.def("commit", &saildb::Connection::Commit, py::call_guard<py::gil_scoped_release>())
+		.def("rollback", &saildb::Connection::Rollback, py::call_guard<py::gil_scoped_release>())
+		.def("close", &saildb::Connection::Close, py::call_guard<py::gil_scoped_release>())
+		.def_property_readonly("closed", &saildb::Connection::IsClosed)
+		.def_property("autocommit", &saildb::Connection::GetAutocommit, &saildb::Connection::SetAutocommit)
+		.def_property_readonly("statement_cache", [](const saildb::Connection& connection) {
+			const saildb::StatementCache& cache = connection.GetLease()->GetStatementCache();
+
+			py::dict result;
+			result["size"] = cache.GetSize();
+			result["capacity"] = cache.GetCapacity();
+			result["hits"] = cache.GetHits();
+			result["misses"] = cache.GetMisses();
+			result["evictions"] = cache.GetEvictions();
+			return result;
+		}, "Counter(s) of the prepared statement cache of the connection's pooled connection")
+		.def("__enter__", [](py::object self) { return self; })
+		.def("__exit__", [](saildb::Connection& connection, py::object type, py::object value, py::object traceback) {
+			// Commit(s) on success, as with `sqlite3` & `pyodbc`; the connection remains open
+			if (connection.IsClosed()) {
+				return;
+			}
+
+			py::gil_scoped_release release;
+			if (type.is_none()) {
+				connection.Commit();
+			} else {
+				connection.Rollback();
+			}
+		});
+
+	py::class_<PyCursor, std::shared_ptr<PyCursor>>(m, "Cursor")
+		.def_property_readonly("description", &PyCursor::GetDescription)
+		.def_property_readonly("rowcount", &PyCursor::GetRowCount)
+		.def_property_readonly("connection", [](const PyCursor& cursor) { return cursor.Get()->GetConnection(); })
+		.def_property_readonly("closed", [](const PyCursor& cursor) { return cursor.Get()->IsClosed(); })
+		.def_property(
+			"arraysize",
+			[](const PyCursor& cursor) { return cursor.Get()->GetArraySize(); },
+			[](PyCursor& cursor, size_t arraySize) { cursor.Get()->SetArraySize(arraySize); }
+		)
+		.def("execute", [](py::object self, const std::string& operation, py::object parameters) {
+			self.cast<PyCursor&>().Execute(operation, parameters);
+			return self;
+		}, py::arg("operation"), py::arg("parameters") = py::none())
+		.def("executemany", [](py::object self, const std::string& operation, py::object sequence, size_t batchSize, bool commitPerBatch, bool stopOnError) {
+			saildb::BulkOptions options;
+			options.batchSize = batchSize;
+			options.commitPerBatch = commitPerBatch;
+			options.stopOnError = stopOnError;
+
+			self.cast<PyCursor&>().ExecuteMany(operation, sequence, options);
+			return self;
+		},
+			"Executes the operation once per parameter set, binding up to `batch_size` set(s) per round trip; the set(s) may be "
+			"a sequence of row(s), a mapping of column(s), e.g. NumPy arrays, or Arrow data, e.g. a pyarrow table",
+			py::arg("operation"),
+			py::arg("seq_of_parameters"),
+			py::kw_only(),
+			py::arg("batch_size") = saildb::BulkOptions().batchSize,
+			py::arg("commit_per_batch") = saildb::BulkOptions().commitPerBatch,
+			py::arg("stop_on_error") = saildb::BulkOptions().stopOnError
+		)
+		.def_property_readonly("rowstatus", &PyCursor::GetRowStatus, "Status of each row of the last array-bound `executemany`, see `PARAM_*`")
+		.def("fetchone", &PyCursor::FetchOne)
+		.def("fetchmany", [](PyCursor& cursor, py::object size) {
+			return cursor.FetchMany(size.is_none() ? static_cast<int64_t>(cursor.Get()->GetArraySize()) : size.cast<int64_t>());
+		}, py::arg("size") = py::none())
+		.def("fetchall", &PyCursor::FetchAll)
+		.def("execute_async", [](py::object self, std::string operation, py::object parameters) {
+			return self.cast<PyCursor&>().ExecuteAsync(self, std::move(operation), parameters);
+		},
+			"Awaitable `execute`, run on the environment's executor without the GIL; resolves to the cursor",
+			py::arg("operation"),
+			py::arg("parameters") = py::none()
+		)
+		.def("fetchmany_async", [](py::object self, py::object size) {
+			PyCursor& cursor = self.cast<PyCursor&>();
+			return cursor.FetchManyAsync(self, size.is_none() ? static_cast<int64_t>(cursor.Get()->GetArraySize()) : size.cast<int64_t>());
+		}, "Awaitable `fetchmany`", py::arg("size") = py::none())
+		.def("fetchall_async", [](py::object self) {
+			return self.cast<PyCursor&>().FetchManyAsync(self, std::numeric_limits<int64_t>::max());
+		}, "Awaitable `fetchall`")
+		.def("close", &PyCursor::Close)
+		.def("setinputsizes", [](PyCursor&, py::object) { }, py::arg("sizes"))
+		.def("setoutputsize", [](PyCursor&, py::object, py::object) { }, py::arg("size"), py::arg("column") = py::none())
+		.def("__iter__", [](py::object self) { return self; })
+		.def("__next__", [](PyCursor& cursor) {
+			py::object row = cursor.FetchOne();
+			if (row.is_none()) {
+				throw py::stop_iteration();
+			}
+
+			return row;
+		})
+		.def("__enter__", [](py::object self) { return self; })
+		.def("__exit__", [](PyCursor& cursor, py::object, py::object, py::object) { cursor.Close(); });
+
+	m.def(
+		"connect",
+		[environment](const std::string& connectionString, bool autocommit) {
+			auto env = environment();
+
+			py::gil_scoped_release release;
+			try {
+				return env->Connect(connectionString, autocommit);
+			} catch (const odbc::Error&) {
+				throw;
+			} catch (const std::runtime_error& e) {
+				// e.g. the pool remained exhausted
+				throw odbc::Error("08001", e.what());
+			}
+		},
+		"Opens a DB-API connection on a pooled connection of the shared environment",
+		py::arg("connection_string"),
+		py::arg("autocommit") = false
+	);
+
+	m.def(
+		"connect_async",
+		[environment](std::string connectionString, bool autocommit) {
+			auto env = environment();
+
+			return ::submitAsync(*env->GetExecutor(), [env, connectionString = std::move(connectionString), autocommit]() -> AsyncCompletion {
+				std::shared_ptr<saildb::Connection> connection;
+				try {
+					connection = env->Connect(connectionString, autocommit);
+				} catch (const odbc::Error&) {
+					throw;
+				} catch (const std::runtime_error& e) {
+					throw odbc::Error("08001", e.what());
+				}
+
+				return [connection]() { return py::cast(connection); };
+			});
+		},
+		"Awaitable `connect`; the checkout, which may wait on an exhausted pool, runs on the shared environment's executor",
+		py::arg("connection_string"),
+		py::arg("autocommit") = false
+	);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <pybind11/pybind11.h>
+
+#include <memory>
+#include <functional>
+
+#include "sailc/driver/Cursor.hpp"
+#include "sailc/driver/Executor.hpp"
+#include "sailc/driver/Environment.hpp"
+
+// Converts the result of an asynchronous operation, run with the GIL held
+using AsyncCompletion = std::function<pybind11::object()>;
+
+// Registers the DB-API 2.0 (PEP 249) connection, cursor & exception type(s) on `m`;
+// `environment` is created by the first module-level `connect` & shared thereafter
+void bindDbApi(pybind11::module_& m, std::function<std::shared_ptr<saildb::Environment>()> environment);
+
+// Converts a Python value to a bound parameter; `bindDbApi` must have been called beforehand
+saildb::Parameter toParameter(pybind11::handle value, const pybind11::object& decimalType);
+
+// Runs `task` on `executor` without the GIL & returns an `asyncio.Future` of the running loop, resolved with its
+// completion's result or its error; Python object(s) may only be captured through `makeShared`
+pybind11::object submitAsync(saildb::Executor& executor, std::function<AsyncCompletion()> task);
+
+// Python reference which may be copied & released without the GIL, e.g. by the capture(s) of an executor's task
+std::shared_ptr<pybind11::object> makeShared(pybind11::object value);
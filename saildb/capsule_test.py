@@ -0,0 +1,111 @@
+"""PyCapsule export of read(s), round-tripped through pyarrow"""
+
+from __future__ import annotations
+
+import gc
+import os
+import tempfile
+import unittest
+
+import pyarrow as pa
+
+import saildb
+
+ROW_COUNT = 5000
+QUERY = 'SELECT id, name FROM saildb_rows ORDER BY id'
+
+
+class CapsuleTest(unittest.TestCase):
+  """A SQLite file opened through the host's driver manager, unless `SAILDB_TEST_CONNECTION` is set"""
+
+  def setUp(self) -> None:
+    self.connection_string = os.environ.get('SAILDB_TEST_CONNECTION', '')
+    if not self.connection_string:
+      directory = tempfile.TemporaryDirectory(dir=os.environ.get('TEST_TMPDIR'))
+      self.addCleanup(directory.cleanup)
+      self.connection_string = f"Driver=SQLite3;Database={os.path.join(directory.name, 'capsule.db')};"
+
+    # A fresh environment per test, so its pool only holds the test's connection
+    self.environment = saildb.Environment.create()
+    try:
+      connection = self.environment.connect(self.connection_string, autocommit=True)
+    except saildb.Error as err:
+      self.skipTest(f'Failed to connect to `{self.connection_string}`: {err}')
+
+    # Returned to the pool once closed, & read from there
+    try:
+      cursor = connection.cursor()
+      cursor.execute('CREATE TABLE saildb_rows (id INTEGER, name VARCHAR(16))')
+      cursor.execute(
+        f'WITH RECURSIVE ids(id) AS (SELECT 1 UNION ALL SELECT id + 1 FROM ids WHERE id < {ROW_COUNT}) '
+        "INSERT INTO saildb_rows SELECT id, 'row-' || id FROM ids"
+      )
+    finally:
+      connection.close()
+
+    self.addCleanup(self.environment.clear)
+
+  def read(self) -> saildb.RecordBatchReader:
+    return self.environment.read(self.connection_string, QUERY, row_array_size=250, batch_size=1000)
+
+  def pool(self) -> dict[str, int]:
+    return self.environment.pool_stats(self.connection_string)
+
+  def test_round_trips_through_from_stream(self) -> None:
+    reader = self.read()
+    self.assertTrue(hasattr(reader, '__arrow_c_stream__'))
+
+    table = pa.RecordBatchReader.from_stream(reader).read_all()
+    self.assertEqual(table.num_rows, ROW_COUNT)
+    self.assertEqual(table.column_names, ['id', 'name'])
+    self.assertTrue(pa.types.is_integer(table.schema.field('id').type))
+    self.assertEqual(table.column('id').to_pylist(), list(range(1, ROW_COUNT + 1)))
+    self.assertEqual(table.column('name')[ROW_COUNT - 1].as_py(), f'row-{ROW_COUNT}')
+
+  def test_exports_schema_and_batches(self) -> None:
+    reader = self.read()
+    schema = pa.schema(reader)
+    self.assertEqual(schema.names, ['id', 'name'])
+
+    batch = reader.read_next_batch()
+    self.assertEqual(len(batch), 1000)
+    self.assertEqual(pa.record_batch(batch).schema, schema)
+
+  def test_releases_lease_once_drained(self) -> None:
+    stream = pa.RecordBatchReader.from_stream(self.read())
+    self.assertEqual(self.pool()['idle'], 0)
+
+    stream.read_all()
+    self.assertEqual(self.pool()['open'], 1)
+    self.assertEqual(self.pool()['idle'], 1)
+
+  def test_releases_lease_once_consumer_drops_stream(self) -> None:
+    reader = self.read()
+    stream = pa.RecordBatchReader.from_stream(reader)
+    self.assertEqual(len(stream.read_next_batch()), 1000)
+    self.assertEqual(self.pool()['idle'], 0)
+
+    # Only the consumer holds the result once the reader is dropped, so it's released with the stream
+    del reader
+    gc.collect()
+    self.assertEqual(self.pool()['idle'], 0)
+
+    del stream
+    gc.collect()
+    self.assertEqual(self.pool()['open'], 1)
+    self.assertEqual(self.pool()['idle'], 1)
+
+  def test_releases_capsule_that_is_never_imported(self) -> None:
+    reader = self.read()
+    capsule = reader.__arrow_c_stream__()
+    del reader
+    gc.collect()
+    self.assertEqual(self.pool()['idle'], 0)
+
+    del capsule
+    gc.collect()
+    self.assertEqual(self.pool()['idle'], 1)
+
+
+if __name__ == '__main__':
+  unittest.main()
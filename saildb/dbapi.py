@@ -0,0 +1,84 @@
+"""DB-API 2.0 (PEP 249) module globals, type objects & constructors; see `_core` for connections"""
+
+from __future__ import annotations
+
+import time
+import datetime
+import decimal
+
+from ._core import (  # type:ignore # isort:skip
+  connect,
+  connect_async,
+  Connection,
+  Cursor,
+  Warning,
+  Error,
+  InterfaceError,
+  DatabaseError,
+  DataError,
+  OperationalError,
+  IntegrityError,
+  InternalError,
+  ProgrammingError,
+  NotSupportedError
+)
+
+apilevel = '2.0'
+threadsafety = 1
+paramstyle = 'qmark'
+
+
+class DBAPITypeObject:
+  """Compares equal to each of the `Cursor.description` type code(s) it describes"""
+
+  def __init__(self, *values: type) -> None:
+    self.values = frozenset(values)
+
+  def __eq__(self, other: object) -> bool:
+    return other in self.values
+
+  def __ne__(self, other: object) -> bool:
+    return other not in self.values
+
+  def __hash__(self) -> int:
+    return hash(self.values)
+
+
+STRING = DBAPITypeObject(str)
+BINARY = DBAPITypeObject(bytes)
+NUMBER = DBAPITypeObject(int, float, bool, decimal.Decimal)
+DATETIME = DBAPITypeObject(datetime.date, datetime.time, datetime.datetime)
+ROWID = DBAPITypeObject()
+
+Date = datetime.date
+Time = datetime.time
+Timestamp = datetime.datetime
+Binary = bytes
+
+# Byte(s) of `Cursor.rowstatus`, one per parameter set of the last array-bound `executemany`
+PARAM_SUCCESS = 0
+PARAM_SUCCESS_WITH_INFO = 1
+PARAM_ERROR = 2
+PARAM_UNUSED = 3
+
+
+def DateFromTicks(ticks: float) -> datetime.date:
+  return Date(*time.localtime(ticks)[:3])
+
+
+def TimeFromTicks(ticks: float) -> datetime.time:
+  return Time(*time.localtime(ticks)[3:6])
+
+
+def TimestampFromTicks(ticks: float) -> datetime.datetime:
+  return Timestamp(*time.localtime(ticks)[:6])
+
+
+__all__ = [
+  'apilevel', 'threadsafety', 'paramstyle', 'connect', 'connect_async', 'Connection', 'Cursor',
+  'Warning', 'Error', 'InterfaceError', 'DatabaseError', 'DataError', 'OperationalError',
+  'IntegrityError', 'InternalError', 'ProgrammingError', 'NotSupportedError',
+  'STRING', 'BINARY', 'NUMBER', 'DATETIME', 'ROWID',
+  'Date', 'Time', 'Timestamp', 'Binary', 'DateFromTicks', 'TimeFromTicks', 'TimestampFromTicks',
+  'PARAM_SUCCESS', 'PARAM_SUCCESS_WITH_INFO', 'PARAM_ERROR', 'PARAM_UNUSED'
+]
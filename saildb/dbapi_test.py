@@ -0,0 +1,234 @@
+"""PEP 249 semantics of `Connection` & `Cursor`"""
+
+from __future__ import annotations
+
+import os
+import tempfile
+import unittest
+
+import saildb
+
+ROW_COUNT = 10
+
+
+class DbApiTest(unittest.TestCase):
+  """A SQLite file opened through the host's driver manager, unless `SAILDB_TEST_CONNECTION` is set"""
+
+  def setUp(self) -> None:
+    self.connection_string = os.environ.get('SAILDB_TEST_CONNECTION', '')
+    if not self.connection_string:
+      directory = tempfile.TemporaryDirectory(dir=os.environ.get('TEST_TMPDIR'))
+      self.addCleanup(directory.cleanup)
+      self.connection_string = f"Driver=SQLite3;Database={os.path.join(directory.name, 'dbapi.db')};"
+
+    try:
+      self.connection = saildb.connect(self.connection_string, autocommit=True)
+    except saildb.Error as err:
+      self.skipTest(f'Failed to connect to `{self.connection_string}`: {err}')
+
+    self.addCleanup(self.connection.close)
+    self.execute('CREATE TABLE saildb_rows (id INTEGER, name VARCHAR(16), score DOUBLE)')
+    self.execute(
+      f'WITH RECURSIVE ids(id) AS (SELECT 1 UNION ALL SELECT id + 1 FROM ids WHERE id < {ROW_COUNT}) '
+      "INSERT INTO saildb_rows SELECT id, 'row-' || id, id * 0.5 FROM ids"
+    )
+
+  def execute(self, operation: str, parameters: tuple[object, ...] | None = None) -> saildb.Cursor:
+    return self.connection.cursor().execute(operation, parameters)
+
+  def count(self) -> int:
+    # Closed at once, so that the connection holds no lock on the table
+    with self.execute('SELECT COUNT(*) FROM saildb_rows') as cursor:
+      return cursor.fetchone()[0]
+
+  # Fetch
+
+  def test_fetchone_yields_rows_then_none(self) -> None:
+    cursor = self.execute('SELECT id, name FROM saildb_rows WHERE id <= 2 ORDER BY id')
+    self.assertEqual(cursor.fetchone(), (1, 'row-1'))
+    self.assertEqual(cursor.fetchone(), (2, 'row-2'))
+    self.assertIsNone(cursor.fetchone())
+    self.assertIsNone(cursor.fetchone())
+
+  def test_fetchmany_defaults_to_arraysize(self) -> None:
+    cursor = self.execute('SELECT id FROM saildb_rows ORDER BY id')
+    self.assertEqual(cursor.arraysize, 1)
+    self.assertEqual(cursor.fetchmany(), [(1,)])
+
+    cursor.arraysize = 3
+    self.assertEqual(cursor.fetchmany(), [(2,), (3,), (4,)])
+    self.assertEqual(cursor.fetchmany(2), [(5,), (6,)])
+
+    # Fewer than requested once exhausted, then none
+    self.assertEqual(cursor.fetchmany(10), [(7,), (8,), (9,), (10,)])
+    self.assertEqual(cursor.fetchmany(10), [])
+
+  def test_fetchall_yields_remaining_rows(self) -> None:
+    cursor = self.execute('SELECT id FROM saildb_rows ORDER BY id')
+    self.assertEqual(cursor.fetchone(), (1,))
+    self.assertEqual(cursor.fetchmany(2), [(2,), (3,)])
+    self.assertEqual(cursor.fetchall(), [(id,) for id in range(4, ROW_COUNT + 1)])
+    self.assertEqual(cursor.fetchall(), [])
+    self.assertIsNone(cursor.fetchone())
+
+  def test_iterates_rows(self) -> None:
+    cursor = self.execute('SELECT id FROM saildb_rows ORDER BY id')
+    self.assertEqual([id for (id,) in cursor], list(range(1, ROW_COUNT + 1)))
+
+  def test_binds_qmark_parameters(self) -> None:
+    cursor = self.execute('SELECT name FROM saildb_rows WHERE id = ? OR name = ? ORDER BY id', (3, 'row-5'))
+    self.assertEqual(cursor.fetchall(), [('row-3',), ('row-5',)])
+
+  def test_fetch_without_result_set_raises(self) -> None:
+    cursor = self.execute('UPDATE saildb_rows SET name = name')
+    with self.assertRaises(saildb.ProgrammingError):
+      cursor.fetchone()
+
+  def test_execute_replaces_result_set(self) -> None:
+    cursor = self.execute('SELECT id FROM saildb_rows ORDER BY id')
+    self.assertEqual(cursor.fetchone(), (1,))
+
+    cursor.execute('SELECT name FROM saildb_rows WHERE id = 2')
+    self.assertEqual(cursor.fetchall(), [('row-2',)])
+
+  # Description & rowcount
+
+  def test_description_describes_columns(self) -> None:
+    cursor = self.connection.cursor()
+    self.assertIsNone(cursor.description)
+
+    cursor.execute('SELECT id, name, score FROM saildb_rows')
+    description = cursor.description
+    self.assertEqual([column[0] for column in description], ['id', 'name', 'score'])
+    self.assertTrue(all(len(column) == 7 for column in description))
+
+    self.assertEqual(description[0][1], saildb.NUMBER)
+    self.assertEqual(description[1][1], saildb.STRING)
+    self.assertEqual(description[2][1], saildb.NUMBER)
+    self.assertNotEqual(description[1][1], saildb.NUMBER)
+
+  def test_description_is_none_without_result_set(self) -> None:
+    cursor = self.execute('SELECT id FROM saildb_rows')
+    self.assertIsNotNone(cursor.description)
+
+    cursor.execute('UPDATE saildb_rows SET name = name WHERE id = 1')
+    self.assertIsNone(cursor.description)
+
+  def test_rowcount(self) -> None:
+    cursor = self.connection.cursor()
+    self.assertEqual(cursor.rowcount, -1)
+
+    cursor.execute('UPDATE saildb_rows SET score = 0 WHERE id <= 3')
+    self.assertEqual(cursor.rowcount, 3)
+
+    cursor.execute('DELETE FROM saildb_rows WHERE id > ?', (ROW_COUNT,))
+    self.assertEqual(cursor.rowcount, 0)
+
+    cursor.execute('INSERT INTO saildb_rows VALUES (?, ?, ?)', (ROW_COUNT + 1, 'row-11', 5.5))
+    self.assertEqual(cursor.rowcount, 1)
+
+    # Unknown for a result set
+    cursor.execute('SELECT id FROM saildb_rows')
+    self.assertEqual(cursor.rowcount, -1)
+
+  # Executemany
+
+  def test_executemany_binds_rows_of_mixed_types_over_batches(self) -> None:
+    # More set(s) than `batch_size`, each column NULL on some row(s) & the float column also given int(s)
+    rows = [
+      (id, None if id % 3 == 0 else f'many-{id}', None if id % 5 == 0 else (id if id % 2 else id * 0.25))
+      for id in range(100, 350)
+    ]
+    cursor = self.connection.cursor()
+    cursor.executemany('INSERT INTO saildb_rows VALUES (?, ?, ?)', rows, batch_size=100)
+    self.assertEqual(cursor.rowcount, len(rows))
+    self.assertEqual(cursor.rowstatus, bytes([saildb.PARAM_SUCCESS]) * len(rows))
+
+    cursor.execute('SELECT id, name, score FROM saildb_rows WHERE id >= 100 ORDER BY id')
+    self.assertEqual(cursor.fetchall(), rows)
+
+  def test_executemany_falls_back_to_row_by_row_for_mixed_column(self) -> None:
+    # A column of both str & int can't be array-bound, so each row is executed on its own
+    rows = [(100, 'many-100', 1.5), (101, 101, None), (102, None, 2.5)]
+    cursor = self.connection.cursor()
+    cursor.executemany('INSERT INTO saildb_rows VALUES (?, ?, ?)', rows)
+    self.assertEqual(cursor.rowcount, len(rows))
+    self.assertEqual(self.count(), ROW_COUNT + len(rows))
+
+    cursor.execute('SELECT id, score FROM saildb_rows WHERE id >= 100 ORDER BY id')
+    self.assertEqual(cursor.fetchall(), [(100, 1.5), (101, None), (102, 2.5)])
+
+  def test_executemany_of_no_rows(self) -> None:
+    cursor = self.connection.cursor()
+    cursor.executemany('INSERT INTO saildb_rows VALUES (?, ?, ?)', [])
+    self.assertEqual(cursor.rowcount, 0)
+    self.assertEqual(self.count(), ROW_COUNT)
+
+  # Close
+
+  def test_closed_cursor_raises(self) -> None:
+    cursor = self.execute('SELECT id FROM saildb_rows')
+    self.assertFalse(cursor.closed)
+
+    cursor.close()
+    self.assertTrue(cursor.closed)
+    with self.assertRaises(saildb.InterfaceError):
+      cursor.fetchone()
+    with self.assertRaises(saildb.InterfaceError):
+      cursor.execute('SELECT id FROM saildb_rows')
+
+  def test_cursor_closes_on_exit(self) -> None:
+    with self.connection.cursor() as cursor:
+      cursor.execute('SELECT id FROM saildb_rows')
+
+    self.assertTrue(cursor.closed)
+
+  def test_closing_connection_closes_its_cursors(self) -> None:
+    connection = saildb.connect(self.connection_string)
+    cursor = connection.cursor().execute('SELECT id FROM saildb_rows')
+
+    connection.close()
+    self.assertTrue(connection.closed)
+    self.assertTrue(cursor.closed)
+    with self.assertRaises(saildb.InterfaceError):
+      cursor.fetchone()
+    with self.assertRaises(saildb.InterfaceError):
+      connection.cursor()
+
+    # Idempotent
+    connection.close()
+
+  def test_close_rolls_back_open_transaction(self) -> None:
+    connection = saildb.connect(self.connection_string)
+    self.assertFalse(connection.autocommit)
+    connection.cursor().execute('DELETE FROM saildb_rows')
+
+    connection.close()
+    self.assertEqual(self.count(), ROW_COUNT)
+
+  # Transactions
+
+  def test_commit_and_rollback(self) -> None:
+    connection = saildb.connect(self.connection_string)
+    self.addCleanup(connection.close)
+
+    cursor = connection.cursor()
+    cursor.execute('DELETE FROM saildb_rows WHERE id = 1')
+    connection.rollback()
+    self.assertEqual(self.count(), ROW_COUNT)
+
+    cursor.execute('DELETE FROM saildb_rows WHERE id = 1')
+    connection.commit()
+    self.assertEqual(self.count(), ROW_COUNT - 1)
+
+  def test_exit_commits_without_closing(self) -> None:
+    with saildb.connect(self.connection_string) as connection:
+      connection.cursor().execute('DELETE FROM saildb_rows WHERE id = 1')
+
+    self.addCleanup(connection.close)
+    self.assertFalse(connection.closed)
+    self.assertEqual(self.count(), ROW_COUNT - 1)
+
+
+if __name__ == '__main__':
+  unittest.main()
@@ -13,3 +13,33 @@ local_defines_flag = rule(
     'value': attr.label()
   }
 )
+
+def embedded_dot_env(name, src, symbol, namespace = 'saildb::profiles', **kwargs):
+  """Generates `<name>.hpp`, declaring `symbol` as a compile-time parsed `wapi::EmbeddedDotEnv` of `src`
+
+  e.g.
+
+    embedded_dot_env(
+      name = 'defaults',
+      src = 'defaults.env',
+      symbol = 'DEFAULTS',
+    )
+
+  ... exposes `saildb::profiles::DEFAULTS` to dependents through `#include "<package>/defaults.hpp"`
+  """
+  header = name + '.hpp'
+
+  native.genrule(
+    name = name + '_gen',
+    srcs = [src],
+    outs = [header],
+    cmd = '$(execpath //saildb/sailc/wapi:embed_dotenv) $< --out $@ --symbol %s --namespace %s --origin $(rootpath %s)' % (symbol, namespace, src),
+    tools = ['//saildb/sailc/wapi:embed_dotenv'],
+  )
+
+  native.cc_library(
+    name = name,
+    hdrs = [header],
+    deps = ['//saildb/sailc/wapi:embedded'],
+    **kwargs
+  )
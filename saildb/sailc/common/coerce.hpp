@@ -0,0 +1,152 @@
+#pragma once
+
+#include "sailc/common/typing.hpp"
+#include "sailc/common/cstring.hpp"
+#include "sailc/common/strutil.hpp"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <cstdint>
+#include <sstream>
+#include <utility>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace saildb {
+namespace common {
+
+/*
+ * Coercion of a textual value into some type `U`, shared by `wapi::DotEnv` & `wapi::EmbeddedDotEnv`
+ *
+ *  - Scalar(s) are parsed as one of `bool`, `int64_t`, `uint64_t` or `double` before being
+ *    narrowed into `U`; callers may substitute the parse of that scalar, e.g. to memoise it
+ *  - `signed char` & `unsigned char` are coerced as integer(s), i.e. `int8_t` & `uint8_t`
+ *
+ */
+enum class Coercion : uint8_t {
+  Narrow,   // std::string & type(s) constructible from a std::string_view
+  Wide,     // std::wstring & type(s) constructible from a std::wstring_view
+  Boolean,  // One of: 1/0, true/false, on/off
+  Signed,
+  Unsigned,
+  Floating, // `float` & `double`
+  Extended, // Remaining floating point type(s), parsed without narrowing
+  Stream,   // Fallback for types without a locale-independent parser, e.g. char(s) & user type(s)
+};
+
+template <typename U>
+inline constexpr auto getCoercion() -> Coercion {
+  constexpr bool isCharType = (
+    std::is_same_v<U, char> || std::is_same_v<U, wchar_t> ||
+    std::is_same_v<U, char8_t> || std::is_same_v<U, char16_t> || std::is_same_v<U, char32_t>
+  );
+
+  if constexpr(std::is_same_v<U, std::string> || std::is_convertible_v<U, std::string_view>) {
+    return Coercion::Narrow;
+  } else if constexpr(std::is_same_v<U, std::wstring> || std::is_convertible_v<U, std::wstring_view>) {
+    return Coercion::Wide;
+  } else if constexpr(std::is_same_v<U, bool>) {
+    return Coercion::Boolean;
+  } else if constexpr(std::is_integral_v<U> && !isCharType) {
+    return std::is_signed_v<U> ? Coercion::Signed : Coercion::Unsigned;
+  } else if constexpr(std::is_same_v<U, double> || std::is_same_v<U, float>) {
+    return Coercion::Floating;
+  } else if constexpr(std::is_floating_point_v<U>) {
+    return Coercion::Extended;
+  } else {
+    return Coercion::Stream;
+  }
+}
+
+// Parses the intermediate scalar of a coercion, i.e. one of `bool`, `int64_t`, `uint64_t` or `double`
+template <typename V>
+inline auto tryParseScalar(std::string_view input, V& result) -> bool {
+  if constexpr(std::is_same_v<V, bool>) {
+    return common::tryParseBoolean(input, result);
+  } else {
+    return common::tryParseNumber(input, result);
+  }
+}
+
+template <typename U, typename Parse>
+inline auto tryCoerce(std::string_view value, U& result, Parse&& parse) -> bool {
+  constexpr Coercion coercion = common::getCoercion<U>();
+
+  if constexpr(coercion == Coercion::Narrow) {
+    result = U(value);
+    return true;
+  } else if constexpr(coercion == Coercion::Wide && std::is_same_v<U, std::wstring>) {
+    common::str2wstr(value, result);
+    return true;
+  } else if constexpr(coercion == Coercion::Wide) {
+    result = common::str2wstr(std::string(value));
+    return true;
+  } else if constexpr(coercion == Coercion::Boolean) {
+    return parse(value, result);
+  } else if constexpr(coercion == Coercion::Signed || coercion == Coercion::Unsigned) {
+    using V = std::conditional_t<coercion == Coercion::Signed, int64_t, uint64_t>;
+
+    V parsed{};
+    if (!parse(value, parsed) || !std::in_range<U>(parsed)) {
+      return false;
+    }
+
+    result = static_cast<U>(parsed);
+    return true;
+  } else if constexpr(coercion == Coercion::Floating) {
+    double parsed{};
+    if (!parse(value, parsed)) {
+      return false;
+    }
+
+    if constexpr(std::is_same_v<U, float>) {
+      if (std::isfinite(parsed) && std::abs(parsed) > std::numeric_limits<float>::max()) {
+        return false;
+      }
+    }
+
+    result = static_cast<U>(parsed);
+    return true;
+  } else if constexpr(coercion == Coercion::Extended) {
+    return common::tryParseNumber(value, result);
+  } else {
+    U parsed{};
+    auto stream = std::istringstream{std::string(value)};
+    if (!(stream >> parsed)) {
+      return false;
+    }
+
+    result = parsed;
+    return true;
+  }
+}
+
+template <typename U>
+inline auto tryCoerce(std::string_view value, U& result) -> bool {
+  return common::tryCoerce(value, result, [](std::string_view input, auto& parsed) {
+    return common::tryParseScalar(input, parsed);
+  });
+}
+
+template <typename U>
+[[noreturn]] inline void throwCoercionError(std::string_view value) {
+  if constexpr(common::getCoercion<U>() == Coercion::Boolean) {
+    throw std::runtime_error(
+      std::string("Failed to coerce '")
+        .append(value)
+        .append("' into boolean, expected one of: 1/0, true/false, on/off")
+    );
+  } else {
+    throw std::runtime_error(
+      std::string("Failed to coerce '")
+        .append(value)
+        .append("' into ")
+        .append(common::getTypeName<U>())
+    );
+  }
+}
+
+} // namespace common
+} // namespace saildb
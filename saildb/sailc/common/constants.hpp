@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <chrono>
 
 namespace saildb {
@@ -8,6 +9,7 @@ namespace constants {
 
 /* Unicode byte order mark*/
 inline constexpr const wchar_t UNICODE_BYTE_ORDER_MARK = 0xFEFF;
+inline constexpr const std::string_view UTF8_BYTE_ORDER_MARK("\xEF\xBB\xBF");
 
 /* Filetime conversion constants */
 inline constexpr const std::chrono::seconds FILETIME_EPOCH { -11'644'473'600 }; 					// Windows FILETIME<->SYSTIME conversion
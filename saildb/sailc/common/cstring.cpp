@@ -1,6 +1,8 @@
 #include "cstring.hpp"
 #include "constants.hpp"
+#include "utf.hpp"
 
+#ifdef _WIN32
 #ifndef NOMINMAX
 #define NOMINMAX
 #endif
@@ -10,35 +12,64 @@
 #endif
 #include <windows.h>
 #include <stringapiset.h>
+#endif
 
 #include <cstring>
-#include <codecvt>
-#include <algorithm>
+#include <stdexcept>
 
 namespace common = saildb::common;
 
 bool common::startsWithUnicodeByteMark(const wchar_t* str, int sz) {
+#ifdef _WIN32
   if (!IsTextUnicode(str, sz, NULL)) {
     return false;
   }
+#else
+  if (str == nullptr || sz < static_cast<int>(sizeof(wchar_t))) {
+    return false;
+  }
+#endif
 
   return (*((wchar_t*)str) == saildb::constants::UNICODE_BYTE_ORDER_MARK);
 }
 
 std::wstring common::str2wstr(const std::string& str) {
-	std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-  std::wstring res = converter.from_bytes(str);
-  res.erase(std::find(res.begin(), res.end(), L'\0'), res.end());
+  std::wstring res;
+  common::str2wstr(str, res);
 
   return res;
 }
 
+void common::str2wstr(std::string_view str, std::wstring& output) {
+  str = str.substr(0, str.find('\0'));
+  if (!common::tryDecodeUtf8(str, output)) {
+    throw std::range_error("Failed to convert string, found malformed UTF-8");
+  }
+}
+
 std::string common::wstr2str(const std::wstring& str) {
-	std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
-  return converter.to_bytes(str);
+  std::string res;
+  common::wstr2str(str, res);
+
+  return res;
+}
+
+void common::wstr2str(std::wstring_view str, std::string& output) {
+  if (!common::tryEncodeUtf8(str, output)) {
+    throw std::range_error("Failed to convert wide string, found malformed UTF-16/32");
+  }
 }
 
-std::string common::lpwstr2str(wchar_t* str, uint32_t codepage /*= CP_UTF8*/, uint32_t flags /*= 0*/) {
+std::string common::lpwstr2str(wchar_t* str, [[maybe_unused]] uint32_t codepage /*= CP_UTF8*/, [[maybe_unused]] uint32_t flags /*= 0*/) {
+#ifndef _WIN32
+  // Code page(s) are a Windows concept, output is always UTF-8 elsewhere
+  std::string buf;
+  if (str != nullptr && !common::tryEncodeUtf8(std::wstring_view(str), buf)) {
+    buf.clear();
+  }
+
+  return buf;
+#else
   size_t len = WideCharToMultiByte(codepage, flags, str, -1, NULL, 0, nullptr, nullptr);
   if (len != 0) {
     std::string buf;
@@ -50,6 +81,7 @@ std::string common::lpwstr2str(wchar_t* str, uint32_t codepage /*= CP_UTF8*/, ui
   }
 
   return std::string();
+#endif
 }
 
 std::string common::lsastr2str(wchar_t* buf, const uint16_t& length, uint32_t codepage /*= CP_UTF8*/, uint32_t flags /*= 0*/) {
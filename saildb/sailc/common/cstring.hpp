@@ -4,15 +4,20 @@
 #include <string>
 #include <memory>
 #include <utility>
+#include <string_view>
 
 namespace saildb {
 namespace common {
 
 bool startsWithUnicodeByteMark(const wchar_t* str, int sz);
 
+// UTF-8 <-> UTF-16/32 conversion(s), throws `std::range_error` if the input is malformed
+//   - `str2wstr` truncates its result at the first NUL, if any
 std::wstring str2wstr(const std::string& str);
+void str2wstr(std::string_view str, std::wstring& output);
 
 std::string wstr2str(const std::wstring& str);
+void wstr2str(std::wstring_view str, std::string& output);
 
 std::string lpwstr2str(wchar_t* str, uint32_t codepage = 65001 /*CP_UTF8*/, uint32_t flags = 0);
 
@@ -2,10 +2,15 @@
 
 #include <memory>
 #include <string>
+#include <limits>
 #include <cstdint>
 #include <sstream>
 #include <utility>
+#include <charconv>
+#include <algorithm>
 #include <functional>
+#include <string_view>
+#include <type_traits>
 
 namespace saildb {
 namespace common {
@@ -80,5 +85,62 @@ inline auto trim(std::basic_string<CharT, TraitsT, AllocT>& input) -> void {
   input = input.substr(first, last - first + 1);
 }
 
+template <typename CharT, typename TraitsT>
+inline constexpr auto trimView(std::basic_string_view<CharT, TraitsT> input) -> std::basic_string_view<CharT, TraitsT> {
+  const auto isWhitespace = [](CharT ch) {
+    return ch == CharT(' ') || ch == CharT('\t') || ch == CharT('\n') ||
+           ch == CharT('\f') || ch == CharT('\v') || ch == CharT('\r');
+  };
+
+  while (!input.empty() && isWhitespace(input.front())) {
+    input.remove_prefix(1);
+  }
+
+  while (!input.empty() && isWhitespace(input.back())) {
+    input.remove_suffix(1);
+  }
+
+  return input;
+}
+
+template <typename T>
+inline auto tryParseNumber(std::string_view input, T& result) -> bool {
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>);
+
+  // Locale-independent; surrounding whitespace & a leading `+` are permitted
+  input = common::trimView(input);
+  if (!input.empty() && input.front() == '+') {
+    input.remove_prefix(1);
+    if (!input.empty() && input.front() == '-') {
+      return false;
+    }
+  }
+
+  const char* end = input.data() + input.size();
+  const auto [ptr, ec] = std::from_chars(input.data(), end, result);
+  return !input.empty() && ec == std::errc() && ptr == end;
+}
+
+inline auto tryParseBoolean(std::string_view input, bool& result) -> bool {
+  // Accepts one of: 1/0, true/false, on/off
+  input = common::trimView(input);
+
+  const auto matches = [&input](std::string_view expected) {
+    return std::equal(input.begin(), input.end(), expected.begin(), expected.end(), [](char a, char b) {
+      return (a >= 'A' && a <= 'Z' ? a + ('a' - 'A') : a) == b;
+    });
+  };
+
+  if (matches("1") || matches("true") || matches("on")) {
+    result = true;
+    return true;
+  } else if (matches("0") || matches("false") || matches("off")) {
+    result = false;
+    return true;
+  }
+
+  return false;
+}
+
 } // namespace common
 } // namespace saildb
@@ -1,3 +1,5 @@
+#pragma once
+
 #include <string_view>
 
 namespace saildb {
@@ -6,7 +8,11 @@ namespace common {
 // Implementation derived from: https://stackoverflow.com/a/66551751
 template <typename T>
 constexpr auto getRawTypeName() -> std::string_view {
+#if defined(_MSC_VER)
 	return __FUNCSIG__;
+#else
+	return __PRETTY_FUNCTION__;
+#endif
 }
 
 struct TypeNameInfo {
@@ -0,0 +1,338 @@
+#include "utf.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SAILDB_UTF_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace common = saildb::common;
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Decoding                         *
+ *                                                          *
+ ************************************************************/
+
+static constexpr const size_t LANE_SIZE = 16;
+
+// Widens a run of ASCII beginning at `input[i]`, returns the index of the first non-ASCII byte
+template <typename CharT>
+inline size_t widenAscii(const uint8_t* input, size_t i, size_t size, CharT* output, size_t& o) {
+#ifdef SAILDB_UTF_SSE2
+  const __m128i zero = _mm_setzero_si128();
+  while (i + LANE_SIZE <= size) {
+    const __m128i lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(lane));
+    if (mask != 0) {
+      const size_t length = std::countr_zero(mask);
+      for (size_t j = 0; j < length; ++j) {
+        output[o++] = static_cast<CharT>(input[i + j]);
+      }
+
+      return i + length;
+    }
+
+    const __m128i lo = _mm_unpacklo_epi8(lane, zero);
+    const __m128i hi = _mm_unpackhi_epi8(lane, zero);
+    if constexpr(sizeof(CharT) == 2) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + o), lo);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + o + 8), hi);
+    } else {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + o), _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + o + 4), _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + o + 8), _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(output + o + 12), _mm_unpackhi_epi16(hi, zero));
+    }
+
+    i += LANE_SIZE;
+    o += LANE_SIZE;
+  }
+#endif
+
+  while (i < size && input[i] < 0x80) {
+    output[o++] = static_cast<CharT>(input[i++]);
+  }
+
+  return i;
+}
+
+// Decodes the multi-byte sequence at `input[i]`, returns the number of byte(s) consumed or 0 if malformed
+inline size_t decodeSequence(const uint8_t* input, size_t i, size_t size, char32_t& codepoint) {
+  const uint8_t lead = input[i];
+  const size_t remaining = size - i;
+
+  const auto isContinuation = [](uint8_t byte) {
+    return (byte & 0xC0) == 0x80;
+  };
+
+  if (lead >= 0xC2 && lead <= 0xDF) {
+    if (remaining < 2 || !isContinuation(input[i + 1])) {
+      return 0;
+    }
+
+    codepoint = (char32_t(lead & 0x1F) << 6) | (input[i + 1] & 0x3F);
+    return 2;
+  } else if (lead >= 0xE0 && lead <= 0xEF) {
+    if (remaining < 3 || !isContinuation(input[i + 1]) || !isContinuation(input[i + 2])) {
+      return 0;
+    }
+
+    // Reject overlong form(s) & surrogate(s)
+    const uint8_t next = input[i + 1];
+    if ((lead == 0xE0 && next < 0xA0) || (lead == 0xED && next > 0x9F)) {
+      return 0;
+    }
+
+    codepoint = (char32_t(lead & 0x0F) << 12) | (char32_t(next & 0x3F) << 6) | (input[i + 2] & 0x3F);
+    return 3;
+  } else if (lead >= 0xF0 && lead <= 0xF4) {
+    if (remaining < 4 || !isContinuation(input[i + 1]) || !isContinuation(input[i + 2]) || !isContinuation(input[i + 3])) {
+      return 0;
+    }
+
+    // Reject overlong form(s) & codepoint(s) beyond U+10FFFF
+    const uint8_t next = input[i + 1];
+    if ((lead == 0xF0 && next < 0x90) || (lead == 0xF4 && next > 0x8F)) {
+      return 0;
+    }
+
+    codepoint = (char32_t(lead & 0x07) << 18) | (char32_t(next & 0x3F) << 12) |
+                (char32_t(input[i + 2] & 0x3F) << 6) | (input[i + 3] & 0x3F);
+    return 4;
+  }
+
+  return 0;
+}
+
+template <typename CharT>
+bool decodeUtf8(std::string_view input, std::basic_string<CharT>& output) {
+  static_assert(sizeof(CharT) == 2 || sizeof(CharT) == 4);
+
+  // Each byte yields at most one code unit, incl. surrogate pair(s) from 4-byte sequence(s)
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+  const size_t size = input.size();
+
+  output.resize(size);
+  CharT* out = output.data();
+
+  size_t i = 0;
+  size_t o = 0;
+  while (i < size) {
+    i = ::widenAscii(data, i, size, out, o);
+    if (i >= size) {
+      break;
+    }
+
+    char32_t codepoint;
+    const size_t length = ::decodeSequence(data, i, size, codepoint);
+    if (length == 0) {
+      output.clear();
+      return false;
+    }
+
+    if constexpr(sizeof(CharT) == 2) {
+      if (codepoint >= 0x10000) {
+        codepoint -= 0x10000;
+        out[o++] = static_cast<CharT>(0xD800 + (codepoint >> 10));
+        out[o++] = static_cast<CharT>(0xDC00 + (codepoint & 0x3FF));
+      } else {
+        out[o++] = static_cast<CharT>(codepoint);
+      }
+    } else {
+      out[o++] = static_cast<CharT>(codepoint);
+    }
+
+    i += length;
+  }
+
+  output.resize(o);
+  return true;
+}
+
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Encoding                         *
+ *                                                          *
+ ************************************************************/
+
+// Narrows a run of ASCII beginning at `input[i]`, returns the index of the first non-ASCII code unit
+template <typename CharT>
+inline size_t narrowAscii(const CharT* input, size_t i, size_t size, char* output, size_t& o) {
+#ifdef SAILDB_UTF_SSE2
+  constexpr size_t step = 8;
+  while (i + step <= size) {
+    __m128i packed;
+    if constexpr(sizeof(CharT) == 2) {
+      const __m128i lane = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const __m128i high = _mm_and_si128(lane, _mm_set1_epi16(static_cast<short>(0xFF80)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) != 0xFFFF) {
+        break;
+      }
+
+      packed = _mm_packus_epi16(lane, lane);
+    } else {
+      const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+      const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 4));
+      const __m128i high = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi32(static_cast<int>(0xFFFFFF80)));
+      if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) != 0xFFFF) {
+        break;
+      }
+
+      const __m128i words = _mm_packs_epi32(lo, hi);
+      packed = _mm_packus_epi16(words, words);
+    }
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(output + o), packed);
+    i += step;
+    o += step;
+  }
+#endif
+
+  while (i < size && static_cast<uint32_t>(input[i]) < 0x80) {
+    output[o++] = static_cast<char>(input[i++]);
+  }
+
+  return i;
+}
+
+template <typename CharT>
+bool encodeUtf8(std::basic_string_view<CharT> input, std::string& output) {
+  static_assert(sizeof(CharT) == 2 || sizeof(CharT) == 4);
+
+  // At most 3 byte(s) per UTF-16 code unit, i.e. surrogate pair(s) yield 4 byte(s) from 2 unit(s)
+  const CharT* data = input.data();
+  const size_t size = input.size();
+
+  output.resize(size * (sizeof(CharT) == 2 ? 3 : 4));
+  char* out = output.data();
+
+  size_t i = 0;
+  size_t o = 0;
+  while (i < size) {
+    i = ::narrowAscii(data, i, size, out, o);
+    if (i >= size) {
+      break;
+    }
+
+    char32_t codepoint = static_cast<char32_t>(static_cast<std::make_unsigned_t<CharT>>(data[i++]));
+    if (codepoint >= 0xD800 && codepoint <= 0xDFFF) {
+      // Surrogate(s) must be paired in UTF-16 & are illegal in UTF-32
+      if constexpr(sizeof(CharT) == 2) {
+        const bool isPaired = (
+          codepoint <= 0xDBFF && i < size &&
+          static_cast<char32_t>(data[i]) >= 0xDC00 && static_cast<char32_t>(data[i]) <= 0xDFFF
+        );
+
+        if (!isPaired) {
+          output.clear();
+          return false;
+        }
+
+        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (static_cast<char32_t>(data[i++]) - 0xDC00);
+      } else {
+        output.clear();
+        return false;
+      }
+    }
+
+    if (codepoint < 0x800) {
+      out[o++] = static_cast<char>(0xC0 | (codepoint >> 6));
+      out[o++] = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+      out[o++] = static_cast<char>(0xE0 | (codepoint >> 12));
+      out[o++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+      out[o++] = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint <= 0x10FFFF) {
+      out[o++] = static_cast<char>(0xF0 | (codepoint >> 18));
+      out[o++] = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+      out[o++] = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+      out[o++] = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+      output.clear();
+      return false;
+    }
+  }
+
+  output.resize(o);
+  return true;
+}
+
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Public                          *
+ *                                                          *
+ ************************************************************/
+
+bool common::tryDecodeUtf8(std::string_view input, std::wstring& output) {
+  return ::decodeUtf8(input, output);
+}
+
+bool common::tryDecodeUtf8(std::string_view input, std::u16string& output) {
+  return ::decodeUtf8(input, output);
+}
+
+bool common::tryDecodeUtf8(std::string_view input, std::u32string& output) {
+  return ::decodeUtf8(input, output);
+}
+
+bool common::tryEncodeUtf8(std::wstring_view input, std::string& output) {
+  return ::encodeUtf8(input, output);
+}
+
+bool common::tryEncodeUtf8(std::u16string_view input, std::string& output) {
+  return ::encodeUtf8(input, output);
+}
+
+bool common::tryEncodeUtf8(std::u32string_view input, std::string& output) {
+  return ::encodeUtf8(input, output);
+}
+
+bool common::isValidUtf8(std::string_view input) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(input.data());
+  const size_t size = input.size();
+
+  size_t i = 0;
+  while (i < size) {
+#ifdef SAILDB_UTF_SSE2
+    while (i + LANE_SIZE <= size) {
+      const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i))));
+      if (mask != 0) {
+        i += std::countr_zero(mask);
+        break;
+      }
+
+      i += LANE_SIZE;
+    }
+#endif
+
+    while (i < size && data[i] < 0x80) {
+      i++;
+    }
+
+    if (i >= size) {
+      break;
+    }
+
+    char32_t codepoint;
+    const size_t length = ::decodeSequence(data, i, size, codepoint);
+    if (length == 0) {
+      return false;
+    }
+
+    i += length;
+  }
+
+  return true;
+}
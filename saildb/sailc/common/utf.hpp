@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace saildb {
+namespace common {
+
+/*
+ * Validating UTF-8 transcoding to & from UTF-16 or UTF-32
+ *
+ *  - `wchar_t` is treated as UTF-16 or UTF-32 per its width, i.e. Windows & Linux respectively
+ *  - Run(s) of ASCII are transcoded 16 code unit(s) at a time with SSE2 where available
+ *  - Malformed input, e.g. overlong or truncated sequence(s) & unpaired surrogate(s),
+ *    fails the conversion & leaves `output` empty
+ *  - `output` is overwritten, not appended to; its capacity is reused across call(s)
+ *
+ */
+bool tryDecodeUtf8(std::string_view input, std::wstring& output);
+bool tryDecodeUtf8(std::string_view input, std::u16string& output);
+bool tryDecodeUtf8(std::string_view input, std::u32string& output);
+
+bool tryEncodeUtf8(std::wstring_view input, std::string& output);
+bool tryEncodeUtf8(std::u16string_view input, std::string& output);
+bool tryEncodeUtf8(std::u32string_view input, std::string& output);
+
+bool isValidUtf8(std::string_view input);
+
+} // namespace common
+} // namespace saildb
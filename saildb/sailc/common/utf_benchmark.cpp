@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <locale>
+#include <vector>
+#include <codecvt>
+#include <cstdint>
+
+#include "sailc/common/utf.hpp"
+
+namespace common = saildb::common;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Inputs                          *
+ *                                                          *
+ ************************************************************/
+
+// Indexed by each benchmark's argument: an env var key, a secret's label, 4 KiB of ASCII & 4 KiB of mixed text
+const std::vector<std::string>& getInputs() {
+  static const std::vector<std::string> inputs = []() {
+    std::string ascii;
+    while (ascii.size() < 4096) {
+      ascii += "The quick brown fox jumps over the lazy dog; ";
+    }
+    ascii.resize(4096);
+
+    std::string mixed;
+    while (mixed.size() < 4096) {
+      mixed += "value=\xCE\xB8 Test#ing \xE1\xBA\xBF \xE0\xA4\xB9 utf-8 \xF0\x9F\x98\x80; ";
+    }
+
+    return std::vector<std::string>{ "SAILDB_USERNAME", "saildb:credentials:default-profile", ascii, mixed };
+  }();
+
+  return inputs;
+}
+
+void setInputLabel(benchmark::State& state) {
+  static const char* labels[] = { "key", "label", "ascii", "mixed" };
+  state.SetLabel(labels[state.range(0)]);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Benchmarks                        *
+ *                                                          *
+ ************************************************************/
+
+// The deprecated converter replaced by `common::utf`, constructed per call as `str2wstr` & `wstr2str` did
+void BM_WstringConvertDecode(benchmark::State& state) {
+  const std::string& input = ::getInputs()[state.range(0)];
+  for (auto _ : state) {
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+    std::wstring output = converter.from_bytes(input);
+    benchmark::DoNotOptimize(output);
+  }
+
+  ::setInputLabel(state);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+void BM_Utf8Decode(benchmark::State& state) {
+  const std::string& input = ::getInputs()[state.range(0)];
+
+  std::wstring output;
+  for (auto _ : state) {
+    common::tryDecodeUtf8(input, output);
+    benchmark::DoNotOptimize(output);
+  }
+
+  ::setInputLabel(state);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+void BM_WstringConvertEncode(benchmark::State& state) {
+  const std::string& source = ::getInputs()[state.range(0)];
+  const std::wstring input = std::wstring_convert<std::codecvt_utf8<wchar_t>>().from_bytes(source);
+  for (auto _ : state) {
+    std::wstring_convert<std::codecvt_utf8<wchar_t>> converter;
+    std::string output = converter.to_bytes(input);
+    benchmark::DoNotOptimize(output);
+  }
+
+  ::setInputLabel(state);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+
+void BM_Utf8Encode(benchmark::State& state) {
+  const std::string& source = ::getInputs()[state.range(0)];
+
+  std::wstring input;
+  common::tryDecodeUtf8(source, input);
+
+  std::string output;
+  for (auto _ : state) {
+    common::tryEncodeUtf8(input, output);
+    benchmark::DoNotOptimize(output);
+  }
+
+  ::setInputLabel(state);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(source.size()));
+}
+
+void BM_Utf8Validate(benchmark::State& state) {
+  const std::string& input = ::getInputs()[state.range(0)];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(common::isValidUtf8(input));
+  }
+
+  ::setInputLabel(state);
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(input.size()));
+}
+
+BENCHMARK(BM_WstringConvertDecode)->DenseRange(0, 3);
+BENCHMARK(BM_Utf8Decode)->DenseRange(0, 3);
+BENCHMARK(BM_WstringConvertEncode)->DenseRange(0, 3);
+BENCHMARK(BM_Utf8Encode)->DenseRange(0, 3);
+BENCHMARK(BM_Utf8Validate)->DenseRange(0, 3);
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+#include "sailc/common/utf.hpp"
+
+namespace common = saildb::common;
+
+namespace {
+
+// Prefixed to malformed input so that it's reached through the vectorised ASCII path as well
+const std::string ASCII_RUN(37, 'a');
+
+// Expects `input` to be rejected by both the decoder(s) & the validator, incl. after a run of ASCII
+void expectMalformedUtf8(std::string_view input) {
+  for (const std::string& candidate : { std::string(input), ASCII_RUN + std::string(input), ASCII_RUN + std::string(input) + ASCII_RUN }) {
+    std::u16string utf16 = u"stale";
+    std::u32string utf32 = U"stale";
+    std::wstring wide = L"stale";
+
+    EXPECT_FALSE(common::tryDecodeUtf8(candidate, utf16));
+    EXPECT_FALSE(common::tryDecodeUtf8(candidate, utf32));
+    EXPECT_FALSE(common::tryDecodeUtf8(candidate, wide));
+    EXPECT_FALSE(common::isValidUtf8(candidate));
+
+    EXPECT_TRUE(utf16.empty());
+    EXPECT_TRUE(utf32.empty());
+    EXPECT_TRUE(wide.empty());
+  }
+}
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Valid                           *
+ *                                                          *
+ ************************************************************/
+
+TEST(UtfTest, RoundTripsEncodingBoundaries) {
+  // U+007F, U+0080, U+07FF, U+0800, U+FFFF, U+10000 & U+10FFFF
+  const std::string utf8 = "\x7F" "\xC2\x80" "\xDF\xBF" "\xE0\xA0\x80" "\xEF\xBF\xBF" "\xF0\x90\x80\x80" "\xF4\x8F\xBF\xBF";
+  const std::u32string utf32 = U"\U0000007F\U00000080\U000007FF\U00000800\U0000FFFF\U00010000\U0010FFFF";
+  const std::u16string utf16 = u"\u007F\u0080\u07FF\u0800\uFFFF\U00010000\U0010FFFF";
+
+  std::u32string decoded32;
+  ASSERT_TRUE(common::tryDecodeUtf8(utf8, decoded32));
+  EXPECT_EQ(decoded32, utf32);
+
+  std::u16string decoded16;
+  ASSERT_TRUE(common::tryDecodeUtf8(utf8, decoded16));
+  EXPECT_EQ(decoded16, utf16);
+
+  std::string encoded;
+  ASSERT_TRUE(common::tryEncodeUtf8(utf32, encoded));
+  EXPECT_EQ(encoded, utf8);
+  ASSERT_TRUE(common::tryEncodeUtf8(utf16, encoded));
+  EXPECT_EQ(encoded, utf8);
+
+  EXPECT_TRUE(common::isValidUtf8(utf8));
+}
+
+TEST(UtfTest, RoundTripsMixedRuns) {
+  // ASCII run(s) straddling the vector lane(s), interleaved with multi-byte sequence(s)
+  std::string utf8;
+  for (size_t length : { 0, 1, 7, 8, 15, 16, 17, 31, 33 }) {
+    utf8 += std::string(length, 'x');
+    utf8 += "\xCE\xB8" "\xE0\xA4\xB9" "\xF0\x9F\x98\x80";
+  }
+
+  std::wstring wide;
+  ASSERT_TRUE(common::tryDecodeUtf8(utf8, wide));
+
+  std::string encoded;
+  ASSERT_TRUE(common::tryEncodeUtf8(wide, encoded));
+  EXPECT_EQ(encoded, utf8);
+}
+
+TEST(UtfTest, ReusesOutput) {
+  std::u32string output = U"previous content, longer than the result";
+  ASSERT_TRUE(common::tryDecodeUtf8("abc", output));
+  EXPECT_EQ(output, U"abc");
+
+  std::string encoded = "previous content, longer than the result";
+  ASSERT_TRUE(common::tryEncodeUtf8(std::u32string_view(U"abc"), encoded));
+  EXPECT_EQ(encoded, "abc");
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Malformed                        *
+ *                                                          *
+ ************************************************************/
+
+TEST(UtfTest, RejectsOverlongForms) {
+  ::expectMalformedUtf8("\xC0\x80");             // U+0000
+  ::expectMalformedUtf8("\xC1\xBF");             // U+007F
+  ::expectMalformedUtf8("\xE0\x80\x80");         // U+0000
+  ::expectMalformedUtf8("\xE0\x9F\xBF");         // U+07FF
+  ::expectMalformedUtf8("\xF0\x80\x80\x80");     // U+0000
+  ::expectMalformedUtf8("\xF0\x8F\xBF\xBF");     // U+FFFF
+}
+
+TEST(UtfTest, RejectsSurrogates) {
+  ::expectMalformedUtf8("\xED\xA0\x80");         // U+D800
+  ::expectMalformedUtf8("\xED\xBF\xBF");         // U+DFFF
+  ::expectMalformedUtf8("\xED\xA0\xBD\xED\xB8\x80"); // CESU-8 encoded U+1F600
+
+  std::string encoded = "stale";
+  EXPECT_FALSE(common::tryEncodeUtf8(std::u32string_view(U"a\xD800"), encoded));
+  EXPECT_TRUE(encoded.empty());
+  EXPECT_FALSE(common::tryEncodeUtf8(std::u32string_view(U"\xDFFF"), encoded));
+}
+
+TEST(UtfTest, RejectsValuesBeyondMaxCodepoint) {
+  ::expectMalformedUtf8("\xF4\x90\x80\x80");     // U+110000
+  ::expectMalformedUtf8("\xF5\x80\x80\x80");
+  ::expectMalformedUtf8("\xF7\xBF\xBF\xBF");
+  ::expectMalformedUtf8("\xF8\x88\x80\x80\x80"); // 5-byte form
+  ::expectMalformedUtf8("\xFF");
+
+  const char32_t beyond[] = { U'a', char32_t(0x110000) };
+  std::string encoded = "stale";
+  EXPECT_FALSE(common::tryEncodeUtf8(std::u32string_view(beyond, 2), encoded));
+  EXPECT_TRUE(encoded.empty());
+}
+
+TEST(UtfTest, RejectsTruncatedSequences) {
+  ::expectMalformedUtf8("\xC3");
+  ::expectMalformedUtf8("\xE2\x82");
+  ::expectMalformedUtf8("\xF0\x9F\x98");
+  ::expectMalformedUtf8("\xE2\x82" "a");         // Interrupted by ASCII
+  ::expectMalformedUtf8("\xF0\x9F" "\xC3\xA9");  // Interrupted by another lead byte
+  ::expectMalformedUtf8("\x80");                 // Stray continuation
+  ::expectMalformedUtf8("\xC3\xA9\xA9");
+}
+
+TEST(UtfTest, RejectsUnpairedUtf16) {
+  const std::u16string unpaired[] = {
+    std::u16string(1, char16_t(0xD800)),                          // High surrogate at the end
+    std::u16string({ char16_t(0xD800), u'a' }),                   // High surrogate followed by ASCII
+    std::u16string({ char16_t(0xD800), char16_t(0xD800) }),       // Two high surrogates
+    std::u16string(1, char16_t(0xDC00)),                          // Lone low surrogate
+    std::u16string({ char16_t(0xDC00), char16_t(0xD800) }),       // Reversed pair
+  };
+
+  for (const std::u16string& input : unpaired) {
+    for (const std::u16string& candidate : { input, u"abcdefghijklmnopq" + input }) {
+      std::string encoded = "stale";
+      EXPECT_FALSE(common::tryEncodeUtf8(candidate, encoded));
+      EXPECT_TRUE(encoded.empty());
+    }
+  }
+}
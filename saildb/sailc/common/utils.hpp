@@ -31,7 +31,7 @@ class OnScopeExitImpl final {
 };
 
 template <typename Fn>
-inline _Check_return_ auto OnScopeExit(Fn&& fn) -> OnScopeExitImpl<Fn> {
+[[nodiscard]] inline auto OnScopeExit(Fn&& fn) -> OnScopeExitImpl<Fn> {
   return OnScopeExitImpl<Fn>{ std::move(fn) };
 }
 
@@ -0,0 +1,173 @@
+#include "Connection.hpp"
+
+#include <utility>
+#include <algorithm>
+#include <exception>
+
+using Connection = saildb::Connection;
+
+/* Static impl. */
+std::shared_ptr<Connection> Connection::Create(
+  saildb::PooledConnection connection,
+  bool autocommit /*= false*/,
+  std::shared_ptr<saildb::Executor> executor /*= nullptr*/,
+  std::shared_ptr<saildb::ResultCache> results /*= nullptr*/
+) {
+  if (!connection) {
+    throw std::invalid_argument("Expected a leased connection");
+  }
+
+  std::shared_ptr<Connection> result(new Connection(std::move(connection), std::move(executor), std::move(results)));
+  result->SetAutocommit(autocommit);
+
+  return result;
+}
+
+
+/* Ctor & Dtor */
+Connection::Operation::Operation(std::shared_ptr<Connection> connection)
+  : m_connection(std::move(connection))
+{
+  m_connection->m_operations.fetch_add(1, std::memory_order_relaxed);
+}
+
+Connection::Operation::~Operation() {
+  if (m_connection) {
+    m_connection->m_operations.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+Connection::Connection(saildb::PooledConnection connection, std::shared_ptr<saildb::Executor> executor, std::shared_ptr<saildb::ResultCache> results)
+  : m_connection(std::make_shared<saildb::PooledConnection>(std::move(connection))), m_executor(std::move(executor)), m_results(std::move(results)) { };
+
+Connection::~Connection() {
+  try {
+    Close();
+  } catch (const std::exception&) {
+    // Connection was invalidated by `Close`
+  }
+}
+
+
+/* Public impl. */
+std::shared_ptr<saildb::Cursor> Connection::CreateCursor(saildb::CursorOptions options /*= CursorOptions()*/) {
+  GetLease();
+
+  auto cursor = std::make_shared<saildb::Cursor>(shared_from_this(), std::move(options));
+
+  m_cursors.erase(
+    std::remove_if(m_cursors.begin(), m_cursors.end(), [](const std::weak_ptr<saildb::Cursor>& ref) { return ref.expired(); }),
+    m_cursors.end()
+  );
+  m_cursors.push_back(cursor);
+
+  return cursor;
+}
+
+void Connection::Commit() {
+  endTransaction(SQL_COMMIT, "Failed to commit transaction");
+}
+
+void Connection::Rollback() {
+  endTransaction(SQL_ROLLBACK, "Failed to rollback transaction");
+}
+
+void Connection::Close() {
+  if (!m_connection) {
+    return;
+  }
+  ensureIdle();
+
+  for (const std::weak_ptr<saildb::Cursor>& ref : m_cursors) {
+    if (auto cursor = ref.lock()) {
+      cursor->Close();
+    }
+  }
+  m_cursors.clear();
+
+  // Pooled connection(s) are expected in autocommit mode with no open transaction;
+  // the connection is dropped rather than returned if that can't be restored
+  auto connection = std::exchange(m_connection, nullptr);
+  if (!m_autocommit) {
+    SQLHDBC handle = static_cast<SQLHDBC>((*connection)->native_dbc_handle());
+
+    const SQLRETURN rc = SQLEndTran(SQL_HANDLE_DBC, handle, SQL_ROLLBACK);
+    connection->GetStatementCache().OnTransactionEnd(handle, SQL_ROLLBACK);
+
+    const SQLRETURN rs = SQLSetConnectAttr(handle, SQL_ATTR_AUTOCOMMIT, reinterpret_cast<SQLPOINTER>(static_cast<uintptr_t>(SQL_AUTOCOMMIT_ON)), SQL_IS_UINTEGER);
+    if (!SQL_SUCCEEDED(rc) || !SQL_SUCCEEDED(rs)) {
+      connection->Invalidate();
+    }
+  }
+}
+
+bool Connection::IsClosed() const {
+  return !m_connection;
+}
+
+bool Connection::GetAutocommit() const {
+  return m_autocommit;
+}
+
+void Connection::SetAutocommit(bool autocommit) {
+  SQLHDBC handle = GetHandle();
+  ensureIdle();
+
+  const SQLUINTEGER value = autocommit ? SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF;
+  odbc::check(
+    SQLSetConnectAttr(handle, SQL_ATTR_AUTOCOMMIT, reinterpret_cast<SQLPOINTER>(static_cast<uintptr_t>(value)), SQL_IS_UINTEGER),
+    SQL_HANDLE_DBC, handle, "Failed to set autocommit"
+  );
+
+  m_autocommit = autocommit;
+}
+
+Connection::Operation Connection::BeginOperation() {
+  GetLease();
+  return Operation(shared_from_this());
+}
+
+const std::shared_ptr<saildb::PooledConnection>& Connection::GetLease() const {
+  if (!m_connection) {
+    throw odbc::Error("08003", "Connection is closed");
+  }
+
+  return m_connection;
+}
+
+SQLHDBC Connection::GetHandle() const {
+  return static_cast<SQLHDBC>((*GetLease())->native_dbc_handle());
+}
+
+const std::shared_ptr<saildb::Executor>& Connection::GetExecutor() const {
+  if (!m_executor) {
+    throw odbc::Error("HYC00", "Connection doesn't support asynchronous execution, expected an executor");
+  }
+
+  return m_executor;
+}
+
+const std::shared_ptr<saildb::ResultCache>& Connection::GetResultCache() const {
+  return m_results;
+}
+
+
+/* Private impl. */
+void Connection::ensureIdle() const {
+  if (m_operations.load(std::memory_order_acquire) > 0) {
+    throw odbc::Error("HY010", "Connection has pending asynchronous operation(s)");
+  }
+}
+
+void Connection::endTransaction(SQLSMALLINT completionType, std::string_view context) {
+  SQLHDBC handle = GetHandle();
+  ensureIdle();
+  if (m_autocommit) {
+    return;
+  }
+
+  const SQLRETURN rc = SQLEndTran(SQL_HANDLE_DBC, handle, completionType);
+  GetLease()->GetStatementCache().OnTransactionEnd(handle, completionType);
+
+  odbc::check(rc, SQL_HANDLE_DBC, handle, context);
+}
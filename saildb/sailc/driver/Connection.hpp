@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "sailc/driver/Odbc.hpp"
+#include "sailc/driver/Cursor.hpp"
+#include "sailc/driver/Executor.hpp"
+#include "sailc/driver/ResultCache.hpp"
+#include "sailc/driver/ConnectionPool.hpp"
+
+namespace saildb {
+
+/*
+ * DB-API connection over a pooled connection
+ *
+ *  - Transaction(s) are explicit unless `autocommit` is set; an open transaction is
+ *    rolled back when the connection is closed
+ *  - Closing closes its cursor(s) & returns the connection to its pool in autocommit mode
+ *  - Statement(s) are prepared through the pooled connection's `StatementCache`, which is
+ *    cleared on commit or rollback where the driver deletes prepared statement(s)
+ *  - Cursor(s) opted in by `CursorOptions::useResultCache` are served by its `ResultCache`, if any
+ *  - Commit, rollback, close & changes to `autocommit` fail with `HY010` while an operation begun by
+ *    `BeginOperation`, e.g. one run on its executor, is pending
+ *  - Not thread-safe, i.e. DB-API `threadsafety = 1`
+ *
+ */
+class Connection : public std::enable_shared_from_this<Connection> {
+  public:
+    // Marks an operation as pending on the connection until destroyed
+    class Operation {
+      public:
+        ~Operation();
+
+        Operation(Operation&& other) noexcept = default;
+        Operation(Operation const&) = delete;
+        Operation &operator=(Operation const&) = delete;
+        Operation &operator=(Operation&&) = delete;
+
+      private:
+        friend class Connection;
+        explicit Operation(std::shared_ptr<Connection> connection);
+
+      private:
+        std::shared_ptr<Connection> m_connection;
+    };
+
+  public:
+    // `executor` runs the connection's asynchronous operation(s) & `results` caches its result set(s), e.g. the environment's
+    static std::shared_ptr<Connection> Create(
+      PooledConnection connection,
+      bool autocommit = false,
+      std::shared_ptr<Executor> executor = nullptr,
+      std::shared_ptr<ResultCache> results = nullptr
+    );
+
+  public:
+    Connection(Connection const&) = delete;
+    Connection &operator=(Connection const&) = delete;
+    ~Connection();
+
+  public:
+    std::shared_ptr<Cursor> CreateCursor(CursorOptions options = CursorOptions());
+
+    void Commit();
+    void Rollback();
+    void Close();
+    bool IsClosed() const;
+
+    bool GetAutocommit() const;
+    void SetAutocommit(bool autocommit);
+
+    // Taken on the caller's thread before an operation is handed to another, e.g. the executor; throws if closed
+    Operation BeginOperation();
+
+    // The lease is shared with the connection's open result set(s); throws if closed
+    const std::shared_ptr<PooledConnection>& GetLease() const;
+    SQLHDBC GetHandle() const;
+
+    // Throws if the connection was created without an executor
+    const std::shared_ptr<Executor>& GetExecutor() const;
+
+    // `nullptr` unless the connection was created with a result cache
+    const std::shared_ptr<ResultCache>& GetResultCache() const;
+
+  private:
+    Connection(PooledConnection connection, std::shared_ptr<Executor> executor, std::shared_ptr<ResultCache> results);
+
+    void ensureIdle() const;
+    void endTransaction(SQLSMALLINT completionType, std::string_view context);
+
+  private:
+    std::shared_ptr<PooledConnection> m_connection;
+    std::shared_ptr<Executor> m_executor;
+    std::shared_ptr<ResultCache> m_results;
+    bool m_autocommit{true};
+    std::vector<std::weak_ptr<Cursor>> m_cursors;
+    std::atomic<size_t> m_operations{0};
+};
+
+} // namespace saildb
@@ -0,0 +1,396 @@
+#include "ConnectionPool.hpp"
+
+#include <bit>
+#include <thread>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+
+#include "sailc/driver/Odbc.hpp"
+
+using Clock = std::chrono::steady_clock;
+using ConnectionPool = saildb::ConnectionPool;
+using PooledConnection = saildb::PooledConnection;
+
+
+
+/************************************************************
+ *                                                          *
+ *                     PooledConnection                     *
+ *                                                          *
+ ************************************************************/
+
+struct PooledConnection::Slot {
+  nanodbc::connection connection;
+  Clock::time_point lastUsed;
+  Clock::time_point lastValidated;
+  uint64_t generation{0};
+
+  // Declared after the connection, so its statement(s) are freed first
+  std::unique_ptr<saildb::StatementCache> statements;
+};
+
+PooledConnection::PooledConnection(std::shared_ptr<ConnectionPool> pool, PooledConnection::Slot* slot)
+  : m_pool(std::move(pool)), m_slot(slot) { };
+
+PooledConnection::~PooledConnection() {
+  Release();
+}
+
+PooledConnection::PooledConnection(PooledConnection&& other) noexcept
+  : m_pool(std::move(other.m_pool)), m_slot(std::exchange(other.m_slot, nullptr)) { };
+
+PooledConnection& PooledConnection::operator=(PooledConnection&& other) noexcept {
+  if (this != &other) {
+    Release();
+    m_pool = std::move(other.m_pool);
+    m_slot = std::exchange(other.m_slot, nullptr);
+  }
+
+  return *this;
+}
+
+PooledConnection::operator bool() const {
+  return m_slot != nullptr;
+}
+
+nanodbc::connection& PooledConnection::operator*() const {
+  return m_slot->connection;
+}
+
+nanodbc::connection* PooledConnection::operator->() const {
+  return &m_slot->connection;
+}
+
+saildb::StatementCache& PooledConnection::GetStatementCache() const {
+  return *m_slot->statements;
+}
+
+const std::string& PooledConnection::GetConnectionString() const {
+  return m_pool->GetConnectionString();
+}
+
+void PooledConnection::Release() {
+  if (m_slot != nullptr) {
+    m_pool->release(std::exchange(m_slot, nullptr), false);
+    m_pool.reset();
+  }
+}
+
+void PooledConnection::Invalidate() {
+  if (m_slot != nullptr) {
+    m_pool->release(std::exchange(m_slot, nullptr), true);
+    m_pool.reset();
+  }
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                      ConnectionPool                      *
+ *                                                          *
+ ************************************************************/
+
+/* Static impl. */
+std::shared_ptr<ConnectionPool> ConnectionPool::Create(std::string connectionString, PoolOptions options /*= PoolOptions()*/) {
+  if (options.maxSize < 1) {
+    throw std::invalid_argument("Expected a pool size of at least 1");
+  }
+
+  return std::shared_ptr<ConnectionPool>(new ConnectionPool(std::move(connectionString), std::move(options)));
+}
+
+
+/* Ctor & Dtor */
+ConnectionPool::ConnectionPool(std::string connectionString, PoolOptions options)
+  : m_connectionString(std::move(connectionString)), m_options(std::move(options))
+{
+  const size_t capacity = std::bit_ceil(static_cast<size_t>(m_options.maxSize));
+
+  m_mask = capacity - 1;
+  m_cells = std::make_unique<Cell[]>(capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    m_cells[i].slot = nullptr;
+  }
+}
+
+ConnectionPool::~ConnectionPool() {
+  // Leases hold a reference to the pool, only idle connection(s) remain
+  Slot* slot;
+  while (tryPop(slot)) {
+    delete slot;
+  }
+}
+
+
+/* Public impl. */
+PooledConnection ConnectionPool::Acquire() {
+  const auto deadline = Clock::now() + m_options.checkoutTimeout;
+
+  PooledConnection connection;
+  while (true) {
+    bool isExhausted = false;
+    if (tryCheckout(connection, isExhausted)) {
+      return connection;
+    }
+
+    // Wait for a return or a discard; `m_waiters` is published before the
+    // predicate is tested so that a concurrent release can't miss us
+    std::unique_lock<std::mutex> lock(m_waitLock);
+    m_waiters.fetch_add(1, std::memory_order_seq_cst);
+
+    const bool isSignalled = m_available.wait_until(lock, deadline, [this]() {
+      return m_idle.load(std::memory_order_seq_cst) > 0 || m_open.load(std::memory_order_seq_cst) < m_options.maxSize;
+    });
+
+    m_waiters.fetch_sub(1, std::memory_order_relaxed);
+    if (!isSignalled) {
+      throw std::runtime_error(
+        std::string("Failed to acquire a connection, pool of size ")
+          .append(std::to_string(m_options.maxSize))
+          .append(" remained exhausted for ")
+          .append(std::to_string(m_options.checkoutTimeout.count()))
+          .append("ms")
+      );
+    }
+  }
+}
+
+bool ConnectionPool::TryAcquire(PooledConnection& connection) {
+  bool isExhausted = false;
+  return tryCheckout(connection, isExhausted);
+}
+
+void ConnectionPool::EvictIdle() {
+  const auto now = Clock::now();
+  m_lastSweep.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+
+  // Bounded by the idle count at the time of the sweep; fresh connection(s) are re-queued
+  uint32_t remaining = m_idle.load(std::memory_order_acquire);
+  Slot* slot;
+  while (remaining-- > 0 && tryPop(slot)) {
+    m_idle.fetch_sub(1, std::memory_order_seq_cst);
+
+    const bool isStale = (
+      slot->generation != m_generation.load(std::memory_order_acquire) ||
+      now - slot->lastUsed > m_options.idleTimeout
+    );
+
+    if (isStale) {
+      discard(slot);
+    } else {
+      requeue(slot);
+    }
+  }
+}
+
+void ConnectionPool::Clear() {
+  m_generation.fetch_add(1, std::memory_order_acq_rel);
+
+  Slot* slot;
+  while (tryPop(slot)) {
+    m_idle.fetch_sub(1, std::memory_order_seq_cst);
+    discard(slot);
+  }
+}
+
+uint32_t ConnectionPool::GetOpenCount() const {
+  return m_open.load(std::memory_order_relaxed);
+}
+
+uint32_t ConnectionPool::GetIdleCount() const {
+  return m_idle.load(std::memory_order_relaxed);
+}
+
+const saildb::PoolOptions& ConnectionPool::GetOptions() const {
+  return m_options;
+}
+
+const std::string& ConnectionPool::GetConnectionString() const {
+  return m_connectionString;
+}
+
+const saildb::StatementCacheStats& ConnectionPool::GetStatementCacheStats() const {
+  return m_statementStats;
+}
+
+
+/* Private impl. */
+bool ConnectionPool::tryPush(ConnectionPool::Slot* slot) {
+  // Vyukov's bounded MPMC queue; never full, as open connection(s) are bounded by its capacity
+  size_t position = m_tail.load(std::memory_order_relaxed);
+  while (true) {
+    Cell& cell = m_cells[position & m_mask];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+    if (diff == 0) {
+      if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        cell.slot = slot;
+        cell.sequence.store(position + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      position = m_tail.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool ConnectionPool::tryPop(ConnectionPool::Slot*& slot) {
+  size_t position = m_head.load(std::memory_order_relaxed);
+  while (true) {
+    Cell& cell = m_cells[position & m_mask];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+    if (diff == 0) {
+      if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+        slot = cell.slot;
+        cell.sequence.store(position + m_mask + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      position = m_head.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void ConnectionPool::requeue(ConnectionPool::Slot* slot) {
+  // Counted before it's visible, otherwise a concurrent checkout could pop it & decrement `m_idle` below zero
+  m_idle.fetch_add(1, std::memory_order_seq_cst);
+  if (!tryPush(slot)) {
+    m_idle.fetch_sub(1, std::memory_order_seq_cst);
+    discard(slot);
+  }
+}
+
+bool ConnectionPool::tryCheckout(PooledConnection& connection, bool& isExhausted) {
+  // Fast path: reuse an idle connection
+  Slot* slot;
+  while (tryPop(slot)) {
+    m_idle.fetch_sub(1, std::memory_order_seq_cst);
+    if (isUsable(slot, Clock::now())) {
+      connection = PooledConnection(shared_from_this(), slot);
+      return true;
+    }
+
+    discard(slot);
+  }
+
+  // Grow the partition if it's below capacity
+  uint32_t open = m_open.load(std::memory_order_relaxed);
+  while (open < m_options.maxSize) {
+    if (m_open.compare_exchange_weak(open, open + 1, std::memory_order_seq_cst)) {
+      try {
+        connection = PooledConnection(shared_from_this(), connect());
+      } catch (...) {
+        m_open.fetch_sub(1, std::memory_order_seq_cst);
+        notifyWaiter();
+        throw;
+      }
+
+      return true;
+    }
+  }
+
+  isExhausted = true;
+  return false;
+}
+
+ConnectionPool::Slot* ConnectionPool::connect() {
+  auto slot = std::make_unique<Slot>();
+  slot->connection.connect(odbc::toNativeString(m_connectionString), m_options.loginTimeout);
+  slot->lastUsed = slot->lastValidated = Clock::now();
+  slot->generation = m_generation.load(std::memory_order_acquire);
+  slot->statements = std::make_unique<saildb::StatementCache>(m_options.statementCacheSize, &m_statementStats);
+
+  return slot.release();
+}
+
+bool ConnectionPool::isUsable(ConnectionPool::Slot* slot, Clock::time_point now) {
+  if (slot->generation != m_generation.load(std::memory_order_acquire) || now - slot->lastUsed > m_options.idleTimeout) {
+    return false;
+  }
+
+  if (now - slot->lastValidated <= m_options.validationInterval) {
+    return true;
+  }
+
+  if (!slot->connection.connected()) {
+    return false;
+  }
+
+  // Driver-side liveness check, without a round trip where supported
+  SQLUINTEGER isDead = SQL_CD_FALSE;
+  const SQLRETURN rc = SQLGetConnectAttr(
+    static_cast<SQLHDBC>(slot->connection.native_dbc_handle()),
+    SQL_ATTR_CONNECTION_DEAD,
+    &isDead,
+    SQL_IS_UINTEGER,
+    nullptr
+  );
+
+  if (SQL_SUCCEEDED(rc) && isDead == SQL_CD_TRUE) {
+    return false;
+  }
+
+  if (!m_options.validationQuery.empty()) {
+    try {
+      nanodbc::just_execute(slot->connection, odbc::toNativeString(m_options.validationQuery));
+    } catch (const std::exception&) {
+      return false;
+    }
+  }
+
+  slot->lastValidated = now;
+  return true;
+}
+
+void ConnectionPool::release(ConnectionPool::Slot* slot, bool isInvalid) {
+  const auto now = Clock::now();
+
+  const bool isStale = isInvalid || slot->generation != m_generation.load(std::memory_order_acquire);
+  if (isStale || !slot->connection.connected()) {
+    discard(slot);
+    return;
+  }
+
+  slot->lastUsed = now;
+  requeue(slot);
+  notifyWaiter();
+
+  // Piggyback eviction on return(s), at most once per `idleTimeout`
+  const int64_t tick = now.time_since_epoch().count();
+  int64_t lastSweep = m_lastSweep.load(std::memory_order_relaxed);
+  const auto elapsed = Clock::duration(tick - lastSweep);
+  if (elapsed > m_options.idleTimeout && m_lastSweep.compare_exchange_strong(lastSweep, tick, std::memory_order_relaxed)) {
+    EvictIdle();
+  }
+}
+
+void ConnectionPool::discard(ConnectionPool::Slot* slot) {
+  // Statement handle(s) are invalid once disconnected
+  slot->statements->Clear();
+
+  try {
+    slot->connection.disconnect();
+  } catch (const std::exception&) {
+    // Connection is being dropped regardless
+  }
+
+  delete slot;
+  m_open.fetch_sub(1, std::memory_order_seq_cst);
+  notifyWaiter();
+}
+
+void ConnectionPool::notifyWaiter() {
+  // Locked so that the notification can't land between a waiter's predicate test & its wait
+  if (m_waiters.load(std::memory_order_seq_cst) > 0) {
+    std::lock_guard<std::mutex> lock(m_waitLock);
+    m_available.notify_one();
+  }
+}
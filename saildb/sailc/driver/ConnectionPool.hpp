@@ -0,0 +1,158 @@
+#pragma once
+
+#include <nanodbc/nanodbc.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+
+#include "sailc/driver/StatementCache.hpp"
+
+namespace saildb {
+
+struct PoolOptions {
+  uint32_t maxSize{8};                                  // Upper bound of open connection(s) per partition
+  std::chrono::milliseconds checkoutTimeout{30'000};    // Max. wait for a connection once the partition is exhausted
+  std::chrono::milliseconds idleTimeout{300'000};       // Idle connection(s) are closed once unused for this long
+  std::chrono::milliseconds validationInterval{5'000};  // Connection(s) idle for longer are validated on checkout
+  std::string validationQuery;                          // e.g. `SELECT 1`, otherwise only `SQL_ATTR_CONNECTION_DEAD` is checked
+  long loginTimeout{0};                                 // Seconds, or 0 for the driver's default
+  size_t statementCacheSize{64};                        // Prepared statement(s) cached per connection, or 0 to disable
+};
+
+class ConnectionPool;
+
+/*
+ * Lease of a pooled connection, returned to its pool on destruction
+ */
+class PooledConnection {
+  public:
+    PooledConnection() = default;
+    ~PooledConnection();
+
+    PooledConnection(PooledConnection&& other) noexcept;
+    PooledConnection& operator=(PooledConnection&& other) noexcept;
+    PooledConnection(const PooledConnection&) = delete;
+    PooledConnection& operator=(const PooledConnection&) = delete;
+
+  public:
+    explicit operator bool() const;
+    nanodbc::connection& operator*() const;
+    nanodbc::connection* operator->() const;
+
+    // Prepared statement(s) of the connection, kept across lease(s)
+    StatementCache& GetStatementCache() const;
+
+    // Connection string of the connection's pool
+    const std::string& GetConnectionString() const;
+
+    // Returns the connection to its pool ahead of destruction
+    void Release();
+
+    // Closes the connection rather than returning it, e.g. following a connection-level error
+    void Invalidate();
+
+  private:
+    friend class ConnectionPool;
+
+    struct Slot;
+    PooledConnection(std::shared_ptr<ConnectionPool> pool, Slot* slot);
+
+  private:
+    std::shared_ptr<ConnectionPool> m_pool;
+    Slot* m_slot{nullptr};
+};
+
+/*
+ * Bounded pool of connection(s) to a single connection string, i.e. one DSN &
+ * credential partition of an `Environment`
+ *
+ *  - Idle connection(s) are held in a lock-free MPMC ring; checkout & return only
+ *    lock once the partition is exhausted & a caller must wait
+ *  - Connection(s) idle beyond `idleTimeout` are closed, either when next popped or
+ *    by a sweep piggybacked on return(s); no reaper thread is required
+ *  - Connection(s) idle beyond `validationInterval` are validated before checkout
+ *  - Each connection keeps its own `StatementCache`, freed before it's disconnected
+ *
+ */
+class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
+  public:
+    static std::shared_ptr<ConnectionPool> Create(std::string connectionString, PoolOptions options = PoolOptions());
+
+  public:
+    ConnectionPool(ConnectionPool const&) = delete;
+    ConnectionPool &operator=(ConnectionPool const&) = delete;
+    ~ConnectionPool();
+
+  public:
+    // Throws if a connection can't be opened, or if none is returned within `checkoutTimeout`
+    PooledConnection Acquire();
+    bool TryAcquire(PooledConnection& connection);
+
+    // Closes idle connection(s) unused for longer than `idleTimeout`
+    void EvictIdle();
+
+    // Closes every idle connection; leased connection(s) are closed on return
+    void Clear();
+
+    uint32_t GetOpenCount() const;
+    uint32_t GetIdleCount() const;
+    const PoolOptions& GetOptions() const;
+    const std::string& GetConnectionString() const;
+
+    // Summed across the statement cache(s) of every connection
+    const StatementCacheStats& GetStatementCacheStats() const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+    using Slot = PooledConnection::Slot;
+
+    ConnectionPool(std::string connectionString, PoolOptions options);
+
+    // Idle ring
+    bool tryPush(Slot* slot);
+    bool tryPop(Slot*& slot);
+    void requeue(Slot* slot);
+
+    // Lifecycle
+    bool tryCheckout(PooledConnection& connection, bool& isExhausted);
+    Slot* connect();
+    bool isUsable(Slot* slot, Clock::time_point now);
+    void release(Slot* slot, bool isInvalid);
+    void discard(Slot* slot);
+    void notifyWaiter();
+
+    friend class PooledConnection;
+
+  private:
+    struct Cell {
+      std::atomic<size_t> sequence;
+      Slot* slot;
+    };
+
+    const std::string m_connectionString;
+    const PoolOptions m_options;
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask{0};
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+
+    alignas(64) std::atomic<uint32_t> m_open{0};
+    std::atomic<uint32_t> m_idle{0};
+    std::atomic<uint64_t> m_generation{0};
+    std::atomic<int64_t> m_lastSweep{0};
+
+    StatementCacheStats m_statementStats;
+
+    std::mutex m_waitLock;
+    std::condition_variable m_available;
+    std::atomic<uint32_t> m_waiters{0};
+};
+
+} // namespace saildb
@@ -0,0 +1,291 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <stdexcept>
+
+#include "sailc/driver/ConnectionPool.hpp"
+#include "sailc/driver/TestDatabase.hpp"
+
+using Clock = std::chrono::steady_clock;
+using saildb::ConnectionPool;
+using saildb::PoolOptions;
+using saildb::PooledConnection;
+using saildb::testing::TestDatabase;
+
+namespace {
+
+class ConnectionPoolTest : public ::testing::Test {
+  protected:
+    ConnectionPoolTest()
+      : m_database(::testing::UnitTest::GetInstance()->current_test_info()->name()) { };
+
+    // Creates a pool over the test's database, or `nullptr` with `m_errorMessage` set if its driver is unavailable
+    std::shared_ptr<ConnectionPool> createPool(PoolOptions options) {
+      return m_database.TryCreatePool(std::move(options), m_errorMessage);
+    }
+
+    // Marks the leased connection, so that it can be told apart from a fresh one once returned
+    static void mark(PooledConnection& connection) {
+      TestDatabase::Execute(*connection, "CREATE TEMP TABLE saildb_marker (id INTEGER)");
+    }
+
+    static bool isMarked(PooledConnection& connection) {
+      try {
+        TestDatabase::Execute(*connection, "SELECT id FROM saildb_marker");
+        return true;
+      } catch (const std::exception&) {
+        return false;
+      }
+    }
+
+  protected:
+    TestDatabase m_database;
+    std::string m_errorMessage;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Checkout                         *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ConnectionPoolTest, ReusesReturnedConnection) {
+  auto pool = createPool(PoolOptions());
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  {
+    PooledConnection connection = pool->Acquire();
+    ASSERT_TRUE(connection);
+    mark(connection);
+  }
+
+  EXPECT_EQ(pool->GetOpenCount(), 1u);
+  EXPECT_EQ(pool->GetIdleCount(), 1u);
+
+  PooledConnection connection = pool->Acquire();
+  EXPECT_TRUE(isMarked(connection));
+  EXPECT_EQ(pool->GetIdleCount(), 0u);
+}
+
+TEST_F(ConnectionPoolTest, TimesOutOnceExhausted) {
+  PoolOptions options;
+  options.maxSize = 2;
+  options.checkoutTimeout = std::chrono::milliseconds(100);
+  auto pool = createPool(options);
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  PooledConnection first = pool->Acquire();
+  PooledConnection second = pool->Acquire();
+  EXPECT_EQ(pool->GetOpenCount(), 2u);
+
+  PooledConnection third;
+  EXPECT_FALSE(pool->TryAcquire(third));
+  EXPECT_FALSE(third);
+
+  const auto start = Clock::now();
+  EXPECT_THROW(pool->Acquire(), std::runtime_error);
+  EXPECT_GE(Clock::now() - start, options.checkoutTimeout);
+  EXPECT_EQ(pool->GetOpenCount(), 2u);
+}
+
+TEST_F(ConnectionPoolTest, WakesWaiterOnRelease) {
+  PoolOptions options;
+  options.maxSize = 1;
+  options.checkoutTimeout = std::chrono::seconds(10);
+  auto pool = createPool(options);
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  PooledConnection connection = pool->Acquire();
+  mark(connection);
+
+  PooledConnection waited;
+  std::thread waiter([&]() { waited = pool->Acquire(); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const auto start = Clock::now();
+  connection.Release();
+  waiter.join();
+
+  EXPECT_LT(Clock::now() - start, std::chrono::seconds(5));
+  ASSERT_TRUE(waited);
+  EXPECT_TRUE(isMarked(waited));
+  EXPECT_EQ(pool->GetOpenCount(), 1u);
+}
+
+TEST_F(ConnectionPoolTest, WakesWaiterOnInvalidate) {
+  PoolOptions options;
+  options.maxSize = 1;
+  options.checkoutTimeout = std::chrono::seconds(10);
+  auto pool = createPool(options);
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  PooledConnection connection = pool->Acquire();
+  mark(connection);
+
+  PooledConnection waited;
+  std::thread waiter([&]() { waited = pool->Acquire(); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const auto start = Clock::now();
+  connection.Invalidate();
+  waiter.join();
+
+  // The waiter opens a connection of its own, in place of the one closed
+  EXPECT_LT(Clock::now() - start, std::chrono::seconds(5));
+  ASSERT_TRUE(waited);
+  EXPECT_FALSE(isMarked(waited));
+  EXPECT_EQ(pool->GetOpenCount(), 1u);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Lifecycle                         *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ConnectionPoolTest, EvictsIdleConnections) {
+  PoolOptions options;
+  options.idleTimeout = std::chrono::milliseconds(50);
+  auto pool = createPool(options);
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  {
+    PooledConnection first = pool->Acquire();
+    PooledConnection second = pool->Acquire();
+  }
+
+  // Fresh connection(s) are kept
+  pool->EvictIdle();
+  EXPECT_EQ(pool->GetIdleCount(), 2u);
+  EXPECT_EQ(pool->GetOpenCount(), 2u);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  pool->EvictIdle();
+  EXPECT_EQ(pool->GetIdleCount(), 0u);
+  EXPECT_EQ(pool->GetOpenCount(), 0u);
+}
+
+TEST_F(ConnectionPoolTest, ClosesExpiredConnectionOnCheckout) {
+  PoolOptions options;
+  options.idleTimeout = std::chrono::milliseconds(50);
+  auto pool = createPool(options);
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  {
+    PooledConnection connection = pool->Acquire();
+    mark(connection);
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  PooledConnection connection = pool->Acquire();
+  EXPECT_FALSE(isMarked(connection));
+  EXPECT_EQ(pool->GetOpenCount(), 1u);
+}
+
+TEST_F(ConnectionPoolTest, ClearClosesOutstandingLeaseOnReturn) {
+  auto pool = createPool(PoolOptions());
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  PooledConnection leased = pool->Acquire();
+  mark(leased);
+  pool->Acquire().Release();
+  EXPECT_EQ(pool->GetOpenCount(), 2u);
+  EXPECT_EQ(pool->GetIdleCount(), 1u);
+
+  pool->Clear();
+  EXPECT_EQ(pool->GetIdleCount(), 0u);
+  EXPECT_EQ(pool->GetOpenCount(), 1u);
+
+  // The lease remains usable until it's returned, & is then closed rather than re-queued
+  EXPECT_TRUE(isMarked(leased));
+  leased.Release();
+  EXPECT_EQ(pool->GetIdleCount(), 0u);
+  EXPECT_EQ(pool->GetOpenCount(), 0u);
+
+  PooledConnection connection = pool->Acquire();
+  EXPECT_FALSE(isMarked(connection));
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Validation                        *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ConnectionPoolTest, ValidatesOnBorrow) {
+  PoolOptions options;
+  options.validationInterval = std::chrono::milliseconds(0);
+  options.validationQuery = "SELECT id FROM saildb_marker";
+  auto pool = createPool(options);
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  {
+    PooledConnection connection = pool->Acquire();
+    mark(connection);
+  }
+
+  // Passes validation, so the marked connection is handed out again
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  {
+    PooledConnection connection = pool->Acquire();
+    ASSERT_TRUE(isMarked(connection));
+    TestDatabase::Execute(*connection, "DROP TABLE saildb_marker");
+  }
+
+  // Fails validation, so it's closed & replaced by a fresh connection
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  PooledConnection connection = pool->Acquire();
+  EXPECT_FALSE(isMarked(connection));
+  EXPECT_EQ(pool->GetOpenCount(), 1u);
+  EXPECT_EQ(pool->GetIdleCount(), 0u);
+}
+
+TEST_F(ConnectionPoolTest, SkipsValidationWithinInterval) {
+  PoolOptions options;
+  options.validationInterval = std::chrono::hours(1);
+  options.validationQuery = "SELECT id FROM saildb_marker";
+  auto pool = createPool(options);
+  if (!pool) {
+    GTEST_SKIP() << m_errorMessage;
+  }
+
+  // Would fail validation, but was validated on connect
+  {
+    PooledConnection connection = pool->Acquire();
+    mark(connection);
+    TestDatabase::Execute(*connection, "DROP TABLE saildb_marker");
+    TestDatabase::Execute(*connection, "CREATE TEMP TABLE saildb_other (id INTEGER)");
+  }
+
+  PooledConnection connection = pool->Acquire();
+  EXPECT_NO_THROW(TestDatabase::Execute(*connection, "SELECT id FROM saildb_other"));
+}
@@ -0,0 +1,489 @@
+#include "Cursor.hpp"
+
+#include <string>
+#include <cstring>
+#include <variant>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+#include "sailc/driver/Connection.hpp"
+#include "sailc/driver/SpillReader.hpp"
+
+using Cursor = saildb::Cursor;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Utils                           *
+ *                                                          *
+ ************************************************************/
+
+template <typename T>
+void copyTo(std::vector<uint8_t>& buffer, const T& value) {
+  buffer.resize(sizeof(T));
+  std::memcpy(buffer.data(), &value, sizeof(T));
+}
+
+// Binds `parameter` as input; `buffer` & `indicator` must outlive the statement's execution
+void bindParameter(
+  const saildb::odbc::StatementHandle& statement,
+  SQLUSMALLINT index,
+  const saildb::Parameter& parameter,
+  std::vector<uint8_t>& buffer,
+  SQLLEN& indicator
+) {
+  SQLSMALLINT cType, sqlType, digits = 0;
+  SQLULEN columnSize = 0;
+
+  std::visit([&](const auto& value) {
+    using T = std::decay_t<decltype(value)>;
+
+    if constexpr (std::is_same_v<T, std::monostate>) {
+      cType = SQL_C_WCHAR;
+      sqlType = SQL_WVARCHAR;
+      columnSize = 1;
+      buffer.assign(sizeof(SQLWCHAR), 0);
+      indicator = SQL_NULL_DATA;
+    } else if constexpr (std::is_same_v<T, bool>) {
+      cType = SQL_C_BIT;
+      sqlType = SQL_BIT;
+      columnSize = 1;
+      ::copyTo(buffer, static_cast<uint8_t>(value ? 1 : 0));
+      indicator = 0;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      cType = SQL_C_SBIGINT;
+      sqlType = SQL_BIGINT;
+      columnSize = 19;
+      ::copyTo(buffer, value);
+      indicator = 0;
+    } else if constexpr (std::is_same_v<T, double>) {
+      cType = SQL_C_DOUBLE;
+      sqlType = SQL_DOUBLE;
+      columnSize = 15;
+      ::copyTo(buffer, value);
+      indicator = 0;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      const nanodbc::string text = saildb::odbc::toNativeString(value);
+      const size_t size = text.size() * sizeof(SQLWCHAR);
+
+      cType = SQL_C_WCHAR;
+      sqlType = text.size() > 4000 ? SQL_WLONGVARCHAR : SQL_WVARCHAR;
+      columnSize = std::max<size_t>(text.size(), 1);
+      buffer.resize(size + sizeof(SQLWCHAR));
+      std::memcpy(buffer.data(), text.c_str(), size + sizeof(SQLWCHAR));
+      indicator = static_cast<SQLLEN>(size);
+    } else if constexpr (std::is_same_v<T, std::vector<uint8_t>>) {
+      cType = SQL_C_BINARY;
+      sqlType = value.size() > 8000 ? SQL_LONGVARBINARY : SQL_VARBINARY;
+      columnSize = std::max<size_t>(value.size(), 1);
+      buffer.assign(value.begin(), value.end());
+      buffer.resize(std::max<size_t>(buffer.size(), 1));
+      indicator = static_cast<SQLLEN>(value.size());
+    } else if constexpr (std::is_same_v<T, SQL_DATE_STRUCT>) {
+      cType = SQL_C_TYPE_DATE;
+      sqlType = SQL_TYPE_DATE;
+      columnSize = 10;
+      ::copyTo(buffer, value);
+      indicator = 0;
+    } else if constexpr (std::is_same_v<T, SQL_TIME_STRUCT>) {
+      cType = SQL_C_TYPE_TIME;
+      sqlType = SQL_TYPE_TIME;
+      columnSize = 8;
+      ::copyTo(buffer, value);
+      indicator = 0;
+    } else if constexpr (std::is_same_v<T, SQL_TIMESTAMP_STRUCT>) {
+      // Microsecond precision, i.e. `yyyy-mm-dd hh:mm:ss.ffffff`
+      cType = SQL_C_TYPE_TIMESTAMP;
+      sqlType = SQL_TYPE_TIMESTAMP;
+      columnSize = 26;
+      digits = 6;
+      ::copyTo(buffer, value);
+      indicator = 0;
+    }
+  }, parameter);
+
+  statement.Check(
+    SQLBindParameter(
+      statement.Get(), index, SQL_PARAM_INPUT, cType, sqlType, columnSize, digits,
+      buffer.data(), static_cast<SQLLEN>(buffer.size()), &indicator
+    ),
+    "Failed to bind parameter"
+  );
+}
+
+// Bound type(s) of the parameter(s), i.e. one character per parameter; long value(s) are bound as `LONGVAR` type(s)
+std::string getSignature(const std::vector<saildb::Parameter>& parameters) {
+  std::string result;
+  result.reserve(parameters.size());
+
+  for (const saildb::Parameter& parameter : parameters) {
+    bool isLong = false;
+    if (const auto* text = std::get_if<std::string>(&parameter)) {
+      isLong = text->size() > 4000;
+    } else if (const auto* bytes = std::get_if<std::vector<uint8_t>>(&parameter)) {
+      isLong = bytes->size() > 8000;
+    }
+
+    result.push_back(static_cast<char>((isLong ? 'A' : 'a') + parameter.index()));
+  }
+
+  return result;
+}
+
+// Unambiguous encoding of the parameter value(s), e.g. as part of a `ResultCache` key
+std::string encodeParameters(const std::vector<saildb::Parameter>& parameters) {
+  std::string result;
+  for (const saildb::Parameter& parameter : parameters) {
+    result.push_back(static_cast<char>(parameter.index()));
+
+    std::visit([&result](const auto& value) {
+      using T = std::decay_t<decltype(value)>;
+      if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::vector<uint8_t>>) {
+        const uint64_t size = value.size();
+        result.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        result.append(reinterpret_cast<const char*>(value.data()), value.size());
+      } else if constexpr (!std::is_same_v<T, std::monostate>) {
+        // Fixed size & unpadded, incl. the `SQL_*_STRUCT` type(s)
+        result.append(reinterpret_cast<const char*>(&value), sizeof(value));
+      }
+    }, parameter);
+  }
+
+  return result;
+}
+
+saildb::ParameterStatus toParameterStatus(SQLUSMALLINT status) {
+  switch (status) {
+    case SQL_PARAM_SUCCESS:              return saildb::ParameterStatus::Success;
+    case SQL_PARAM_SUCCESS_WITH_INFO:    return saildb::ParameterStatus::SuccessWithInfo;
+    case SQL_PARAM_UNUSED:               return saildb::ParameterStatus::Unused;
+    default:                             return saildb::ParameterStatus::Error;
+  }
+}
+
+// Sums the row count(s) of each result; driver(s) may report one per parameter set
+int64_t countRows(const saildb::odbc::StatementHandle& statement) {
+  int64_t result = 0;
+
+  SQLRETURN rc;
+  do {
+    SQLLEN rowCount = 0;
+    if (SQL_SUCCEEDED(SQLRowCount(statement.Get(), &rowCount)) && rowCount > 0) {
+      result += rowCount;
+    }
+
+    rc = SQLMoreResults(statement.Get());
+  } while (SQL_SUCCEEDED(rc));
+
+  return result;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Cursor                          *
+ *                                                          *
+ ************************************************************/
+
+/* Ctor & Dtor */
+Cursor::Cursor(std::shared_ptr<saildb::Connection> connection, saildb::CursorOptions options)
+  : m_connection(std::move(connection)), m_options(std::move(options))
+{
+  m_options.arraySize = std::max<size_t>(m_options.arraySize, 1);
+}
+
+Cursor::~Cursor() {
+  closeResult();
+}
+
+
+/* Public impl. */
+void Cursor::Execute(std::string_view query, const std::vector<saildb::Parameter>& parameters /*= {}*/) {
+  ensureOpen();
+  closeResult();
+  m_rowStatus.clear();
+
+  // Held by value, as the connection's own reference is released once closed
+  const std::shared_ptr<saildb::PooledConnection> lease = m_connection->GetLease();
+  StatementCache& cache = lease->GetStatementCache();
+
+  const std::shared_ptr<ResultCache> results = m_options.useResultCache ? m_connection->GetResultCache() : nullptr;
+
+  std::string resultKey;
+  if (results) {
+    resultKey = results->GetKey(lease->GetConnectionString(), query, ::encodeParameters(parameters));
+    if (auto reader = results->Get(resultKey)) {
+      m_schema = reader->schema();
+      m_reader = std::move(reader);
+      return;
+    }
+  }
+
+  std::string key = StatementCache::GetKey(query, ::getSignature(parameters));
+  PreparedStatement prepared = cache.Prepare(m_connection->GetHandle(), query, key);
+  const odbc::StatementHandle& statement = prepared.statement;
+
+  std::vector<std::vector<uint8_t>> buffers(parameters.size());
+  std::vector<SQLLEN> indicators(parameters.size());
+  for (size_t i = 0; i < parameters.size(); ++i) {
+    ::bindParameter(statement, static_cast<SQLUSMALLINT>(i + 1), parameters[i], buffers[i], indicators[i]);
+  }
+
+  const SQLRETURN rc = SQLExecute(statement.Get());
+  if (rc != SQL_NO_DATA) {
+    statement.Check(rc, "Failed to execute query");
+  }
+
+  // Parameter buffer(s) are released once executed
+  SQLFreeStmt(statement.Get(), SQL_RESET_PARAMS);
+
+  SQLSMALLINT columnCount = 0;
+  statement.Check(SQLNumResultCols(statement.Get(), &columnCount), "Failed to describe result set");
+  if (columnCount < 1) {
+    SQLLEN rowCount = 0;
+    if (rc != SQL_NO_DATA) {
+      statement.Check(SQLRowCount(statement.Get(), &rowCount), "Failed to get row count");
+    }
+
+    m_rowCount = rowCount;
+    cache.Put(std::move(key), std::move(prepared));
+    return;
+  }
+
+  ReaderOptions options = m_options.reader;
+  options.batchSize = std::max<int64_t>(options.batchSize, static_cast<int64_t>(m_options.arraySize));
+
+  std::shared_ptr<arrow::RecordBatchReader> reader = ResultReader::Create(lease, std::move(key), std::move(prepared), std::move(options));
+  m_schema = reader->schema();
+
+  // Written by the producer, if prefetched
+  if (results) {
+    reader = results->Put(resultKey, std::move(reader));
+  }
+
+  if (m_options.reader.memoryBudget > 0) {
+    m_reader = SpillReader::Create(std::move(reader), m_options.reader.memoryBudget, m_options.reader.spillDirectory);
+  } else if (m_options.prefetchDepth > 0) {
+    m_reader = PrefetchReader::Create(std::move(reader), m_options.prefetchDepth);
+  } else {
+    m_reader = std::move(reader);
+  }
+}
+
+void Cursor::ExecuteMany(std::string_view query, arrow::RecordBatchReader& parameters, const saildb::BulkOptions& options /*= BulkOptions()*/) {
+  ensureOpen();
+  closeResult();
+  m_rowStatus.clear();
+
+  const std::shared_ptr<arrow::Schema> schema = parameters.schema();
+
+  std::vector<ParameterArray> arrays;
+  arrays.reserve(schema->num_fields());
+  for (const auto& field : schema->fields()) {
+    arrays.emplace_back(field->type());
+  }
+
+  // Keyed apart from `Execute`, whose statement(s) have no parameter array attribute(s)
+  std::string signature("*");
+  for (const auto& field : schema->fields()) {
+    signature.append(field->type()->ToString()).push_back(',');
+  }
+
+  const std::shared_ptr<saildb::PooledConnection> lease = m_connection->GetLease();
+  StatementCache& cache = lease->GetStatementCache();
+  std::string key = StatementCache::GetKey(query, signature);
+  PreparedStatement prepared = cache.Prepare(m_connection->GetHandle(), query, key);
+  const odbc::StatementHandle& statement = prepared.statement;
+
+  // Not every driver describes its parameter(s), so the count is only checked where it does
+  SQLSMALLINT markerCount = 0;
+  if (SQL_SUCCEEDED(SQLNumParams(statement.Get(), &markerCount)) && markerCount != schema->num_fields()) {
+    throw odbc::Error(
+      "07002",
+      "Expected " + std::to_string(markerCount) + " parameter(s), got " + std::to_string(schema->num_fields()) + " column(s)"
+    );
+  }
+
+  // Driver(s) without parameter array support reduce the set size, i.e. `01S02`, so it's read back
+  SQLULEN batchSize = static_cast<SQLULEN>(std::max<size_t>(options.batchSize, 1));
+  statement.Check(
+    SQLSetStmtAttr(statement.Get(), SQL_ATTR_PARAM_BIND_TYPE, reinterpret_cast<SQLPOINTER>(SQL_PARAM_BIND_BY_COLUMN), 0),
+    "Failed to set parameter binding"
+  );
+  statement.Check(
+    SQLSetStmtAttr(statement.Get(), SQL_ATTR_PARAMSET_SIZE, reinterpret_cast<SQLPOINTER>(batchSize), 0),
+    "Failed to set parameter set size"
+  );
+  statement.Check(
+    SQLGetStmtAttr(statement.Get(), SQL_ATTR_PARAMSET_SIZE, &batchSize, 0, nullptr),
+    "Failed to get parameter set size"
+  );
+  batchSize = std::max<SQLULEN>(batchSize, 1);
+
+  std::vector<SQLUSMALLINT> statuses(batchSize);
+  SQLULEN processed = 0;
+  statement.Check(SQLSetStmtAttr(statement.Get(), SQL_ATTR_PARAM_STATUS_PTR, statuses.data(), 0), "Failed to set parameter status array");
+  statement.Check(SQLSetStmtAttr(statement.Get(), SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0), "Failed to set parameters processed");
+
+  int64_t rowCount = 0;
+  SQLULEN setSize = batchSize;
+  std::shared_ptr<arrow::RecordBatch> batch;
+  while (true) {
+    const arrow::Status status = parameters.ReadNext(&batch);
+    if (!status.ok()) {
+      throw odbc::Error("HY000", status.message());
+    }
+
+    if (!batch) {
+      break;
+    }
+
+    int64_t length = 0;
+    for (int64_t offset = 0; offset < batch->num_rows(); offset += length) {
+      length = std::min<int64_t>(static_cast<int64_t>(batchSize), batch->num_rows() - offset);
+
+      // Only the final set of each batch may be partial
+      if (static_cast<SQLULEN>(length) != setSize) {
+        setSize = static_cast<SQLULEN>(length);
+        statement.Check(
+          SQLSetStmtAttr(statement.Get(), SQL_ATTR_PARAMSET_SIZE, reinterpret_cast<SQLPOINTER>(setSize), 0),
+          "Failed to set parameter set size"
+        );
+      }
+
+      for (int i = 0; i < batch->num_columns(); ++i) {
+        arrays[i].Bind(statement, static_cast<SQLUSMALLINT>(i + 1), *batch->column(i), offset, length);
+      }
+
+      processed = 0;
+      std::fill(statuses.begin(), statuses.begin() + length, static_cast<SQLUSMALLINT>(SQL_PARAM_UNUSED));
+
+      const SQLRETURN rc = SQLExecute(statement.Get());
+      const bool isFailed = !SQL_SUCCEEDED(rc) && rc != SQL_NO_DATA;
+
+      const size_t base = m_rowStatus.size();
+      for (int64_t i = 0; i < length; ++i) {
+        // Driver(s) may fail the set as a whole, without reporting a status per row
+        m_rowStatus.push_back(isFailed && processed == 0 ? ParameterStatus::Error : ::toParameterStatus(statuses[i]));
+      }
+
+      const auto failure = std::find(m_rowStatus.begin() + base, m_rowStatus.end(), ParameterStatus::Error);
+      if (failure != m_rowStatus.end() && options.stopOnError) {
+        std::string state("HY000");
+        const std::string diagnostics = odbc::getDiagnostics(SQL_HANDLE_STMT, statement.Get(), &state);
+
+        SQLFreeStmt(statement.Get(), SQL_RESET_PARAMS);
+        m_rowCount = rowCount;
+        throw odbc::Error(
+          std::move(state),
+          "Failed to execute row " + std::to_string(failure - m_rowStatus.begin()) + ", got err: " + diagnostics
+        );
+      }
+
+      if (!isFailed) {
+        rowCount += ::countRows(statement);
+      }
+
+      if (options.commitPerBatch) {
+        m_connection->Commit();
+      }
+    }
+  }
+
+  SQLFreeStmt(statement.Get(), SQL_RESET_PARAMS);
+  m_rowCount = rowCount;
+
+  // The status array(s) are released with this frame
+  SQLSetStmtAttr(statement.Get(), SQL_ATTR_PARAM_STATUS_PTR, nullptr, 0);
+  SQLSetStmtAttr(statement.Get(), SQL_ATTR_PARAMS_PROCESSED_PTR, nullptr, 0);
+  cache.Put(std::move(key), std::move(prepared));
+}
+
+std::shared_ptr<arrow::RecordBatch> Cursor::Fetch(int64_t maxRows) {
+  ensureOpen();
+  if (!m_schema) {
+    throw odbc::Error("24000", "Previous statement didn't produce a result set");
+  }
+
+  while (m_reader) {
+    if (m_batch && m_offset < m_batch->num_rows()) {
+      const int64_t length = std::min<int64_t>(std::max<int64_t>(maxRows, 1), m_batch->num_rows() - m_offset);
+      auto slice = m_batch->Slice(m_offset, length);
+      m_offset += length;
+
+      return slice;
+    }
+
+    m_batch = nullptr;
+    m_offset = 0;
+
+    const arrow::Status status = m_reader->ReadNext(&m_batch);
+    if (!status.ok()) {
+      m_reader = nullptr;
+      throw odbc::Error("HY000", status.message());
+    }
+
+    // Exhausted; the result's reference to the connection is dropped with it
+    if (!m_batch) {
+      m_reader = nullptr;
+    }
+  }
+
+  return nullptr;
+}
+
+std::shared_ptr<arrow::Schema> Cursor::GetSchema() const {
+  return m_schema;
+}
+
+int64_t Cursor::GetRowCount() const {
+  return m_rowCount;
+}
+
+const std::vector<saildb::ParameterStatus>& Cursor::GetRowStatus() const {
+  return m_rowStatus;
+}
+
+size_t Cursor::GetArraySize() const {
+  return m_options.arraySize;
+}
+
+void Cursor::SetArraySize(size_t arraySize) {
+  m_options.arraySize = std::max<size_t>(arraySize, 1);
+}
+
+void Cursor::Close() {
+  closeResult();
+  m_isClosed = true;
+}
+
+bool Cursor::IsClosed() const {
+  return m_isClosed;
+}
+
+const std::shared_ptr<saildb::Connection>& Cursor::GetConnection() const {
+  return m_connection;
+}
+
+
+/* Private impl. */
+void Cursor::ensureOpen() const {
+  if (m_isClosed) {
+    throw odbc::Error("HY010", "Cursor is closed");
+  }
+}
+
+void Cursor::closeResult() {
+  if (m_reader) {
+    (void)m_reader->Close();
+    m_reader = nullptr;
+  }
+
+  m_schema = nullptr;
+  m_batch = nullptr;
+  m_offset = 0;
+  m_rowCount = -1;
+}
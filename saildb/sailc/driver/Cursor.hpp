@@ -0,0 +1,113 @@
+#pragma once
+
+#include <arrow/api.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+
+#include "sailc/driver/Odbc.hpp"
+#include "sailc/driver/ResultReader.hpp"
+#include "sailc/driver/PrefetchReader.hpp"
+#include "sailc/driver/ParameterArray.hpp"
+
+namespace saildb {
+
+class Connection;
+
+// Statement parameter; text is UTF-8, bound as `SQL_C_WCHAR`
+using Parameter = std::variant<
+  std::monostate,
+  bool,
+  int64_t,
+  double,
+  std::string,
+  std::vector<uint8_t>,
+  SQL_DATE_STRUCT,
+  SQL_TIME_STRUCT,
+  SQL_TIMESTAMP_STRUCT
+>;
+
+struct CursorOptions {
+  size_t arraySize{1};                                  // Default row count of `fetchmany`, i.e. DB-API `arraysize`
+  size_t prefetchDepth{2};                              // Batch(es) fetched ahead of the consumer, or zero to read on the caller's thread
+  bool useResultCache{false};                           // Serve result set(s) from the connection's `ResultCache`, if any, without touching the server
+  ReaderOptions reader;                                 // Batch(es) are at least `arraySize` row(s)
+};
+
+struct BulkOptions {
+  size_t batchSize{1024};                               // Row(s) bound per round trip, i.e. `SQL_ATTR_PARAMSET_SIZE`
+  bool commitPerBatch{false};                           // Commit each batch once executed, otherwise the connection's transaction spans every batch
+  bool stopOnError{true};                               // Throw on the first failed batch, otherwise continue & report the failure(s) by row status
+};
+
+// Outcome of a single row of an array-bound execution, i.e. `SQL_PARAM_*`
+enum class ParameterStatus : uint8_t {
+  Success,
+  SuccessWithInfo,
+  Error,
+  Unused,
+};
+
+/*
+ * DB-API cursor; result set(s) are read ahead by a producer thread, see `PrefetchReader`
+ */
+class Cursor {
+  public:
+    Cursor(std::shared_ptr<Connection> connection, CursorOptions options);
+    ~Cursor();
+
+    Cursor(Cursor const&) = delete;
+    Cursor &operator=(Cursor const&) = delete;
+
+  public:
+    // Closes the current result set, if any, before executing
+    void Execute(std::string_view query, const std::vector<Parameter>& parameters = {});
+
+    // Prepares `query` & executes it once per row of `parameters`, whose column(s) are bound to its marker(s)
+    // in order as parameter array(s); see `GetRowStatus` for the outcome of each row, also if this throws
+    void ExecuteMany(std::string_view query, arrow::RecordBatchReader& parameters, const BulkOptions& options = BulkOptions());
+
+    // Up to `maxRows` row(s) of the current result set as a zero-copy slice, or `nullptr` once exhausted;
+    // fewer row(s) are returned at batch boundaries
+    std::shared_ptr<arrow::RecordBatch> Fetch(int64_t maxRows);
+
+    // `nullptr` unless the last statement produced a result set
+    std::shared_ptr<arrow::Schema> GetSchema() const;
+
+    // Row(s) affected by the last statement, or -1 for result set(s)
+    int64_t GetRowCount() const;
+
+    // Per row outcome of the last `ExecuteMany`
+    const std::vector<ParameterStatus>& GetRowStatus() const;
+
+    size_t GetArraySize() const;
+    void SetArraySize(size_t arraySize);
+
+    void Close();
+    bool IsClosed() const;
+
+    const std::shared_ptr<Connection>& GetConnection() const;
+
+  private:
+    void ensureOpen() const;
+    void closeResult();
+
+  private:
+    std::shared_ptr<Connection> m_connection;
+    CursorOptions m_options;
+    bool m_isClosed{false};
+
+    std::shared_ptr<arrow::RecordBatchReader> m_reader;
+    std::shared_ptr<arrow::Schema> m_schema;
+    std::shared_ptr<arrow::RecordBatch> m_batch;
+    int64_t m_offset{0};
+    int64_t m_rowCount{-1};
+    std::vector<ParameterStatus> m_rowStatus;
+};
+
+} // namespace saildb
@@ -0,0 +1,314 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "sailc/driver/Cursor.hpp"
+#include "sailc/driver/Connection.hpp"
+#include "sailc/driver/TestDatabase.hpp"
+
+using saildb::Cursor;
+using saildb::Connection;
+using saildb::BulkOptions;
+using saildb::PoolOptions;
+using saildb::ConnectionPool;
+using saildb::ParameterArray;
+using saildb::ParameterStatus;
+using saildb::testing::TestDatabase;
+
+namespace {
+
+constexpr int64_t ROW_COUNT = 2500;
+
+// Column(s) of `saildb_params`, each NULL on a row of its own
+const char* const CREATE_TABLE =
+  "CREATE TABLE saildb_params ("
+    "k BIGINT PRIMARY KEY, i BIGINT, d DOUBLE, b BIT, s VARCHAR(32), y VARBINARY(16), dt DATE, ts TIMESTAMP, n DECIMAL(10, 2)"
+  ")";
+
+const char* const INSERT = "INSERT INTO saildb_params VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+bool isNull(int64_t row, int column) {
+  return row % 9 == column;
+}
+
+template <typename Builder, typename Append>
+std::shared_ptr<arrow::Array> build(Builder builder, int column, int64_t count, Append append) {
+  for (int64_t row = 0; row < count; ++row) {
+    EXPECT_TRUE((isNull(row, column) ? builder.AppendNull() : append(builder, row)).ok());
+  }
+
+  std::shared_ptr<arrow::Array> result;
+  EXPECT_TRUE(builder.Finish(&result).ok());
+  return result;
+}
+
+std::string getText(int64_t row) {
+  // Of varying length, with multi-byte & surrogate pair character(s)
+  return "h\xC3\xA9llo-" + std::string(static_cast<size_t>(row % 7), 'x') + (row % 2 == 0 ? "\xF0\x9F\x98\x80" : "") + std::to_string(row);
+}
+
+// Parameter set(s) of `INSERT`, keyed by `k`
+std::shared_ptr<arrow::RecordBatch> makeParameters(int64_t count) {
+  const auto decimalType = arrow::decimal128(10, 2);
+  const auto timestampType = arrow::timestamp(arrow::TimeUnit::MICRO);
+
+  const auto schema = arrow::schema({
+    arrow::field("k", arrow::int64()),
+    arrow::field("i", arrow::int64()),
+    arrow::field("d", arrow::float64()),
+    arrow::field("b", arrow::boolean()),
+    arrow::field("s", arrow::utf8()),
+    arrow::field("y", arrow::binary()),
+    arrow::field("dt", arrow::date32()),
+    arrow::field("ts", timestampType),
+    arrow::field("n", decimalType),
+  });
+
+  return arrow::RecordBatch::Make(schema, count, {
+    build(arrow::Int64Builder(), -1, count, [](auto& builder, int64_t row) { return builder.Append(row); }),
+    build(arrow::Int64Builder(), 1, count, [](auto& builder, int64_t row) { return builder.Append(row * -3'000'000'000); }),
+    build(arrow::DoubleBuilder(), 2, count, [](auto& builder, int64_t row) { return builder.Append(row + 0.25); }),
+    build(arrow::BooleanBuilder(), 3, count, [](auto& builder, int64_t row) { return builder.Append(row % 3 == 0); }),
+    build(arrow::StringBuilder(), 4, count, [](auto& builder, int64_t row) { return builder.Append(getText(row)); }),
+    build(arrow::BinaryBuilder(), 5, count, [](auto& builder, int64_t row) {
+      const std::string bytes{'\0', static_cast<char>(row % 256), '\xFF'};
+      return builder.Append(bytes.substr(0, static_cast<size_t>(1 + row % 3)));
+    }),
+    build(arrow::Date32Builder(), 6, count, [](auto& builder, int64_t row) { return builder.Append(static_cast<int32_t>(19'000 + row)); }),
+    build(arrow::TimestampBuilder(timestampType, arrow::default_memory_pool()), 7, count, [](auto& builder, int64_t row) {
+      return builder.Append(1'700'000'000'000'000 + row * 1'000'001);
+    }),
+    build(arrow::Decimal128Builder(decimalType), 8, count, [](auto& builder, int64_t row) {
+      return builder.Append(arrow::Decimal128(row * 101 - 5000));
+    }),
+  });
+}
+
+class CursorTest : public ::testing::Test {
+  protected:
+    CursorTest()
+      : m_database(::testing::UnitTest::GetInstance()->current_test_info()->name()) { };
+
+    void SetUp() override {
+      std::string errorMessage;
+      m_pool = m_database.TryCreatePool(PoolOptions(), errorMessage);
+      if (!m_pool) {
+        GTEST_SKIP() << errorMessage;
+      }
+
+      // A single transaction, rolled back once closed
+      m_connection = Connection::Create(m_pool->Acquire());
+      m_cursor = m_connection->CreateCursor();
+      m_cursor->Execute(CREATE_TABLE);
+    }
+
+    void TearDown() override {
+      if (m_connection) {
+        m_connection->Close();
+      }
+    }
+
+    // Every row of `saildb_params` in key order, in a single batch
+    std::shared_ptr<arrow::RecordBatch> readBack() {
+      m_cursor->Execute("SELECT k, i, d, b, s, y, dt, ts, n FROM saildb_params ORDER BY k");
+
+      arrow::RecordBatchVector batches;
+      while (auto batch = m_cursor->Fetch(ROW_COUNT)) {
+        batches.push_back(std::move(batch));
+      }
+
+      auto table = arrow::Table::FromRecordBatches(m_cursor->GetSchema(), batches).ValueOrDie();
+      return table->CombineChunksToBatch().ValueOrDie();
+    }
+
+    static std::shared_ptr<arrow::RecordBatchReader> makeReader(arrow::RecordBatchVector batches) {
+      return arrow::RecordBatchReader::Make(std::move(batches)).ValueOrDie();
+    }
+
+  protected:
+    TestDatabase m_database;
+    std::shared_ptr<ConnectionPool> m_pool;
+    std::shared_ptr<Connection> m_connection;
+    std::shared_ptr<Cursor> m_cursor;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                       ExecuteMany                        *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(CursorTest, ExecutesManyOfMixedTypes) {
+  // Offset slice(s), split across batch boundaries, i.e. full & partial parameter set(s) of each batch
+  const auto parameters = makeParameters(ROW_COUNT + 100);
+  auto reader = makeReader({parameters->Slice(0, 1500), parameters->Slice(1500, ROW_COUNT - 1500)});
+
+  BulkOptions options;
+  options.batchSize = 1000;
+  m_cursor->ExecuteMany(INSERT, *reader, options);
+
+  EXPECT_EQ(m_cursor->GetRowCount(), ROW_COUNT);
+  ASSERT_EQ(m_cursor->GetRowStatus().size(), static_cast<size_t>(ROW_COUNT));
+  for (ParameterStatus status : m_cursor->GetRowStatus()) {
+    ASSERT_EQ(status, ParameterStatus::Success);
+  }
+
+  const auto result = readBack();
+  ASSERT_EQ(result->num_rows(), ROW_COUNT);
+  ASSERT_TRUE(result->ValidateFull().ok());
+
+  const auto& k = static_cast<const arrow::Int64Array&>(*result->column(0));
+  const auto& i = static_cast<const arrow::Int64Array&>(*result->column(1));
+  const auto& d = static_cast<const arrow::DoubleArray&>(*result->column(2));
+  const auto& b = static_cast<const arrow::BooleanArray&>(*result->column(3));
+  const auto& s = static_cast<const arrow::StringArray&>(*result->column(4));
+  const auto& y = static_cast<const arrow::BinaryArray&>(*result->column(5));
+  const auto& dt = static_cast<const arrow::Date32Array&>(*result->column(6));
+  const auto& ts = static_cast<const arrow::TimestampArray&>(*result->column(7));
+  const auto& n = static_cast<const arrow::DoubleArray&>(*result->column(8));
+
+  const auto& expectedBinary = static_cast<const arrow::BinaryArray&>(*parameters->column(5));
+  for (int64_t row = 0; row < ROW_COUNT; ++row) {
+    SCOPED_TRACE("row " + std::to_string(row));
+    ASSERT_EQ(k.Value(row), row);
+
+    for (int column = 1; column < 9; ++column) {
+      ASSERT_EQ(result->column(column)->IsNull(row), isNull(row, column)) << result->schema()->field(column)->name();
+    }
+
+    if (!isNull(row, 1)) {
+      EXPECT_EQ(i.Value(row), row * -3'000'000'000);
+    }
+    if (!isNull(row, 2)) {
+      EXPECT_EQ(d.Value(row), row + 0.25);
+    }
+    if (!isNull(row, 3)) {
+      EXPECT_EQ(b.Value(row), row % 3 == 0);
+    }
+    if (!isNull(row, 4)) {
+      EXPECT_EQ(s.GetString(row), getText(row));
+    }
+    if (!isNull(row, 5)) {
+      EXPECT_EQ(y.GetView(row), expectedBinary.GetView(row));
+    }
+    if (!isNull(row, 6)) {
+      EXPECT_EQ(dt.Value(row), 19'000 + row);
+    }
+    if (!isNull(row, 7)) {
+      EXPECT_EQ(ts.Value(row), 1'700'000'000'000'000 + row * 1'000'001);
+    }
+    if (!isNull(row, 8)) {
+      EXPECT_DOUBLE_EQ(n.Value(row), (row * 101 - 5000) / 100.0);
+    }
+  }
+}
+
+TEST_F(CursorTest, ExecutesManyOfNullColumn) {
+  auto ids = makeParameters(3)->column(0);
+  auto nulls = std::make_shared<arrow::NullArray>(3);
+  auto batch = arrow::RecordBatch::Make(
+    arrow::schema({arrow::field("k", arrow::int64()), arrow::field("s", arrow::null())}), 3, {ids, nulls}
+  );
+  auto reader = makeReader({batch});
+
+  m_cursor->ExecuteMany("INSERT INTO saildb_params (k, s) VALUES (?, ?)", *reader);
+  EXPECT_EQ(m_cursor->GetRowCount(), 3);
+
+  const auto result = readBack();
+  ASSERT_EQ(result->num_rows(), 3);
+  EXPECT_EQ(result->column(4)->null_count(), 3);
+}
+
+TEST_F(CursorTest, ExecutesManyOfNoRows) {
+  auto reader = makeReader({makeParameters(0)});
+
+  m_cursor->ExecuteMany(INSERT, *reader);
+  EXPECT_EQ(m_cursor->GetRowCount(), 0);
+  EXPECT_TRUE(m_cursor->GetRowStatus().empty());
+}
+
+TEST_F(CursorTest, ReusesPreparedStatementAcrossCalls) {
+  const auto parameters = makeParameters(20);
+  const auto& cache = m_connection->GetLease()->GetStatementCache();
+
+  auto reader = makeReader({parameters->Slice(0, 10)});
+  m_cursor->ExecuteMany(INSERT, *reader);
+  const uint64_t misses = cache.GetMisses();
+
+  reader = makeReader({parameters->Slice(10, 10)});
+  m_cursor->ExecuteMany(INSERT, *reader);
+  EXPECT_EQ(cache.GetMisses(), misses);
+  EXPECT_EQ(readBack()->num_rows(), 20);
+}
+
+TEST_F(CursorTest, StopsOnFailedRow) {
+  const auto parameters = makeParameters(ROW_COUNT);
+
+  // Key 1500 already exists, so the second set fails
+  auto reader = makeReader({parameters->Slice(1500, 1)});
+  m_cursor->ExecuteMany(INSERT, *reader);
+
+  reader = makeReader({parameters});
+  BulkOptions options;
+  options.batchSize = 1000;
+  EXPECT_THROW(m_cursor->ExecuteMany(INSERT, *reader, options), saildb::odbc::Error);
+
+  // Reported up to the failed set; driver(s) may fail the set as a whole
+  const auto& status = m_cursor->GetRowStatus();
+  ASSERT_EQ(status.size(), 2000u);
+  for (size_t row = 0; row < 1000; ++row) {
+    ASSERT_EQ(status[row], ParameterStatus::Success);
+  }
+  EXPECT_EQ(status[1500], ParameterStatus::Error);
+  EXPECT_EQ(m_cursor->GetRowCount(), 1000);
+}
+
+TEST_F(CursorTest, RejectsMismatchedParameterCount) {
+  auto reader = makeReader({makeParameters(3)});
+
+  try {
+    m_cursor->ExecuteMany("INSERT INTO saildb_params (k, i) VALUES (?, ?)", *reader);
+    FAIL() << "Expected an odbc::Error";
+  } catch (const saildb::odbc::Error& error) {
+    EXPECT_EQ(error.GetState(), "07002");
+  }
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                      ParameterArray                      *
+ *                                                          *
+ ************************************************************/
+
+TEST(ParameterArrayTest, RejectsUnsupportedType) {
+  try {
+    ParameterArray array(arrow::list(arrow::int32()));
+    FAIL() << "Expected an odbc::Error";
+  } catch (const saildb::odbc::Error& error) {
+    EXPECT_EQ(error.GetState(), "HYC00");
+  }
+}
+
+TEST(ParameterArrayTest, AcceptsBindableTypes) {
+  for (const auto& type : {
+    arrow::null(), arrow::boolean(), arrow::int8(), arrow::uint8(), arrow::int16(), arrow::uint16(), arrow::int32(),
+    arrow::uint32(), arrow::int64(), arrow::uint64(), arrow::float32(), arrow::float64(), arrow::date32(), arrow::date64(),
+    arrow::time32(arrow::TimeUnit::SECOND), arrow::time64(arrow::TimeUnit::NANO), arrow::timestamp(arrow::TimeUnit::NANO),
+    arrow::decimal128(38, 10), arrow::decimal256(76, 0), arrow::utf8(), arrow::large_utf8(), arrow::binary(),
+    arrow::large_binary(), arrow::fixed_size_binary(16),
+  }) {
+    EXPECT_NO_THROW(ParameterArray{type}) << type->ToString();
+  }
+}
@@ -3,22 +3,159 @@
 #include <nanodbc/nanodbc.h>
 #include <nlohmann/json.hpp>
 
+#include <mutex>
+#include <stdexcept>
+
 #include "sailc/wapi/wapi.hpp"
+#include "sailc/driver/Odbc.hpp"
+#include "sailc/driver/SpillReader.hpp"
 #include "sailc/common/cstring.hpp"
 
 namespace wapi = saildb::wapi;
+namespace odbc = saildb::odbc;
 namespace common = saildb::common;
 
-saildb::Environment::Environment(std::string& pkgname, common::Session& usesh)
-  : m_serviceName(std::move(pkgname)), m_session(std::move(usesh)) { };
+saildb::Environment::Environment(std::string& pkgname, common::Session& usesh, saildb::PoolOptions& poolOptions)
+  : m_serviceName(std::move(pkgname)), m_session(std::move(usesh)), m_poolOptions(std::move(poolOptions)),
+    m_executor(std::make_shared<saildb::Executor>(m_poolOptions.maxSize)) { };
 
 saildb::Environment::~Environment() = default;
 
-std::shared_ptr<saildb::Environment> saildb::Environment::Create(std::string pkgname) {
+std::shared_ptr<saildb::Environment> saildb::Environment::Create(std::string pkgname, saildb::PoolOptions poolOptions /*= PoolOptions()*/) {
   common::Session usesh;
 
-  // TODO
-  // -> Derive session from WAPI
+  std::string errorMessage;
+  if (!wapi::tryGetSessionInfo(usesh, errorMessage)) {
+    throw std::runtime_error(std::string("Failed to derive session, got err: ").append(errorMessage));
+  }
+
+  return std::shared_ptr<saildb::Environment>(new saildb::Environment(pkgname, usesh, poolOptions));
+}
+
+const std::string& saildb::Environment::GetServiceName() const {
+  return m_serviceName;
+}
+
+const common::Session& saildb::Environment::GetSession() const {
+  return m_session;
+}
+
+const saildb::PoolOptions& saildb::Environment::GetPoolOptions() const {
+  return m_poolOptions;
+}
+
+const std::shared_ptr<saildb::Executor>& saildb::Environment::GetExecutor() const {
+  return m_executor;
+}
+
+std::shared_ptr<saildb::ConnectionPool> saildb::Environment::GetPool(const std::string& connectionString) {
+  {
+    std::shared_lock<std::shared_mutex> lock(m_poolLock);
+    if (auto it = m_pools.find(connectionString); it != m_pools.end()) {
+      return it->second;
+    }
+  }
+
+  std::unique_lock<std::shared_mutex> lock(m_poolLock);
+  if (auto it = m_pools.find(connectionString); it != m_pools.end()) {
+    return it->second;
+  }
+
+  auto pool = saildb::ConnectionPool::Create(connectionString, m_poolOptions);
+  m_pools.emplace(connectionString, pool);
+
+  return pool;
+}
+
+saildb::PooledConnection saildb::Environment::Acquire(const std::string& connectionString) {
+  return GetPool(connectionString)->Acquire();
+}
+
+saildb::PooledConnection saildb::Environment::Acquire(std::string_view dsn, std::string_view username, std::string_view password) {
+  return GetPool(odbc::makeConnectionString(dsn, username, password))->Acquire();
+}
+
+void saildb::Environment::EnableResultCache(saildb::ResultCacheOptions options) {
+  std::string account = m_session.domainName.empty() ? m_session.username : m_session.domainName + "\\" + m_session.username;
+  auto results = saildb::ResultCache::Create(std::move(options), std::move(account));
+
+  std::lock_guard<std::mutex> lock(m_resultLock);
+  m_results = std::move(results);
+}
+
+void saildb::Environment::DisableResultCache() {
+  std::lock_guard<std::mutex> lock(m_resultLock);
+  m_results = nullptr;
+}
+
+std::shared_ptr<saildb::ResultCache> saildb::Environment::GetResultCache() const {
+  std::lock_guard<std::mutex> lock(m_resultLock);
+  return m_results;
+}
+
+std::shared_ptr<saildb::Connection> saildb::Environment::Connect(const std::string& connectionString, bool autocommit /*= false*/) {
+  return saildb::Connection::Create(Acquire(connectionString), autocommit, m_executor, GetResultCache());
+}
+
+std::shared_ptr<arrow::RecordBatchReader> saildb::Environment::Read(
+  const std::string& connectionString,
+  std::string_view query,
+  saildb::ReaderOptions options /*= ReaderOptions()*/,
+  bool useResultCache /*= false*/
+) {
+  const int64_t memoryBudget = options.memoryBudget;
+  const std::filesystem::path spillDirectory = options.spillDirectory;
+
+  const std::shared_ptr<saildb::ResultCache> results = useResultCache ? GetResultCache() : nullptr;
+
+  std::string key;
+  if (results) {
+    key = results->GetKey(connectionString, query);
+    if (auto reader = results->Get(key)) {
+      return reader;
+    }
+  }
+
+  std::shared_ptr<arrow::RecordBatchReader> reader = saildb::ResultReader::Create(Acquire(connectionString), query, std::move(options));
+  if (results) {
+    reader = results->Put(key, std::move(reader));
+  }
+
+  if (memoryBudget > 0) {
+    reader = saildb::SpillReader::Create(std::move(reader), memoryBudget, spillDirectory);
+  }
+
+  return reader;
+}
+
+std::shared_ptr<arrow::RecordBatchReader> saildb::Environment::ReadPartitioned(
+  const std::string& connectionString,
+  std::string_view query,
+  PartitionOptions options
+) {
+  const int64_t memoryBudget = options.reader.memoryBudget;
+  const std::filesystem::path spillDirectory = options.reader.spillDirectory;
+
+  std::shared_ptr<arrow::RecordBatchReader> reader = saildb::PartitionedReader::Create(GetPool(connectionString), query, std::move(options));
+  if (memoryBudget > 0) {
+    reader = saildb::SpillReader::Create(std::move(reader), memoryBudget, spillDirectory);
+  }
+
+  return reader;
+}
+
+void saildb::Environment::EvictIdle() {
+  std::shared_lock<std::shared_mutex> lock(m_poolLock);
+  for (auto& [_, pool] : m_pools) {
+    pool->EvictIdle();
+  }
+}
+
+void saildb::Environment::Clear() {
+  std::unique_lock<std::shared_mutex> lock(m_poolLock);
+  for (auto& [_, pool] : m_pools) {
+    pool->Clear();
+  }
 
-  return std::shared_ptr<saildb::Environment>(new saildb::Environment(pkgname, usesh));
+  m_pools.clear();
 }
@@ -1,29 +1,102 @@
 #pragma once
 
 #include "sailc/common/data.hpp"
+#include "sailc/driver/Executor.hpp"
+#include "sailc/driver/ResultCache.hpp"
+#include "sailc/driver/ResultReader.hpp"
+#include "sailc/driver/Connection.hpp"
+#include "sailc/driver/ConnectionPool.hpp"
+#include "sailc/driver/PartitionedReader.hpp"
 
 #include <list>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <memory>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
 
 namespace common = saildb::common;
 
 namespace saildb {
 
-// TODO
+/*
+ * Process-wide driver state, i.e. the user's session & the connection pool(s)
+ *
+ *  - Pool(s) are partitioned by connection string, so each DSN & credential pair
+ *    is pooled separately
+ *  - Asynchronous operation(s) share a single `Executor` of up to `maxSize` worker(s)
+ *  - Result(s) are only cached once `EnableResultCache` is called, & only for read(s) that opt in
+ *
+ */
 class Environment : public std::enable_shared_from_this<Environment> {
   public:
-    static std::shared_ptr<Environment> Create(std::string pkgname);
+    static std::shared_ptr<Environment> Create(std::string pkgname, PoolOptions poolOptions = PoolOptions());
 
   public:
     Environment(Environment const&) = delete;
     Environment &operator=(Environment const&) = delete;
     virtual ~Environment();
 
+  public:
+    const std::string& GetServiceName() const;
+    const common::Session& GetSession() const;
+    const PoolOptions& GetPoolOptions() const;
+
+    // Pool of the given partition, created on first use
+    std::shared_ptr<ConnectionPool> GetPool(const std::string& connectionString);
+
+    PooledConnection Acquire(const std::string& connectionString);
+    PooledConnection Acquire(std::string_view dsn, std::string_view username, std::string_view password);
+
+    // Runs asynchronous operation(s), including those of connection(s) opened by `Connect`
+    const std::shared_ptr<Executor>& GetExecutor() const;
+
+    // Caches result(s) of the session's account under `options.directory`, replacing the current cache, if any;
+    // connection(s) opened beforehand keep the cache they were opened with
+    void EnableResultCache(ResultCacheOptions options);
+    void DisableResultCache();
+
+    // `nullptr` unless enabled
+    std::shared_ptr<ResultCache> GetResultCache() const;
+
+    // DB-API connection over a connection of the given partition
+    std::shared_ptr<Connection> Connect(const std::string& connectionString, bool autocommit = false);
+
+    // Reads the query on a connection of the given partition, served by the result cache if `useResultCache` is set & it's enabled;
+    // read ahead within `options.memoryBudget`, if set
+    std::shared_ptr<arrow::RecordBatchReader> Read(
+      const std::string& connectionString,
+      std::string_view query,
+      ReaderOptions options = ReaderOptions(),
+      bool useResultCache = false
+    );
+
+    // Reads the query's partition(s) concurrently on connection(s) of the given partition, see `PartitionedReader`; the merged
+    // stream is read ahead within `options.reader.memoryBudget`, if set
+    std::shared_ptr<arrow::RecordBatchReader> ReadPartitioned(const std::string& connectionString, std::string_view query, PartitionOptions options);
+
+    // Closes idle connection(s) of every partition, see `ConnectionPool::EvictIdle`
+    void EvictIdle();
+
+    // Closes every idle connection & drops each partition; leased connection(s) are closed on return
+    void Clear();
+
   protected:
-    Environment(std::string& pkgname, common::Session& usesh);
+    Environment(std::string& pkgname, common::Session& usesh, PoolOptions& poolOptions);
+
+  private:
+    std::string m_serviceName;
+    common::Session m_session;
+    PoolOptions m_poolOptions;
+    std::shared_ptr<Executor> m_executor;
+
+    mutable std::mutex m_resultLock;
+    std::shared_ptr<ResultCache> m_results;
 
+    mutable std::shared_mutex m_poolLock;
+    std::unordered_map<std::string, std::shared_ptr<ConnectionPool>> m_pools;
 };
 
 } // namespace saildb
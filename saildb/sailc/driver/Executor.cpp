@@ -0,0 +1,87 @@
+#include "Executor.hpp"
+
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+using Executor = saildb::Executor;
+
+/* Ctor & Dtor */
+Executor::Executor(size_t threadCount)
+  : m_threadCount(std::max<size_t>(threadCount, 1)), m_state(std::make_shared<State>()) { };
+
+Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(m_state->lock);
+    m_state->isStopped = true;
+  }
+
+  m_state->notEmpty.notify_all();
+  for (std::thread& worker : m_workers) {
+    if (worker.get_id() == std::this_thread::get_id()) {
+      worker.detach();
+    } else {
+      worker.join();
+    }
+  }
+}
+
+
+/* Public impl. */
+void Executor::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(m_state->lock);
+    if (m_state->isStopped) {
+      throw std::runtime_error("Failed to submit task, executor is stopping");
+    }
+
+    m_state->tasks.push_back(std::move(task));
+
+    // Idle worker(s) may already have been claimed by queued task(s)
+    if (m_state->idle < m_state->tasks.size() && m_workers.size() < m_threadCount) {
+      m_workers.emplace_back(&Executor::work, m_state);
+      return;
+    }
+  }
+
+  m_state->notEmpty.notify_one();
+}
+
+size_t Executor::GetThreadCount() const {
+  std::lock_guard<std::mutex> lock(m_state->lock);
+  return m_workers.size();
+}
+
+size_t Executor::GetPendingCount() const {
+  std::lock_guard<std::mutex> lock(m_state->lock);
+  return m_state->tasks.size();
+}
+
+
+/* Private impl. */
+void Executor::work(std::shared_ptr<State> state) {
+  std::unique_lock<std::mutex> lock(state->lock);
+  while (true) {
+    ++state->idle;
+    state->notEmpty.wait(lock, [&state]() { return state->isStopped || !state->tasks.empty(); });
+    --state->idle;
+
+    if (state->tasks.empty()) {
+      return;
+    }
+
+    std::function<void()> task = std::move(state->tasks.front());
+    state->tasks.pop_front();
+
+    lock.unlock();
+    try {
+      task();
+    } catch (...) {
+      // Task(s) are expected to report their own error(s)
+    }
+
+    // Released outside of the lock, as its capture(s) may have arbitrary destructor(s), incl. the executor's
+    task = nullptr;
+    lock.lock();
+  }
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+namespace saildb {
+
+/*
+ * Pool of worker thread(s) running submitted task(s) in FIFO order, e.g. asynchronous query execution
+ *
+ *  - Task(s) are expected to block on the network, i.e. checkout, execution & fetch, so the pool is
+ *    bounded by connection count rather than core count
+ *  - Worker(s) are started on demand, once every started worker is busy, up to `threadCount`
+ *  - Task(s) report their own error(s); an exception escaping a task is discarded
+ *  - Destruction runs the remaining task(s) before joining the worker(s); a worker releasing the last
+ *    reference, e.g. through a task's capture(s), is detached rather than joining itself
+ *
+ */
+class Executor {
+  public:
+    explicit Executor(size_t threadCount);
+    ~Executor();
+
+    Executor(Executor const&) = delete;
+    Executor &operator=(Executor const&) = delete;
+
+  public:
+    // Throws once the executor is stopping
+    void Submit(std::function<void()> task);
+
+    size_t GetThreadCount() const;
+    size_t GetPendingCount() const;
+
+  private:
+    // Shared with the worker(s), as a detached worker outlives the executor
+    struct State {
+      std::mutex lock;
+      std::condition_variable notEmpty;
+      std::deque<std::function<void()>> tasks;
+      size_t idle{0};
+      bool isStopped{false};
+    };
+
+    static void work(std::shared_ptr<State> state);
+
+  private:
+    const size_t m_threadCount;
+    const std::shared_ptr<State> m_state;
+
+    // Guarded by the state's lock
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace saildb
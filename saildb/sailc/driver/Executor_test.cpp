@@ -0,0 +1,254 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+#include <condition_variable>
+
+#include "sailc/driver/Executor.hpp"
+
+using saildb::Executor;
+
+namespace {
+
+// Holds each task waiting on it until opened
+class Gate {
+  public:
+    void Wait() {
+      std::unique_lock<std::mutex> lock(m_lock);
+      ++m_waiting;
+      m_changed.notify_all();
+      m_changed.wait(lock, [this]() { return m_isOpen; });
+    }
+
+    void Open() {
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_isOpen = true;
+      }
+      m_changed.notify_all();
+    }
+
+    // Waits for `count` task(s) to be held
+    bool Await(size_t count) {
+      std::unique_lock<std::mutex> lock(m_lock);
+      return m_changed.wait_for(lock, std::chrono::seconds(5), [this, count]() { return m_waiting >= count; });
+    }
+
+  private:
+    std::mutex m_lock;
+    std::condition_variable m_changed;
+    size_t m_waiting{0};
+    bool m_isOpen{false};
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Queueing                         *
+ *                                                          *
+ ************************************************************/
+
+TEST(ExecutorTest, RunsTasksInOrderOfSubmission) {
+  Executor executor(1);
+  Gate gate;
+  executor.Submit([&gate]() { gate.Wait(); });
+  ASSERT_TRUE(gate.Await(1));
+
+  std::mutex lock;
+  std::vector<int> order;
+  std::promise<void> done;
+  for (int i = 0; i < 5; ++i) {
+    executor.Submit([&, i]() {
+      std::lock_guard<std::mutex> guard(lock);
+      order.push_back(i);
+    });
+  }
+  executor.Submit([&done]() { done.set_value(); });
+
+  // Queued behind the busy worker
+  EXPECT_EQ(executor.GetPendingCount(), 6u);
+  EXPECT_EQ(executor.GetThreadCount(), 1u);
+
+  gate.Open();
+  done.get_future().wait();
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(executor.GetPendingCount(), 0u);
+}
+
+TEST(ExecutorTest, StartsWorkersOnDemandUpToThreadCount) {
+  Executor executor(3);
+  EXPECT_EQ(executor.GetThreadCount(), 0u);
+
+  // Each busy worker leads to another, until the bound is reached
+  Gate gate;
+  for (size_t count = 1; count <= 3; ++count) {
+    executor.Submit([&gate]() { gate.Wait(); });
+    ASSERT_TRUE(gate.Await(count));
+    EXPECT_EQ(executor.GetThreadCount(), count);
+  }
+
+  executor.Submit([&gate]() { gate.Wait(); });
+  EXPECT_EQ(executor.GetThreadCount(), 3u);
+  EXPECT_EQ(executor.GetPendingCount(), 1u);
+
+  gate.Open();
+  ASSERT_TRUE(gate.Await(4));
+}
+
+TEST(ExecutorTest, ReusesIdleWorker) {
+  Executor executor(4);
+  for (int i = 0; i < 10; ++i) {
+    std::promise<void> done;
+    executor.Submit([&done]() { done.set_value(); });
+    done.get_future().wait();
+
+    // Given time to wait for the next task
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  EXPECT_EQ(executor.GetThreadCount(), 1u);
+}
+
+TEST(ExecutorTest, ClampsThreadCountToOne) {
+  Executor executor(0);
+
+  std::promise<void> done;
+  executor.Submit([&done]() { done.set_value(); });
+  EXPECT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_EQ(executor.GetThreadCount(), 1u);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Shutdown                         *
+ *                                                          *
+ ************************************************************/
+
+TEST(ExecutorTest, RunsPendingTasksOnDestruction) {
+  auto executor = std::make_unique<Executor>(1);
+  Gate gate;
+  executor->Submit([&gate]() { gate.Wait(); });
+  ASSERT_TRUE(gate.Await(1));
+
+  std::atomic<int> runs{0};
+  for (int i = 0; i < 10; ++i) {
+    executor->Submit([&runs]() { ++runs; });
+  }
+
+  // Joins the worker, which drains the queue first
+  auto destroyed = std::async(std::launch::async, [&executor]() { executor.reset(); });
+  EXPECT_EQ(destroyed.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+  EXPECT_EQ(runs.load(), 0);
+
+  gate.Open();
+  destroyed.get();
+  EXPECT_EQ(runs.load(), 10);
+}
+
+TEST(ExecutorTest, RejectsSubmissionOnceStopping) {
+  auto executor = std::make_unique<Executor>(1);
+  Executor* const raw = executor.get();
+
+  Gate gate;
+  executor->Submit([&gate]() { gate.Wait(); });
+  ASSERT_TRUE(gate.Await(1));
+
+  // A pending task run during destruction can't queue another
+  std::promise<bool> rejected;
+  executor->Submit([raw, &rejected]() {
+    try {
+      raw->Submit([]() { });
+      rejected.set_value(false);
+    } catch (const std::runtime_error&) {
+      rejected.set_value(true);
+    }
+  });
+
+  auto destroyed = std::async(std::launch::async, [&executor]() { executor.reset(); });
+  EXPECT_EQ(destroyed.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  gate.Open();
+  EXPECT_TRUE(rejected.get_future().get());
+  destroyed.get();
+}
+
+TEST(ExecutorTest, DetachesWorkerReleasingLastReference) {
+  auto executor = std::make_shared<Executor>(1);
+  std::promise<void> destroyed;
+
+  // Destroyed by the worker once the task's capture(s) are released
+  struct Owner {
+    std::shared_ptr<Executor> executor;
+    std::promise<void>* destroyed{nullptr};
+
+    ~Owner() {
+      executor.reset();
+      destroyed->set_value();
+    }
+  };
+
+  auto owner = std::make_shared<Owner>();
+  owner->executor = std::move(executor);
+  owner->destroyed = &destroyed;
+
+  std::weak_ptr<Owner> weak = owner;
+  owner->executor->Submit([owner = std::move(owner)]() { });
+  EXPECT_EQ(destroyed.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_TRUE(weak.expired());
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Errors                          *
+ *                                                          *
+ ************************************************************/
+
+TEST(ExecutorTest, PropagatesErrorsThroughTask) {
+  Executor executor(2);
+
+  // Task(s) report their own error(s), e.g. through a future
+  auto failing = std::make_shared<std::packaged_task<int()>>([]() -> int { throw std::invalid_argument("Task failed"); });
+  auto succeeding = std::make_shared<std::packaged_task<int()>>([]() { return 42; });
+  auto failed = failing->get_future();
+  auto succeeded = succeeding->get_future();
+
+  executor.Submit([failing]() { (*failing)(); });
+  executor.Submit([succeeding]() { (*succeeding)(); });
+
+  EXPECT_THROW(
+    {
+      try {
+        failed.get();
+      } catch (const std::invalid_argument& error) {
+        EXPECT_STREQ(error.what(), "Task failed");
+        throw;
+      }
+    },
+    std::invalid_argument
+  );
+  EXPECT_EQ(succeeded.get(), 42);
+}
+
+TEST(ExecutorTest, DiscardsEscapedExceptionAndKeepsWorker) {
+  Executor executor(1);
+  executor.Submit([]() { throw std::runtime_error("Escaped"); });
+  executor.Submit([]() { throw 42; });
+
+  // The same worker runs the next task
+  std::promise<void> done;
+  executor.Submit([&done]() { done.set_value(); });
+  EXPECT_EQ(done.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_EQ(executor.GetThreadCount(), 1u);
+}
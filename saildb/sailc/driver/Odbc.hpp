@@ -0,0 +1,197 @@
+#pragma once
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#endif
+
+#include <sql.h>
+#include <sqlext.h>
+
+#include <nanodbc/nanodbc.h>
+
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+
+#include "sailc/common/utf.hpp"
+
+namespace saildb {
+namespace odbc {
+
+// UTF-8 to nanodbc's native string, i.e. `std::wstring` with MSVC & `std::u16string` elsewhere
+inline auto toNativeString(std::string_view value) -> nanodbc::string {
+  nanodbc::string result;
+  if (!common::tryDecodeUtf8(value, result)) {
+    throw std::range_error("Failed to convert string, found malformed UTF-8");
+  }
+
+  return result;
+}
+
+inline auto fromNativeString(const nanodbc::string& value) -> std::string {
+  std::string result;
+  if (!common::tryEncodeUtf8(value, result)) {
+    throw std::range_error("Failed to convert ODBC string, found malformed UTF-16/32");
+  }
+
+  return result;
+}
+
+// Builds a `DSN=...;UID=...;PWD=...;` connection string, brace-quoting value(s) where required
+inline auto makeConnectionString(std::string_view dsn, std::string_view username, std::string_view password) -> std::string {
+  const auto append = [](std::string& output, std::string_view key, std::string_view value) {
+    if (value.empty()) {
+      return;
+    }
+
+    output.append(key).push_back('=');
+    if (value.find_first_of(";{}") == std::string_view::npos && value.front() != ' ') {
+      output.append(value);
+    } else {
+      output.push_back('{');
+      for (const char ch : value) {
+        output.push_back(ch);
+        if (ch == '}') {
+          output.push_back('}');
+        }
+      }
+      output.push_back('}');
+    }
+    output.push_back(';');
+  };
+
+  std::string result;
+  append(result, "DSN", dsn);
+  append(result, "UID", username);
+  append(result, "PWD", password);
+
+  return result;
+}
+
+/*
+ * ODBC failure, carrying the SQLSTATE of the first diagnostic record, e.g. `08001`
+ */
+class Error : public std::runtime_error {
+  public:
+    Error(std::string state, const std::string& message)
+      : std::runtime_error(message), m_state(std::move(state)) { };
+
+  public:
+    const std::string& GetState() const { return m_state; }
+
+  private:
+    std::string m_state;
+};
+
+// Concatenates the diagnostic record(s) of `handle`, optionally returning the SQLSTATE of the first
+inline auto getDiagnostics(SQLSMALLINT handleType, SQLHANDLE handle, std::string* state = nullptr) -> std::string {
+  std::string result;
+
+  SQLCHAR code[6];
+  SQLCHAR message[SQL_MAX_MESSAGE_LENGTH];
+  SQLINTEGER nativeError;
+  SQLSMALLINT length;
+  for (SQLSMALLINT i = 1; ; ++i) {
+    const SQLRETURN rc = SQLGetDiagRecA(handleType, handle, i, code, &nativeError, message, sizeof(message), &length);
+    if (!SQL_SUCCEEDED(rc)) {
+      break;
+    }
+
+    if (i == 1 && state != nullptr) {
+      state->assign(reinterpret_cast<const char*>(code), 5);
+    }
+
+    if (!result.empty()) {
+      result.append("; ");
+    }
+
+    result.append(reinterpret_cast<const char*>(code), 5)
+      .append(": ")
+      .append(reinterpret_cast<const char*>(message), std::min<size_t>(length, sizeof(message) - 1));
+  }
+
+  return result.empty() ? std::string("Unknown ODBC error") : result;
+}
+
+// Throws with the diagnostic record(s) of `handle` unless `rc` succeeded
+inline void check(SQLRETURN rc, SQLSMALLINT handleType, SQLHANDLE handle, std::string_view context) {
+  if (!SQL_SUCCEEDED(rc)) {
+    std::string state("HY000");
+    const std::string diagnostics = getDiagnostics(handleType, handle, &state);
+    throw Error(std::move(state), std::string(context).append(", got err: ").append(diagnostics));
+  }
+}
+
+// `SQLWCHAR` is UTF-16 with both the Windows driver manager & unixODBC, but UTF-32 with iODBC
+inline auto toSqlWide(const nanodbc::string& value) -> const SQLWCHAR* {
+  static_assert(sizeof(nanodbc::string::value_type) == sizeof(SQLWCHAR), "Expected nanodbc's string to match SQLWCHAR");
+  return reinterpret_cast<const SQLWCHAR*>(value.c_str());
+}
+
+inline bool tryEncodeSqlWide(const SQLWCHAR* data, size_t length, std::string& output) {
+  if constexpr (sizeof(SQLWCHAR) == sizeof(char16_t)) {
+    return common::tryEncodeUtf8(std::u16string_view(reinterpret_cast<const char16_t*>(data), length), output);
+  } else {
+    return common::tryEncodeUtf8(std::u32string_view(reinterpret_cast<const char32_t*>(data), length), output);
+  }
+}
+
+/*
+ * Owned statement handle, allocated on a connection & freed on destruction
+ */
+class StatementHandle {
+  public:
+    StatementHandle() = default;
+
+    explicit StatementHandle(SQLHDBC connection) {
+      SQLHSTMT handle = SQL_NULL_HSTMT;
+      check(SQLAllocHandle(SQL_HANDLE_STMT, connection, &handle), SQL_HANDLE_DBC, connection, "Failed to allocate statement");
+      m_handle = handle;
+    }
+
+    ~StatementHandle() {
+      if (m_handle != SQL_NULL_HSTMT) {
+        SQLFreeHandle(SQL_HANDLE_STMT, m_handle);
+      }
+    }
+
+    StatementHandle(StatementHandle&& other) noexcept
+      : m_handle(std::exchange(other.m_handle, SQL_NULL_HSTMT)) { };
+
+    StatementHandle& operator=(StatementHandle&& other) noexcept {
+      if (this != &other) {
+        if (m_handle != SQL_NULL_HSTMT) {
+          SQLFreeHandle(SQL_HANDLE_STMT, m_handle);
+        }
+        m_handle = std::exchange(other.m_handle, SQL_NULL_HSTMT);
+      }
+
+      return *this;
+    }
+
+    StatementHandle(const StatementHandle&) = delete;
+    StatementHandle& operator=(const StatementHandle&) = delete;
+
+  public:
+    SQLHSTMT Get() const { return m_handle; }
+    explicit operator bool() const { return m_handle != SQL_NULL_HSTMT; }
+
+    // Throws with the statement's diagnostic record(s) unless `rc` succeeded
+    void Check(SQLRETURN rc, std::string_view context) const {
+      check(rc, SQL_HANDLE_STMT, m_handle, context);
+    }
+
+  private:
+    SQLHSTMT m_handle{SQL_NULL_HSTMT};
+};
+
+} // namespace odbc
+} // namespace saildb
@@ -0,0 +1,478 @@
+#include "ParameterArray.hpp"
+
+#include <chrono>
+#include <string>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+
+using ParameterArray = saildb::ParameterArray;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Utils                           *
+ *                                                          *
+ ************************************************************/
+
+constexpr int64_t SECONDS_PER_DAY = 86'400;
+
+// Floored, so that value(s) before the epoch map to the preceding day
+int64_t floorDivide(int64_t value, int64_t divisor) {
+  const int64_t quotient = value / divisor;
+  return (value % divisor != 0 && (value < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+SQL_DATE_STRUCT toDateStruct(int64_t days) {
+  const std::chrono::year_month_day date{std::chrono::sys_days(std::chrono::days(days))};
+
+  SQL_DATE_STRUCT result{};
+  result.year = static_cast<SQLSMALLINT>(static_cast<int>(date.year()));
+  result.month = static_cast<SQLUSMALLINT>(static_cast<unsigned>(date.month()));
+  result.day = static_cast<SQLUSMALLINT>(static_cast<unsigned>(date.day()));
+  return result;
+}
+
+SQL_TIME_STRUCT toTimeStruct(int64_t seconds) {
+  SQL_TIME_STRUCT result{};
+  result.hour = static_cast<SQLUSMALLINT>(seconds / 3600);
+  result.minute = static_cast<SQLUSMALLINT>(seconds / 60 % 60);
+  result.second = static_cast<SQLUSMALLINT>(seconds % 60);
+  return result;
+}
+
+SQL_TIMESTAMP_STRUCT toTimestampStruct(int64_t value, int64_t unitsPerSecond) {
+  const int64_t seconds = ::floorDivide(value, unitsPerSecond);
+  const int64_t days = ::floorDivide(seconds, SECONDS_PER_DAY);
+  const SQL_DATE_STRUCT date = ::toDateStruct(days);
+  const SQL_TIME_STRUCT time = ::toTimeStruct(seconds - days*SECONDS_PER_DAY);
+
+  SQL_TIMESTAMP_STRUCT result{};
+  result.year = date.year;
+  result.month = date.month;
+  result.day = date.day;
+  result.hour = time.hour;
+  result.minute = time.minute;
+  result.second = time.second;
+  result.fraction = static_cast<SQLUINTEGER>((value - seconds*unitsPerSecond) * (1'000'000'000 / unitsPerSecond));
+  return result;
+}
+
+int64_t getUnitsPerSecond(arrow::TimeUnit::type unit) {
+  switch (unit) {
+    case arrow::TimeUnit::SECOND: return 1;
+    case arrow::TimeUnit::MILLI:  return 1'000;
+    case arrow::TimeUnit::MICRO:  return 1'000'000;
+    default:                      return 1'000'000'000;
+  }
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                      ParameterArray                      *
+ *                                                          *
+ ************************************************************/
+
+/* Ctor & Dtor */
+ParameterArray::ParameterArray(std::shared_ptr<arrow::DataType> type)
+  : m_type(std::move(type))
+{
+  switch (m_type->id()) {
+    case arrow::Type::NA:
+      m_kind = Kind::Null;
+      m_cType = SQL_C_CHAR;
+      m_sqlType = SQL_VARCHAR;
+      m_columnSize = 1;
+      break;
+
+    case arrow::Type::BOOL:
+      m_kind = Kind::Boolean;
+      m_cType = SQL_C_BIT;
+      m_sqlType = SQL_BIT;
+      m_columnSize = 1;
+      break;
+
+    case arrow::Type::INT8:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_STINYINT;
+      m_sqlType = SQL_SMALLINT;
+      m_columnSize = 5;
+      break;
+
+    case arrow::Type::UINT8:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_UTINYINT;
+      m_sqlType = SQL_SMALLINT;
+      m_columnSize = 5;
+      break;
+
+    case arrow::Type::INT16:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_SSHORT;
+      m_sqlType = SQL_SMALLINT;
+      m_columnSize = 5;
+      break;
+
+    case arrow::Type::UINT16:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_USHORT;
+      m_sqlType = SQL_INTEGER;
+      m_columnSize = 10;
+      break;
+
+    case arrow::Type::INT32:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_SLONG;
+      m_sqlType = SQL_INTEGER;
+      m_columnSize = 10;
+      break;
+
+    case arrow::Type::UINT32:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_ULONG;
+      m_sqlType = SQL_BIGINT;
+      m_columnSize = 19;
+      break;
+
+    case arrow::Type::INT64:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_SBIGINT;
+      m_sqlType = SQL_BIGINT;
+      m_columnSize = 19;
+      break;
+
+    case arrow::Type::UINT64:
+      // Exceeds `BIGINT`, so bound as `DECIMAL(20, 0)`
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_UBIGINT;
+      m_sqlType = SQL_DECIMAL;
+      m_columnSize = 20;
+      break;
+
+    case arrow::Type::FLOAT:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_FLOAT;
+      m_sqlType = SQL_REAL;
+      m_columnSize = 7;
+      break;
+
+    case arrow::Type::DOUBLE:
+      m_kind = Kind::Fixed;
+      m_cType = SQL_C_DOUBLE;
+      m_sqlType = SQL_DOUBLE;
+      m_columnSize = 15;
+      break;
+
+    case arrow::Type::DATE32:
+    case arrow::Type::DATE64:
+      m_kind = m_type->id() == arrow::Type::DATE32 ? Kind::Date32 : Kind::Date64;
+      m_cType = SQL_C_TYPE_DATE;
+      m_sqlType = SQL_TYPE_DATE;
+      m_columnSize = 10;
+      break;
+
+    case arrow::Type::TIME32:
+    case arrow::Type::TIME64:
+      // `SQL_TIME_STRUCT` has no fraction, so sub-second unit(s) are truncated
+      m_kind = Kind::Time;
+      m_cType = SQL_C_TYPE_TIME;
+      m_sqlType = SQL_TYPE_TIME;
+      m_columnSize = 8;
+      m_unitsPerSecond = ::getUnitsPerSecond(static_cast<const arrow::TimeType&>(*m_type).unit());
+      break;
+
+    case arrow::Type::TIMESTAMP: {
+      // Value(s) are bound as UTC wall clock time, irrespective of the type's time zone
+      const arrow::TimeUnit::type unit = static_cast<const arrow::TimestampType&>(*m_type).unit();
+
+      m_kind = Kind::Timestamp;
+      m_cType = SQL_C_TYPE_TIMESTAMP;
+      m_sqlType = SQL_TYPE_TIMESTAMP;
+      m_unitsPerSecond = ::getUnitsPerSecond(unit);
+      m_digits = static_cast<SQLSMALLINT>(unit == arrow::TimeUnit::SECOND ? 0 : unit == arrow::TimeUnit::MILLI ? 3 : unit == arrow::TimeUnit::MICRO ? 6 : 9);
+      m_columnSize = m_digits > 0 ? 20 + m_digits : 19;
+      break;
+    }
+
+    case arrow::Type::DECIMAL128:
+    case arrow::Type::DECIMAL256: {
+      const auto& decimal = static_cast<const arrow::DecimalType&>(*m_type);
+
+      m_kind = Kind::Decimal;
+      m_cType = SQL_C_CHAR;
+      m_sqlType = SQL_DECIMAL;
+      m_columnSize = static_cast<SQLULEN>(decimal.precision());
+      m_digits = static_cast<SQLSMALLINT>(decimal.scale());
+      break;
+    }
+
+    case arrow::Type::STRING:
+    case arrow::Type::LARGE_STRING:
+      m_kind = Kind::String;
+      m_cType = SQL_C_WCHAR;
+      m_sqlType = SQL_WVARCHAR;
+      break;
+
+    case arrow::Type::BINARY:
+    case arrow::Type::LARGE_BINARY:
+    case arrow::Type::FIXED_SIZE_BINARY:
+      m_kind = Kind::Binary;
+      m_cType = SQL_C_BINARY;
+      m_sqlType = SQL_VARBINARY;
+      break;
+
+    default:
+      throw odbc::Error("HYC00", "Unsupported parameter type: " + m_type->ToString());
+  }
+}
+
+
+/* Public impl. */
+void ParameterArray::Bind(const odbc::StatementHandle& statement, SQLUSMALLINT index, const arrow::Array& array, int64_t offset, int64_t length) {
+  void* data = nullptr;
+  SQLLEN* indicators = m_indicators.data();
+  SQLLEN bufferLength = 0;
+
+  switch (m_kind) {
+    case Kind::Null: {
+      data = resize<char>(length);
+      bufferLength = 1;
+      m_indicators.assign(static_cast<size_t>(length), SQL_NULL_DATA);
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::Boolean: {
+      const auto& values = static_cast<const arrow::BooleanArray&>(array);
+      auto* output = resize<uint8_t>(length);
+      for (int64_t i = 0; i < length; ++i) {
+        output[i] = values.Value(offset + i) ? 1 : 0;
+      }
+
+      data = output;
+      fillIndicators(array, offset, length, 1);
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::Fixed: {
+      // Bound in place; without null(s), the indicator array may be omitted
+      const int64_t width = static_cast<const arrow::FixedWidthType&>(*m_type).bit_width() / 8;
+      const uint8_t* values = array.data()->buffers[1]->data() + (array.offset() + offset)*width;
+
+      data = const_cast<uint8_t*>(values);
+      if (array.null_count() == 0) {
+        indicators = nullptr;
+      } else {
+        fillIndicators(array, offset, length, static_cast<SQLLEN>(width));
+        indicators = m_indicators.data();
+      }
+    } break;
+
+    case Kind::Date32: {
+      const auto& values = static_cast<const arrow::Date32Array&>(array);
+      auto* output = resize<SQL_DATE_STRUCT>(length);
+      for (int64_t i = 0; i < length; ++i) {
+        output[i] = ::toDateStruct(values.Value(offset + i));
+      }
+
+      data = output;
+      fillIndicators(array, offset, length, sizeof(SQL_DATE_STRUCT));
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::Date64: {
+      const auto& values = static_cast<const arrow::Date64Array&>(array);
+      auto* output = resize<SQL_DATE_STRUCT>(length);
+      for (int64_t i = 0; i < length; ++i) {
+        output[i] = ::toDateStruct(::floorDivide(values.Value(offset + i), SECONDS_PER_DAY*1000));
+      }
+
+      data = output;
+      fillIndicators(array, offset, length, sizeof(SQL_DATE_STRUCT));
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::Time: {
+      auto* output = resize<SQL_TIME_STRUCT>(length);
+      for (int64_t i = 0; i < length; ++i) {
+        const int64_t value = m_type->id() == arrow::Type::TIME32
+          ? static_cast<const arrow::Time32Array&>(array).Value(offset + i)
+          : static_cast<const arrow::Time64Array&>(array).Value(offset + i);
+
+        output[i] = ::toTimeStruct(value / m_unitsPerSecond);
+      }
+
+      data = output;
+      fillIndicators(array, offset, length, sizeof(SQL_TIME_STRUCT));
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::Timestamp: {
+      const auto& values = static_cast<const arrow::TimestampArray&>(array);
+      auto* output = resize<SQL_TIMESTAMP_STRUCT>(length);
+      for (int64_t i = 0; i < length; ++i) {
+        output[i] = ::toTimestampStruct(values.Value(offset + i), m_unitsPerSecond);
+      }
+
+      data = output;
+      fillIndicators(array, offset, length, sizeof(SQL_TIMESTAMP_STRUCT));
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::Decimal: {
+      // Formatted as text, i.e. sign, digit(s), decimal point & terminator
+      const size_t width = m_columnSize + 3;
+      auto* output = resize<char>(length * static_cast<int64_t>(width));
+      m_indicators.resize(static_cast<size_t>(length));
+
+      for (int64_t i = 0; i < length; ++i) {
+        if (array.IsNull(offset + i)) {
+          m_indicators[i] = SQL_NULL_DATA;
+          continue;
+        }
+
+        const std::string text = m_type->id() == arrow::Type::DECIMAL128
+          ? static_cast<const arrow::Decimal128Array&>(array).FormatValue(offset + i)
+          : static_cast<const arrow::Decimal256Array&>(array).FormatValue(offset + i);
+
+        const size_t size = std::min(text.size(), width - 1);
+        std::memcpy(output + i*width, text.data(), size);
+        output[i*width + size] = '\0';
+        m_indicators[i] = static_cast<SQLLEN>(size);
+      }
+
+      data = output;
+      bufferLength = static_cast<SQLLEN>(width);
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::String: {
+      bufferLength = fillStrings(array, offset, length);
+      data = m_buffer.data();
+      indicators = m_indicators.data();
+    } break;
+
+    case Kind::Binary: {
+      if (m_type->id() == arrow::Type::FIXED_SIZE_BINARY) {
+        // Fixed-width element(s) are bound in place
+        const auto& values = static_cast<const arrow::FixedSizeBinaryArray&>(array);
+        const int32_t width = values.byte_width();
+
+        m_columnSize = static_cast<SQLULEN>(std::max<int32_t>(width, 1));
+        data = const_cast<uint8_t*>(values.GetValue(offset));
+        bufferLength = static_cast<SQLLEN>(width);
+        fillIndicators(array, offset, length, width);
+      } else {
+        fillBinaries(array, offset, length);
+        data = m_buffer.data();
+        bufferLength = static_cast<SQLLEN>(m_columnSize);
+      }
+
+      m_sqlType = m_columnSize > 8000 ? SQL_LONGVARBINARY : SQL_VARBINARY;
+      indicators = m_indicators.data();
+    } break;
+  }
+
+  statement.Check(
+    SQLBindParameter(
+      statement.Get(), index, SQL_PARAM_INPUT, m_cType, m_sqlType, m_columnSize, m_digits,
+      data, bufferLength, indicators
+    ),
+    "Failed to bind parameter array"
+  );
+}
+
+
+/* Private impl. */
+template <typename T>
+T* ParameterArray::resize(int64_t length) {
+  m_buffer.resize(std::max<size_t>(static_cast<size_t>(length) * sizeof(T), 1));
+  return reinterpret_cast<T*>(m_buffer.data());
+}
+
+void ParameterArray::fillIndicators(const arrow::Array& array, int64_t offset, int64_t length, SQLLEN size) {
+  m_indicators.resize(static_cast<size_t>(length));
+  if (array.null_count() == 0) {
+    std::fill(m_indicators.begin(), m_indicators.end(), size);
+    return;
+  }
+
+  for (int64_t i = 0; i < length; ++i) {
+    m_indicators[i] = array.IsNull(offset + i) ? SQL_NULL_DATA : size;
+  }
+}
+
+SQLLEN ParameterArray::fillStrings(const arrow::Array& array, int64_t offset, int64_t length) {
+  const auto getView = [&array](int64_t i) -> std::string_view {
+    return array.type_id() == arrow::Type::STRING
+      ? static_cast<const arrow::StringArray&>(array).GetView(i)
+      : static_cast<const arrow::LargeStringArray&>(array).GetView(i);
+  };
+
+  // UTF-16 never needs more code unit(s) than UTF-8 needs byte(s), so the longest
+  // value in byte(s) bounds the element width
+  size_t maxLength = 1;
+  for (int64_t i = 0; i < length; ++i) {
+    maxLength = std::max(maxLength, getView(offset + i).size());
+  }
+
+  const size_t width = maxLength + 1;
+  auto* output = resize<SQLWCHAR>(length * static_cast<int64_t>(width));
+  m_indicators.resize(static_cast<size_t>(length));
+
+  nanodbc::string text;
+  size_t maxUnits = 1;
+  for (int64_t i = 0; i < length; ++i) {
+    if (array.IsNull(offset + i)) {
+      m_indicators[i] = SQL_NULL_DATA;
+      continue;
+    }
+
+    text.clear();
+    if (!common::tryDecodeUtf8(getView(offset + i), text)) {
+      throw odbc::Error("22018", "Failed to bind string parameter, found malformed UTF-8");
+    }
+
+    std::memcpy(output + i*width, text.data(), text.size() * sizeof(SQLWCHAR));
+    output[i*width + text.size()] = 0;
+    m_indicators[i] = static_cast<SQLLEN>(text.size() * sizeof(SQLWCHAR));
+    maxUnits = std::max(maxUnits, text.size());
+  }
+
+  m_columnSize = static_cast<SQLULEN>(maxUnits);
+  m_sqlType = maxUnits > 4000 ? SQL_WLONGVARCHAR : SQL_WVARCHAR;
+
+  return static_cast<SQLLEN>(width * sizeof(SQLWCHAR));
+}
+
+void ParameterArray::fillBinaries(const arrow::Array& array, int64_t offset, int64_t length) {
+  const auto getView = [&array](int64_t i) -> std::string_view {
+    return array.type_id() == arrow::Type::BINARY
+      ? static_cast<const arrow::BinaryArray&>(array).GetView(i)
+      : static_cast<const arrow::LargeBinaryArray&>(array).GetView(i);
+  };
+
+  size_t width = 1;
+  for (int64_t i = 0; i < length; ++i) {
+    width = std::max(width, getView(offset + i).size());
+  }
+
+  auto* output = resize<uint8_t>(length * static_cast<int64_t>(width));
+  m_indicators.resize(static_cast<size_t>(length));
+
+  for (int64_t i = 0; i < length; ++i) {
+    if (array.IsNull(offset + i)) {
+      m_indicators[i] = SQL_NULL_DATA;
+      continue;
+    }
+
+    const std::string_view value = getView(offset + i);
+    std::memcpy(output + i*width, value.data(), value.size());
+    m_indicators[i] = static_cast<SQLLEN>(value.size());
+  }
+
+  m_columnSize = static_cast<SQLULEN>(width);
+}
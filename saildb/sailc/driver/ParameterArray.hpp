@@ -0,0 +1,68 @@
+#pragma once
+
+#include <arrow/api.h>
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+#include "sailc/driver/Odbc.hpp"
+
+namespace saildb {
+
+/*
+ * Column-wise parameter array of a single Arrow column, i.e. one `?` bound for `SQL_ATTR_PARAMSET_SIZE` row(s)
+ *
+ *  - Integer & floating point column(s) are bound in place, without copying the Arrow buffer(s)
+ *  - Boolean, temporal & decimal column(s) are converted into a reused scratch buffer
+ *  - String & binary column(s) are copied into fixed-width element(s), sized by the longest value of
+ *    each slice; string(s) are transcoded to UTF-16
+ *
+ */
+class ParameterArray {
+  public:
+    // Throws an `odbc::Error` if values of `type` can't be bound
+    explicit ParameterArray(std::shared_ptr<arrow::DataType> type);
+
+  public:
+    // Binds row(s) `[offset, offset + length)` of `array`, whose buffer(s) must outlive the execution
+    void Bind(const odbc::StatementHandle& statement, SQLUSMALLINT index, const arrow::Array& array, int64_t offset, int64_t length);
+
+  private:
+    enum class Kind : uint8_t {
+      Null,
+      Boolean,
+      Fixed,
+      Date32,
+      Date64,
+      Time,
+      Timestamp,
+      Decimal,
+      String,
+      Binary,
+    };
+
+    template <typename T>
+    T* resize(int64_t length);
+
+    void fillIndicators(const arrow::Array& array, int64_t offset, int64_t length, SQLLEN size);
+
+    // Returns the element width in byte(s)
+    SQLLEN fillStrings(const arrow::Array& array, int64_t offset, int64_t length);
+    void fillBinaries(const arrow::Array& array, int64_t offset, int64_t length);
+
+  private:
+    std::shared_ptr<arrow::DataType> m_type;
+    Kind m_kind;
+    SQLSMALLINT m_cType;
+    SQLSMALLINT m_sqlType;
+    SQLULEN m_columnSize{0};
+    SQLSMALLINT m_digits{0};
+    int64_t m_unitsPerSecond{1};
+
+    std::vector<uint8_t> m_buffer;
+    std::vector<SQLLEN> m_indicators;
+};
+
+} // namespace saildb
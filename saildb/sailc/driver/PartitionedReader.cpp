@@ -0,0 +1,423 @@
+#include "PartitionedReader.hpp"
+
+#include <cmath>
+#include <chrono>
+#include <cctype>
+#include <cstdio>
+#include <utility>
+#include <charconv>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using PartitionedReader = saildb::PartitionedReader;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Utils                           *
+ *                                                          *
+ ************************************************************/
+
+using Microseconds = std::chrono::sys_time<std::chrono::microseconds>;
+
+constexpr int64_t MICROSECONDS_PER_DAY = 86'400'000'000;
+
+int64_t toDays(const SQL_DATE_STRUCT& value) {
+  const std::chrono::year_month_day date{
+    std::chrono::year{value.year},
+    std::chrono::month{value.month},
+    std::chrono::day{value.day}
+  };
+
+  return std::chrono::sys_days(date).time_since_epoch().count();
+}
+
+int64_t toMicroseconds(const SQL_TIMESTAMP_STRUCT& value) {
+  const int64_t days = ::toDays(SQL_DATE_STRUCT{value.year, value.month, value.day});
+  const int64_t seconds = value.hour*3600 + value.minute*60 + value.second;
+
+  return days*MICROSECONDS_PER_DAY + seconds*1'000'000 + value.fraction / 1000;
+}
+
+std::string formatDate(int64_t days) {
+  const std::chrono::year_month_day date{std::chrono::sys_days(std::chrono::days(days))};
+
+  char buffer[32];
+  std::snprintf(
+    buffer, sizeof(buffer), "{d '%04d-%02u-%02u'}",
+    static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day())
+  );
+
+  return buffer;
+}
+
+std::string formatTimestamp(int64_t microseconds) {
+  const Microseconds time{std::chrono::microseconds(microseconds)};
+  const std::chrono::sys_days days = std::chrono::floor<std::chrono::days>(time);
+  const std::chrono::year_month_day date{days};
+  const std::chrono::hh_mm_ss clock{time - days};
+
+  char buffer[48];
+  std::snprintf(
+    buffer, sizeof(buffer), "{ts '%04d-%02u-%02u %02d:%02d:%02d.%06lld'}",
+    static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()),
+    static_cast<int>(clock.hours().count()), static_cast<int>(clock.minutes().count()), static_cast<int>(clock.seconds().count()),
+    static_cast<long long>(clock.subseconds().count())
+  );
+
+  return buffer;
+}
+
+std::string formatDouble(double value) {
+  char buffer[32];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  return std::string(buffer, result.ptr);
+}
+
+// Split point(s) of an integer range into at most `count` partition(s) of equal width
+std::vector<int64_t> splitRange(int64_t lower, int64_t upper, size_t count) {
+  // Computed unsigned, as the width of the range may exceed `INT64_MAX`
+  const uint64_t width = static_cast<uint64_t>(upper) - static_cast<uint64_t>(lower);
+  const uint64_t partitions = std::min<uint64_t>(count, width);
+  const uint64_t stride = width / partitions;
+  const uint64_t remainder = width % partitions;
+
+  std::vector<int64_t> result;
+  result.reserve(partitions - 1);
+  for (uint64_t i = 1; i < partitions; ++i) {
+    const uint64_t offset = stride*i + remainder*i / partitions;
+    result.push_back(static_cast<int64_t>(static_cast<uint64_t>(lower) + offset));
+  }
+
+  return result;
+}
+
+// Literal(s) of the value(s) between consecutive partition(s), in ascending order
+std::vector<std::string> getSplitLiterals(const saildb::PartitionBound& lower, const saildb::PartitionBound& upper, size_t count) {
+  if (lower.index() != upper.index()) {
+    throw std::invalid_argument("Partition bounds must be of the same type");
+  }
+
+  std::vector<std::string> result;
+  if (std::holds_alternative<double>(lower)) {
+    const double low = std::get<double>(lower);
+    const double high = std::get<double>(upper);
+    if (!std::isfinite(low) || !std::isfinite(high) || !(low < high)) {
+      throw std::invalid_argument("Expected finite partition bounds where lowerBound < upperBound");
+    }
+
+    for (size_t i = 1; i < count; ++i) {
+      result.push_back(::formatDouble(low + (high - low)*static_cast<double>(i) / static_cast<double>(count)));
+    }
+
+    return result;
+  }
+
+  int64_t low, high;
+  std::string (*format)(int64_t);
+  if (std::holds_alternative<int64_t>(lower)) {
+    low = std::get<int64_t>(lower);
+    high = std::get<int64_t>(upper);
+    format = [](int64_t value) { return std::to_string(value); };
+  } else if (std::holds_alternative<SQL_DATE_STRUCT>(lower)) {
+    low = ::toDays(std::get<SQL_DATE_STRUCT>(lower));
+    high = ::toDays(std::get<SQL_DATE_STRUCT>(upper));
+    format = &::formatDate;
+  } else {
+    low = ::toMicroseconds(std::get<SQL_TIMESTAMP_STRUCT>(lower));
+    high = ::toMicroseconds(std::get<SQL_TIMESTAMP_STRUCT>(upper));
+    format = &::formatTimestamp;
+  }
+
+  if (low >= high) {
+    throw std::invalid_argument("Expected partition bounds where lowerBound < upperBound");
+  }
+
+  for (int64_t value : ::splitRange(low, high, count)) {
+    result.push_back(format(value));
+  }
+
+  return result;
+}
+
+std::string_view trimQuery(std::string_view query) {
+  while (!query.empty() && (std::isspace(static_cast<unsigned char>(query.back())) || query.back() == ';')) {
+    query.remove_suffix(1);
+  }
+
+  return query;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                    PartitionedReader                     *
+ *                                                          *
+ ************************************************************/
+
+/* Static impl. */
+std::shared_ptr<PartitionedReader> PartitionedReader::Create(
+  std::shared_ptr<ConnectionPool> pool,
+  std::string_view query,
+  PartitionOptions options
+) {
+  const std::vector<std::string> predicates = GetPredicates(options);
+
+  // Worker(s) beyond the pool's bound would only wait on checkout
+  size_t parallelism = options.parallelism > 0 ? options.parallelism : pool->GetOptions().maxSize;
+  parallelism = std::clamp<size_t>(parallelism, 1, std::min<size_t>(predicates.size(), pool->GetOptions().maxSize));
+  options.parallelism = parallelism;
+  options.depth = std::max<size_t>(options.depth, 1);
+
+  std::shared_ptr<PartitionedReader> reader(new PartitionedReader(std::move(pool), std::move(options)));
+
+  const std::string_view source = ::trimQuery(query);
+  reader->m_partitions.resize(predicates.size());
+  reader->m_remaining = predicates.size();
+  for (size_t i = 0; i < predicates.size(); ++i) {
+    std::string& text = reader->m_partitions[i].query;
+    text.append("SELECT * FROM (").append(source).append(") saildb_partition WHERE ").append(predicates[i]);
+  }
+
+  // Started once constructed, as the worker(s) refer to the reader's member(s)
+  reader->m_workers.reserve(parallelism);
+  for (size_t i = 0; i < parallelism; ++i) {
+    reader->m_workers.emplace_back(&PartitionedReader::work, reader.get());
+  }
+
+  arrow::Status status;
+  {
+    std::unique_lock<std::mutex> lock(reader->m_lock);
+    reader->m_notEmpty.wait(lock, [&reader]() {
+      return reader->m_schema || !reader->m_status.ok();
+    });
+
+    status = reader->m_status;
+  }
+
+  if (!status.ok()) {
+    (void)reader->Close();
+    throw std::runtime_error(status.message());
+  }
+
+  return reader;
+}
+
+std::vector<std::string> PartitionedReader::GetPredicates(const PartitionOptions& options) {
+  if (options.column.empty()) {
+    throw std::invalid_argument("Expected a partition column");
+  }
+
+  if (options.partitionCount < 1) {
+    throw std::invalid_argument("Expected at least one partition");
+  }
+
+  const std::string& key = options.column;
+  std::vector<std::string> result;
+
+  if (options.strategy == PartitionStrategy::Modulo) {
+    const std::string count = std::to_string(options.partitionCount);
+    for (size_t i = 0; i < options.partitionCount; ++i) {
+      std::string predicate = "{fn MOD({fn ABS(" + key + ")}, " + count + ")} = " + std::to_string(i);
+      if (i == 0) {
+        predicate = "(" + predicate + " OR " + key + " IS NULL)";
+      }
+
+      result.push_back(std::move(predicate));
+    }
+
+    return result;
+  }
+
+  const std::vector<std::string> splits = ::getSplitLiterals(options.lowerBound, options.upperBound, options.partitionCount);
+  if (splits.empty()) {
+    result.push_back("1 = 1");
+    return result;
+  }
+
+  result.push_back("(" + key + " < " + splits.front() + " OR " + key + " IS NULL)");
+  for (size_t i = 1; i < splits.size(); ++i) {
+    result.push_back(key + " >= " + splits[i - 1] + " AND " + key + " < " + splits[i]);
+  }
+  result.push_back(key + " >= " + splits.back());
+
+  return result;
+}
+
+
+/* Ctor & Dtor */
+PartitionedReader::PartitionedReader(std::shared_ptr<ConnectionPool> pool, PartitionOptions options)
+  : m_pool(std::move(pool)), m_options(std::move(options)) { };
+
+PartitionedReader::~PartitionedReader() {
+  (void)Close();
+}
+
+
+/* Public impl. */
+std::shared_ptr<arrow::Schema> PartitionedReader::schema() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_schema;
+}
+
+arrow::Status PartitionedReader::ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) {
+  std::unique_lock<std::mutex> lock(m_lock);
+  while (true) {
+    m_notEmpty.wait(lock, [this]() {
+      if (isStopped() || m_current >= m_partitions.size()) {
+        return true;
+      }
+
+      return m_options.isOrdered
+        ? !m_partitions[m_current].queue.empty() || m_partitions[m_current].isDone
+        : !m_queue.empty() || m_remaining == 0;
+    });
+
+    if (!m_status.ok()) {
+      *batch = nullptr;
+      return m_status;
+    }
+
+    if (m_isClosed || m_current >= m_partitions.size()) {
+      *batch = nullptr;
+      return arrow::Status::OK();
+    }
+
+    Queue& queue = getQueue(m_current);
+    if (!queue.empty()) {
+      *batch = std::move(queue.front());
+      queue.pop_front();
+      m_notFull.notify_all();
+      return arrow::Status::OK();
+    }
+
+    // Unordered, every partition is exhausted; ordered, the current one is & the next is awaited
+    m_current = m_options.isOrdered ? m_current + 1 : m_partitions.size();
+  }
+}
+
+arrow::Status PartitionedReader::Close() {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_isClosed = true;
+    m_queue.clear();
+    for (Partition& partition : m_partitions) {
+      partition.queue.clear();
+    }
+  }
+  m_notFull.notify_all();
+  m_notEmpty.notify_all();
+
+  for (std::thread& worker : m_workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+
+  return arrow::Status::OK();
+}
+
+size_t PartitionedReader::GetPartitionCount() const {
+  return m_partitions.size();
+}
+
+size_t PartitionedReader::GetParallelism() const {
+  return m_options.parallelism;
+}
+
+
+/* Private impl. */
+void PartitionedReader::work() {
+  while (true) {
+    const size_t index = m_nextPartition.fetch_add(1);
+    if (index >= m_partitions.size()) {
+      break;
+    }
+
+    arrow::Status status;
+    try {
+      status = readPartition(index);
+    } catch (const std::exception& e) {
+      status = arrow::Status::UnknownError(e.what());
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (!status.ok() && m_status.ok()) {
+      m_status = status.WithMessage("Partition ", index, ": ", status.message());
+      m_notFull.notify_all();
+    }
+
+    m_partitions[index].isDone = true;
+    --m_remaining;
+    m_notEmpty.notify_all();
+
+    if (isStopped()) {
+      break;
+    }
+  }
+}
+
+arrow::Status PartitionedReader::readPartition(size_t index) {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (isStopped()) {
+      return arrow::Status::OK();
+    }
+  }
+
+  // Released by the reader once its result set is exhausted, or on return
+  std::shared_ptr<ResultReader> reader = ResultReader::Create(m_pool->Acquire(), m_partitions[index].query, m_options.reader);
+
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (!m_schema) {
+      m_schema = reader->schema();
+      m_notEmpty.notify_all();
+    } else if (!m_schema->Equals(*reader->schema())) {
+      return arrow::Status::Invalid("Schema differs from that of the other partition(s): ", reader->schema()->ToString());
+    }
+  }
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      m_notFull.wait(lock, [this, index]() {
+        return getQueue(index).size() < getCapacity() || isStopped();
+      });
+
+      if (isStopped()) {
+        return reader->Close();
+      }
+    }
+
+    // Fetched outside of the lock, so the other worker(s) & the consumer proceed meanwhile
+    std::shared_ptr<arrow::RecordBatch> batch;
+    ARROW_RETURN_NOT_OK(reader->ReadNext(&batch));
+    if (!batch) {
+      return arrow::Status::OK();
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (isStopped()) {
+      return reader->Close();
+    }
+
+    getQueue(index).push_back(std::move(batch));
+    m_notEmpty.notify_all();
+  }
+}
+
+PartitionedReader::Queue& PartitionedReader::getQueue(size_t index) {
+  return m_options.isOrdered ? m_partitions[index].queue : m_queue;
+}
+
+size_t PartitionedReader::getCapacity() const {
+  return m_options.isOrdered ? m_options.depth : m_options.depth * m_options.parallelism;
+}
+
+bool PartitionedReader::isStopped() const {
+  return m_isClosed || !m_status.ok();
+}
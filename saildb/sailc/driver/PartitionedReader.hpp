@@ -0,0 +1,121 @@
+#pragma once
+
+#include <arrow/api.h>
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <variant>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <condition_variable>
+
+#include "sailc/driver/Odbc.hpp"
+#include "sailc/driver/ResultReader.hpp"
+#include "sailc/driver/ConnectionPool.hpp"
+
+namespace saildb {
+
+using PartitionBound = std::variant<
+  int64_t,
+  double,
+  SQL_DATE_STRUCT,
+  SQL_TIMESTAMP_STRUCT
+>;
+
+enum class PartitionStrategy : uint8_t {
+  Range,                                                // Slice(s) of equal width between `lowerBound` & `upperBound`
+  Modulo,                                               // `MOD(ABS(key), partitionCount)`, for integer key(s)
+};
+
+struct PartitionOptions {
+  std::string column;                                   // Partition key, i.e. a column or expression of the query's result
+  PartitionStrategy strategy{PartitionStrategy::Range};
+  size_t partitionCount{8};
+  PartitionBound lowerBound{int64_t{0}};                // Range only; decides the stride, row(s) outside belong to the first & last partition
+  PartitionBound upperBound{int64_t{0}};
+  size_t parallelism{0};                                // Partition(s) read concurrently, or 0 for the pool's `maxSize`
+  bool isOrdered{false};                                // Yield partition(s) in order, rather than batch(es) as they arrive
+  size_t depth{2};                                      // Batch(es) buffered per partition
+  ReaderOptions reader;
+};
+
+/*
+ * Reads a query as partition(s) on concurrent pooled connection(s), merged into a single stream
+ *
+ *  - Each partition wraps the query as `SELECT * FROM (<query>) WHERE <predicate>`; the predicates
+ *    cover every row, including those with a NULL key, exactly once
+ *  - Partition(s) are claimed in order by `parallelism` worker(s), each holding one lease at a time
+ *  - Unordered, batch(es) are yielded as they arrive; ordered, partition `N` is yielded in full
+ *    before `N + 1`, whose batch(es) are buffered meanwhile
+ *  - A worker waits once its partition has `depth` batch(es) buffered
+ *  - The first error of any partition stops the remaining worker(s) & is yielded to the consumer
+ *
+ */
+class PartitionedReader : public arrow::RecordBatchReader {
+  public:
+    // Blocks until the first partition's result set is described, so that the schema is known
+    static std::shared_ptr<PartitionedReader> Create(std::shared_ptr<ConnectionPool> pool, std::string_view query, PartitionOptions options);
+
+    // Predicate of each partition
+    static std::vector<std::string> GetPredicates(const PartitionOptions& options);
+
+  public:
+    PartitionedReader(PartitionedReader const&) = delete;
+    PartitionedReader &operator=(PartitionedReader const&) = delete;
+    ~PartitionedReader() override;
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override;
+
+    // Blocks until a batch is available; yields `nullptr` once every partition is exhausted
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override;
+    arrow::Status Close() override;
+
+    size_t GetPartitionCount() const;
+    size_t GetParallelism() const;
+
+  private:
+    using Queue = std::deque<std::shared_ptr<arrow::RecordBatch>>;
+
+    struct Partition {
+      std::string query;
+      Queue queue;
+      bool isDone{false};
+    };
+
+    PartitionedReader(std::shared_ptr<ConnectionPool> pool, PartitionOptions options);
+
+    void work();
+    arrow::Status readPartition(size_t index);
+
+    // Expects `m_lock` to be held
+    Queue& getQueue(size_t index);
+    size_t getCapacity() const;
+    bool isStopped() const;
+
+  private:
+    std::shared_ptr<ConnectionPool> m_pool;
+    const PartitionOptions m_options;
+
+    std::vector<Partition> m_partitions;
+    std::atomic<size_t> m_nextPartition{0};
+    std::vector<std::thread> m_workers;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::shared_ptr<arrow::Schema> m_schema;
+    arrow::Status m_status;
+    Queue m_queue;
+    size_t m_current{0};
+    size_t m_remaining{0};
+    bool m_isClosed{false};
+};
+
+} // namespace saildb
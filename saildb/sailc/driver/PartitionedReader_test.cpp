@@ -0,0 +1,415 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+
+#include <cmath>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+
+#include "sailc/driver/PartitionedReader.hpp"
+#include "sailc/driver/TestDatabase.hpp"
+
+using saildb::PoolOptions;
+using saildb::ConnectionPool;
+using saildb::PartitionBound;
+using saildb::PartitionOptions;
+using saildb::PartitionStrategy;
+using saildb::PartitionedReader;
+using saildb::testing::TestDatabase;
+
+namespace {
+
+PartitionOptions getRangeOptions(PartitionBound lowerBound, PartitionBound upperBound, size_t partitionCount) {
+  PartitionOptions options;
+  options.column = "id";
+  options.partitionCount = partitionCount;
+  options.lowerBound = lowerBound;
+  options.upperBound = upperBound;
+  return options;
+}
+
+class PartitionedReaderTest : public ::testing::Test {
+  protected:
+    PartitionedReaderTest()
+      : m_database(::testing::UnitTest::GetInstance()->current_test_info()->name()) { };
+
+    void SetUp() override {
+      PoolOptions options;
+      options.maxSize = 4;
+      m_pool = m_database.TryCreatePool(options, m_errorMessage);
+      if (!m_pool) {
+        GTEST_SKIP() << m_errorMessage;
+      }
+    }
+
+    void execute(std::string_view query) {
+      TestDatabase::Execute(*m_pool->Acquire(), query);
+    }
+
+    // Inserts `count` row(s) into `saildb_rows`, i.e. an `id` & its code
+    void seed(int64_t count) {
+      execute("CREATE TABLE saildb_rows (id INTEGER, code VARCHAR(8))");
+      execute(
+        "WITH RECURSIVE ids(id) AS (SELECT 0 UNION ALL SELECT id + 1 FROM ids WHERE id + 1 < " + std::to_string(count) + ") "
+        "INSERT INTO saildb_rows SELECT id, 'row-' || (id % 100) FROM ids"
+      );
+    }
+
+    std::shared_ptr<PartitionedReader> read(std::string_view query, PartitionOptions options) {
+      options.reader.rowArraySize = 10;
+      options.reader.batchSize = 10;
+      return PartitionedReader::Create(m_pool, query, std::move(options));
+    }
+
+    // Key(s) of every batch, in the order yielded; NULL(s) as `std::nullopt`
+    static std::vector<std::optional<int64_t>> drain(PartitionedReader& reader) {
+      std::vector<std::optional<int64_t>> result;
+      while (true) {
+        std::shared_ptr<arrow::RecordBatch> batch;
+        const arrow::Status status = reader.ReadNext(&batch);
+        EXPECT_TRUE(status.ok()) << status.ToString();
+        if (!status.ok() || !batch) {
+          return result;
+        }
+
+        const auto& ids = static_cast<const arrow::Int32Array&>(*batch->column(0));
+        for (int64_t i = 0; i < ids.length(); ++i) {
+          result.push_back(ids.IsNull(i) ? std::nullopt : std::optional<int64_t>(ids.Value(i)));
+        }
+      }
+    }
+
+    // Waits for every open connection to be returned
+    bool awaitIdle() const {
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (m_pool->GetIdleCount() != m_pool->GetOpenCount()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+
+      return true;
+    }
+
+  protected:
+    TestDatabase m_database;
+    std::shared_ptr<ConnectionPool> m_pool;
+    std::string m_errorMessage;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Predicates                        *
+ *                                                          *
+ ************************************************************/
+
+TEST(PartitionPredicateTest, SplitsIntegerRange) {
+  const auto predicates = PartitionedReader::GetPredicates(getRangeOptions(int64_t{0}, int64_t{100}, 4));
+
+  // Row(s) below the range & NULL key(s) belong to the first partition, those above to the last
+  const std::vector<std::string> expected{
+    "(id < 25 OR id IS NULL)",
+    "id >= 25 AND id < 50",
+    "id >= 50 AND id < 75",
+    "id >= 75",
+  };
+  EXPECT_EQ(predicates, expected);
+}
+
+TEST(PartitionPredicateTest, SpreadsRemainderOfUnevenRange) {
+  const auto predicates = PartitionedReader::GetPredicates(getRangeOptions(int64_t{-10}, int64_t{0}, 3));
+
+  const std::vector<std::string> expected{
+    "(id < -7 OR id IS NULL)",
+    "id >= -7 AND id < -4",
+    "id >= -4",
+  };
+  EXPECT_EQ(predicates, expected);
+}
+
+TEST(PartitionPredicateTest, LimitsPartitionsToWidthOfRange) {
+  const auto predicates = PartitionedReader::GetPredicates(getRangeOptions(int64_t{0}, int64_t{3}, 8));
+
+  const std::vector<std::string> expected{
+    "(id < 1 OR id IS NULL)",
+    "id >= 1 AND id < 2",
+    "id >= 2",
+  };
+  EXPECT_EQ(predicates, expected);
+}
+
+TEST(PartitionPredicateTest, SplitsFullIntegerRange) {
+  const auto predicates = PartitionedReader::GetPredicates(getRangeOptions(INT64_MIN, INT64_MAX, 2));
+
+  const std::vector<std::string> expected{"(id < -1 OR id IS NULL)", "id >= -1"};
+  EXPECT_EQ(predicates, expected);
+}
+
+TEST(PartitionPredicateTest, SingleRangePartitionCoversEveryRow) {
+  const auto predicates = PartitionedReader::GetPredicates(getRangeOptions(int64_t{0}, int64_t{100}, 1));
+
+  EXPECT_EQ(predicates, std::vector<std::string>{"1 = 1"});
+}
+
+TEST(PartitionPredicateTest, SplitsDoubleRange) {
+  const auto predicates = PartitionedReader::GetPredicates(getRangeOptions(0.0, 1.0, 4));
+
+  const std::vector<std::string> expected{
+    "(id < 0.25 OR id IS NULL)",
+    "id >= 0.25 AND id < 0.5",
+    "id >= 0.5 AND id < 0.75",
+    "id >= 0.75",
+  };
+  EXPECT_EQ(predicates, expected);
+}
+
+TEST(PartitionPredicateTest, SplitsDateRangeAsEscapes) {
+  const auto predicates = PartitionedReader::GetPredicates(
+    getRangeOptions(SQL_DATE_STRUCT{2024, 1, 1}, SQL_DATE_STRUCT{2024, 3, 1}, 2)
+  );
+
+  // Leap year, i.e. 60 day(s) split at day 30
+  const std::vector<std::string> expected{
+    "(id < {d '2024-01-31'} OR id IS NULL)",
+    "id >= {d '2024-01-31'}",
+  };
+  EXPECT_EQ(predicates, expected);
+}
+
+TEST(PartitionPredicateTest, SplitsTimestampRangeAsEscapes) {
+  const auto predicates = PartitionedReader::GetPredicates(
+    getRangeOptions(SQL_TIMESTAMP_STRUCT{2024, 1, 1, 0, 0, 0, 0}, SQL_TIMESTAMP_STRUCT{2024, 1, 1, 0, 0, 1, 0}, 2)
+  );
+
+  const std::vector<std::string> expected{
+    "(id < {ts '2024-01-01 00:00:00.500000'} OR id IS NULL)",
+    "id >= {ts '2024-01-01 00:00:00.500000'}",
+  };
+  EXPECT_EQ(predicates, expected);
+}
+
+TEST(PartitionPredicateTest, AssignsNullKeysToFirstModuloPartition) {
+  PartitionOptions options;
+  options.column = "id";
+  options.strategy = PartitionStrategy::Modulo;
+  options.partitionCount = 3;
+
+  const std::vector<std::string> expected{
+    "({fn MOD({fn ABS(id)}, 3)} = 0 OR id IS NULL)",
+    "{fn MOD({fn ABS(id)}, 3)} = 1",
+    "{fn MOD({fn ABS(id)}, 3)} = 2",
+  };
+  EXPECT_EQ(PartitionedReader::GetPredicates(options), expected);
+}
+
+TEST(PartitionPredicateTest, RejectsInvalidOptions) {
+  PartitionOptions options = getRangeOptions(int64_t{0}, int64_t{100}, 4);
+  options.column.clear();
+  EXPECT_THROW(PartitionedReader::GetPredicates(options), std::invalid_argument);
+
+  options = getRangeOptions(int64_t{0}, int64_t{100}, 0);
+  EXPECT_THROW(PartitionedReader::GetPredicates(options), std::invalid_argument);
+
+  EXPECT_THROW(PartitionedReader::GetPredicates(getRangeOptions(int64_t{100}, int64_t{100}, 4)), std::invalid_argument);
+  EXPECT_THROW(PartitionedReader::GetPredicates(getRangeOptions(int64_t{100}, int64_t{0}, 4)), std::invalid_argument);
+  EXPECT_THROW(PartitionedReader::GetPredicates(getRangeOptions(int64_t{0}, 1.0, 4)), std::invalid_argument);
+  EXPECT_THROW(PartitionedReader::GetPredicates(getRangeOptions(0.0, std::nan(""), 4)), std::invalid_argument);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Reading                          *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(PartitionedReaderTest, ReadsEveryRowExactlyOnce) {
+  seed(100);
+  execute("INSERT INTO saildb_rows VALUES (NULL, 'null'), (NULL, 'null'), (-5, 'below'), (150, 'above')");
+
+  // Split at 25, 50 & 75, so that those row(s) sit on a boundary
+  auto reader = read("SELECT id, code FROM saildb_rows", getRangeOptions(int64_t{0}, int64_t{100}, 4));
+  EXPECT_EQ(reader->GetPartitionCount(), 4u);
+  ASSERT_EQ(reader->schema()->num_fields(), 2);
+  EXPECT_EQ(reader->schema()->field(0)->name(), "id");
+
+  std::vector<std::optional<int64_t>> ids = drain(*reader);
+  std::sort(ids.begin(), ids.end());
+
+  std::vector<std::optional<int64_t>> expected{std::nullopt, std::nullopt, -5};
+  for (int64_t id = 0; id < 100; ++id) {
+    expected.push_back(id);
+  }
+  expected.push_back(150);
+
+  EXPECT_EQ(ids, expected);
+  EXPECT_TRUE(awaitIdle());
+}
+
+TEST_F(PartitionedReaderTest, YieldsPartitionsInOrder) {
+  seed(100);
+  execute("INSERT INTO saildb_rows VALUES (NULL, 'null'), (150, 'above')");
+
+  PartitionOptions options = getRangeOptions(int64_t{0}, int64_t{100}, 4);
+  options.isOrdered = true;
+  options.depth = 1;
+
+  // Descending within each partition, so that only the partition order is ascending
+  auto reader = read("SELECT id, code FROM saildb_rows ORDER BY id DESC", options);
+  const std::vector<std::optional<int64_t>> ids = drain(*reader);
+  ASSERT_EQ(ids.size(), 102u);
+
+  // The first partition holds the NULL key, the last the row above the range
+  std::vector<std::optional<int64_t>> expected;
+  for (int64_t id = 24; id >= 0; --id) {
+    expected.push_back(id);
+  }
+  expected.push_back(std::nullopt);
+  for (int64_t partition = 1; partition < 4; ++partition) {
+    if (partition == 3) {
+      expected.push_back(150);
+    }
+
+    for (int64_t id = partition*25 + 24; id >= partition*25; --id) {
+      expected.push_back(id);
+    }
+  }
+
+  EXPECT_EQ(ids, expected);
+}
+
+TEST_F(PartitionedReaderTest, ReadsEmptyPartitions) {
+  seed(10);
+
+  // Every row falls into the first of the partition(s)
+  auto reader = read("SELECT id FROM saildb_rows;", getRangeOptions(int64_t{1000}, int64_t{2000}, 4));
+
+  std::vector<std::optional<int64_t>> ids = drain(*reader);
+  EXPECT_EQ(ids.size(), 10u);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                       Concurrency                        *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(PartitionedReaderTest, ReadsPartitionsConcurrently) {
+  seed(400);
+
+  PartitionOptions options = getRangeOptions(int64_t{0}, int64_t{400}, 4);
+  options.isOrdered = true;
+  options.depth = 1;
+
+  // Each worker holds its lease once its partition's buffer is full, as none is consumed yet
+  auto reader = read("SELECT id FROM saildb_rows", options);
+  EXPECT_EQ(reader->GetParallelism(), 4u);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (m_pool->GetOpenCount() < 4 || m_pool->GetIdleCount() > 0) {
+    ASSERT_LT(std::chrono::steady_clock::now(), deadline)
+      << m_pool->GetOpenCount() << " open, " << m_pool->GetIdleCount() << " idle";
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+
+  EXPECT_EQ(drain(*reader).size(), 400u);
+  EXPECT_TRUE(awaitIdle());
+  EXPECT_EQ(m_pool->GetOpenCount(), 4u);
+}
+
+TEST_F(PartitionedReaderTest, BoundsParallelismByPoolAndPartitions) {
+  seed(10);
+
+  PartitionOptions options = getRangeOptions(int64_t{0}, int64_t{10}, 8);
+  EXPECT_EQ(read("SELECT id FROM saildb_rows", options)->GetParallelism(), 4u);
+
+  options.parallelism = 2;
+  EXPECT_EQ(read("SELECT id FROM saildb_rows", options)->GetParallelism(), 2u);
+
+  options = getRangeOptions(int64_t{0}, int64_t{10}, 3);
+  EXPECT_EQ(read("SELECT id FROM saildb_rows", options)->GetParallelism(), 3u);
+}
+
+TEST_F(PartitionedReaderTest, ClosesBeforeDrained) {
+  seed(400);
+
+  PartitionOptions options = getRangeOptions(int64_t{0}, int64_t{400}, 4);
+  options.depth = 1;
+
+  auto reader = read("SELECT id FROM saildb_rows", options);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  ASSERT_NE(batch, nullptr);
+
+  // The blocked worker(s) are woken & joined, returning their lease(s)
+  ASSERT_TRUE(reader->Close().ok());
+  EXPECT_EQ(m_pool->GetIdleCount(), m_pool->GetOpenCount());
+
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(batch, nullptr);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Errors                          *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(PartitionedReaderTest, YieldsErrorOfOnePartition) {
+  seed(400);
+
+  // SQLite doesn't enforce the declared length, so the last partition overflows its bound buffer
+  execute("UPDATE saildb_rows SET code = 'overflowing' WHERE id = 390");
+
+  auto reader = read("SELECT id, code FROM saildb_rows", getRangeOptions(int64_t{0}, int64_t{400}, 4));
+
+  arrow::Status status;
+  int64_t rowCount = 0;
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    status = reader->ReadNext(&batch);
+    if (!status.ok() || !batch) {
+      break;
+    }
+
+    rowCount += batch->num_rows();
+  }
+
+  ASSERT_FALSE(status.ok());
+  EXPECT_TRUE(status.IsIOError()) << status.ToString();
+  EXPECT_EQ(status.message().rfind("Partition 3: ", 0), 0u) << status.message();
+  EXPECT_NE(status.message().find("truncated"), std::string::npos) << status.message();
+  EXPECT_LT(rowCount, 400);
+
+  // The error sticks, & the remaining worker(s) stop
+  std::shared_ptr<arrow::RecordBatch> batch;
+  EXPECT_TRUE(reader->ReadNext(&batch).IsIOError());
+  EXPECT_EQ(batch, nullptr);
+
+  ASSERT_TRUE(reader->Close().ok());
+  EXPECT_EQ(m_pool->GetIdleCount(), m_pool->GetOpenCount());
+}
+
+TEST_F(PartitionedReaderTest, ThrowsWhenFirstPartitionFails) {
+  EXPECT_THROW(read("SELECT id FROM saildb_missing", getRangeOptions(int64_t{0}, int64_t{100}, 4)), std::runtime_error);
+  EXPECT_TRUE(awaitIdle());
+}
@@ -0,0 +1,105 @@
+#include "PrefetchReader.hpp"
+
+#include <utility>
+#include <algorithm>
+#include <exception>
+
+using PrefetchReader = saildb::PrefetchReader;
+
+/* Static impl. */
+std::shared_ptr<PrefetchReader> PrefetchReader::Create(std::shared_ptr<arrow::RecordBatchReader> source, size_t depth /*= 2*/) {
+  std::shared_ptr<PrefetchReader> reader(new PrefetchReader(std::move(source), std::max<size_t>(depth, 1)));
+
+  // Started once constructed, as the producer refers to the reader's member(s)
+  reader->m_producer = std::thread(&PrefetchReader::produce, reader.get());
+  return reader;
+}
+
+
+/* Ctor & Dtor */
+PrefetchReader::PrefetchReader(std::shared_ptr<arrow::RecordBatchReader> source, size_t depth)
+  : m_source(std::move(source)), m_depth(depth) { };
+
+PrefetchReader::~PrefetchReader() {
+  (void)Close();
+}
+
+
+/* Public impl. */
+std::shared_ptr<arrow::Schema> PrefetchReader::schema() const {
+  return m_source->schema();
+}
+
+arrow::Status PrefetchReader::ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) {
+  std::unique_lock<std::mutex> lock(m_lock);
+  m_notEmpty.wait(lock, [this]() {
+    return !m_queue.empty() || m_isDone || m_isClosed;
+  });
+
+  if (!m_queue.empty()) {
+    *batch = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_notFull.notify_one();
+    return arrow::Status::OK();
+  }
+
+  *batch = nullptr;
+  return m_status;
+}
+
+arrow::Status PrefetchReader::Close() {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_isClosed = true;
+    m_queue.clear();
+  }
+  m_notFull.notify_all();
+  m_notEmpty.notify_all();
+
+  if (m_producer.joinable()) {
+    m_producer.join();
+  }
+
+  return m_source->Close();
+}
+
+
+/* Private impl. */
+void PrefetchReader::produce() {
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_lock);
+      m_notFull.wait(lock, [this]() {
+        return m_queue.size() < m_depth || m_isClosed;
+      });
+
+      if (m_isClosed) {
+        break;
+      }
+    }
+
+    // Fetched outside of the lock, so the consumer can drain the queue meanwhile
+    std::shared_ptr<arrow::RecordBatch> batch;
+    arrow::Status status;
+    try {
+      status = m_source->ReadNext(&batch);
+    } catch (const std::exception& e) {
+      status = arrow::Status::UnknownError(e.what());
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (!status.ok() || !batch) {
+      m_status = std::move(status);
+      m_isDone = true;
+      m_notEmpty.notify_all();
+      break;
+    }
+
+    if (m_isClosed) {
+      break;
+    }
+
+    m_queue.push_back(std::move(batch));
+    m_notEmpty.notify_one();
+  }
+}
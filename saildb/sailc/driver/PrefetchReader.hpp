@@ -0,0 +1,59 @@
+#pragma once
+
+#include <arrow/api.h>
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <condition_variable>
+
+namespace saildb {
+
+/*
+ * Reads ahead of its consumer on a background producer thread
+ *
+ *  - Batch `N + 1` is fetched while the consumer processes batch `N`
+ *  - At most `depth` batch(es) are queued; the producer waits once the queue is full
+ *  - The source's first error is yielded once the batch(es) queued before it are consumed
+ *  - Closing stops the producer once its current fetch returns
+ *
+ */
+class PrefetchReader : public arrow::RecordBatchReader {
+  public:
+    static std::shared_ptr<PrefetchReader> Create(std::shared_ptr<arrow::RecordBatchReader> source, size_t depth = 2);
+
+  public:
+    PrefetchReader(PrefetchReader const&) = delete;
+    PrefetchReader &operator=(PrefetchReader const&) = delete;
+    ~PrefetchReader() override;
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override;
+
+    // Blocks until a batch is available; yields `nullptr` once the source is exhausted
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override;
+    arrow::Status Close() override;
+
+  private:
+    PrefetchReader(std::shared_ptr<arrow::RecordBatchReader> source, size_t depth);
+
+    void produce();
+
+  private:
+    std::shared_ptr<arrow::RecordBatchReader> m_source;
+    const size_t m_depth;
+
+    std::mutex m_lock;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    std::deque<std::shared_ptr<arrow::RecordBatch>> m_queue;
+    arrow::Status m_status;
+    bool m_isDone{false};
+    bool m_isClosed{false};
+
+    std::thread m_producer;
+};
+
+} // namespace saildb
@@ -0,0 +1,316 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <stdexcept>
+#include <condition_variable>
+
+#include "sailc/driver/PrefetchReader.hpp"
+
+using saildb::PrefetchReader;
+
+namespace {
+
+/*
+ * Source of `count` single row batch(es), the Nth holding N
+ *
+ *  - Fails with an `IOError` in place of batch `failAt`, if set, or throws if `throws` is set
+ *  - A blocked source holds each read until unblocked
+ *
+ */
+class ScriptedReader : public arrow::RecordBatchReader {
+  public:
+    explicit ScriptedReader(int64_t count, int64_t failAt = -1, bool throws = false)
+      : m_count(count), m_failAt(failAt), m_throws(throws) { };
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override {
+      return arrow::schema({arrow::field("id", arrow::int64())});
+    }
+
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+      const int64_t index = m_reads.fetch_add(1);
+      {
+        std::unique_lock<std::mutex> lock(m_lock);
+        m_unblocked.wait(lock, [this]() { return !m_isBlocked; });
+      }
+
+      if (index == m_failAt) {
+        if (m_throws) {
+          throw std::runtime_error("Source threw");
+        }
+
+        return arrow::Status::IOError("Source failed");
+      }
+
+      if (index >= m_count) {
+        *batch = nullptr;
+        return arrow::Status::OK();
+      }
+
+      arrow::Int64Builder builder;
+      ARROW_RETURN_NOT_OK(builder.Append(index));
+      std::shared_ptr<arrow::Array> ids;
+      ARROW_RETURN_NOT_OK(builder.Finish(&ids));
+
+      *batch = arrow::RecordBatch::Make(schema(), 1, {ids});
+      return arrow::Status::OK();
+    }
+
+    arrow::Status Close() override {
+      m_closes.fetch_add(1);
+      return arrow::Status::OK();
+    }
+
+  public:
+    void Block() {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_isBlocked = true;
+    }
+
+    void Unblock() {
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_isBlocked = false;
+      }
+      m_unblocked.notify_all();
+    }
+
+    // Read(s) started, including a blocked one
+    int64_t GetReads() const { return m_reads.load(); }
+    int64_t GetCloses() const { return m_closes.load(); }
+
+  private:
+    const int64_t m_count;
+    const int64_t m_failAt;
+    const bool m_throws;
+
+    std::mutex m_lock;
+    std::condition_variable m_unblocked;
+    bool m_isBlocked{false};
+
+    std::atomic<int64_t> m_reads{0};
+    std::atomic<int64_t> m_closes{0};
+};
+
+// Waits for the producer to start `reads` read(s) of the source
+bool awaitReads(const ScriptedReader& source, int64_t reads) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (source.GetReads() < reads) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  return true;
+}
+
+int64_t idOf(const std::shared_ptr<arrow::RecordBatch>& batch) {
+  return std::static_pointer_cast<arrow::Int64Array>(batch->column(0))->Value(0);
+}
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Read-ahead                        *
+ *                                                          *
+ ************************************************************/
+
+TEST(PrefetchReaderTest, YieldsSourceBatchesInOrder) {
+  auto source = std::make_shared<ScriptedReader>(5);
+  auto reader = PrefetchReader::Create(source, 2);
+  EXPECT_TRUE(reader->schema()->Equals(*source->schema()));
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  for (int64_t id = 0; id < 5; ++id) {
+    ASSERT_TRUE(reader->ReadNext(&batch).ok());
+    ASSERT_NE(batch, nullptr);
+    EXPECT_EQ(idOf(batch), id);
+  }
+
+  // Stays exhausted
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(batch, nullptr);
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(batch, nullptr);
+}
+
+TEST(PrefetchReaderTest, StopsReadingAheadAtDepth) {
+  auto source = std::make_shared<ScriptedReader>(10);
+  auto reader = PrefetchReader::Create(source, 3);
+
+  // The producer waits once `depth` batch(es) are queued, without fetching another
+  ASSERT_TRUE(awaitReads(*source, 3));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(source->GetReads(), 3);
+
+  // Each consumed batch frees a single slot
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(idOf(batch), 0);
+  ASSERT_TRUE(awaitReads(*source, 4));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(source->GetReads(), 4);
+}
+
+TEST(PrefetchReaderTest, ClampsDepthToOne) {
+  auto source = std::make_shared<ScriptedReader>(10);
+  auto reader = PrefetchReader::Create(source, 0);
+
+  ASSERT_TRUE(awaitReads(*source, 1));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(source->GetReads(), 1);
+}
+
+TEST(PrefetchReaderTest, WaitsForBlockedFetch) {
+  auto source = std::make_shared<ScriptedReader>(1);
+  source->Block();
+  auto reader = PrefetchReader::Create(source, 2);
+  ASSERT_TRUE(awaitReads(*source, 1));
+
+  auto next = std::async(std::launch::async, [&reader]() {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    EXPECT_TRUE(reader->ReadNext(&batch).ok());
+    return batch;
+  });
+  EXPECT_EQ(next.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  source->Unblock();
+  const auto batch = next.get();
+  ASSERT_NE(batch, nullptr);
+  EXPECT_EQ(idOf(batch), 0);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Close                           *
+ *                                                          *
+ ************************************************************/
+
+TEST(PrefetchReaderTest, ClosesWhileQueueIsFull) {
+  auto source = std::make_shared<ScriptedReader>(100);
+  auto reader = PrefetchReader::Create(source, 2);
+  ASSERT_TRUE(awaitReads(*source, 2));
+
+  // The waiting producer is woken & joined, & the queued batch(es) dropped
+  const auto start = std::chrono::steady_clock::now();
+  ASSERT_TRUE(reader->Close().ok());
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  EXPECT_EQ(source->GetReads(), 2);
+  EXPECT_EQ(source->GetCloses(), 1);
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(batch, nullptr);
+}
+
+TEST(PrefetchReaderTest, ClosesOnceCurrentFetchReturns) {
+  auto source = std::make_shared<ScriptedReader>(100);
+  auto reader = PrefetchReader::Create(source, 2);
+  ASSERT_TRUE(awaitReads(*source, 2));
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  source->Block();
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  ASSERT_TRUE(awaitReads(*source, 3));
+
+  auto closed = std::async(std::launch::async, [&reader]() { return reader->Close(); });
+  EXPECT_EQ(closed.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  // The fetched batch is discarded rather than queued
+  source->Unblock();
+  ASSERT_TRUE(closed.get().ok());
+  EXPECT_EQ(source->GetReads(), 3);
+
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(batch, nullptr);
+}
+
+TEST(PrefetchReaderTest, WakesConsumerOnClose) {
+  auto source = std::make_shared<ScriptedReader>(10);
+  source->Block();
+  auto reader = PrefetchReader::Create(source, 2);
+  ASSERT_TRUE(awaitReads(*source, 1));
+
+  auto next = std::async(std::launch::async, [&reader]() {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    const arrow::Status status = reader->ReadNext(&batch);
+    return status.ok() && batch == nullptr;
+  });
+  EXPECT_EQ(next.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  // The consumer is released at once, while the producer is only joined once its fetch returns
+  auto closed = std::async(std::launch::async, [&reader]() { return reader->Close(); });
+  EXPECT_TRUE(next.get());
+
+  source->Unblock();
+  EXPECT_TRUE(closed.get().ok());
+}
+
+TEST(PrefetchReaderTest, ClosesOnDestruction) {
+  auto source = std::make_shared<ScriptedReader>(100);
+  {
+    auto reader = PrefetchReader::Create(source, 2);
+    ASSERT_TRUE(awaitReads(*source, 2));
+  }
+
+  EXPECT_EQ(source->GetCloses(), 1);
+  EXPECT_EQ(source->GetReads(), 2);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Errors                          *
+ *                                                          *
+ ************************************************************/
+
+TEST(PrefetchReaderTest, YieldsErrorAfterQueuedBatches) {
+  auto source = std::make_shared<ScriptedReader>(10, 2);
+  auto reader = PrefetchReader::Create(source, 4);
+  ASSERT_TRUE(awaitReads(*source, 3));
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  for (int64_t id = 0; id < 2; ++id) {
+    ASSERT_TRUE(reader->ReadNext(&batch).ok());
+    ASSERT_NE(batch, nullptr);
+    EXPECT_EQ(idOf(batch), id);
+  }
+
+  // The producer stops at the error, which is then yielded on every read
+  arrow::Status status = reader->ReadNext(&batch);
+  EXPECT_TRUE(status.IsIOError());
+  EXPECT_EQ(status.message(), "Source failed");
+  EXPECT_EQ(batch, nullptr);
+
+  EXPECT_TRUE(reader->ReadNext(&batch).IsIOError());
+  EXPECT_EQ(source->GetReads(), 3);
+}
+
+TEST(PrefetchReaderTest, YieldsThrownErrorAsStatus) {
+  auto source = std::make_shared<ScriptedReader>(10, 0, true);
+  auto reader = PrefetchReader::Create(source, 2);
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  const arrow::Status status = reader->ReadNext(&batch);
+  EXPECT_TRUE(status.IsUnknownError());
+  EXPECT_EQ(status.message(), "Source threw");
+  EXPECT_EQ(batch, nullptr);
+
+  EXPECT_TRUE(reader->Close().ok());
+  EXPECT_EQ(source->GetCloses(), 1);
+}
@@ -0,0 +1,592 @@
+#include "ResultCache.hpp"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/api.h>
+#include <arrow/util/compression.h>
+#include <arrow/util/key_value_metadata.h>
+
+#include <random>
+#include <vector>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <system_error>
+
+#include "sailc/common/strutil.hpp"
+#include "sailc/driver/StatementCache.hpp"
+
+namespace fs = std::filesystem;
+namespace common = saildb::common;
+
+using ResultCache = saildb::ResultCache;
+
+// Footer metadata holding the entry's key
+constexpr const char* RESULT_CACHE_KEY = "saildb.result_cache.key";
+
+// Leading byte(s) of an Arrow IPC file
+constexpr std::string_view ARROW_FILE_MAGIC = "ARROW1";
+
+// Length of a key's hash as hex, i.e. of a cached result's file stem
+constexpr size_t KEY_HASH_LENGTH = 16;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Utils                           *
+ *                                                          *
+ ************************************************************/
+
+// File name of `key`, i.e. its 64-bit FNV-1a hash as hex
+std::string hashKey(std::string_view key) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (const char ch : key) {
+    hash ^= static_cast<uint8_t>(ch);
+    hash *= 0x100000001b3ull;
+  }
+
+  static constexpr const char digits[] = "0123456789abcdef";
+
+  std::string result(16, '0');
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[result.size() - i - 1] = digits[(hash >> (i * 4)) & 0xf];
+  }
+
+  return result;
+}
+
+bool isKeyHash(std::string_view name) {
+  return name.size() == KEY_HASH_LENGTH && std::all_of(name.begin(), name.end(), [](char ch) {
+    return (ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f');
+  });
+}
+
+// Whether `path` is a cached result, i.e. named by a key's hash & an Arrow IPC file, rather than
+// another file sharing the directory
+bool isResultFile(const fs::path& path) {
+  if (path.extension() != ".arrow" || !::isKeyHash(path.stem().string())) {
+    return false;
+  }
+
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  char magic[ARROW_FILE_MAGIC.size()];
+  return file.read(magic, sizeof(magic)) && std::string_view(magic, sizeof(magic)) == ARROW_FILE_MAGIC;
+}
+
+// Whether `path` is a writer's temporary file, i.e. `<hash>.<token>-<sequence>.tmp`
+bool isTemporaryFile(const fs::path& path) {
+  if (path.extension() != ".tmp") {
+    return false;
+  }
+
+  const std::string stem = path.stem().string();
+  const size_t sequence = 2 * KEY_HASH_LENGTH + 2;
+  if (stem.size() <= sequence || stem[KEY_HASH_LENGTH] != '.' || stem[sequence - 1] != '-') {
+    return false;
+  }
+
+  const std::string_view name(stem);
+  return (
+    ::isKeyHash(name.substr(0, KEY_HASH_LENGTH)) &&
+    ::isKeyHash(name.substr(KEY_HASH_LENGTH + 1, KEY_HASH_LENGTH)) &&
+    std::all_of(name.begin() + sequence, name.end(), [](char ch) { return ch >= '0' && ch <= '9'; })
+  );
+}
+
+bool isPasswordAttribute(std::string_view name) {
+  name = common::trimView(name);
+
+  const auto matches = [&name](std::string_view expected) {
+    return std::equal(name.begin(), name.end(), expected.begin(), expected.end(), [](char a, char b) {
+      return (a >= 'a' && a <= 'z' ? a - ('a' - 'A') : a) == b;
+    });
+  };
+
+  return matches("PWD") || matches("PASSWORD");
+}
+
+// Connection string without its password attribute(s); braced value(s) may contain `;` & `}}` escape(s)
+std::string stripPassword(std::string_view connectionString) {
+  std::string result;
+  result.reserve(connectionString.size());
+
+  size_t start = 0;
+  while (start < connectionString.size()) {
+    size_t end = connectionString.find_first_of("=;", start);
+    const std::string_view name = connectionString.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start);
+
+    if (end != std::string_view::npos && connectionString[end] == '=') {
+      ++end;
+      if (end < connectionString.size() && connectionString[end] == '{') {
+        for (++end; end < connectionString.size(); ++end) {
+          if (connectionString[end] != '}') {
+            continue;
+          }
+
+          if (end + 1 < connectionString.size() && connectionString[end + 1] == '}') {
+            ++end;
+            continue;
+          }
+
+          break;
+        }
+      }
+
+      end = connectionString.find(';', std::min(end, connectionString.size()));
+    }
+
+    end = end == std::string_view::npos ? connectionString.size() : end + 1;
+    if (!::isPasswordAttribute(name)) {
+      result.append(connectionString.substr(start, end - start));
+    }
+
+    start = end;
+  }
+
+  return result;
+}
+
+// Distinguishes the temporary file(s) of this cache from those of other process(es)
+std::string makeToken() {
+  std::random_device device;
+  const uint64_t value = (static_cast<uint64_t>(device()) << 32) | device();
+
+  return ::hashKey(std::string_view(reinterpret_cast<const char*>(&value), sizeof(value)));
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Reader                          *
+ *                                                          *
+ ************************************************************/
+
+// Batch(es) of a memory-mapped IPC file, in order
+class MappedResultReader : public arrow::RecordBatchReader {
+  public:
+    MappedResultReader(std::shared_ptr<arrow::ipc::RecordBatchFileReader> file)
+      : m_file(std::move(file)), m_schema(m_file->schema()) { };
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override {
+      return m_schema;
+    }
+
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+      if (!m_file || m_index >= m_file->num_record_batches()) {
+        *batch = nullptr;
+        return arrow::Status::OK();
+      }
+
+      auto result = m_file->ReadRecordBatch(m_index++);
+      if (!result.ok()) {
+        return result.status();
+      }
+
+      *batch = result.MoveValueUnsafe();
+      return arrow::Status::OK();
+    }
+
+    // Batch(es) already read keep the mapping alive
+    arrow::Status Close() override {
+      m_file = nullptr;
+      return arrow::Status::OK();
+    }
+
+  private:
+    std::shared_ptr<arrow::ipc::RecordBatchFileReader> m_file;
+    std::shared_ptr<arrow::Schema> m_schema;
+    int m_index{0};
+};
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Writer                          *
+ *                                                          *
+ ************************************************************/
+
+/*
+ * Passes its source's batch(es) through while writing them to a temporary file, published once the
+ * source is exhausted; write error(s) only abandon the file, never the read
+ */
+class ResultCache::Writer : public arrow::RecordBatchReader {
+  public:
+    Writer(std::shared_ptr<ResultCache> cache, std::string name, const std::string& key, std::shared_ptr<arrow::RecordBatchReader> source)
+      : m_cache(std::move(cache)), m_name(std::move(name)), m_source(std::move(source)) {
+      m_path = m_cache->getTemporaryPath(m_name);
+
+      auto stream = arrow::io::FileOutputStream::Open(m_path.string());
+      if (!stream.ok()) {
+        return;
+      }
+
+      m_stream = stream.MoveValueUnsafe();
+
+      arrow::ipc::IpcWriteOptions options = arrow::ipc::IpcWriteOptions::Defaults();
+      if (m_cache->m_options.compression != ResultCompression::None) {
+        auto codec = arrow::util::Codec::Create(
+          m_cache->m_options.compression == ResultCompression::Lz4 ? arrow::Compression::LZ4_FRAME : arrow::Compression::ZSTD
+        );
+
+        if (!codec.ok()) {
+          abandon();
+          return;
+        }
+
+        options.codec = std::shared_ptr<arrow::util::Codec>(codec.MoveValueUnsafe());
+      }
+
+      auto writer = arrow::ipc::MakeFileWriter(m_stream, m_source->schema(), options, arrow::key_value_metadata({ RESULT_CACHE_KEY }, { key }));
+      if (!writer.ok()) {
+        abandon();
+        return;
+      }
+
+      m_writer = writer.MoveValueUnsafe();
+    }
+
+    ~Writer() override {
+      abandon();
+    }
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override {
+      return m_source->schema();
+    }
+
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+      const arrow::Status status = m_source->ReadNext(batch);
+      if (!status.ok()) {
+        abandon();
+        return status;
+      }
+
+      if (!m_writer) {
+        return arrow::Status::OK();
+      }
+
+      if (*batch) {
+        write(**batch);
+      } else {
+        publish();
+      }
+
+      return arrow::Status::OK();
+    }
+
+    // An incomplete result isn't cached
+    arrow::Status Close() override {
+      abandon();
+      return m_source->Close();
+    }
+
+  private:
+    void write(const arrow::RecordBatch& batch) {
+      if (!m_writer->WriteRecordBatch(batch).ok()) {
+        abandon();
+        return;
+      }
+
+      auto position = m_stream->Tell();
+      if (!position.ok() || static_cast<uint64_t>(*position) > m_cache->m_options.maxBytes) {
+        abandon();
+      }
+    }
+
+    void publish() {
+      auto position = m_writer->Close().ok() ? m_stream->Tell() : arrow::Result<int64_t>(arrow::Status::IOError("Failed to write footer"));
+      if (!position.ok() || !m_stream->Close().ok()) {
+        abandon();
+        return;
+      }
+
+      m_writer = nullptr;
+      m_stream = nullptr;
+      m_cache->publish(m_name, m_path, static_cast<uint64_t>(*position));
+    }
+
+    void abandon() {
+      if (!m_stream) {
+        return;
+      }
+
+      m_writer = nullptr;
+      (void)m_stream->Close();
+      m_stream = nullptr;
+
+      std::error_code error;
+      fs::remove(m_path, error);
+    }
+
+  private:
+    std::shared_ptr<ResultCache> m_cache;
+    const std::string m_name;
+    fs::path m_path;
+
+    std::shared_ptr<arrow::RecordBatchReader> m_source;
+    std::shared_ptr<arrow::io::FileOutputStream> m_stream;
+    std::shared_ptr<arrow::ipc::RecordBatchWriter> m_writer;
+};
+
+
+
+/************************************************************
+ *                                                          *
+ *                        ResultCache                       *
+ *                                                          *
+ ************************************************************/
+
+/* Static impl. */
+std::shared_ptr<ResultCache> ResultCache::Create(saildb::ResultCacheOptions options, std::string account) {
+  std::error_code error;
+  fs::create_directories(options.directory, error);
+  if (error) {
+    throw std::runtime_error(std::string("Failed to create result cache directory, got err: ").append(error.message()));
+  }
+
+  if (options.compression != ResultCompression::None) {
+    const arrow::Compression::type codec = options.compression == ResultCompression::Lz4 ? arrow::Compression::LZ4_FRAME : arrow::Compression::ZSTD;
+    if (!arrow::util::Codec::IsAvailable(codec)) {
+      throw std::runtime_error(std::string("Failed to create result cache, codec unavailable: ").append(arrow::util::Codec::GetCodecAsString(codec)));
+    }
+  }
+
+  std::shared_ptr<ResultCache> cache(new ResultCache(std::move(options), std::move(account)));
+  {
+    std::lock_guard<std::mutex> lock(cache->m_lock);
+    cache->scan();
+  }
+
+  return cache;
+}
+
+
+/* Ctor & Dtor */
+ResultCache::ResultCache(saildb::ResultCacheOptions options, std::string account)
+  : m_options(std::move(options)), m_account(std::move(account)), m_token(::makeToken()) { };
+
+ResultCache::~ResultCache() = default;
+
+
+/* Public impl. */
+std::string ResultCache::GetKey(std::string_view connectionString, std::string_view query, std::string_view parameters /*= {}*/) const {
+  std::string result = ::stripPassword(connectionString);
+  result.push_back('\0');
+  result.append(m_account);
+  result.push_back('\0');
+  result.append(saildb::StatementCache::Normalise(query));
+  result.push_back('\0');
+  result.append(parameters);
+
+  return result;
+}
+
+std::shared_ptr<arrow::RecordBatchReader> ResultCache::Get(const std::string& key) {
+  const std::string name = ::hashKey(key);
+  const fs::path path = getPath(name);
+
+  const auto miss = [this]() -> std::shared_ptr<arrow::RecordBatchReader> {
+    std::lock_guard<std::mutex> lock(m_lock);
+    ++m_misses;
+    return nullptr;
+  };
+
+  std::error_code error;
+  const fs::file_time_type modified = fs::last_write_time(path, error);
+  if (error) {
+    return miss();
+  }
+
+  if (fs::file_time_type::clock::now() - modified > m_options.ttl) {
+    if (!::isResultFile(path)) {
+      return miss();
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    remove(name);
+    ++m_misses;
+    return nullptr;
+  }
+
+  auto file = arrow::io::MemoryMappedFile::Open(path.string(), arrow::io::FileMode::READ);
+  if (!file.ok()) {
+    return miss();
+  }
+
+  auto reader = arrow::ipc::RecordBatchFileReader::Open(*file);
+  if (!reader.ok()) {
+    return miss();
+  }
+
+  // A collision of the key's hash, overwritten once the result is put
+  const auto metadata = (*reader)->metadata();
+  if (!metadata || metadata->Get(RESULT_CACHE_KEY).ValueOr(std::string()) != key) {
+    return miss();
+  }
+
+  auto size = (*file)->GetSize();
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    touch(name, size.ok() ? static_cast<uint64_t>(*size) : 0);
+    ++m_hits;
+  }
+
+  return std::make_shared<MappedResultReader>(reader.MoveValueUnsafe());
+}
+
+std::shared_ptr<arrow::RecordBatchReader> ResultCache::Put(const std::string& key, std::shared_ptr<arrow::RecordBatchReader> reader) {
+  return std::make_shared<ResultCache::Writer>(shared_from_this(), ::hashKey(key), key, std::move(reader));
+}
+
+void ResultCache::Clear() {
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  std::error_code error;
+  for (const auto& entry : fs::directory_iterator(m_options.directory, error)) {
+    std::error_code entryError;
+    if (entry.is_regular_file(entryError) && ::isResultFile(entry.path())) {
+      fs::remove(entry.path(), entryError);
+    }
+  }
+
+  m_index.clear();
+  m_entries.clear();
+  m_bytes = 0;
+}
+
+const saildb::ResultCacheOptions& ResultCache::GetOptions() const {
+  return m_options;
+}
+
+size_t ResultCache::GetSize() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_entries.size();
+}
+
+uint64_t ResultCache::GetBytes() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_bytes;
+}
+
+uint64_t ResultCache::GetHits() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_hits;
+}
+
+uint64_t ResultCache::GetMisses() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_misses;
+}
+
+uint64_t ResultCache::GetEvictions() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_evictions;
+}
+
+
+/* Private impl. */
+fs::path ResultCache::getPath(std::string_view name) const {
+  return m_options.directory / (std::string(name) + ".arrow");
+}
+
+fs::path ResultCache::getTemporaryPath(std::string_view name) {
+  const uint64_t sequence = m_sequence.fetch_add(1, std::memory_order_relaxed);
+  return m_options.directory / (std::string(name) + "." + m_token + "-" + std::to_string(sequence) + ".tmp");
+}
+
+void ResultCache::publish(const std::string& name, const fs::path& temporary, uint64_t size) {
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  // Fails where the previous file is still mapped, e.g. on Windows
+  std::error_code error;
+  fs::rename(temporary, getPath(name), error);
+  if (error) {
+    fs::remove(temporary, error);
+    return;
+  }
+
+  touch(name, size);
+  evict();
+}
+
+void ResultCache::scan() {
+  struct Found {
+    fs::file_time_type modified;
+    std::string name;
+    uint64_t size;
+  };
+
+  const auto now = fs::file_time_type::clock::now();
+
+  std::vector<Found> found;
+  std::error_code error;
+  for (const auto& entry : fs::directory_iterator(m_options.directory, error)) {
+    std::error_code entryError;
+    const fs::file_time_type modified = entry.last_write_time(entryError);
+    if (entryError || !entry.is_regular_file(entryError)) {
+      continue;
+    }
+
+    // Other file(s) sharing the directory are neither indexed nor removed
+    const fs::path& path = entry.path();
+    const bool isExpired = now - modified > m_options.ttl;
+    if (::isResultFile(path)) {
+      if (isExpired) {
+        fs::remove(path, entryError);
+      } else {
+        found.push_back({ modified, path.stem().string(), static_cast<uint64_t>(entry.file_size(entryError)) });
+      }
+    } else if (isExpired && ::isTemporaryFile(path)) {
+      // Temporary file(s) this old were abandoned by their writer
+      fs::remove(path, entryError);
+    }
+  }
+
+  std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) { return a.modified < b.modified; });
+  for (const Found& entry : found) {
+    touch(entry.name, entry.size);
+  }
+
+  evict();
+}
+
+void ResultCache::touch(const std::string& name, uint64_t size) {
+  const auto it = m_index.find(name);
+  if (it != m_index.end()) {
+    m_bytes -= it->second->size;
+    it->second->size = size;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+  } else {
+    m_entries.push_front({ name, size });
+    m_index.emplace(m_entries.front().name, m_entries.begin());
+  }
+
+  m_bytes += size;
+}
+
+void ResultCache::remove(const std::string& name) {
+  std::error_code error;
+  fs::remove(getPath(name), error);
+
+  const auto it = m_index.find(name);
+  if (it == m_index.end()) {
+    return;
+  }
+
+  const auto entry = it->second;
+  m_index.erase(it);
+
+  m_bytes -= entry->size;
+  m_entries.erase(entry);
+}
+
+void ResultCache::evict() {
+  while (m_bytes > m_options.maxBytes && !m_entries.empty()) {
+    remove(std::string(m_entries.back().name));
+    ++m_evictions;
+  }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <arrow/api.h>
+
+#include <list>
+#include <mutex>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
+
+namespace saildb {
+
+// Buffer compression of cached result(s)
+enum class ResultCompression : uint8_t {
+  None,
+  Lz4,
+  Zstd,
+};
+
+struct ResultCacheOptions {
+  std::filesystem::path directory;                      // Root of the cached file(s), created if missing
+  std::chrono::seconds ttl{3'600};                      // Result(s) older than this are stale & read from the server again
+  uint64_t maxBytes{1ull << 30};                        // Upper bound of the cache's size on disk, beyond which the least recently used result(s) are evicted
+  ResultCompression compression{ResultCompression::None}; // Compressed buffer(s) are decompressed when read, i.e. not zero-copy
+};
+
+/*
+ * Opt-in cache of query result(s) as Arrow IPC (Feather V2) file(s), keyed by a hash of the connection
+ * string, the account, the normalised query & its parameter(s)
+ *
+ *  - Hit(s) are read from a memory-mapped file without touching the server; uncompressed batch(es)
+ *    reference the mapping rather than copying it
+ *  - Result(s) are written while they're consumed & published by rename once exhausted; a result that's
+ *    closed early, fails or outgrows `maxBytes` isn't cached
+ *  - The index is rebuilt from the directory on creation, ordered by modification time; process(es) sharing
+ *    a directory evict independently, so the bound is approximate across them
+ *  - Password(s) are stripped from the connection string; the key is kept in the file's footer to rule out
+ *    collision(s) of its hash
+ *  - Only file(s) named by a key's hash that start with the Arrow IPC magic, & the writer(s)' temporary
+ *    file(s), are indexed, evicted or removed; other file(s) sharing the directory are left as found
+ *
+ */
+class ResultCache : public std::enable_shared_from_this<ResultCache> {
+  public:
+    // Throws if the directory can't be created or the codec isn't available
+    static std::shared_ptr<ResultCache> Create(ResultCacheOptions options, std::string account);
+
+  public:
+    ResultCache(ResultCache const&) = delete;
+    ResultCache &operator=(ResultCache const&) = delete;
+    ~ResultCache();
+
+  public:
+    // `parameters` is an unambiguous encoding of the statement's parameter value(s), if any
+    std::string GetKey(std::string_view connectionString, std::string_view query, std::string_view parameters = {}) const;
+
+    // Reader of the cached result of `key`, or `nullptr` if it's missing or expired
+    std::shared_ptr<arrow::RecordBatchReader> Get(const std::string& key);
+
+    // Reader yielding the batch(es) of `reader`, which are cached as `key` once it's exhausted
+    std::shared_ptr<arrow::RecordBatchReader> Put(const std::string& key, std::shared_ptr<arrow::RecordBatchReader> reader);
+
+    // Removes every cached result of the directory, leaving other file(s) as found
+    void Clear();
+
+    const ResultCacheOptions& GetOptions() const;
+    size_t GetSize() const;
+    uint64_t GetBytes() const;
+    uint64_t GetHits() const;
+    uint64_t GetMisses() const;
+    uint64_t GetEvictions() const;
+
+  private:
+    class Writer;
+    friend class Writer;
+
+    struct Entry {
+      std::string name;
+      uint64_t size{0};
+    };
+
+    ResultCache(ResultCacheOptions options, std::string account);
+
+    std::filesystem::path getPath(std::string_view name) const;
+    std::filesystem::path getTemporaryPath(std::string_view name);
+
+    // Moves a completed file into place as the most recently used entry
+    void publish(const std::string& name, const std::filesystem::path& temporary, uint64_t size);
+
+    // Expects `m_lock` to be held
+    void scan();
+    void touch(const std::string& name, uint64_t size);
+    void remove(const std::string& name);
+    void evict();
+
+  private:
+    const ResultCacheOptions m_options;
+    const std::string m_account;
+    const std::string m_token;
+    std::atomic<uint64_t> m_sequence{0};
+
+    mutable std::mutex m_lock;
+
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> m_index;
+    uint64_t m_bytes{0};
+
+    uint64_t m_hits{0};
+    uint64_t m_misses{0};
+    uint64_t m_evictions{0};
+};
+
+} // namespace saildb
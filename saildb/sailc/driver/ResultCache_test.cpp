@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <arrow/ipc/api.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+#include "sailc/driver/ResultCache.hpp"
+
+namespace fs = std::filesystem;
+
+using saildb::ResultCache;
+using saildb::ResultCacheOptions;
+
+namespace {
+
+std::shared_ptr<arrow::RecordBatch> makeBatch(int64_t start, int64_t count) {
+  arrow::Int64Builder builder;
+  for (int64_t id = start; id < start + count; ++id) {
+    EXPECT_TRUE(builder.Append(id).ok());
+  }
+
+  std::shared_ptr<arrow::Array> ids;
+  EXPECT_TRUE(builder.Finish(&ids).ok());
+  return arrow::RecordBatch::Make(arrow::schema({arrow::field("id", arrow::int64())}), count, {ids});
+}
+
+// `count` row(s) of `id`s from `start`, in batch(es) of 100 row(s)
+std::shared_ptr<arrow::RecordBatchReader> makeReader(int64_t start, int64_t count) {
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int64_t offset = 0; offset < count; offset += 100) {
+    batches.push_back(makeBatch(start + offset, std::min<int64_t>(100, count - offset)));
+  }
+
+  return arrow::RecordBatchReader::Make(std::move(batches), arrow::schema({arrow::field("id", arrow::int64())})).ValueOrDie();
+}
+
+std::vector<int64_t> drain(arrow::RecordBatchReader& reader) {
+  std::vector<int64_t> ids;
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    EXPECT_TRUE(reader.ReadNext(&batch).ok());
+    if (!batch) {
+      return ids;
+    }
+
+    const auto column = std::static_pointer_cast<arrow::Int64Array>(batch->column(0));
+    for (int64_t i = 0; i < column->length(); ++i) {
+      ids.push_back(column->Value(i));
+    }
+  }
+}
+
+std::string readFile(const fs::path& path) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return contents.str();
+}
+
+/*
+ * Cache directory of a test, shared with file(s) the cache doesn't own
+ *
+ *  - `report.arrow`: an Arrow IPC file not named by a key's hash
+ *  - `0123456789abcdef.arrow`: named like a cached result, but not an Arrow IPC file
+ *  - `export.tmp`: a temporary file of another writer
+ *
+ */
+class ResultCacheTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      const char* directory = std::getenv("TEST_TMPDIR");
+      m_directory = (directory != nullptr ? fs::path(directory) : fs::temp_directory_path()) / (
+        std::string("saildb_results_").append(::testing::UnitTest::GetInstance()->current_test_info()->name())
+      );
+
+      std::error_code error;
+      fs::remove_all(m_directory, error);
+      fs::create_directories(m_directory);
+
+      writeForeignArrow(m_directory / "report.arrow");
+      std::ofstream(m_directory / "0123456789abcdef.arrow", std::ios::binary) << "not a cached result";
+      std::ofstream(m_directory / "export.tmp", std::ios::binary) << "not a cache's temporary file";
+
+      for (const char* name : FOREIGN) {
+        m_foreign.emplace_back(name, readFile(m_directory / name));
+      }
+    }
+
+    void TearDown() override {
+      std::error_code error;
+      fs::remove_all(m_directory, error);
+    }
+
+    std::shared_ptr<ResultCache> create(uint64_t maxBytes = 1ull << 30, std::chrono::seconds ttl = std::chrono::seconds(3'600)) {
+      ResultCacheOptions options;
+      options.directory = m_directory;
+      options.ttl = ttl;
+      options.maxBytes = maxBytes;
+
+      return ResultCache::Create(std::move(options), "account");
+    }
+
+    // Caches `count` row(s) from `start` as `key`
+    static void put(ResultCache& cache, const std::string& key, int64_t start, int64_t count) {
+      auto writer = cache.Put(key, makeReader(start, count));
+      EXPECT_EQ(drain(*writer).size(), static_cast<size_t>(count));
+    }
+
+    // Result file(s) of the cache, i.e. excluding the foreign one named like one
+    std::vector<fs::path> results() const {
+      std::vector<fs::path> paths;
+      for (const auto& entry : fs::directory_iterator(m_directory)) {
+        const fs::path& path = entry.path();
+        if (path.extension() == ".arrow" && path.stem().string().size() == 16 && path.filename() != "0123456789abcdef.arrow") {
+          paths.push_back(path);
+        }
+      }
+
+      return paths;
+    }
+
+    void expire(const fs::path& path) const {
+      fs::last_write_time(path, fs::file_time_type::clock::now() - std::chrono::hours(2));
+    }
+
+    void expectForeignFilesIntact() const {
+      for (const auto& [name, contents] : m_foreign) {
+        ASSERT_TRUE(fs::exists(m_directory / name)) << name;
+        EXPECT_EQ(readFile(m_directory / name), contents) << name;
+      }
+    }
+
+  private:
+    static void writeForeignArrow(const fs::path& path) {
+      auto stream = arrow::io::FileOutputStream::Open(path.string()).ValueOrDie();
+      auto batch = makeBatch(0, 10);
+      auto writer = arrow::ipc::MakeFileWriter(stream, batch->schema()).ValueOrDie();
+      ASSERT_TRUE(writer->WriteRecordBatch(*batch).ok());
+      ASSERT_TRUE(writer->Close().ok());
+      ASSERT_TRUE(stream->Close().ok());
+    }
+
+  protected:
+    static constexpr const char* FOREIGN[] = {"report.arrow", "0123456789abcdef.arrow", "export.tmp"};
+
+    fs::path m_directory;
+    std::vector<std::pair<std::string, std::string>> m_foreign;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Cache                           *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ResultCacheTest, ServesPutResult) {
+  auto cache = create();
+  const std::string key = cache->GetKey("Driver=SQLite3;PWD=secret;", "SELECT id FROM t");
+  EXPECT_EQ(cache->Get(key), nullptr);
+
+  put(*cache, key, 0, 250);
+  EXPECT_EQ(cache->GetSize(), 1u);
+  EXPECT_EQ(results().size(), 1u);
+
+  auto reader = cache->Get(key);
+  ASSERT_NE(reader, nullptr);
+  const std::vector<int64_t> ids = drain(*reader);
+  ASSERT_EQ(ids.size(), 250u);
+  EXPECT_EQ(ids.front(), 0);
+  EXPECT_EQ(ids.back(), 249);
+
+  EXPECT_EQ(cache->GetHits(), 1u);
+  EXPECT_EQ(cache->GetMisses(), 1u);
+}
+
+TEST_F(ResultCacheTest, DoesNotCacheResultClosedEarly) {
+  auto cache = create();
+  const std::string key = cache->GetKey("Driver=SQLite3;", "SELECT id FROM t");
+
+  auto writer = cache->Put(key, makeReader(0, 250));
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_TRUE(writer->ReadNext(&batch).ok());
+  ASSERT_TRUE(writer->Close().ok());
+
+  EXPECT_EQ(cache->GetSize(), 0u);
+  EXPECT_EQ(cache->Get(key), nullptr);
+
+  // Its temporary file is removed, the foreign one kept
+  for (const auto& entry : fs::directory_iterator(m_directory)) {
+    EXPECT_TRUE(entry.path().extension() != ".tmp" || entry.path().filename() == "export.tmp") << entry.path();
+  }
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                       Foreign files                      *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ResultCacheTest, ScanIndexesOnlyOwnedFiles) {
+  const uint64_t bytes = [this]() {
+    auto cache = create();
+    put(*cache, cache->GetKey("Driver=SQLite3;", "SELECT 1"), 0, 250);
+    return cache->GetBytes();
+  }();
+
+  // Rebuilt from the directory, where the foreign file(s) are ignored
+  auto cache = create();
+  EXPECT_EQ(cache->GetSize(), 1u);
+  EXPECT_EQ(cache->GetBytes(), bytes);
+  EXPECT_EQ(bytes, fs::file_size(results().front()));
+  expectForeignFilesIntact();
+}
+
+TEST_F(ResultCacheTest, ScanRemovesOnlyOwnedExpiredFiles) {
+  {
+    auto cache = create();
+    put(*cache, cache->GetKey("Driver=SQLite3;", "SELECT 1"), 0, 250);
+  }
+
+  ASSERT_EQ(results().size(), 1u);
+  expire(results().front());
+  for (const char* name : FOREIGN) {
+    expire(m_directory / name);
+  }
+
+  auto cache = create();
+  EXPECT_EQ(cache->GetSize(), 0u);
+  EXPECT_TRUE(results().empty());
+  expectForeignFilesIntact();
+}
+
+TEST_F(ResultCacheTest, EvictsOnlyOwnedFiles) {
+  const uint64_t bytes = [this]() {
+    auto cache = create();
+    put(*cache, cache->GetKey("Driver=SQLite3;", "SELECT 1"), 0, 250);
+    return cache->GetBytes();
+  }();
+
+  // Foreign byte(s) don't count towards the bound, which fits a single result
+  std::ofstream(m_directory / "large.bin", std::ios::binary) << std::string(4 * bytes, 'x');
+  auto cache = create(bytes + bytes / 2);
+  EXPECT_EQ(cache->GetSize(), 1u);
+  EXPECT_EQ(cache->GetEvictions(), 0u);
+
+  const std::string key = cache->GetKey("Driver=SQLite3;", "SELECT 2");
+  put(*cache, key, 1000, 250);
+  EXPECT_EQ(cache->GetSize(), 1u);
+  EXPECT_EQ(cache->GetEvictions(), 1u);
+  EXPECT_EQ(results().size(), 1u);
+  EXPECT_EQ(cache->Get(cache->GetKey("Driver=SQLite3;", "SELECT 1")), nullptr);
+  EXPECT_NE(cache->Get(key), nullptr);
+
+  expectForeignFilesIntact();
+  EXPECT_TRUE(fs::exists(m_directory / "large.bin"));
+}
+
+TEST_F(ResultCacheTest, ClearRemovesOnlyOwnedFiles) {
+  auto cache = create();
+  put(*cache, cache->GetKey("Driver=SQLite3;", "SELECT 1"), 0, 250);
+  put(*cache, cache->GetKey("Driver=SQLite3;", "SELECT 2"), 0, 250);
+  ASSERT_EQ(results().size(), 2u);
+
+  cache->Clear();
+  EXPECT_EQ(cache->GetSize(), 0u);
+  EXPECT_EQ(cache->GetBytes(), 0u);
+  EXPECT_TRUE(results().empty());
+  expectForeignFilesIntact();
+}
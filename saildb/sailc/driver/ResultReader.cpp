@@ -0,0 +1,743 @@
+#include "ResultReader.hpp"
+
+#include <chrono>
+#include <utility>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using ResultReader = saildb::ResultReader;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Utils                           *
+ *                                                          *
+ ************************************************************/
+
+template <typename T>
+T unwrap(arrow::Result<T> result) {
+  if (!result.ok()) {
+    throw std::runtime_error(result.status().ToString());
+  }
+
+  return std::move(result).ValueUnsafe();
+}
+
+void unwrap(const arrow::Status& status) {
+  if (!status.ok()) {
+    throw std::runtime_error(status.ToString());
+  }
+}
+
+int32_t toDays(SQLSMALLINT year, SQLUSMALLINT month, SQLUSMALLINT day) {
+  const std::chrono::year_month_day date{
+    std::chrono::year{year},
+    std::chrono::month{month},
+    std::chrono::day{day}
+  };
+
+  return static_cast<int32_t>(std::chrono::sys_days(date).time_since_epoch().count());
+}
+
+// Byte length of a bound value, or -1 if the driver truncated it
+SQLLEN getBoundLength(SQLLEN indicator, SQLLEN elementSize, SQLLEN terminatorSize) {
+  if (indicator == SQL_NO_TOTAL || indicator > elementSize - terminatorSize) {
+    return -1;
+  }
+
+  return indicator;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                       ResultReader                       *
+ *                                                          *
+ ************************************************************/
+
+/* Static impl. */
+std::shared_ptr<ResultReader> ResultReader::Create(saildb::PooledConnection connection, std::string_view query, saildb::ReaderOptions options /*= ReaderOptions()*/) {
+  if (!connection) {
+    throw std::invalid_argument("Expected a leased connection");
+  }
+
+  auto lease = std::make_shared<saildb::PooledConnection>(std::move(connection));
+  SQLHDBC handle = static_cast<SQLHDBC>((*lease)->native_dbc_handle());
+
+  std::string key = saildb::StatementCache::GetKey(query, {});
+  saildb::PreparedStatement statement = lease->GetStatementCache().Prepare(handle, query, key);
+
+  const SQLRETURN rc = SQLExecute(statement.statement.Get());
+  if (rc != SQL_NO_DATA) {
+    statement.statement.Check(rc, "Failed to execute query");
+  }
+
+  return Create(std::move(lease), std::move(key), std::move(statement), std::move(options));
+}
+
+std::shared_ptr<ResultReader> ResultReader::Create(std::shared_ptr<saildb::PooledConnection> connection, saildb::odbc::StatementHandle statement, saildb::ReaderOptions options /*= ReaderOptions()*/) {
+  if (!connection || !*connection || !statement) {
+    throw std::invalid_argument("Expected a leased connection & an executed statement");
+  }
+
+  std::shared_ptr<ResultReader> reader(new ResultReader(std::move(connection), std::move(statement), std::move(options)));
+  reader->open();
+
+  return reader;
+}
+
+std::shared_ptr<ResultReader> ResultReader::Create(std::shared_ptr<saildb::PooledConnection> connection, std::string key, saildb::PreparedStatement statement, saildb::ReaderOptions options /*= ReaderOptions()*/) {
+  if (!connection || !*connection || !statement.statement) {
+    throw std::invalid_argument("Expected a leased connection & an executed statement");
+  }
+
+  std::shared_ptr<ResultReader> reader(new ResultReader(std::move(connection), std::move(statement.statement), std::move(options)));
+  reader->m_cacheKey = std::move(key);
+  reader->m_description = std::move(statement.description);
+  reader->m_generation = statement.generation;
+  reader->open();
+
+  return reader;
+}
+
+
+/* Ctor & Dtor */
+ResultReader::ResultReader(std::shared_ptr<saildb::PooledConnection> connection, saildb::odbc::StatementHandle statement, saildb::ReaderOptions options)
+  : m_connection(std::move(connection)), m_statement(std::move(statement)), m_options(std::move(options))
+{
+  m_options.rowArraySize = std::max<size_t>(m_options.rowArraySize, 1);
+  m_options.batchSize = std::max<int64_t>(m_options.batchSize, 1);
+  if (m_options.memoryPool == nullptr) {
+    m_options.memoryPool = arrow::default_memory_pool();
+  }
+}
+
+ResultReader::~ResultReader() {
+  release();
+}
+
+
+/* Public impl. */
+std::shared_ptr<arrow::Schema> ResultReader::schema() const {
+  return m_schema;
+}
+
+arrow::Status ResultReader::ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) {
+  *batch = nullptr;
+  if (m_isExhausted) {
+    return arrow::Status::OK();
+  }
+
+  try {
+    int64_t rowCount = 0;
+    while (rowCount < m_options.batchSize) {
+      const size_t fetched = fetch();
+      if (fetched < 1) {
+        break;
+      }
+
+      rowCount += static_cast<int64_t>(fetched);
+    }
+
+    if (rowCount > 0) {
+      *batch = finish(rowCount);
+    } else {
+      release();
+    }
+  } catch (const std::exception& e) {
+    release();
+    return arrow::Status::IOError(e.what());
+  }
+
+  return arrow::Status::OK();
+}
+
+arrow::Status ResultReader::Close() {
+  release();
+  return arrow::Status::OK();
+}
+
+int64_t ResultReader::GetRowCount() const {
+  return m_rowCount;
+}
+
+size_t ResultReader::GetRowArraySize() const {
+  return m_rowArraySize;
+}
+
+
+/* Private impl. */
+void ResultReader::open() {
+  describe();
+  bind();
+}
+
+void ResultReader::describe() {
+  SQLHSTMT handle = m_statement.Get();
+
+  SQLSMALLINT columnCount = 0;
+  m_statement.Check(SQLNumResultCols(handle, &columnCount), "Failed to describe result set");
+
+  // A cached description is only reused if each column's type & size still match, since DDL may
+  // alter a column without changing the column count; the name(s) of matching column(s) are kept
+  bool isStale = !m_description || m_description->size() != static_cast<size_t>(columnCount);
+  for (SQLSMALLINT i = 0; !isStale && i < columnCount; ++i) {
+    isStale = !isDescribed(static_cast<SQLUSMALLINT>(i + 1), (*m_description)[i]);
+  }
+
+  if (isStale) {
+    auto description = std::make_shared<saildb::ResultDescription>(columnCount);
+
+    SQLWCHAR name[512];
+    for (SQLSMALLINT i = 0; i < columnCount; ++i) {
+      saildb::ColumnDescription& desc = (*description)[i];
+
+      SQLSMALLINT nameLength = 0;
+      m_statement.Check(
+        SQLDescribeColW(
+          handle, i + 1, name, sizeof(name) / sizeof(SQLWCHAR), &nameLength,
+          &desc.sqlType, &desc.columnSize, &desc.digits, &desc.nullable
+        ),
+        "Failed to describe column"
+      );
+
+      nameLength = std::min<SQLSMALLINT>(nameLength, sizeof(name) / sizeof(SQLWCHAR) - 1);
+      if (!odbc::tryEncodeSqlWide(name, static_cast<size_t>(nameLength), desc.name)) {
+        throw std::range_error("Failed to convert column name, found malformed UTF-16/32");
+      }
+    }
+
+    m_description = std::move(description);
+  }
+
+  arrow::FieldVector fields;
+  fields.reserve(columnCount);
+  m_columns.resize(columnCount);
+
+  for (SQLSMALLINT i = 0; i < columnCount; ++i) {
+    const saildb::ColumnDescription& desc = (*m_description)[i];
+    const SQLSMALLINT sqlType = desc.sqlType, digits = desc.digits, nullable = desc.nullable;
+    SQLULEN columnSize = desc.columnSize;
+
+    Column& column = m_columns[i];
+    column.name = desc.name;
+
+    std::shared_ptr<arrow::DataType> type;
+    switch (sqlType) {
+      case SQL_BIT:
+        column.kind = ColumnKind::Boolean;
+        column.cType = SQL_C_BIT;
+        column.elementSize = sizeof(uint8_t);
+        type = arrow::boolean();
+        break;
+
+      case SQL_TINYINT:
+      case SQL_SMALLINT:
+        // Widened, as TINYINT is unsigned with some driver(s)
+        column.kind = ColumnKind::Int16;
+        column.cType = SQL_C_SSHORT;
+        column.elementSize = sizeof(int16_t);
+        type = arrow::int16();
+        break;
+
+      case SQL_INTEGER:
+        column.kind = ColumnKind::Int32;
+        column.cType = SQL_C_SLONG;
+        column.elementSize = sizeof(int32_t);
+        type = arrow::int32();
+        break;
+
+      case SQL_BIGINT:
+        column.kind = ColumnKind::Int64;
+        column.cType = SQL_C_SBIGINT;
+        column.elementSize = sizeof(int64_t);
+        type = arrow::int64();
+        break;
+
+      case SQL_REAL:
+        column.kind = ColumnKind::Float;
+        column.cType = SQL_C_FLOAT;
+        column.elementSize = sizeof(float);
+        type = arrow::float32();
+        break;
+
+      case SQL_FLOAT:
+      case SQL_DOUBLE:
+        column.kind = ColumnKind::Double;
+        column.cType = SQL_C_DOUBLE;
+        column.elementSize = sizeof(double);
+        type = arrow::float64();
+        break;
+
+      case SQL_DECIMAL:
+      case SQL_NUMERIC:
+        if (digits == 0 && columnSize > 0 && columnSize <= 18) {
+          column.kind = ColumnKind::Int64;
+          column.cType = SQL_C_SBIGINT;
+          column.elementSize = sizeof(int64_t);
+          type = arrow::int64();
+        } else if (columnSize > 0 && columnSize <= 38) {
+          // Bound as text, i.e. sign, digit(s), point & terminator, since `SQL_C_NUMERIC` is poorly supported
+          column.kind = ColumnKind::Decimal;
+          column.cType = SQL_C_CHAR;
+          column.elementSize = static_cast<SQLLEN>(columnSize) + 3;
+          column.scale = digits;
+          type = arrow::decimal128(static_cast<int32_t>(columnSize), digits);
+        } else {
+          column.kind = ColumnKind::Double;
+          column.cType = SQL_C_DOUBLE;
+          column.elementSize = sizeof(double);
+          type = arrow::float64();
+        }
+        break;
+
+      case SQL_TYPE_DATE:
+      case SQL_DATE:
+        column.kind = ColumnKind::Date;
+        column.cType = SQL_C_TYPE_DATE;
+        column.elementSize = sizeof(SQL_DATE_STRUCT);
+        type = arrow::date32();
+        break;
+
+      case SQL_TYPE_TIME:
+      case SQL_TIME:
+        column.kind = ColumnKind::Time;
+        column.cType = SQL_C_TYPE_TIME;
+        column.elementSize = sizeof(SQL_TIME_STRUCT);
+        type = arrow::time32(arrow::TimeUnit::SECOND);
+        break;
+
+      case SQL_TYPE_TIMESTAMP:
+      case SQL_TIMESTAMP:
+        column.kind = ColumnKind::Timestamp;
+        column.cType = SQL_C_TYPE_TIMESTAMP;
+        column.elementSize = sizeof(SQL_TIMESTAMP_STRUCT);
+        type = arrow::timestamp(arrow::TimeUnit::MICRO);
+        break;
+
+      case SQL_BINARY:
+      case SQL_VARBINARY:
+      case SQL_LONGVARBINARY:
+        column.kind = ColumnKind::Binary;
+        column.cType = SQL_C_BINARY;
+        column.elementSize = static_cast<SQLLEN>(columnSize);
+        column.isStreamed = columnSize < 1 || columnSize > m_options.maxBindLength || sqlType == SQL_LONGVARBINARY;
+        type = arrow::binary();
+        break;
+
+      default:
+        // Character, GUID & interval type(s) etc. are read as text
+        if (sqlType == SQL_GUID) {
+          columnSize = 36;
+        }
+
+        column.kind = ColumnKind::String;
+        column.cType = SQL_C_WCHAR;
+        column.elementSize = static_cast<SQLLEN>((columnSize + 1) * sizeof(SQLWCHAR));
+        column.isStreamed = (
+          columnSize < 1 ||
+          static_cast<size_t>(column.elementSize) > m_options.maxBindLength ||
+          sqlType == SQL_LONGVARCHAR ||
+          sqlType == SQL_WLONGVARCHAR
+        );
+        type = arrow::utf8();
+        break;
+    }
+
+    // Unbound column(s) must follow bound column(s) unless the driver supports `SQL_GD_ANY_COLUMN`
+    m_hasStreamed = m_hasStreamed || column.isStreamed;
+    column.isStreamed = m_hasStreamed;
+
+    column.builder = ::unwrap(arrow::MakeBuilder(type, m_options.memoryPool));
+    fields.push_back(arrow::field(column.name, std::move(type), nullable != SQL_NO_NULLS));
+  }
+
+  m_schema = arrow::schema(std::move(fields));
+  if (columnCount < 1) {
+    release();
+  }
+}
+
+bool ResultReader::isDescribed(SQLUSMALLINT index, const saildb::ColumnDescription& desc) {
+  SQLHSTMT handle = m_statement.Get();
+
+  const auto getAttribute = [&](SQLUSMALLINT field) {
+    SQLLEN value = 0;
+    m_statement.Check(SQLColAttributeW(handle, index, field, nullptr, 0, nullptr, &value), "Failed to describe column");
+    return value;
+  };
+
+  if (getAttribute(SQL_DESC_CONCISE_TYPE) != desc.sqlType || getAttribute(SQL_DESC_NULLABLE) != desc.nullable) {
+    return false;
+  }
+
+  // Size per `SQLDescribeCol`, i.e. precision & scale of exact numeric(s), length of character & binary type(s)
+  switch (desc.sqlType) {
+    case SQL_DECIMAL:
+    case SQL_NUMERIC:
+      return (
+        getAttribute(SQL_DESC_PRECISION) == static_cast<SQLLEN>(desc.columnSize) &&
+        getAttribute(SQL_DESC_SCALE) == desc.digits
+      );
+
+    case SQL_BIT:
+    case SQL_TINYINT:
+    case SQL_SMALLINT:
+    case SQL_INTEGER:
+    case SQL_BIGINT:
+    case SQL_REAL:
+    case SQL_FLOAT:
+    case SQL_DOUBLE:
+    case SQL_TYPE_DATE:
+    case SQL_DATE:
+    case SQL_TYPE_TIME:
+    case SQL_TIME:
+    case SQL_TYPE_TIMESTAMP:
+    case SQL_TIMESTAMP:
+    case SQL_GUID:
+      // Bound by type alone
+      return true;
+
+    default:
+      return getAttribute(SQL_DESC_LENGTH) == static_cast<SQLLEN>(desc.columnSize);
+  }
+}
+
+void ResultReader::bind() {
+  if (m_isExhausted) {
+    return;
+  }
+
+  SQLHSTMT handle = m_statement.Get();
+
+  size_t rowWidth = 0;
+  for (const Column& column : m_columns) {
+    if (!column.isStreamed) {
+      rowWidth += static_cast<size_t>(column.elementSize) + sizeof(SQLLEN);
+    }
+  }
+
+  // `SQLGetData` is only defined for a single row rowset without `SQL_GD_BLOCK`
+  size_t rowArraySize = m_hasStreamed ? 1 : m_options.rowArraySize;
+  if (rowWidth > 0) {
+    rowArraySize = std::clamp<size_t>(m_options.maxBufferSize / rowWidth, 1, rowArraySize);
+  }
+
+  m_statement.Check(
+    SQLSetStmtAttr(handle, SQL_ATTR_ROW_BIND_TYPE, reinterpret_cast<SQLPOINTER>(static_cast<uintptr_t>(SQL_BIND_BY_COLUMN)), 0),
+    "Failed to set column-wise binding"
+  );
+
+  // Driver(s) may substitute a smaller rowset, i.e. `01S02`
+  const SQLRETURN rc = SQLSetStmtAttr(handle, SQL_ATTR_ROW_ARRAY_SIZE, reinterpret_cast<SQLPOINTER>(static_cast<uintptr_t>(rowArraySize)), 0);
+  m_statement.Check(rc, "Failed to set rowset size");
+  if (rc == SQL_SUCCESS_WITH_INFO) {
+    SQLULEN actual = 1;
+    m_statement.Check(SQLGetStmtAttr(handle, SQL_ATTR_ROW_ARRAY_SIZE, &actual, SQL_IS_UINTEGER, nullptr), "Failed to get rowset size");
+    rowArraySize = std::max<size_t>(static_cast<size_t>(actual), 1);
+  }
+  m_rowArraySize = rowArraySize;
+
+  m_rowStatus.resize(m_rowArraySize);
+  m_statement.Check(SQLSetStmtAttr(handle, SQL_ATTR_ROWS_FETCHED_PTR, &m_rowsFetched, 0), "Failed to set rows fetched pointer");
+  m_statement.Check(SQLSetStmtAttr(handle, SQL_ATTR_ROW_STATUS_PTR, m_rowStatus.data(), 0), "Failed to set row status pointer");
+
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    Column& column = m_columns[i];
+    if (column.isStreamed) {
+      // Fixed-width value(s) are still read through the column's buffer
+      column.buffer.resize(column.kind == ColumnKind::String || column.kind == ColumnKind::Binary ? 0 : column.elementSize);
+      column.indicators.resize(1);
+      continue;
+    }
+
+    column.buffer.resize(static_cast<size_t>(column.elementSize) * m_rowArraySize);
+    column.indicators.resize(m_rowArraySize);
+
+    m_statement.Check(
+      SQLBindCol(handle, static_cast<SQLUSMALLINT>(i + 1), column.cType, column.buffer.data(), column.elementSize, column.indicators.data()),
+      "Failed to bind column"
+    );
+  }
+
+  m_chunk.resize(m_hasStreamed ? std::max<size_t>(m_options.maxBindLength, 4096) : 0);
+  for (Column& column : m_columns) {
+    ::unwrap(column.builder->Reserve(m_options.batchSize));
+  }
+}
+
+size_t ResultReader::fetch() {
+  const SQLRETURN rc = SQLFetchScroll(m_statement.Get(), SQL_FETCH_NEXT, 0);
+  if (rc == SQL_NO_DATA) {
+    m_isExhausted = true;
+    return 0;
+  }
+  m_statement.Check(rc, "Failed to fetch rowset");
+
+  const size_t count = static_cast<size_t>(m_rowsFetched);
+  for (size_t i = 0; i < count; ++i) {
+    if (m_rowStatus[i] == SQL_ROW_ERROR) {
+      std::string state("HY000");
+      const std::string diagnostics = odbc::getDiagnostics(SQL_HANDLE_STMT, m_statement.Get(), &state);
+      throw odbc::Error(std::move(state), std::string("Failed to fetch row, got err: ").append(diagnostics));
+    }
+  }
+
+  for (size_t i = 0; i < m_columns.size(); ++i) {
+    Column& column = m_columns[i];
+    if (column.isStreamed) {
+      appendStreamed(column, static_cast<SQLUSMALLINT>(i + 1));
+    } else {
+      appendBound(column, count);
+    }
+  }
+
+  m_rowCount += static_cast<int64_t>(count);
+  return count;
+}
+
+void ResultReader::appendBound(ResultReader::Column& column, size_t count) {
+  const uint8_t* data = column.buffer.data();
+  const SQLLEN* indicators = column.indicators.data();
+  const int64_t length = static_cast<int64_t>(count);
+
+  m_valid.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    m_valid[i] = indicators[i] != SQL_NULL_DATA;
+  }
+  const uint8_t* valid = m_valid.data();
+
+  switch (column.kind) {
+    case ColumnKind::Boolean:
+      ::unwrap(static_cast<arrow::BooleanBuilder*>(column.builder.get())->AppendValues(data, length, valid));
+      break;
+
+    case ColumnKind::Int16:
+      ::unwrap(static_cast<arrow::Int16Builder*>(column.builder.get())->AppendValues(reinterpret_cast<const int16_t*>(data), length, valid));
+      break;
+
+    case ColumnKind::Int32:
+      ::unwrap(static_cast<arrow::Int32Builder*>(column.builder.get())->AppendValues(reinterpret_cast<const int32_t*>(data), length, valid));
+      break;
+
+    case ColumnKind::Int64:
+      ::unwrap(static_cast<arrow::Int64Builder*>(column.builder.get())->AppendValues(reinterpret_cast<const int64_t*>(data), length, valid));
+      break;
+
+    case ColumnKind::Float:
+      ::unwrap(static_cast<arrow::FloatBuilder*>(column.builder.get())->AppendValues(reinterpret_cast<const float*>(data), length, valid));
+      break;
+
+    case ColumnKind::Double:
+      ::unwrap(static_cast<arrow::DoubleBuilder*>(column.builder.get())->AppendValues(reinterpret_cast<const double*>(data), length, valid));
+      break;
+
+    case ColumnKind::Date: {
+      const auto* values = reinterpret_cast<const SQL_DATE_STRUCT*>(data);
+      m_int32s.resize(count);
+      for (size_t i = 0; i < count; ++i) {
+        m_int32s[i] = valid[i] ? ::toDays(values[i].year, values[i].month, values[i].day) : 0;
+      }
+
+      ::unwrap(static_cast<arrow::Date32Builder*>(column.builder.get())->AppendValues(m_int32s.data(), length, valid));
+    } break;
+
+    case ColumnKind::Time: {
+      const auto* values = reinterpret_cast<const SQL_TIME_STRUCT*>(data);
+      m_int32s.resize(count);
+      for (size_t i = 0; i < count; ++i) {
+        m_int32s[i] = valid[i] ? values[i].hour * 3600 + values[i].minute * 60 + values[i].second : 0;
+      }
+
+      ::unwrap(static_cast<arrow::Time32Builder*>(column.builder.get())->AppendValues(m_int32s.data(), length, valid));
+    } break;
+
+    case ColumnKind::Timestamp: {
+      // `fraction` is in nanosecond(s)
+      const auto* values = reinterpret_cast<const SQL_TIMESTAMP_STRUCT*>(data);
+      m_int64s.resize(count);
+      for (size_t i = 0; i < count; ++i) {
+        if (!valid[i]) {
+          m_int64s[i] = 0;
+          continue;
+        }
+
+        const SQL_TIMESTAMP_STRUCT& value = values[i];
+        const int64_t seconds = static_cast<int64_t>(::toDays(value.year, value.month, value.day)) * 86400
+          + value.hour * 3600 + value.minute * 60 + value.second;
+
+        m_int64s[i] = seconds * 1'000'000 + value.fraction / 1'000;
+      }
+
+      ::unwrap(static_cast<arrow::TimestampBuilder*>(column.builder.get())->AppendValues(m_int64s.data(), length, valid));
+    } break;
+
+    case ColumnKind::Decimal: {
+      auto* builder = static_cast<arrow::Decimal128Builder*>(column.builder.get());
+      for (size_t i = 0; i < count; ++i) {
+        if (!valid[i]) {
+          ::unwrap(builder->AppendNull());
+          continue;
+        }
+
+        const SQLLEN size = ::getBoundLength(indicators[i], column.elementSize, 1);
+        if (size < 0) {
+          throw std::runtime_error(std::string("Failed to read column '").append(column.name).append("', value was truncated"));
+        }
+
+        arrow::Decimal128 value;
+        int32_t precision, scale;
+        const std::string_view text(reinterpret_cast<const char*>(data + i * column.elementSize), static_cast<size_t>(size));
+        ::unwrap(arrow::Decimal128::FromString(text, &value, &precision, &scale));
+        if (scale != column.scale) {
+          value = ::unwrap(value.Rescale(scale, column.scale));
+        }
+
+        ::unwrap(builder->Append(value));
+      }
+    } break;
+
+    case ColumnKind::String: {
+      auto* builder = static_cast<arrow::StringBuilder*>(column.builder.get());
+      for (size_t i = 0; i < count; ++i) {
+        if (!valid[i]) {
+          ::unwrap(builder->AppendNull());
+          continue;
+        }
+
+        const SQLLEN size = ::getBoundLength(indicators[i], column.elementSize, sizeof(SQLWCHAR));
+        if (size < 0) {
+          throw std::runtime_error(std::string("Failed to read column '").append(column.name).append("', value was truncated"));
+        }
+
+        const auto* chars = reinterpret_cast<const SQLWCHAR*>(data + i * column.elementSize);
+        if (!odbc::tryEncodeSqlWide(chars, static_cast<size_t>(size) / sizeof(SQLWCHAR), m_text)) {
+          throw std::range_error(std::string("Failed to read column '").append(column.name).append("', found malformed UTF-16/32"));
+        }
+
+        ::unwrap(builder->Append(m_text));
+      }
+    } break;
+
+    case ColumnKind::Binary: {
+      auto* builder = static_cast<arrow::BinaryBuilder*>(column.builder.get());
+      for (size_t i = 0; i < count; ++i) {
+        if (!valid[i]) {
+          ::unwrap(builder->AppendNull());
+          continue;
+        }
+
+        const SQLLEN size = ::getBoundLength(indicators[i], column.elementSize, 0);
+        if (size < 0) {
+          throw std::runtime_error(std::string("Failed to read column '").append(column.name).append("', value was truncated"));
+        }
+
+        ::unwrap(builder->Append(data + i * column.elementSize, static_cast<int32_t>(size)));
+      }
+    } break;
+  }
+}
+
+void ResultReader::appendStreamed(ResultReader::Column& column, SQLUSMALLINT index) {
+  SQLHSTMT handle = m_statement.Get();
+
+  // Fixed-width value(s) fit the column's buffer, so are appended as a single row rowset
+  if (column.kind != ColumnKind::String && column.kind != ColumnKind::Binary) {
+    const SQLRETURN rc = SQLGetData(handle, index, column.cType, column.buffer.data(), column.elementSize, column.indicators.data());
+    m_statement.Check(rc, "Failed to get column data");
+    appendBound(column, 1);
+    return;
+  }
+
+  // Variable-width value(s) are read in chunk(s); each chunk except the last is filled,
+  // less the terminator for character data
+  const SQLLEN chunkSize = static_cast<SQLLEN>(m_chunk.size());
+  const SQLLEN terminatorSize = column.kind == ColumnKind::String ? sizeof(SQLWCHAR) : 0;
+
+  bool isNull = false;
+  m_value.clear();
+  while (true) {
+    SQLLEN indicator = 0;
+    const SQLRETURN rc = SQLGetData(handle, index, column.cType, m_chunk.data(), chunkSize, &indicator);
+    if (rc == SQL_NO_DATA) {
+      break;
+    }
+    m_statement.Check(rc, "Failed to get column data");
+
+    if (indicator == SQL_NULL_DATA) {
+      isNull = true;
+      break;
+    }
+
+    // `SQL_NO_TOTAL` is only reported alongside truncation, i.e. `01004`
+    const bool hasMore = rc == SQL_SUCCESS_WITH_INFO && (indicator == SQL_NO_TOTAL || indicator > chunkSize - terminatorSize);
+    if (!hasMore && indicator < 0) {
+      throw std::runtime_error(std::string("Failed to read column '").append(column.name).append("', driver reported no length"));
+    }
+
+    const size_t size = static_cast<size_t>(hasMore ? chunkSize - terminatorSize : indicator);
+    m_value.insert(m_value.end(), m_chunk.data(), m_chunk.data() + size);
+
+    if (!hasMore) {
+      break;
+    }
+  }
+
+  if (isNull) {
+    ::unwrap(column.builder->AppendNull());
+    return;
+  }
+
+  if (column.kind == ColumnKind::Binary) {
+    ::unwrap(static_cast<arrow::BinaryBuilder*>(column.builder.get())->Append(m_value.data(), static_cast<int32_t>(m_value.size())));
+    return;
+  }
+
+  const auto* chars = reinterpret_cast<const SQLWCHAR*>(m_value.data());
+  if (!odbc::tryEncodeSqlWide(chars, m_value.size() / sizeof(SQLWCHAR), m_text)) {
+    throw std::range_error(std::string("Failed to read column '").append(column.name).append("', found malformed UTF-16/32"));
+  }
+
+  ::unwrap(static_cast<arrow::StringBuilder*>(column.builder.get())->Append(m_text));
+}
+
+std::shared_ptr<arrow::RecordBatch> ResultReader::finish(int64_t rowCount) {
+  arrow::ArrayVector arrays;
+  arrays.reserve(m_columns.size());
+
+  for (Column& column : m_columns) {
+    std::shared_ptr<arrow::Array> array;
+    ::unwrap(column.builder->Finish(&array));
+    arrays.push_back(std::move(array));
+
+    if (!m_isExhausted) {
+      ::unwrap(column.builder->Reserve(m_options.batchSize));
+    }
+  }
+
+  // Return the connection as soon as the result set is drained
+  if (m_isExhausted) {
+    release();
+  }
+
+  return arrow::RecordBatch::Make(m_schema, rowCount, std::move(arrays));
+}
+
+void ResultReader::release() {
+  m_isExhausted = true;
+
+  // Returned while the lease, and with it the cache, is still held
+  if (m_cacheKey && m_statement && m_connection) {
+    m_connection->GetStatementCache().Put(
+      std::move(*m_cacheKey),
+      saildb::PreparedStatement{std::move(m_statement), m_description, m_generation}
+    );
+  }
+
+  m_cacheKey.reset();
+  m_statement = odbc::StatementHandle();
+  m_connection.reset();
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <arrow/api.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <optional>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+#include "sailc/driver/Odbc.hpp"
+#include "sailc/driver/ConnectionPool.hpp"
+
+namespace saildb {
+
+struct ReaderOptions {
+  size_t rowArraySize{4096};                                    // Row(s) fetched per round trip, i.e. `SQL_ATTR_ROW_ARRAY_SIZE`
+  int64_t batchSize{65536};                                     // Row(s) per record batch, rounded up to whole rowset(s)
+  size_t maxBindLength{8192};                                   // Wider variable-width column(s) are streamed with `SQLGetData`
+  size_t maxBufferSize{64 << 20};                               // Bound on the rowset buffer(s), `rowArraySize` is reduced to fit
+  int64_t memoryBudget{0};                                      // Byte(s) read ahead of the consumer before spilling to disk, see `SpillReader`, or 0 to read on demand
+  std::filesystem::path spillDirectory;                         // Directory of spill file(s), or the system's temporary directory
+  arrow::MemoryPool* memoryPool{arrow::default_memory_pool()};
+};
+
+/*
+ * Reads a result set into Arrow record batch(es) using ODBC block cursors
+ *
+ *  - Column(s) are bound column-wise, so each `SQLFetchScroll` fills up to `rowArraySize`
+ *    row(s) which are appended to the column builder(s) in bulk
+ *  - Variable-width column(s) are bound as `SQL_C_WCHAR` & transcoded to UTF-8
+ *  - Long or unbounded column(s), and any following them, are read per row with `SQLGetData`;
+ *    most driver(s) don't support `SQLGetData` with block cursors, so the rowset is reduced
+ *    to a single row where required
+ *  - The reader's reference to the connection lease is dropped as soon as the result set is
+ *    exhausted or closed; a cached statement is returned to the lease's `StatementCache` first
+ *  - A cached statement's result set is only described once, unless its column count changes
+ *
+ */
+class ResultReader : public arrow::RecordBatchReader {
+  public:
+    // Executes `query` on the leased connection, prepared through its `StatementCache`
+    static std::shared_ptr<ResultReader> Create(PooledConnection connection, std::string_view query, ReaderOptions options = ReaderOptions());
+
+    // Reads the result set of an already executed statement; the lease may be shared, e.g. with a `Connection`
+    static std::shared_ptr<ResultReader> Create(std::shared_ptr<PooledConnection> connection, odbc::StatementHandle statement, ReaderOptions options = ReaderOptions());
+
+    // Reads the result set of an already executed, cached statement, which is put back under `key` once released
+    static std::shared_ptr<ResultReader> Create(std::shared_ptr<PooledConnection> connection, std::string key, PreparedStatement statement, ReaderOptions options = ReaderOptions());
+
+  public:
+    ResultReader(ResultReader const&) = delete;
+    ResultReader &operator=(ResultReader const&) = delete;
+    ~ResultReader() override;
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override;
+
+    // Yields `nullptr` once the result set is exhausted
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override;
+    arrow::Status Close() override;
+
+    int64_t GetRowCount() const;
+    size_t GetRowArraySize() const;
+
+  private:
+    enum class ColumnKind : uint8_t {
+      Boolean,
+      Int16,
+      Int32,
+      Int64,
+      Float,
+      Double,
+      Decimal,
+      Date,
+      Time,
+      Timestamp,
+      String,
+      Binary,
+    };
+
+    struct Column {
+      std::string name;
+      ColumnKind kind;
+      SQLSMALLINT cType;
+      SQLLEN elementSize;
+      int32_t scale{0};
+      bool isStreamed{false};
+      std::vector<uint8_t> buffer;
+      std::vector<SQLLEN> indicators;
+      std::unique_ptr<arrow::ArrayBuilder> builder;
+    };
+
+    ResultReader(std::shared_ptr<PooledConnection> connection, odbc::StatementHandle statement, ReaderOptions options);
+
+    // Setup
+    void open();
+    void describe();
+    bool isDescribed(SQLUSMALLINT index, const ColumnDescription& desc);
+    void bind();
+
+    // Fetch
+    size_t fetch();
+    void appendBound(Column& column, size_t count);
+    void appendStreamed(Column& column, SQLUSMALLINT index);
+    std::shared_ptr<arrow::RecordBatch> finish(int64_t rowCount);
+    void release();
+
+  private:
+    std::shared_ptr<PooledConnection> m_connection;
+    odbc::StatementHandle m_statement;
+    ReaderOptions m_options;
+
+    // Set if `m_statement` is returned to the lease's cache
+    std::optional<std::string> m_cacheKey;
+    std::shared_ptr<const ResultDescription> m_description;
+    uint64_t m_generation{0};
+
+    std::shared_ptr<arrow::Schema> m_schema;
+    std::vector<Column> m_columns;
+    size_t m_rowArraySize{1};
+    bool m_hasStreamed{false};
+    bool m_isExhausted{false};
+    int64_t m_rowCount{0};
+
+    SQLULEN m_rowsFetched{0};
+    std::vector<SQLUSMALLINT> m_rowStatus;
+
+    // Scratch buffer(s), reused across rowset(s)
+    std::vector<uint8_t> m_valid;
+    std::vector<int32_t> m_int32s;
+    std::vector<int64_t> m_int64s;
+    std::vector<uint8_t> m_chunk;
+    std::vector<uint8_t> m_value;
+    std::string m_text;
+};
+
+} // namespace saildb
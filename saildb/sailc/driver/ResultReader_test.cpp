@@ -0,0 +1,375 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "sailc/driver/ResultReader.hpp"
+#include "sailc/driver/TestDatabase.hpp"
+
+using saildb::PoolOptions;
+using saildb::ResultReader;
+using saildb::ReaderOptions;
+using saildb::ConnectionPool;
+using saildb::testing::TestDatabase;
+
+namespace {
+
+class ResultReaderTest : public ::testing::Test {
+  protected:
+    ResultReaderTest()
+      : m_database(::testing::UnitTest::GetInstance()->current_test_info()->name()) { };
+
+    void SetUp() override {
+      std::string errorMessage;
+      m_pool = m_database.TryCreatePool(PoolOptions(), errorMessage);
+      if (!m_pool) {
+        GTEST_SKIP() << errorMessage;
+      }
+    }
+
+    void execute(std::string_view query) {
+      TestDatabase::Execute(*m_pool->Acquire(), query);
+    }
+
+    // Inserts `count` row(s) into `saildb_rows`, i.e. an `id` & its text
+    void seed(int64_t count) {
+      execute("CREATE TABLE saildb_rows (id INTEGER, name VARCHAR(16))");
+      execute(
+        "WITH RECURSIVE ids(id) AS (SELECT 0 UNION ALL SELECT id + 1 FROM ids WHERE id + 1 < " + std::to_string(count) + ") "
+        "INSERT INTO saildb_rows SELECT id, 'row-' || id FROM ids"
+      );
+    }
+
+    std::shared_ptr<ResultReader> read(std::string_view query, ReaderOptions options = ReaderOptions()) {
+      return ResultReader::Create(m_pool->Acquire(), query, std::move(options));
+    }
+
+    static std::vector<std::shared_ptr<arrow::RecordBatch>> drain(ResultReader& reader) {
+      std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+      while (true) {
+        std::shared_ptr<arrow::RecordBatch> batch;
+        EXPECT_TRUE(reader.ReadNext(&batch).ok());
+        if (!batch) {
+          return batches;
+        }
+
+        batches.push_back(std::move(batch));
+      }
+    }
+
+    template <typename T>
+    static std::shared_ptr<T> column(const std::shared_ptr<arrow::RecordBatch>& batch, int index) {
+      return std::static_pointer_cast<T>(batch->column(index));
+    }
+
+  protected:
+    TestDatabase m_database;
+    std::shared_ptr<ConnectionPool> m_pool;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Types                           *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ResultReaderTest, MapsSqlTypesToArrow) {
+  execute(
+    "CREATE TABLE saildb_types ("
+      "i INTEGER, b BIGINT, s SMALLINT, f BIT, d DOUBLE, v VARCHAR(16), y VARBINARY(8), dt DATE, tm TIME, ts TIMESTAMP"
+    ")"
+  );
+  execute(
+    "INSERT INTO saildb_types VALUES ("
+      "-7, 9007199254740993, 300, 1, 2.5, 'h\xC3\xA9llo \xE4\xB8\xAD', X'00FF10', '2024-02-29', '12:34:56', '2024-02-29 12:34:56.789'"
+    ")"
+  );
+
+  auto reader = read("SELECT i, b, s, f, d, v, y, dt, tm, ts FROM saildb_types");
+  const std::shared_ptr<arrow::Schema> schema = reader->schema();
+  ASSERT_EQ(schema->num_fields(), 10);
+  EXPECT_TRUE(schema->field(0)->type()->Equals(arrow::int32()));
+  EXPECT_TRUE(schema->field(1)->type()->Equals(arrow::int64()));
+  EXPECT_TRUE(schema->field(2)->type()->Equals(arrow::int16()));
+  EXPECT_TRUE(schema->field(3)->type()->Equals(arrow::boolean()));
+  EXPECT_TRUE(schema->field(4)->type()->Equals(arrow::float64()));
+  EXPECT_TRUE(schema->field(5)->type()->Equals(arrow::utf8()));
+  EXPECT_TRUE(schema->field(6)->type()->Equals(arrow::binary()));
+  EXPECT_TRUE(schema->field(7)->type()->Equals(arrow::date32()));
+  EXPECT_TRUE(schema->field(8)->type()->Equals(arrow::time32(arrow::TimeUnit::SECOND)));
+  EXPECT_TRUE(schema->field(9)->type()->Equals(arrow::timestamp(arrow::TimeUnit::MICRO)));
+  EXPECT_EQ(schema->field(0)->name(), "i");
+  EXPECT_EQ(schema->field(9)->name(), "ts");
+
+  const auto batches = drain(*reader);
+  ASSERT_EQ(batches.size(), 1u);
+  const auto& batch = batches.front();
+  ASSERT_EQ(batch->num_rows(), 1);
+  ASSERT_TRUE(batch->ValidateFull().ok());
+
+  EXPECT_EQ(column<arrow::Int32Array>(batch, 0)->Value(0), -7);
+  EXPECT_EQ(column<arrow::Int64Array>(batch, 1)->Value(0), 9007199254740993);
+  EXPECT_EQ(column<arrow::Int16Array>(batch, 2)->Value(0), 300);
+  EXPECT_TRUE(column<arrow::BooleanArray>(batch, 3)->Value(0));
+  EXPECT_DOUBLE_EQ(column<arrow::DoubleArray>(batch, 4)->Value(0), 2.5);
+  EXPECT_EQ(column<arrow::StringArray>(batch, 5)->GetString(0), "h\xC3\xA9llo \xE4\xB8\xAD");
+  EXPECT_EQ(column<arrow::BinaryArray>(batch, 6)->GetString(0), std::string("\x00\xFF\x10", 3));
+
+  // 2024-02-29 is day 19782 since the epoch, 12:34:56 is second 45296 of the day
+  EXPECT_EQ(column<arrow::Date32Array>(batch, 7)->Value(0), 19782);
+  EXPECT_EQ(column<arrow::Time32Array>(batch, 8)->Value(0), 45296);
+  EXPECT_EQ(column<arrow::TimestampArray>(batch, 9)->Value(0), (19782LL * 86400 + 45296) * 1'000'000 + 789'000);
+}
+
+TEST_F(ResultReaderTest, ReadsNullsOfEveryType) {
+  execute("CREATE TABLE saildb_nulls (i INTEGER, b BIGINT, f BIT, d DOUBLE, v VARCHAR(16), y VARBINARY(8), dt DATE, ts TIMESTAMP, body TEXT)");
+  execute("INSERT INTO saildb_nulls VALUES (NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL)");
+  execute("INSERT INTO saildb_nulls VALUES (1, 2, 0, 0.5, '', X'', '1970-01-01', '1970-01-01 00:00:00', '')");
+
+  auto reader = read("SELECT i, b, f, d, v, y, dt, ts, body FROM saildb_nulls ORDER BY i IS NOT NULL");
+  const auto batches = drain(*reader);
+  ASSERT_EQ(batches.size(), 1u);
+  const auto& batch = batches.front();
+  ASSERT_EQ(batch->num_rows(), 2);
+  ASSERT_TRUE(batch->ValidateFull().ok());
+
+  for (int i = 0; i < batch->num_columns(); ++i) {
+    EXPECT_TRUE(batch->schema()->field(i)->nullable()) << batch->schema()->field(i)->name();
+    EXPECT_TRUE(batch->column(i)->IsNull(0)) << batch->schema()->field(i)->name();
+    EXPECT_TRUE(batch->column(i)->IsValid(1)) << batch->schema()->field(i)->name();
+  }
+
+  // Empty value(s) aren't read as null
+  EXPECT_EQ(column<arrow::StringArray>(batch, 4)->GetString(1), "");
+  EXPECT_EQ(column<arrow::BinaryArray>(batch, 5)->GetString(1), "");
+  EXPECT_EQ(column<arrow::StringArray>(batch, 8)->GetString(1), "");
+  EXPECT_EQ(column<arrow::Date32Array>(batch, 6)->Value(1), 0);
+  EXPECT_EQ(column<arrow::TimestampArray>(batch, 7)->Value(1), 0);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Streaming                         *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ResultReaderTest, StreamsLongColumnsWithGetData) {
+  // Longer than the chunk size, with a multi-byte character straddling chunk boundaries
+  std::string text;
+  for (int i = 0; text.size() < 20'000; ++i) {
+    text.append(i % 7 == 0 ? "\xE4\xB8\xAD" : "abcdef");
+  }
+  std::string hex;
+  for (int i = 0; i < 9'000; ++i) {
+    hex.append("5A");
+  }
+
+  execute("CREATE TABLE saildb_long (id INTEGER, label VARCHAR(100), body TEXT, data BLOB, tail INTEGER)");
+  execute("INSERT INTO saildb_long VALUES (1, 'first', '" + text + "', X'" + hex + "', 10)");
+  execute("INSERT INTO saildb_long VALUES (2, NULL, NULL, NULL, NULL)");
+  execute("INSERT INTO saildb_long VALUES (3, 'third', 'short', X'01', 30)");
+
+  // `label` is wider than `maxBindLength`, so it's streamed along with every column following it
+  ReaderOptions options;
+  options.maxBindLength = 64;
+
+  auto reader = read("SELECT id, label, body, data, tail FROM saildb_long ORDER BY id", options);
+  EXPECT_EQ(reader->GetRowArraySize(), 1u);
+  EXPECT_TRUE(reader->schema()->field(3)->type()->Equals(arrow::binary()));
+
+  const auto batches = drain(*reader);
+  ASSERT_EQ(batches.size(), 1u);
+  const auto& batch = batches.front();
+  ASSERT_EQ(batch->num_rows(), 3);
+  ASSERT_TRUE(batch->ValidateFull().ok());
+
+  const auto id = column<arrow::Int32Array>(batch, 0);
+  const auto label = column<arrow::StringArray>(batch, 1);
+  const auto body = column<arrow::StringArray>(batch, 2);
+  const auto tail = column<arrow::Int32Array>(batch, 4);
+  EXPECT_EQ(id->Value(0), 1);
+  EXPECT_EQ(label->GetString(0), "first");
+  EXPECT_EQ(body->GetString(0), text);
+  EXPECT_EQ(column<arrow::BinaryArray>(batch, 3)->GetString(0), std::string(9'000, 'Z'));
+  EXPECT_EQ(tail->Value(0), 10);
+
+  EXPECT_EQ(id->Value(1), 2);
+  for (int i = 1; i < batch->num_columns(); ++i) {
+    EXPECT_TRUE(batch->column(i)->IsNull(1)) << batch->schema()->field(i)->name();
+  }
+
+  EXPECT_EQ(label->GetString(2), "third");
+  EXPECT_EQ(body->GetString(2), "short");
+  EXPECT_EQ(column<arrow::BinaryArray>(batch, 3)->GetString(2), "\x01");
+  EXPECT_EQ(tail->Value(2), 30);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Rowsets                          *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ResultReaderTest, SlicesRowsetsIntoBatches) {
+  seed(2'500);
+
+  ReaderOptions options;
+  options.rowArraySize = 100;
+  options.batchSize = 1'000;
+
+  auto reader = read("SELECT id, name FROM saildb_rows ORDER BY id", options);
+  EXPECT_EQ(reader->GetRowArraySize(), 100u);
+
+  const auto batches = drain(*reader);
+  ASSERT_EQ(batches.size(), 3u);
+  EXPECT_EQ(batches[0]->num_rows(), 1'000);
+  EXPECT_EQ(batches[1]->num_rows(), 1'000);
+  EXPECT_EQ(batches[2]->num_rows(), 500);
+
+  int64_t row = 0;
+  for (const auto& batch : batches) {
+    const auto id = column<arrow::Int32Array>(batch, 0);
+    const auto name = column<arrow::StringArray>(batch, 1);
+    for (int64_t i = 0; i < batch->num_rows(); ++i, ++row) {
+      ASSERT_EQ(id->Value(i), row);
+      ASSERT_EQ(name->GetString(i), "row-" + std::to_string(row));
+    }
+  }
+
+  EXPECT_EQ(reader->GetRowCount(), 2'500);
+}
+
+TEST_F(ResultReaderTest, AdoptsSubstitutedRowsetSize) {
+  seed(5'000);
+
+  // Beyond what most driver(s) accept, so it's expected to be substituted with `01S02`; the
+  // reader has to adopt whichever size the driver settles on
+  ReaderOptions options;
+  options.rowArraySize = 1 << 20;
+  options.batchSize = 5'000;
+  options.maxBufferSize = size_t(1) << 30;
+
+  auto reader = read("SELECT id, name FROM saildb_rows ORDER BY id", options);
+  EXPECT_GE(reader->GetRowArraySize(), 1u);
+  EXPECT_LE(reader->GetRowArraySize(), options.rowArraySize);
+
+  int64_t row = 0;
+  for (const auto& batch : drain(*reader)) {
+    const auto id = column<arrow::Int32Array>(batch, 0);
+    for (int64_t i = 0; i < batch->num_rows(); ++i, ++row) {
+      ASSERT_EQ(id->Value(i), row);
+    }
+  }
+
+  EXPECT_EQ(row, 5'000);
+}
+
+TEST_F(ResultReaderTest, BoundsRowsetByBufferSize) {
+  seed(10);
+
+  // Each row is 4 + 34 byte(s) of data & 2 indicator(s)
+  ReaderOptions options;
+  options.rowArraySize = 1'000;
+  options.maxBufferSize = 4 * (4 + 34 + 2 * sizeof(SQLLEN));
+
+  auto reader = read("SELECT id, name FROM saildb_rows ORDER BY id", options);
+  EXPECT_EQ(reader->GetRowArraySize(), 4u);
+  EXPECT_EQ(reader->ToTable().ValueOrDie()->num_rows(), 10);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Failures                         *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ResultReaderTest, FailsOnTruncatedValue) {
+  // SQLite doesn't enforce the declared length, so the value overflows its bound buffer
+  execute("CREATE TABLE saildb_narrow (id INTEGER, code VARCHAR(4))");
+  execute("INSERT INTO saildb_narrow VALUES (1, 'abcd'), (2, 'abcdefgh')");
+
+  ReaderOptions options;
+  options.rowArraySize = 1;
+  options.batchSize = 1;
+
+  auto reader = read("SELECT id, code FROM saildb_narrow ORDER BY id", options);
+
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  ASSERT_NE(batch, nullptr);
+  EXPECT_EQ(column<arrow::StringArray>(batch, 1)->GetString(0), "abcd");
+
+  const arrow::Status status = reader->ReadNext(&batch);
+  EXPECT_TRUE(status.IsIOError());
+  EXPECT_NE(status.message().find("'code', value was truncated"), std::string::npos) << status.message();
+  EXPECT_EQ(batch, nullptr);
+
+  // The lease is returned on failure, & the reader stays exhausted
+  EXPECT_EQ(m_pool->GetIdleCount(), 1u);
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(batch, nullptr);
+}
+
+TEST_F(ResultReaderTest, FailsOnInvalidQuery) {
+  EXPECT_THROW(read("SELECT id FROM saildb_missing"), saildb::odbc::Error);
+  EXPECT_EQ(m_pool->GetIdleCount(), 1u);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Lease                           *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(ResultReaderTest, ReturnsLeaseOnceExhausted) {
+  seed(10);
+
+  ReaderOptions options;
+  options.batchSize = 4;
+  options.rowArraySize = 4;
+
+  auto reader = read("SELECT id FROM saildb_rows", options);
+  EXPECT_EQ(m_pool->GetIdleCount(), 0u);
+
+  drain(*reader);
+  EXPECT_EQ(m_pool->GetIdleCount(), 1u);
+  EXPECT_EQ(reader->GetRowCount(), 10);
+}
+
+TEST_F(ResultReaderTest, ReturnsLeaseOnClose) {
+  seed(10);
+
+  ReaderOptions options;
+  options.batchSize = 4;
+  options.rowArraySize = 4;
+
+  auto reader = read("SELECT id FROM saildb_rows", options);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  ASSERT_TRUE(reader->ReadNext(&batch).ok());
+  EXPECT_EQ(m_pool->GetIdleCount(), 0u);
+
+  ASSERT_TRUE(reader->Close().ok());
+  EXPECT_EQ(m_pool->GetIdleCount(), 1u);
+
+  // The statement is put back into the cache, & re-executed from it
+  auto again = read("SELECT id FROM saildb_rows", options);
+  EXPECT_EQ(again->ToTable().ValueOrDie()->num_rows(), 10);
+  EXPECT_GE(m_pool->GetStatementCacheStats().hits.load(), 1u);
+}
@@ -0,0 +1,214 @@
+#include "SpillReader.hpp"
+
+#include <arrow/ipc/api.h>
+#include <arrow/util/byte_size.h>
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <utility>
+#include <exception>
+#include <system_error>
+
+namespace fs = std::filesystem;
+
+using SpillReader = saildb::SpillReader;
+
+// Name of a spill file, unique across reader(s) & process(es)
+std::string makeSpillName() {
+  static std::atomic<uint64_t> sequence{0};
+
+  std::random_device device;
+  return "saildb-spill-" + std::to_string(device()) + "-" + std::to_string(sequence.fetch_add(1, std::memory_order_relaxed)) + ".arrows";
+}
+
+/* Static impl. */
+std::shared_ptr<SpillReader> SpillReader::Create(
+  std::shared_ptr<arrow::RecordBatchReader> source,
+  int64_t memoryBudget,
+  std::filesystem::path directory /*= std::filesystem::path()*/
+) {
+  std::shared_ptr<SpillReader> reader(new SpillReader(std::move(source), memoryBudget, std::move(directory)));
+
+  // Started once constructed, as the producer refers to the reader's member(s)
+  reader->m_producer = std::thread(&SpillReader::produce, reader.get());
+  return reader;
+}
+
+
+/* Ctor & Dtor */
+SpillReader::SpillReader(std::shared_ptr<arrow::RecordBatchReader> source, int64_t memoryBudget, std::filesystem::path directory)
+  : m_source(std::move(source)), m_schema(m_source->schema()), m_memoryBudget(memoryBudget), m_directory(std::move(directory)) { };
+
+SpillReader::~SpillReader() {
+  (void)Close();
+}
+
+
+/* Public impl. */
+std::shared_ptr<arrow::Schema> SpillReader::schema() const {
+  return m_schema;
+}
+
+arrow::Status SpillReader::ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) {
+  Entry entry;
+  {
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_notEmpty.wait(lock, [this]() {
+      return !m_queue.empty() || m_isDone || m_isClosed;
+    });
+
+    if (m_queue.empty()) {
+      *batch = nullptr;
+      return m_status;
+    }
+
+    entry = std::move(m_queue.front());
+    m_queue.pop_front();
+
+    if (entry.batch) {
+      m_memoryBytes -= entry.size;
+      *batch = std::move(entry.batch);
+      return arrow::Status::OK();
+    }
+  }
+
+  return load(entry, batch);
+}
+
+arrow::Status SpillReader::Close() {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_isClosed = true;
+    m_queue.clear();
+    m_memoryBytes = 0;
+  }
+  m_notEmpty.notify_all();
+
+  if (m_producer.joinable()) {
+    m_producer.join();
+  }
+
+  // Batch(es) already read keep their mapping alive
+  m_mapping = nullptr;
+  removeFile();
+
+  return m_source->Close();
+}
+
+arrow::Status SpillReader::Wait() {
+  std::unique_lock<std::mutex> lock(m_lock);
+  m_notEmpty.wait(lock, [this]() {
+    return m_isDone || m_isClosed;
+  });
+
+  return m_status;
+}
+
+int64_t SpillReader::GetMemoryBytes() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_memoryBytes;
+}
+
+int64_t SpillReader::GetSpilledBytes() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_spilledBytes;
+}
+
+
+/* Private impl. */
+void SpillReader::produce() {
+  while (true) {
+    std::shared_ptr<arrow::RecordBatch> batch;
+    arrow::Status status;
+    try {
+      status = m_source->ReadNext(&batch);
+    } catch (const std::exception& e) {
+      status = arrow::Status::UnknownError(e.what());
+    }
+
+    Entry entry;
+    if (status.ok() && batch) {
+      entry.size = arrow::util::TotalBufferSize(*batch);
+
+      // Checked ahead of the spill, as only the producer adds to `m_memoryBytes`
+      bool isSpilled = false;
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_isClosed) {
+          break;
+        }
+
+        isSpilled = m_memoryBytes + entry.size > m_memoryBudget && m_memoryBytes > 0;
+      }
+
+      if (isSpilled) {
+        status = spill(*batch, entry);
+      } else {
+        entry.batch = std::move(batch);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (!status.ok() || (!entry.batch && entry.offset < 0)) {
+      m_status = std::move(status);
+      m_isDone = true;
+      m_notEmpty.notify_all();
+      break;
+    }
+
+    if (m_isClosed) {
+      break;
+    }
+
+    if (entry.batch) {
+      m_memoryBytes += entry.size;
+    } else {
+      m_spilledBytes += entry.metadataLength + entry.bodyLength;
+    }
+
+    m_queue.push_back(std::move(entry));
+    m_notEmpty.notify_one();
+  }
+
+  // Written file(s) are complete, so the stream is closed with the producer
+  if (m_output) {
+    (void)m_output->Close();
+  }
+}
+
+arrow::Status SpillReader::spill(const arrow::RecordBatch& batch, Entry& entry) {
+  if (!m_output) {
+    m_path = (m_directory.empty() ? fs::temp_directory_path() : m_directory) / ::makeSpillName();
+    ARROW_ASSIGN_OR_RAISE(m_output, arrow::io::FileOutputStream::Open(m_path.string()));
+  }
+
+  ARROW_ASSIGN_OR_RAISE(entry.offset, m_output->Tell());
+  return arrow::ipc::WriteRecordBatch(
+    batch, 0, m_output.get(), &entry.metadataLength, &entry.bodyLength, arrow::ipc::IpcWriteOptions::Defaults()
+  );
+}
+
+arrow::Status SpillReader::load(const Entry& entry, std::shared_ptr<arrow::RecordBatch>* batch) {
+  // Mapped again once the file has grown past the current mapping
+  const int64_t end = entry.offset + entry.metadataLength + entry.bodyLength;
+  if (!m_mapping || m_mapping->GetSize().ValueOr(0) < end) {
+    ARROW_ASSIGN_OR_RAISE(m_mapping, arrow::io::MemoryMappedFile::Open(m_path.string(), arrow::io::FileMode::READ));
+  }
+
+  ARROW_ASSIGN_OR_RAISE(auto message, arrow::ipc::ReadMessage(entry.offset, entry.metadataLength, m_mapping.get()));
+  ARROW_ASSIGN_OR_RAISE(*batch, arrow::ipc::ReadRecordBatch(*message, m_schema, nullptr, arrow::ipc::IpcReadOptions::Defaults()));
+
+  return arrow::Status::OK();
+}
+
+void SpillReader::removeFile() {
+  if (m_path.empty()) {
+    return;
+  }
+
+  // Best effort, e.g. on Windows while a consumed batch still maps the file
+  std::error_code error;
+  fs::remove(m_path, error);
+  m_path.clear();
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <condition_variable>
+
+namespace saildb {
+
+/*
+ * Reads its source to completion on a background producer thread, within a memory budget
+ *
+ *  - Batch(es) are held in memory until those queued exceed `memoryBudget` byte(s); later batch(es) are
+ *    spilled to a temporary Arrow IPC file until the consumer catches up
+ *  - Spilled batch(es) are read back in order from a memory mapping of the file, so their buffer(s)
+ *    are file-backed page(s) that the OS may reclaim, rather than heap
+ *  - The producer never waits on the consumer, so the source, e.g. its connection, is released as soon
+ *    as it's exhausted
+ *  - The source's first error, or a failure to spill, is yielded once the batch(es) queued before it are consumed
+ *  - Closing stops the producer once its current fetch returns & removes the file
+ *
+ */
+class SpillReader : public arrow::RecordBatchReader {
+  public:
+    // `directory` holds the spill file, or the system's temporary directory if empty
+    static std::shared_ptr<SpillReader> Create(
+      std::shared_ptr<arrow::RecordBatchReader> source,
+      int64_t memoryBudget,
+      std::filesystem::path directory = std::filesystem::path()
+    );
+
+  public:
+    SpillReader(SpillReader const&) = delete;
+    SpillReader &operator=(SpillReader const&) = delete;
+    ~SpillReader() override;
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override;
+
+    // Blocks until a batch is available; yields `nullptr` once the source is exhausted
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override;
+    arrow::Status Close() override;
+
+    // Blocks until the source is exhausted, i.e. every batch is queued; yields its error, if any
+    arrow::Status Wait();
+
+    // Byte(s) of the batch(es) queued in memory
+    int64_t GetMemoryBytes() const;
+
+    // Byte(s) written to the spill file, incl. those already consumed
+    int64_t GetSpilledBytes() const;
+
+  private:
+    // Queued batch, either in memory or at `offset` of the spill file
+    struct Entry {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      int64_t size{0};
+      int64_t offset{-1};
+      int32_t metadataLength{0};
+      int64_t bodyLength{0};
+    };
+
+    SpillReader(std::shared_ptr<arrow::RecordBatchReader> source, int64_t memoryBudget, std::filesystem::path directory);
+
+    void produce();
+
+    // Producer only
+    arrow::Status spill(const arrow::RecordBatch& batch, Entry& entry);
+
+    // Consumer only
+    arrow::Status load(const Entry& entry, std::shared_ptr<arrow::RecordBatch>* batch);
+
+    void removeFile();
+
+  private:
+    std::shared_ptr<arrow::RecordBatchReader> m_source;
+    std::shared_ptr<arrow::Schema> m_schema;
+    const int64_t m_memoryBudget;
+    const std::filesystem::path m_directory;
+
+    mutable std::mutex m_lock;
+    std::condition_variable m_notEmpty;
+    std::deque<Entry> m_queue;
+    arrow::Status m_status;
+    int64_t m_memoryBytes{0};
+    int64_t m_spilledBytes{0};
+    bool m_isDone{false};
+    bool m_isClosed{false};
+
+    // Created on the first spill
+    std::filesystem::path m_path;
+    std::shared_ptr<arrow::io::FileOutputStream> m_output;
+    std::shared_ptr<arrow::io::MemoryMappedFile> m_mapping;
+
+    std::thread m_producer;
+};
+
+} // namespace saildb
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+#include <arrow/util/byte_size.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <filesystem>
+#include <system_error>
+#include <condition_variable>
+
+#include "sailc/driver/SpillReader.hpp"
+
+namespace fs = std::filesystem;
+
+using saildb::SpillReader;
+
+namespace {
+
+constexpr int64_t BATCH_ROWS = 500;
+
+// Batch `index` of `id`s, their text & a score that's NULL on every 7th row; the text is of fixed width, so each batch is of equal size
+std::shared_ptr<arrow::RecordBatch> makeBatch(int64_t index) {
+  arrow::Int64Builder ids;
+  arrow::StringBuilder names;
+  arrow::DoubleBuilder scores;
+  for (int64_t id = index * BATCH_ROWS; id < (index + 1) * BATCH_ROWS; ++id) {
+    EXPECT_TRUE(ids.Append(id).ok());
+    const std::string digits = std::to_string(id);
+    EXPECT_TRUE(names.Append("row-" + std::string(8 - digits.size(), '0') + digits).ok());
+    EXPECT_TRUE((id % 7 == 0 ? scores.AppendNull() : scores.Append(id * 0.5)).ok());
+  }
+
+  const auto schema = arrow::schema({
+    arrow::field("id", arrow::int64()),
+    arrow::field("name", arrow::utf8()),
+    arrow::field("score", arrow::float64()),
+  });
+
+  return arrow::RecordBatch::Make(schema, BATCH_ROWS, {ids.Finish().ValueOrDie(), names.Finish().ValueOrDie(), scores.Finish().ValueOrDie()});
+}
+
+/*
+ * Source of `count` batch(es) per `makeBatch`, of which only those allowed are read without blocking
+ */
+class GatedReader : public arrow::RecordBatchReader {
+  public:
+    explicit GatedReader(int64_t count, int64_t allowed = std::numeric_limits<int64_t>::max())
+      : m_count(count), m_allowed(allowed) { };
+
+  public:
+    std::shared_ptr<arrow::Schema> schema() const override {
+      return makeBatch(0)->schema();
+    }
+
+    arrow::Status ReadNext(std::shared_ptr<arrow::RecordBatch>* batch) override {
+      std::unique_lock<std::mutex> lock(m_lock);
+      const int64_t index = m_reads++;
+      m_changed.notify_all();
+      m_changed.wait(lock, [this, index]() { return index < m_allowed; });
+
+      *batch = index < m_count ? makeBatch(index) : nullptr;
+      return arrow::Status::OK();
+    }
+
+    arrow::Status Close() override {
+      m_closes.fetch_add(1);
+      return arrow::Status::OK();
+    }
+
+  public:
+    void Allow(int64_t allowed) {
+      {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_allowed = allowed;
+      }
+      m_changed.notify_all();
+    }
+
+    // Waits for `reads` read(s) to have started, i.e. the batch(es) of those before to be queued
+    bool Await(int64_t reads) {
+      std::unique_lock<std::mutex> lock(m_lock);
+      return m_changed.wait_for(lock, std::chrono::seconds(5), [this, reads]() { return m_reads >= reads; });
+    }
+
+    int64_t GetCloses() const { return m_closes.load(); }
+
+  private:
+    const int64_t m_count;
+
+    std::mutex m_lock;
+    std::condition_variable m_changed;
+    int64_t m_allowed;
+    int64_t m_reads{0};
+
+    std::atomic<int64_t> m_closes{0};
+};
+
+/*
+ * Spill directory of a test, removed once it completes
+ */
+class SpillReaderTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      const char* directory = std::getenv("TEST_TMPDIR");
+      m_directory = (directory != nullptr ? fs::path(directory) : fs::temp_directory_path()) / (
+        std::string("saildb_spill_").append(::testing::UnitTest::GetInstance()->current_test_info()->name())
+      );
+
+      std::error_code error;
+      fs::remove_all(m_directory, error);
+      fs::create_directories(m_directory);
+    }
+
+    void TearDown() override {
+      std::error_code error;
+      fs::remove_all(m_directory, error);
+    }
+
+    size_t countFiles() const {
+      size_t count = 0;
+      for ([[maybe_unused]] const auto& entry : fs::directory_iterator(m_directory)) {
+        ++count;
+      }
+
+      return count;
+    }
+
+    // Budget of `count` batch(es)
+    static int64_t budgetOf(int64_t count) {
+      return count * arrow::util::TotalBufferSize(*makeBatch(0));
+    }
+
+    // Reads the next batch, expected to be batch `index`
+    static void expectNext(SpillReader& reader, int64_t index) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      ASSERT_TRUE(reader.ReadNext(&batch).ok());
+      ASSERT_NE(batch, nullptr) << index;
+      ASSERT_TRUE(batch->ValidateFull().ok());
+      EXPECT_TRUE(batch->Equals(*makeBatch(index))) << index;
+    }
+
+    static void expectEnd(SpillReader& reader) {
+      std::shared_ptr<arrow::RecordBatch> batch;
+      ASSERT_TRUE(reader.ReadNext(&batch).ok());
+      EXPECT_EQ(batch, nullptr);
+    }
+
+  protected:
+    fs::path m_directory;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Spill                           *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(SpillReaderTest, SpillsBeyondBudgetInOrder) {
+  auto reader = SpillReader::Create(std::make_shared<GatedReader>(20), budgetOf(2), m_directory);
+  ASSERT_TRUE(reader->Wait().ok());
+
+  // Read ahead entirely, with all but the first two batch(es) spilled to a single file
+  EXPECT_GT(reader->GetSpilledBytes(), 0);
+  EXPECT_EQ(reader->GetMemoryBytes(), budgetOf(2));
+  EXPECT_EQ(countFiles(), 1u);
+
+  for (int64_t index = 0; index < 20; ++index) {
+    expectNext(*reader, index);
+  }
+  expectEnd(*reader);
+  EXPECT_EQ(reader->GetMemoryBytes(), 0);
+}
+
+TEST_F(SpillReaderTest, InterleavesMemoryAndSpilledBatchesInOrder) {
+  auto source = std::make_shared<GatedReader>(6, 3);
+  auto reader = SpillReader::Create(source, budgetOf(1), m_directory);
+  ASSERT_TRUE(source->Await(4));
+
+  // Batch 0 is held in memory & 1-2 spilled; once 0 is consumed, 3 fits in memory again & 4-5 are spilled
+  expectNext(*reader, 0);
+  const int64_t spilled = reader->GetSpilledBytes();
+  EXPECT_GT(spilled, 0);
+
+  source->Allow(7);
+  ASSERT_TRUE(reader->Wait().ok());
+  EXPECT_GT(reader->GetSpilledBytes(), spilled);
+  EXPECT_EQ(reader->GetMemoryBytes(), budgetOf(1));
+
+  for (int64_t index = 1; index < 6; ++index) {
+    expectNext(*reader, index);
+  }
+  expectEnd(*reader);
+}
+
+TEST_F(SpillReaderTest, KeepsBatchesWithinBudgetInMemory) {
+  auto reader = SpillReader::Create(std::make_shared<GatedReader>(4), budgetOf(4), m_directory);
+  ASSERT_TRUE(reader->Wait().ok());
+
+  EXPECT_EQ(reader->GetSpilledBytes(), 0);
+  EXPECT_EQ(countFiles(), 0u);
+
+  for (int64_t index = 0; index < 4; ++index) {
+    expectNext(*reader, index);
+  }
+  expectEnd(*reader);
+}
+
+TEST_F(SpillReaderTest, YieldsSpillFailureAfterQueuedBatches) {
+  auto reader = SpillReader::Create(std::make_shared<GatedReader>(4), budgetOf(1), m_directory / "missing");
+
+  // The first batch fits in memory, the second can't be spilled
+  const arrow::Status status = reader->Wait();
+  EXPECT_TRUE(status.IsIOError()) << status.ToString();
+
+  expectNext(*reader, 0);
+  std::shared_ptr<arrow::RecordBatch> batch;
+  EXPECT_TRUE(reader->ReadNext(&batch).IsIOError());
+  EXPECT_EQ(batch, nullptr);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Close                           *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(SpillReaderTest, RemovesFileOnCloseOnceDrained) {
+  auto source = std::make_shared<GatedReader>(5);
+  auto reader = SpillReader::Create(source, budgetOf(1), m_directory);
+  for (int64_t index = 0; index < 5; ++index) {
+    expectNext(*reader, index);
+  }
+  expectEnd(*reader);
+
+  ASSERT_TRUE(reader->Close().ok());
+  EXPECT_EQ(countFiles(), 0u);
+  EXPECT_EQ(source->GetCloses(), 1);
+}
+
+TEST_F(SpillReaderTest, RemovesFileOnCloseBeforeDrained) {
+  auto source = std::make_shared<GatedReader>(10);
+  auto reader = SpillReader::Create(source, budgetOf(1), m_directory);
+  ASSERT_TRUE(reader->Wait().ok());
+  ASSERT_EQ(countFiles(), 1u);
+
+  // Batch 1 is read back from the file, whose mapping it keeps alive beyond the close
+  expectNext(*reader, 0);
+  std::shared_ptr<arrow::RecordBatch> spilled;
+  ASSERT_TRUE(reader->ReadNext(&spilled).ok());
+  ASSERT_NE(spilled, nullptr);
+
+  ASSERT_TRUE(reader->Close().ok());
+  EXPECT_EQ(countFiles(), 0u);
+  EXPECT_EQ(source->GetCloses(), 1);
+  EXPECT_TRUE(spilled->Equals(*makeBatch(1)));
+
+  // The remaining batch(es) are dropped
+  expectEnd(*reader);
+  EXPECT_EQ(reader->GetMemoryBytes(), 0);
+}
+
+TEST_F(SpillReaderTest, RemovesFileOnCloseWhileProducing) {
+  auto source = std::make_shared<GatedReader>(10, 4);
+  auto reader = SpillReader::Create(source, budgetOf(1), m_directory);
+  ASSERT_TRUE(source->Await(5));
+  ASSERT_EQ(countFiles(), 1u);
+
+  // Waits for the producer's current fetch to return
+  auto closed = std::async(std::launch::async, [&reader]() { return reader->Close(); });
+  EXPECT_EQ(closed.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+  source->Allow(5);
+  ASSERT_TRUE(closed.get().ok());
+  EXPECT_EQ(countFiles(), 0u);
+  EXPECT_EQ(source->GetCloses(), 1);
+}
+
+TEST_F(SpillReaderTest, RemovesFileOnDestruction) {
+  auto source = std::make_shared<GatedReader>(10);
+  {
+    auto reader = SpillReader::Create(source, budgetOf(1), m_directory);
+    ASSERT_TRUE(reader->Wait().ok());
+    ASSERT_EQ(countFiles(), 1u);
+  }
+
+  EXPECT_EQ(countFiles(), 0u);
+  EXPECT_EQ(source->GetCloses(), 1);
+}
@@ -0,0 +1,245 @@
+#include "StatementCache.hpp"
+
+#include <utility>
+
+using StatementCache = saildb::StatementCache;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Utils                           *
+ *                                                          *
+ ************************************************************/
+
+bool isSpace(char ch) {
+  return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\f' || ch == '\v' || ch == '\r';
+}
+
+// Driver's `SQL_CB_*` behaviour for `infoType`, or `SQL_CB_DELETE` if unknown
+int32_t getCursorBehavior(SQLHDBC connection, SQLUSMALLINT infoType) {
+  SQLUSMALLINT behavior = SQL_CB_DELETE;
+  if (!SQL_SUCCEEDED(SQLGetInfo(connection, infoType, &behavior, sizeof(behavior), nullptr))) {
+    return SQL_CB_DELETE;
+  }
+
+  return behavior;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                      StatementCache                      *
+ *                                                          *
+ ************************************************************/
+
+/* Static impl. */
+std::string StatementCache::Normalise(std::string_view query) {
+  std::string result;
+  result.reserve(query.size());
+
+  bool isPending = false;
+  size_t i = 0;
+  while (i < query.size()) {
+    const char ch = query[i];
+
+    if (::isSpace(ch)) {
+      isPending = !result.empty();
+      ++i;
+      continue;
+    }
+
+    if (ch == '-' && i + 1 < query.size() && query[i + 1] == '-') {
+      while (i < query.size() && query[i] != '\n') {
+        ++i;
+      }
+
+      isPending = !result.empty();
+      continue;
+    }
+
+    if (isPending) {
+      result.push_back(' ');
+      isPending = false;
+    }
+
+    // Copied verbatim up to & including the closing delimiter; doubled delimiter(s) are escapes
+    size_t end = i + 1;
+    if (ch == '\'' || ch == '"' || ch == '[' || ch == '`') {
+      const char close = ch == '[' ? ']' : ch;
+      while (end < query.size()) {
+        if (query[end++] != close) {
+          continue;
+        }
+
+        if (end < query.size() && query[end] == close) {
+          ++end;
+          continue;
+        }
+
+        break;
+      }
+    } else if (ch == '/' && i + 1 < query.size() && query[i + 1] == '*') {
+      const size_t close = query.find("*/", i + 2);
+      end = close == std::string_view::npos ? query.size() : close + 2;
+    }
+
+    result.append(query.substr(i, end - i));
+    i = end;
+  }
+
+  return result;
+}
+
+std::string StatementCache::GetKey(std::string_view query, std::string_view signature) {
+  std::string result = StatementCache::Normalise(query);
+  result.push_back('\0');
+  result.append(signature);
+
+  return result;
+}
+
+
+/* Ctor & Dtor */
+StatementCache::StatementCache(size_t capacity, saildb::StatementCacheStats* stats /*= nullptr*/)
+  : m_capacity(capacity), m_stats(stats) { };
+
+StatementCache::~StatementCache() {
+  Clear();
+}
+
+
+/* Public impl. */
+saildb::PreparedStatement StatementCache::Prepare(SQLHDBC connection, std::string_view query, const std::string& key) {
+  saildb::PreparedStatement result;
+  if (Take(key, result)) {
+    return result;
+  }
+
+  result.statement = odbc::StatementHandle(connection);
+
+  const nanodbc::string text = odbc::toNativeString(query);
+  result.statement.Check(SQLPrepareW(result.statement.Get(), const_cast<SQLWCHAR*>(odbc::toSqlWide(text)), SQL_NTS), "Failed to prepare query");
+
+  return result;
+}
+
+bool StatementCache::Take(const std::string& key, saildb::PreparedStatement& statement) {
+  std::lock_guard<std::mutex> lock(m_lock);
+  statement.generation = m_generation;
+
+  const auto it = m_index.find(key);
+  if (it == m_index.end()) {
+    ++m_misses;
+    if (m_stats != nullptr) {
+      m_stats->misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return false;
+  }
+
+  statement = std::move(it->second->second);
+  m_entries.erase(it->second);
+  m_index.erase(it);
+
+  ++m_hits;
+  if (m_stats != nullptr) {
+    m_stats->hits.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  return true;
+}
+
+void StatementCache::Put(std::string key, saildb::PreparedStatement statement) {
+  if (m_capacity < 1 || !statement.statement) {
+    return;
+  }
+
+  // Ready for re-execution, i.e. no open cursor, bound column(s) or parameter(s)
+  SQLHSTMT handle = statement.statement.Get();
+  const bool isReset = (
+    SQL_SUCCEEDED(SQLFreeStmt(handle, SQL_CLOSE)) &&
+    SQL_SUCCEEDED(SQLFreeStmt(handle, SQL_UNBIND)) &&
+    SQL_SUCCEEDED(SQLFreeStmt(handle, SQL_RESET_PARAMS))
+  );
+
+  if (!isReset) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_lock);
+  if (statement.generation != m_generation) {
+    return;
+  }
+
+  const auto it = m_index.find(key);
+  if (it != m_index.end()) {
+    m_entries.erase(it->second);
+    m_index.erase(it);
+  }
+
+  m_entries.emplace_front(std::move(key), std::move(statement));
+  m_index.emplace(m_entries.front().first, m_entries.begin());
+
+  while (m_entries.size() > m_capacity) {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+
+    ++m_evictions;
+    if (m_stats != nullptr) {
+      m_stats->evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+void StatementCache::Clear() {
+  std::lock_guard<std::mutex> lock(m_lock);
+  clear();
+}
+
+void StatementCache::OnTransactionEnd(SQLHDBC connection, SQLSMALLINT completionType) {
+  std::lock_guard<std::mutex> lock(m_lock);
+
+  int32_t& behavior = completionType == SQL_COMMIT ? m_commitBehavior : m_rollbackBehavior;
+  if (behavior < 0) {
+    behavior = ::getCursorBehavior(connection, completionType == SQL_COMMIT ? SQL_CURSOR_COMMIT_BEHAVIOR : SQL_CURSOR_ROLLBACK_BEHAVIOR);
+  }
+
+  if (behavior == SQL_CB_DELETE) {
+    clear();
+  }
+}
+
+size_t StatementCache::GetSize() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_entries.size();
+}
+
+size_t StatementCache::GetCapacity() const {
+  return m_capacity;
+}
+
+uint64_t StatementCache::GetHits() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_hits;
+}
+
+uint64_t StatementCache::GetMisses() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_misses;
+}
+
+uint64_t StatementCache::GetEvictions() const {
+  std::lock_guard<std::mutex> lock(m_lock);
+  return m_evictions;
+}
+
+
+/* Private impl. */
+void StatementCache::clear() {
+  ++m_generation;
+
+  m_index.clear();
+  m_entries.clear();
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+
+#include "sailc/driver/Odbc.hpp"
+
+namespace saildb {
+
+// Column of a described result set, i.e. the output of `SQLDescribeCol`
+struct ColumnDescription {
+  std::string name;
+  SQLSMALLINT sqlType{0};
+  SQLULEN columnSize{0};
+  SQLSMALLINT digits{0};
+  SQLSMALLINT nullable{SQL_NULLABLE_UNKNOWN};
+};
+
+using ResultDescription = std::vector<ColumnDescription>;
+
+// Prepared statement handle & the description of its result set, if known
+struct PreparedStatement {
+  odbc::StatementHandle statement;
+  std::shared_ptr<const ResultDescription> description;
+  uint64_t generation{0};
+};
+
+// Counter(s) shared by each cache of a pool
+struct StatementCacheStats {
+  std::atomic<uint64_t> hits{0};
+  std::atomic<uint64_t> misses{0};
+  std::atomic<uint64_t> evictions{0};
+};
+
+/*
+ * LRU cache of prepared statement(s) of a single connection, keyed by the normalised
+ * query & the type(s) of its parameter(s)
+ *
+ *  - Statement(s) are taken out of the cache while in use & put back once their result
+ *    set is closed, so concurrent use of the same query prepares a second statement
+ *  - Statement(s) put back once the cache is invalidated are freed rather than kept, as
+ *    the driver may have deleted them, e.g. on commit with `SQL_CB_DELETE`
+ *  - Owned by the pooled connection; locked, as a result set may be closed by a prefetching
+ *    thread while the lease's owner executes another statement
+ *
+ */
+class StatementCache {
+  public:
+    StatementCache(size_t capacity, StatementCacheStats* stats = nullptr);
+    ~StatementCache();
+
+    StatementCache(StatementCache const&) = delete;
+    StatementCache &operator=(StatementCache const&) = delete;
+
+  public:
+    // Collapses whitespace & strips line comment(s) outside of literal(s), quoted identifier(s) & block comment(s);
+    // block comment(s) are kept, as they may be hint(s)
+    static std::string Normalise(std::string_view query);
+
+    static std::string GetKey(std::string_view query, std::string_view signature);
+
+  public:
+    // Takes the cached statement of `key`, otherwise prepares `query` on `connection`
+    PreparedStatement Prepare(SQLHDBC connection, std::string_view query, const std::string& key);
+
+    // Moves the cached statement of `key` into `statement`, if any; on a miss only its generation is set
+    bool Take(const std::string& key, PreparedStatement& statement);
+
+    // Closes the statement's cursor & returns it to the cache as its most recently used entry
+    void Put(std::string key, PreparedStatement statement);
+
+    // Frees every cached statement; those in use are freed once put back
+    void Clear();
+
+    // Clears the cache if the driver deletes prepared statement(s) on commit or rollback
+    void OnTransactionEnd(SQLHDBC connection, SQLSMALLINT completionType);
+
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    uint64_t GetHits() const;
+    uint64_t GetMisses() const;
+    uint64_t GetEvictions() const;
+
+  private:
+    using Entry = std::pair<std::string, PreparedStatement>;
+
+    // Expects `m_lock` to be held
+    void clear();
+
+  private:
+    const size_t m_capacity;
+    StatementCacheStats* m_stats;
+
+    mutable std::mutex m_lock;
+
+    std::list<Entry> m_entries;
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> m_index;
+    uint64_t m_generation{0};
+
+    // `SQL_CURSOR_COMMIT_BEHAVIOR` & `SQL_CURSOR_ROLLBACK_BEHAVIOR`, or -1 until queried
+    int32_t m_commitBehavior{-1};
+    int32_t m_rollbackBehavior{-1};
+
+    uint64_t m_hits{0};
+    uint64_t m_misses{0};
+    uint64_t m_evictions{0};
+};
+
+} // namespace saildb
@@ -0,0 +1,359 @@
+#include <gtest/gtest.h>
+
+#include <arrow/api.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <functional>
+
+#include "sailc/driver/ResultReader.hpp"
+#include "sailc/driver/StatementCache.hpp"
+#include "sailc/driver/TestDatabase.hpp"
+
+using saildb::PoolOptions;
+using saildb::ResultReader;
+using saildb::ConnectionPool;
+using saildb::StatementCache;
+using saildb::PooledConnection;
+using saildb::PreparedStatement;
+using saildb::ResultDescription;
+using saildb::StatementCacheStats;
+using saildb::testing::TestDatabase;
+
+namespace {
+
+constexpr const char* QUERY = "SELECT id, name FROM saildb_rows ORDER BY id";
+
+/*
+ * Scratch database of a single connection, so that each lease shares one statement cache
+ */
+class StatementCacheTest : public ::testing::Test {
+  protected:
+    StatementCacheTest()
+      : m_database(::testing::UnitTest::GetInstance()->current_test_info()->name()) { };
+
+    void SetUp() override {
+      PoolOptions options;
+      options.maxSize = 1;
+      options.statementCacheSize = 4;
+
+      std::string errorMessage;
+      m_pool = m_database.TryCreatePool(std::move(options), errorMessage);
+      if (!m_pool) {
+        GTEST_SKIP() << errorMessage;
+      }
+
+      TestDatabase::Execute(*m_pool->Acquire(), "CREATE TABLE saildb_rows (id INTEGER, name VARCHAR(16))");
+      TestDatabase::Execute(*m_pool->Acquire(), "INSERT INTO saildb_rows VALUES (1, 'row-1'), (2, 'row-2'), (3, NULL)");
+    }
+
+    static SQLHDBC handleOf(PooledConnection& lease) {
+      return static_cast<SQLHDBC>(lease->native_dbc_handle());
+    }
+
+    // Reads `QUERY` to its end, returning its schema & row count
+    std::pair<std::shared_ptr<arrow::Schema>, int64_t> read() {
+      auto reader = ResultReader::Create(m_pool->Acquire(), QUERY);
+
+      int64_t rows = 0;
+      while (true) {
+        std::shared_ptr<arrow::RecordBatch> batch;
+        EXPECT_TRUE(reader->ReadNext(&batch).ok());
+        if (!batch) {
+          break;
+        }
+
+        EXPECT_TRUE(batch->ValidateFull().ok());
+        rows += batch->num_rows();
+      }
+
+      return {reader->schema(), rows};
+    }
+
+    // Rewrites the description cached with `QUERY`'s statement
+    void rewriteDescription(const std::function<void(ResultDescription&)>& rewrite) {
+      PooledConnection lease = m_pool->Acquire();
+      const std::string key = StatementCache::GetKey(QUERY, {});
+
+      PreparedStatement statement;
+      ASSERT_TRUE(lease.GetStatementCache().Take(key, statement));
+      ASSERT_NE(statement.description, nullptr);
+
+      auto description = std::make_shared<ResultDescription>(*statement.description);
+      rewrite(*description);
+      statement.description = std::move(description);
+
+      lease.GetStatementCache().Put(key, std::move(statement));
+    }
+
+    std::shared_ptr<const ResultDescription> cachedDescription() {
+      PooledConnection lease = m_pool->Acquire();
+      const std::string key = StatementCache::GetKey(QUERY, {});
+
+      PreparedStatement statement;
+      if (!lease.GetStatementCache().Take(key, statement)) {
+        return nullptr;
+      }
+
+      auto description = statement.description;
+      lease.GetStatementCache().Put(key, std::move(statement));
+      return description;
+    }
+
+    // Renames each cached column, so that a reused description is told apart from a fresh one
+    static void rename(ResultDescription& description) {
+      for (auto& column : description) {
+        column.name = "stale_" + column.name;
+      }
+    }
+
+    static std::vector<std::string> namesOf(const arrow::Schema& schema) {
+      std::vector<std::string> names;
+      for (const auto& field : schema.fields()) {
+        names.push_back(field->name());
+      }
+
+      return names;
+    }
+
+  protected:
+    TestDatabase m_database;
+    std::shared_ptr<ConnectionPool> m_pool;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Normalise                         *
+ *                                                          *
+ ************************************************************/
+
+TEST(StatementCacheNormaliseTest, CollapsesWhitespace) {
+  EXPECT_EQ(StatementCache::Normalise("  SELECT\ta,\r\n\n   b\fFROM  t \v "), "SELECT a, b FROM t");
+  EXPECT_EQ(StatementCache::Normalise("SELECT 1"), "SELECT 1");
+  EXPECT_EQ(StatementCache::Normalise(" \n\t "), "");
+  EXPECT_EQ(StatementCache::Normalise(""), "");
+}
+
+TEST(StatementCacheNormaliseTest, StripsLineComments) {
+  EXPECT_EQ(StatementCache::Normalise("-- leading\nSELECT a -- trailing\nFROM t"), "SELECT a FROM t");
+  EXPECT_EQ(StatementCache::Normalise("SELECT a--no space\nFROM t"), "SELECT a FROM t");
+  EXPECT_EQ(StatementCache::Normalise("SELECT a FROM t -- unterminated"), "SELECT a FROM t");
+
+  // A single dash is an operator
+  EXPECT_EQ(StatementCache::Normalise("SELECT a - b, -c FROM t"), "SELECT a - b, -c FROM t");
+}
+
+TEST(StatementCacheNormaliseTest, KeepsBlockComments) {
+  // Possibly a hint, so copied verbatim, whitespace & line comment marker(s) included
+  EXPECT_EQ(
+    StatementCache::Normalise("SELECT  /*+ INDEX(t  i)\n -- not a comment */  a FROM t"),
+    "SELECT /*+ INDEX(t  i)\n -- not a comment */ a FROM t"
+  );
+  EXPECT_EQ(StatementCache::Normalise("SELECT a /* unterminated  \n"), "SELECT a /* unterminated  \n");
+}
+
+TEST(StatementCacheNormaliseTest, KeepsLiteralsAsIs) {
+  EXPECT_EQ(StatementCache::Normalise("SELECT 'a  b\n-- c'  FROM t"), "SELECT 'a  b\n-- c' FROM t");
+  EXPECT_EQ(StatementCache::Normalise("SELECT 'it''s  /* x */'  FROM t"), "SELECT 'it''s  /* x */' FROM t");
+
+  // Quoted identifier(s) of either dialect
+  EXPECT_EQ(StatementCache::Normalise("SELECT \"a  \"\"b\"  FROM t"), "SELECT \"a  \"\"b\" FROM t");
+  EXPECT_EQ(StatementCache::Normalise("SELECT [a  b], `c  -- d`  FROM t"), "SELECT [a  b], `c  -- d` FROM t");
+
+  // Copied to the end if unterminated
+  EXPECT_EQ(StatementCache::Normalise("SELECT 'a  b -- c"), "SELECT 'a  b -- c");
+}
+
+TEST(StatementCacheNormaliseTest, KeysByNormalisedQueryAndSignature) {
+  EXPECT_EQ(StatementCache::GetKey("SELECT  a\nFROM t -- x", "ll"), StatementCache::GetKey("SELECT a FROM t", "ll"));
+  EXPECT_NE(StatementCache::GetKey("SELECT a FROM t", "ll"), StatementCache::GetKey("SELECT a FROM t", "ld"));
+  EXPECT_NE(StatementCache::GetKey("SELECT 'a  b'", {}), StatementCache::GetKey("SELECT 'a b'", {}));
+
+  // The query is delimited from its signature
+  EXPECT_NE(StatementCache::GetKey("SELECT ?", "l"), StatementCache::GetKey("SELECT ?l", {}));
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                           LRU                            *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(StatementCacheTest, EvictsLeastRecentlyUsed) {
+  PooledConnection lease = m_pool->Acquire();
+  StatementCacheStats stats;
+  StatementCache cache(2, &stats);
+
+  for (const char* query : {"SELECT 1", "SELECT 2"}) {
+    cache.Put(query, cache.Prepare(handleOf(lease), query, query));
+  }
+  EXPECT_EQ(cache.GetSize(), 2u);
+  EXPECT_EQ(cache.GetMisses(), 2u);
+
+  // Using the oldest entry makes it the most recent, so the other is evicted instead
+  PreparedStatement statement = cache.Prepare(handleOf(lease), "SELECT 1", "SELECT 1");
+  EXPECT_EQ(cache.GetHits(), 1u);
+  EXPECT_EQ(cache.GetSize(), 1u);
+  cache.Put("SELECT 1", std::move(statement));
+
+  cache.Put("SELECT 3", cache.Prepare(handleOf(lease), "SELECT 3", "SELECT 3"));
+  EXPECT_EQ(cache.GetSize(), 2u);
+  EXPECT_EQ(cache.GetEvictions(), 1u);
+
+  PreparedStatement taken;
+  EXPECT_FALSE(cache.Take("SELECT 2", taken));
+  EXPECT_TRUE(cache.Take("SELECT 1", taken));
+  EXPECT_TRUE(cache.Take("SELECT 3", taken));
+  EXPECT_EQ(cache.GetSize(), 0u);
+
+  // Mirrored into the shared counter(s)
+  EXPECT_EQ(stats.hits.load(), cache.GetHits());
+  EXPECT_EQ(stats.misses.load(), cache.GetMisses());
+  EXPECT_EQ(stats.evictions.load(), 1u);
+}
+
+TEST_F(StatementCacheTest, EvictsInOrderOfPut) {
+  PooledConnection lease = m_pool->Acquire();
+  StatementCache cache(3);
+
+  const std::vector<std::string> queries = {"SELECT 1", "SELECT 2", "SELECT 3", "SELECT 4", "SELECT 5"};
+  for (const std::string& query : queries) {
+    cache.Put(query, cache.Prepare(handleOf(lease), query, query));
+  }
+  EXPECT_EQ(cache.GetSize(), 3u);
+  EXPECT_EQ(cache.GetEvictions(), 2u);
+
+  PreparedStatement taken;
+  for (size_t i = 0; i < queries.size(); ++i) {
+    EXPECT_EQ(cache.Take(queries[i], taken), i >= 2) << queries[i];
+  }
+}
+
+TEST_F(StatementCacheTest, ReplacesEntryOfSameKey) {
+  PooledConnection lease = m_pool->Acquire();
+  StatementCache cache(2);
+
+  // Concurrent use of a query prepares a second statement; only the last one put back is kept
+  PreparedStatement first = cache.Prepare(handleOf(lease), "SELECT 1", "SELECT 1");
+  PreparedStatement second = cache.Prepare(handleOf(lease), "SELECT 1", "SELECT 1");
+  const SQLHSTMT handle = second.statement.Get();
+
+  cache.Put("SELECT 1", std::move(first));
+  cache.Put("SELECT 1", std::move(second));
+  EXPECT_EQ(cache.GetSize(), 1u);
+  EXPECT_EQ(cache.GetEvictions(), 0u);
+
+  PreparedStatement taken;
+  ASSERT_TRUE(cache.Take("SELECT 1", taken));
+  EXPECT_EQ(taken.statement.Get(), handle);
+}
+
+TEST_F(StatementCacheTest, FreesStatementsPutBackOnceCleared) {
+  PooledConnection lease = m_pool->Acquire();
+  StatementCache cache(2);
+
+  cache.Put("SELECT 1", cache.Prepare(handleOf(lease), "SELECT 1", "SELECT 1"));
+  PreparedStatement inUse = cache.Prepare(handleOf(lease), "SELECT 2", "SELECT 2");
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0u);
+
+  // Prepared before the clear, so it may have been deleted by the driver
+  cache.Put("SELECT 2", std::move(inUse));
+  EXPECT_EQ(cache.GetSize(), 0u);
+
+  cache.Put("SELECT 2", cache.Prepare(handleOf(lease), "SELECT 2", "SELECT 2"));
+  EXPECT_EQ(cache.GetSize(), 1u);
+}
+
+TEST_F(StatementCacheTest, CachesNothingWithoutCapacity) {
+  PooledConnection lease = m_pool->Acquire();
+  StatementCache cache(0);
+
+  cache.Put("SELECT 1", cache.Prepare(handleOf(lease), "SELECT 1", "SELECT 1"));
+  EXPECT_EQ(cache.GetSize(), 0u);
+  EXPECT_EQ(cache.GetEvictions(), 0u);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                       Description                        *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(StatementCacheTest, ReusesMatchingDescription) {
+  EXPECT_EQ(read().second, 3);
+  rewriteDescription(rename);
+
+  // Each column's type, size & nullability still match, so it isn't described again
+  const auto [schema, rows] = read();
+  EXPECT_EQ(namesOf(*schema), (std::vector<std::string>{"stale_id", "stale_name"}));
+  EXPECT_EQ(rows, 3);
+}
+
+TEST_F(StatementCacheTest, RedescribesOnTypeChange) {
+  read();
+  rewriteDescription([](ResultDescription& description) {
+    rename(description);
+    description[0].sqlType = SQL_TYPE_DATE;
+  });
+
+  const auto [schema, rows] = read();
+  EXPECT_EQ(namesOf(*schema), (std::vector<std::string>{"id", "name"}));
+  EXPECT_TRUE(arrow::is_integer(schema->field(0)->type()->id()));
+  EXPECT_EQ(rows, 3);
+
+  // Replaced in the cache by the fresh description
+  const auto description = cachedDescription();
+  ASSERT_NE(description, nullptr);
+  EXPECT_NE((*description)[0].sqlType, SQL_TYPE_DATE);
+  EXPECT_EQ((*description)[0].name, "id");
+}
+
+TEST_F(StatementCacheTest, RedescribesOnSizeChange) {
+  read();
+  rewriteDescription([](ResultDescription& description) {
+    rename(description);
+    description[1].columnSize += 1;
+  });
+
+  const auto [schema, rows] = read();
+  EXPECT_EQ(namesOf(*schema), (std::vector<std::string>{"id", "name"}));
+  EXPECT_EQ(rows, 3);
+}
+
+TEST_F(StatementCacheTest, RedescribesOnNullabilityChange) {
+  read();
+  rewriteDescription([](ResultDescription& description) {
+    rename(description);
+    description[1].nullable = description[1].nullable == SQL_NO_NULLS ? SQL_NULLABLE : SQL_NO_NULLS;
+  });
+
+  const auto [schema, rows] = read();
+  EXPECT_EQ(namesOf(*schema), (std::vector<std::string>{"id", "name"}));
+  EXPECT_EQ(rows, 3);
+}
+
+TEST_F(StatementCacheTest, RedescribesOnColumnCountChange) {
+  read();
+  rewriteDescription([](ResultDescription& description) {
+    rename(description);
+    description.pop_back();
+  });
+
+  const auto [schema, rows] = read();
+  EXPECT_EQ(namesOf(*schema), (std::vector<std::string>{"id", "name"}));
+  EXPECT_EQ(rows, 3);
+  EXPECT_EQ(cachedDescription()->size(), 2u);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <utility>
+#include <exception>
+#include <filesystem>
+#include <string_view>
+#include <system_error>
+
+#include "sailc/driver/Odbc.hpp"
+#include "sailc/driver/ConnectionPool.hpp"
+
+namespace saildb {
+namespace testing {
+
+/*
+ * Scratch database of a driver test, i.e. a SQLite file opened through the host's
+ * driver manager (unixODBC & the `SQLite3` driver of sqliteodbc)
+ *
+ *  - `SAILDB_TEST_CONNECTION` overrides the connection string, e.g. to run the
+ *    test(s) against another driver; the database is then left as found
+ *  - The file is created under `TEST_TMPDIR` when run by Bazel, and removed on
+ *    destruction
+ *
+ */
+class TestDatabase {
+  public:
+    explicit TestDatabase(std::string_view name) {
+      if (const char* connectionString = std::getenv("SAILDB_TEST_CONNECTION"); connectionString != nullptr && *connectionString != '\0') {
+        m_connectionString = connectionString;
+        return;
+      }
+
+      const char* directory = std::getenv("TEST_TMPDIR");
+      m_path = (directory != nullptr ? std::filesystem::path(directory) : std::filesystem::temp_directory_path()) / (std::string("saildb_").append(name).append(".db"));
+
+      std::error_code error;
+      std::filesystem::remove(m_path, error);
+
+      m_connectionString = std::string("Driver=SQLite3;Database=").append(m_path.string()).append(";");
+    }
+
+    ~TestDatabase() {
+      if (!m_path.empty()) {
+        std::error_code error;
+        std::filesystem::remove(m_path, error);
+      }
+    }
+
+    TestDatabase(TestDatabase const&) = delete;
+    TestDatabase &operator=(TestDatabase const&) = delete;
+
+  public:
+    const std::string& GetConnectionString() const {
+      return m_connectionString;
+    }
+
+    // Creates a pool & opens its first connection, or returns `nullptr` if the driver is unavailable
+    std::shared_ptr<ConnectionPool> TryCreatePool(PoolOptions options, std::string& errorMessage) const {
+      try {
+        auto pool = ConnectionPool::Create(m_connectionString, std::move(options));
+        pool->Acquire().Release();
+        return pool;
+      } catch (const std::exception& error) {
+        errorMessage = std::string("Failed to connect to `").append(m_connectionString).append("`: ").append(error.what());
+        return nullptr;
+      }
+    }
+
+  public:
+    static void Execute(nanodbc::connection& connection, std::string_view query) {
+      nanodbc::just_execute(connection, odbc::toNativeString(query));
+    }
+
+  private:
+    std::filesystem::path m_path;
+    std::string m_connectionString;
+};
+
+} // namespace testing
+} // namespace saildb
@@ -0,0 +1,1400 @@
+#include "wapi.hpp"
+
+#include <cstring>
+#include <cwctype>
+#include <fstream>
+#include <span>
+#include <array>
+#include <mutex>
+#include <thread>
+#include <random>
+#include <vector>
+#include <exception>
+#include <algorithm>
+#include <unordered_set>
+#include <memory_resource>
+
+#include "sailc/wapi/internal.hpp"
+#include "sailc/wapi/structural.hpp"
+#include "sailc/common/constants.hpp"
+
+namespace wapi = saildb::wapi;
+namespace common = saildb::common;
+namespace constants = saildb::constants;
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Parsing                          *
+ *                                                          *
+ ************************************************************/
+
+using Issue = wapi::DotEnv::Issue;
+using Reference = wapi::DotEnv::Reference;
+using Diagnostic = wapi::DotEnv::Diagnostic;
+using ExpansionExpr = wapi::DotEnv::ExpansionExpr;
+
+
+// Diagnostics
+struct Diagnostics {
+  std::array<wapi::DotEnv::Diagnostic, wapi::DotEnv::DIAGNOSTIC_CAPACITY> ring;
+  size_t count{0};
+
+  void Push(const wapi::DotEnv::Diagnostic& diagnostic) {
+    ring[count % ring.size()] = diagnostic;
+    count++;
+  }
+
+  // Appends the issue(s) of `other`, incl. those it no longer retains to the total
+  void Merge(const Diagnostics& other, uint32_t layer) {
+    const size_t retained = std::min(other.count, other.ring.size());
+    count += other.count - retained;
+
+    for (size_t i = other.count - retained; i < other.count; ++i) {
+      wapi::DotEnv::Diagnostic diagnostic = other.ring[i % other.ring.size()];
+      diagnostic.layer = layer;
+      Push(diagnostic);
+    }
+  }
+};
+
+
+// Storage
+struct wapi::DotEnv::Storage {
+  wapi::internal::MappedFile mapping;
+  wapi::internal::MappedFile snapshot;
+  std::string buffer;
+
+  // Sorted entry table & blob of a snapshot load, viewed from `snapshot`; `snapshotEntries`
+  // holds the value & memoised coercion of each entry, in table order
+  std::string_view snapshotTable;
+  std::string_view snapshotBlob;
+  std::unique_ptr<wapi::DotEnv::Entry[]> snapshotEntries;
+  std::pmr::monotonic_buffer_resource arena;
+
+  // Name(s) of every reference resolved, i.e. the env var(s) the entries depend upon
+  std::vector<std::string_view> references;
+
+  // Storage of each merged layer, viewed by the entries of a layered load
+  std::vector<std::shared_ptr<Storage>> layers;
+
+  // Only allocated if diagnostics are enabled
+  std::unique_ptr<Diagnostics> diagnostics;
+
+  // Guards the arena & entry expansion once parsed, i.e. when lazily interpolating
+  std::mutex lock;
+
+  // Process env captured on first interpolation, shared by any lazy expansion(s)
+  std::shared_ptr<const wapi::EnvSnapshot> environment;
+  bool isSharedEnvironment{false};
+
+  const wapi::EnvSnapshot& Environment() {
+    if (!environment) {
+      environment = isSharedEnvironment ? wapi::EnvSnapshot::GetShared() : wapi::EnvSnapshot::Capture();
+    }
+
+    return *environment;
+  }
+
+  std::string_view View() const {
+    return mapping.IsOpen() ? mapping.View() : std::string_view(buffer);
+  }
+
+  char* Allocate(size_t length) {
+    return static_cast<char*>(arena.allocate(length, alignof(char)));
+  }
+
+  std::string_view Store(std::string_view value) {
+    if (value.empty()) {
+      return std::string_view();
+    }
+
+    char* data = Allocate(value.size());
+    std::memcpy(data, value.data(), value.size());
+    return std::string_view(data, value.size());
+  }
+
+  template <typename T>
+  T* Emplace(T&& value) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    return ::new (arena.allocate(sizeof(T), alignof(T))) T(std::forward<T>(value));
+  }
+};
+
+
+// Interpolation
+struct wapi::DotEnv::Interpolator {
+  // Reference to be spliced into the literal text at `offset`
+  struct Placeholder {
+    size_t offset;
+    Reference ref;
+  };
+
+  Interpolator(const wapi::DotEnv::EntryMap& entryMap, wapi::DotEnv::Storage& entryStorage)
+    : entries(entryMap), storage(entryStorage) { }
+
+  // Entry that a reference would resolve to, i.e. unless shadowed by a process env var
+  const wapi::DotEnv::Entry* FindDependency(const Reference& ref) {
+    if (storage.Environment().Contains(ref.name)) {
+      return nullptr;
+    }
+
+    const auto entry = entries.find(ref.name);
+    return entry != entries.end() ? &entry->second : nullptr;
+  }
+
+  // Expands a pending entry once each of its pending dependencies has been, in depth-first order;
+  // expects the storage's lock to be held if the entries are shared
+  bool Expand(const wapi::DotEnv::Entry& entry);
+
+  std::string_view Render(std::string_view literal, std::span<const Placeholder> placeholders) {
+    // Resolve every reference up front so that the output can be written in one pass
+    size_t length = literal.size();
+    resolved.clear();
+    for (const auto& placeholder : placeholders) {
+      resolved.push_back(resolve(placeholder.ref));
+      length += resolved.back().size();
+    }
+
+    if (length == 0) {
+      return std::string_view();
+    }
+
+    char* const data = storage.Allocate(length);
+    char* out = data;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < placeholders.size(); ++i) {
+      const size_t next = placeholders[i].offset;
+      out = std::copy(literal.data() + offset, literal.data() + next, out);
+      out = std::copy(resolved[i].begin(), resolved[i].end(), out);
+      offset = next;
+    }
+
+    std::copy(literal.data() + offset, literal.data() + literal.size(), out);
+    return std::string_view(data, length);
+  }
+
+  private:
+    std::string_view resolve(const Reference& ref) {
+      // Process env var(s) take precedence over entries
+      std::string_view value;
+      storage.references.push_back(ref.name);
+
+      bool isSetValue = storage.Environment().TryGet(ref.name, value);
+      if (!isSetValue) {
+        const auto entry = entries.find(ref.name);
+        if (entry != entries.end()) {
+          value = entry->second.value;
+          isSetValue = true;
+        }
+      }
+
+      switch (ref.expr) {
+        case ExpansionExpr::SubstituteUnset:
+          return isSetValue ? value : ref.defaultValue;
+
+        case ExpansionExpr::SubstituteEmpty:
+          return value.empty() ? ref.defaultValue : value;
+
+        default:
+          return value;
+      }
+    }
+
+  private:
+    struct Frame {
+      const wapi::DotEnv::Entry* entry;
+      size_t next;
+    };
+
+    const wapi::DotEnv::EntryMap& entries;
+    wapi::DotEnv::Storage& storage;
+    std::vector<std::string_view> resolved;
+    std::vector<Frame> stack;
+};
+
+// Lazy interpolation
+struct wapi::DotEnv::Template {
+  std::string_view literal;
+  std::span<const Interpolator::Placeholder> placeholders;
+};
+
+bool wapi::DotEnv::Interpolator::Expand(const wapi::DotEnv::Entry& entry) {
+  using Entry = wapi::DotEnv::Entry;
+
+  const uint8_t status = entry.GetStatus();
+  if (status != Entry::PENDING) {
+    return status == Entry::READY;
+  }
+
+  stack.clear();
+  stack.push_back({ &entry, 0 });
+  entry.SetStatus(Entry::EXPANDING);
+
+  while (!stack.empty()) {
+    Frame& frame = stack.back();
+
+    const auto placeholders = frame.entry->source->placeholders;
+    if (frame.next < placeholders.size()) {
+      const Entry* dependency = FindDependency(placeholders[frame.next++].ref);
+      if (!dependency) {
+        continue;
+      }
+
+      const uint8_t dependencyStatus = dependency->GetStatus();
+      if (dependencyStatus == Entry::READY) {
+        continue;
+      }
+
+      if (dependencyStatus != Entry::PENDING) {
+        // Everything on the stack is either part of, or depends on, the cycle
+        for (const auto& member : stack) {
+          member.entry->SetStatus(Entry::CYCLIC);
+        }
+
+        return false;
+      }
+
+      dependency->SetStatus(Entry::EXPANDING);
+      stack.push_back({ dependency, 0 });
+      continue;
+    }
+
+    const Entry* expanded = frame.entry;
+    expanded->value = Render(expanded->source->literal, placeholders);
+    expanded->SetStatus(Entry::READY);
+    stack.pop_back();
+  }
+
+  return true;
+}
+
+
+// Validation
+inline bool isBlankChar(char ch) {
+  return ch == ' ' || ch == '\t' || ch == '\v' || ch == '\f' || ch == '\r';
+}
+
+inline bool isQuoteChar(char ch) {
+  return ch == '\'' || ch == '\"' || ch == '`';
+}
+
+inline bool isLegalEnvLead(char ch) {
+  return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+}
+
+inline bool isLegalEnvChar(char ch) {
+  return ::isLegalEnvLead(ch) || (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+bool isLegalEnvKeyword(std::string_view key) {
+  if (key.empty() || !::isLegalEnvLead(key.front())) {
+    return false;
+  }
+
+  return std::all_of(key.begin(), key.end(), ::isLegalEnvChar);
+}
+
+
+// Utility
+std::string_view trimRight(const char* head, const char* tail) {
+  while (tail > head && ::isBlankChar(*(tail - 1))) {
+    tail--;
+  }
+
+  return std::string_view(head, tail - head);
+}
+
+void appendUnescaped(std::string& output, char ch) {
+  switch (ch) {
+    case 'n':
+      output.push_back('\n');
+      break;
+    case 'r':
+      output.push_back('\r');
+      break;
+    case 't':
+      output.push_back('\t');
+      break;
+    case 'b':
+    case 'v':
+    case 'f':
+      break;
+    default:
+      output.push_back(ch);
+      break;
+  }
+}
+
+const char* scanReference(const char* head, const char* end, char delim, Reference& ref) {
+  // Scans a `$VAR` or `${VAR[:-|-]default}` reference beginning at `head`,
+  // returns the position following the reference or `head` if malformed
+  const char* it = head + 1;
+  if (it >= end) {
+    return head;
+  }
+
+  if (*it != '{') {
+    const char* nameHead = it;
+    while (it < end && ::isLegalEnvChar(*it)) {
+      it++;
+    }
+
+    if (it == nameHead) {
+      return head;
+    }
+
+    ref = { std::string_view(nameHead, it - nameHead), std::string_view(), ExpansionExpr::None };
+    return it;
+  }
+
+  const char* nameHead = ++it;
+  while (it < end && ::isLegalEnvChar(*it)) {
+    it++;
+  }
+
+  if (it == nameHead) {
+    return head;
+  }
+
+  auto expr = ExpansionExpr::None;
+  std::string_view name(nameHead, it - nameHead);
+  if (it + 1 < end && *it == ':' && *(it + 1) == '-') {
+    expr = ExpansionExpr::SubstituteEmpty;
+    it += 2;
+  } else if (it < end && *it == '-') {
+    expr = ExpansionExpr::SubstituteUnset;
+    it++;
+  }
+
+  const char* defaultHead = it;
+  while (it < end && *it != '}') {
+    if (*it == '\n' || *it == delim) {
+      return head;
+    }
+
+    it += (*it == '\\' && it + 1 < end) ? 2 : 1;
+  }
+
+  if (it >= end || (expr == ExpansionExpr::None && it != defaultHead)) {
+    return head;
+  }
+
+  ref = { name, std::string_view(defaultHead, it - defaultHead), expr };
+  return it + 1;
+}
+
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Snapshot                         *
+ *                                                          *
+ ************************************************************/
+
+// Layout: SnapshotHeader | SnapshotEntry[entryCount] | SnapshotDependency[dependencyCount] | Blob
+//  - Entries are sorted by key & searched in place; offset(s) are relative to the blob
+//  - Dependencies hold the hash of each referenced env var's value, not the value itself
+//  - The payload, i.e. everything following the header, is hashed to reject corrupt snapshot(s)
+static constexpr const char SNAPSHOT_MAGIC[8] = { 'S', 'A', 'I', 'L', 'E', 'N', 'V', '\0' };
+static constexpr const uint32_t SNAPSHOT_VERSION = 2;
+
+// Flag(s) that alter the resolved value(s), a snapshot is only valid if these match
+static constexpr const uint8_t SNAPSHOT_FLAG_MASK = wapi::DotEnv::NO_INTERPOLATE | wapi::DotEnv::LAZY_INTERP;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t flags;
+  uint64_t sourceHash;
+  uint64_t sourceSize;
+  uint32_t entryCount;
+  uint32_t dependencyCount;
+  uint64_t blobSize;
+  uint64_t payloadHash;
+};
+
+struct SnapshotEntry {
+  uint32_t keyOffset;
+  uint32_t keyLength;
+  uint32_t valueOffset;
+  uint32_t valueLength;
+};
+
+struct SnapshotDependency {
+  uint32_t nameOffset;
+  uint32_t nameLength;
+  uint32_t isSet;
+  uint32_t reserved;
+  uint64_t valueHash;
+};
+
+uint64_t hashContent(std::string_view content) {
+  // Word-at-a-time hash used to detect change(s) to the source, it's not intended to be collision resistant
+  constexpr uint64_t K0 = 0x9E3779B97F4A7C15;
+  constexpr uint64_t K1 = 0xBF58476D1CE4E5B9;
+
+  uint64_t hash = K0 ^ content.size();
+  for (size_t i = 0; i < content.size(); i += 8) {
+    uint64_t word = 0;
+    std::memcpy(&word, content.data() + i, std::min<size_t>(8, content.size() - i));
+    hash = std::rotl(hash ^ (word * K0), 31) * K1;
+  }
+
+  hash ^= hash >> 29;
+  hash *= K1;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+bool isInBounds(std::string_view blob, uint32_t offset, uint32_t length) {
+  return static_cast<uint64_t>(offset) + length <= blob.size();
+}
+
+SnapshotEntry getSnapshotEntry(std::string_view table, size_t index) {
+  // Copied out since the table isn't necessarily aligned, e.g. if read into a buffer
+  SnapshotEntry entry;
+  std::memcpy(&entry, table.data() + index * sizeof(SnapshotEntry), sizeof(entry));
+  return entry;
+}
+
+// Index of `key` in a snapshot's table, or the entry count if missing; keys are ASCII-only so
+// wide key(s) are compared per code unit, as by `KeyEqual`
+template <typename CharT>
+size_t searchSnapshot(std::string_view table, std::string_view blob, std::basic_string_view<CharT> key) {
+  const auto compare = [&](size_t index) -> int {
+    const SnapshotEntry entry = ::getSnapshotEntry(table, index);
+    const std::string_view other = blob.substr(entry.keyOffset, entry.keyLength);
+
+    const size_t length = std::min(other.size(), key.size());
+    for (size_t i = 0; i < length; ++i) {
+      const auto lhs = static_cast<uint32_t>(static_cast<unsigned char>(other[i]));
+      const auto rhs = static_cast<uint32_t>(static_cast<std::make_unsigned_t<CharT>>(key[i]));
+      if (lhs != rhs) {
+        return lhs < rhs ? -1 : 1;
+      }
+    }
+
+    return other.size() == key.size() ? 0 : (other.size() < key.size() ? -1 : 1);
+  };
+
+  const size_t count = table.size() / sizeof(SnapshotEntry);
+
+  size_t lo = 0, hi = count;
+  while (lo < hi) {
+    const size_t mid = lo + (hi - lo) / 2;
+    const int order = compare(mid);
+    if (order == 0) {
+      return mid;
+    }
+
+    if (order < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return count;
+}
+
+
+
+
+/************************************************************
+ *                                                          *
+ *                         DotEnv                           *
+ *                                                          *
+ ************************************************************/
+
+// Impl. DotEnv reader
+wapi::DotEnv::DotEnv() = default;
+
+wapi::DotEnv::DotEnv(const std::string& fp, uint8_t flags /*= 0*/) {
+  parseFile(std::filesystem::path(common::str2wstr(fp)), flags);
+}
+
+wapi::DotEnv::DotEnv(const std::wstring& fp, uint8_t flags /*= 0*/) {
+  parseFile(std::filesystem::path(fp), flags);
+}
+
+wapi::DotEnv::DotEnv(const std::filesystem::path& fp, uint8_t flags /*= 0*/) {
+  parseFile(fp, flags);
+}
+
+wapi::DotEnv::DotEnv(const std::filesystem::path& fp, const std::filesystem::path& snapshotFp, uint8_t flags /*= 0*/) {
+  if (!readFile(fp, flags) || tryReadSnapshot(snapshotFp)) {
+    return;
+  }
+
+  parseBuffer(*m_storage);
+
+  // Refreshing the snapshot is best effort, e.g. its directory may be read-only
+  std::string errorMessage;
+  TrySaveSnapshot(snapshotFp, errorMessage);
+}
+
+
+/* Static impl. */
+const std::wstring_view wapi::DotEnv::GetEnvExtension() {
+  static const std::wstring_view FILE_EXT(L".env");
+  return FILE_EXT;
+}
+
+bool wapi::DotEnv::IsEnvFile(const std::filesystem::path& fp) {
+  auto filename = fp.filename().wstring();
+
+  const auto ext = wapi::DotEnv::GetEnvExtension();
+  if (filename.length() < ext.length()) {
+    return false;
+  }
+
+  std::transform(filename.begin(), filename.end(), filename.begin(), std::towlower);
+  return (filename.find(ext) != std::wstring::npos);
+}
+
+
+wapi::DotEnv wapi::DotEnv::FromLayers(const std::vector<std::filesystem::path>& fps, uint8_t flags /*= 0*/) {
+  // Layer(s) are parsed without interpolation, their reference(s) are deferred until merged
+  const uint8_t layerFlags = (flags & wapi::DotEnv::NO_INTERPOLATE) ? flags : (flags | wapi::DotEnv::LAZY_INTERP);
+
+  std::vector<wapi::DotEnv> layers(fps.size());
+  std::vector<std::exception_ptr> errors(fps.size());
+
+  std::atomic<size_t> cursor{0};
+  const auto parseLayers = [&]() {
+    for (size_t i = cursor.fetch_add(1); i < fps.size(); i = cursor.fetch_add(1)) {
+      try {
+        layers[i].parseFile(fps[i], layerFlags);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  const size_t workerCount = std::min<size_t>(fps.size(), std::max(1u, std::thread::hardware_concurrency()));
+
+  std::vector<std::thread> workers;
+  for (size_t i = 1; i < workerCount; ++i) {
+    workers.emplace_back(parseLayers);
+  }
+
+  parseLayers();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  wapi::DotEnv result;
+  result.m_flags = flags;
+  result.m_storage = std::make_shared<wapi::DotEnv::Storage>();
+  result.m_storage->isSharedEnvironment = (flags & wapi::DotEnv::SHARED_ENV) != 0;
+
+  if (flags & wapi::DotEnv::DIAGNOSTICS) {
+    result.m_storage->diagnostics = std::make_unique<Diagnostics>();
+    for (size_t i = 0; i < layers.size(); ++i) {
+      if (layers[i].m_storage && layers[i].m_storage->diagnostics) {
+        result.m_storage->diagnostics->Merge(*layers[i].m_storage->diagnostics, static_cast<uint32_t>(i));
+      }
+    }
+  }
+
+  // Adopt the largest layer's entries & merge the rest around it; those preceding it are inserted
+  // from last to first without replacement, those following it override in order
+  size_t base = 0;
+  for (size_t i = 0; i < layers.size(); ++i) {
+    if (layers[i].m_storage) {
+      result.m_storage->layers.push_back(layers[i].m_storage);
+    }
+
+    if (layers[i].m_entries.size() > layers[base].m_entries.size()) {
+      base = i;
+    }
+  }
+
+  if (!layers.empty()) {
+    result.m_entries = std::move(layers[base].m_entries);
+  }
+
+  for (size_t i = base; i-- > 0; ) {
+    for (const auto& [key, entry] : layers[i].m_entries) {
+      result.m_entries.try_emplace(key, entry);
+    }
+  }
+
+  for (size_t i = base + 1; i < layers.size(); ++i) {
+    for (const auto& [key, entry] : layers[i].m_entries) {
+      result.m_entries.insert_or_assign(key, entry);
+    }
+  }
+
+  // Cyclic entries are left to report on read, as with lazy interpolation
+  if (!(flags & wapi::DotEnv::LAZY_INTERP)) {
+    Interpolator interpolator(result.m_entries, *result.m_storage);
+    for (const auto& [key, entry] : result.m_entries) {
+      interpolator.Expand(entry);
+    }
+  }
+
+  return result;
+}
+
+
+std::string_view wapi::DotEnv::GetIssueName(wapi::DotEnv::Issue issue) {
+  switch (issue) {
+    case Issue::MalformedAssignment:
+      return "malformed assignment";
+    case Issue::IllegalKey:
+      return "illegal key";
+    case Issue::UnclosedQuote:
+      return "unclosed quote";
+    case Issue::TrailingContent:
+      return "trailing content";
+    default:
+      return "unknown issue";
+  }
+}
+
+
+/* Public impl. */
+bool wapi::DotEnv::IsEmpty() const {
+  return m_isSnapshot ? m_storage->snapshotTable.empty() : m_entries.empty();
+}
+
+uint8_t wapi::DotEnv::GetFlags() const {
+  return m_flags;
+}
+
+bool wapi::DotEnv::IsFromSnapshot() const {
+  return m_isSnapshot;
+}
+
+auto wapi::DotEnv::GetDiagnostics() const -> std::vector<wapi::DotEnv::Diagnostic> {
+  std::vector<Diagnostic> result;
+  if (!m_storage || !m_storage->diagnostics) {
+    return result;
+  }
+
+  const auto& diagnostics = *m_storage->diagnostics;
+  const size_t capacity = diagnostics.ring.size();
+  const size_t retained = std::min(diagnostics.count, capacity);
+
+  result.reserve(retained);
+  for (size_t i = diagnostics.count - retained; i < diagnostics.count; ++i) {
+    result.push_back(diagnostics.ring[i % capacity]);
+  }
+
+  return result;
+}
+
+size_t wapi::DotEnv::GetDiagnosticCount() const {
+  return (m_storage && m_storage->diagnostics) ? m_storage->diagnostics->count : 0;
+}
+
+
+bool wapi::DotEnv::TrySaveSnapshot(const std::filesystem::path& snapshotFp, std::string& errorMessage) const {
+  if (!m_storage) {
+    errorMessage = "Failed to save snapshot, no source has been loaded";
+    return false;
+  }
+
+  // Snapshot(s) hold resolved value(s), i.e. pending entries are expanded first
+  std::vector<std::pair<std::string_view, std::string_view>> entries;
+  if (m_isSnapshot) {
+    const std::string_view table = m_storage->snapshotTable;
+    for (size_t i = 0; i < table.size() / sizeof(SnapshotEntry); ++i) {
+      const SnapshotEntry entry = ::getSnapshotEntry(table, i);
+      entries.emplace_back(m_storage->snapshotBlob.substr(entry.keyOffset, entry.keyLength), m_storage->snapshotEntries[i].value);
+    }
+  }
+
+  entries.reserve(entries.size() + m_entries.size());
+  for (const auto& [key, entry] : m_entries) {
+    if (!entry.IsReady() && !this->expandEntry(entry)) {
+      errorMessage = common::concatTo<std::string>(
+        "Failed to save snapshot, found cyclic reference: ", this->describeCycle(key)
+      );
+      return false;
+    }
+
+    entries.emplace_back(key, entry.value);
+  }
+
+  std::sort(entries.begin(), entries.end());
+
+  std::vector<std::string_view> references;
+  std::shared_ptr<const wapi::EnvSnapshot> environment;
+  {
+    std::scoped_lock lock(m_storage->lock);
+    references = m_storage->references;
+    environment = m_storage->environment;
+  }
+
+  std::sort(references.begin(), references.end());
+  references.erase(std::unique(references.begin(), references.end()), references.end());
+
+  std::string blob;
+  const auto appendBlob = [&blob](std::string_view value) {
+    const auto offset = static_cast<uint32_t>(blob.size());
+    blob.append(value);
+    return offset;
+  };
+
+  std::vector<SnapshotEntry> entryTable;
+  entryTable.reserve(entries.size());
+  for (const auto& [key, value] : entries) {
+    const uint32_t keyOffset = appendBlob(key);
+    const uint32_t valueOffset = appendBlob(value);
+    entryTable.push_back({ keyOffset, static_cast<uint32_t>(key.size()), valueOffset, static_cast<uint32_t>(value.size()) });
+  }
+
+  std::vector<SnapshotDependency> dependencyTable;
+  dependencyTable.reserve(references.size());
+  for (const auto name : references) {
+    std::string_view value;
+    const bool isSet = environment && environment->TryGet(name, value);
+    const uint32_t nameOffset = appendBlob(name);
+    dependencyTable.push_back({ nameOffset, static_cast<uint32_t>(name.size()), isSet, 0, isSet ? ::hashContent(value) : 0 });
+  }
+
+  if (blob.size() > std::numeric_limits<uint32_t>::max()) {
+    errorMessage = "Failed to save snapshot, content exceeds the maximum size";
+    return false;
+  }
+
+  const std::string_view source = m_storage->View();
+
+  SnapshotHeader header{};
+  std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.flags = m_flags & SNAPSHOT_FLAG_MASK;
+  header.sourceHash = ::hashContent(source);
+  header.sourceSize = source.size();
+  header.entryCount = static_cast<uint32_t>(entryTable.size());
+  header.dependencyCount = static_cast<uint32_t>(dependencyTable.size());
+  header.blobSize = blob.size();
+
+  std::string payload;
+  payload.reserve(entryTable.size() * sizeof(SnapshotEntry) + dependencyTable.size() * sizeof(SnapshotDependency) + blob.size());
+  payload.append(reinterpret_cast<const char*>(entryTable.data()), entryTable.size() * sizeof(SnapshotEntry));
+  payload.append(reinterpret_cast<const char*>(dependencyTable.data()), dependencyTable.size() * sizeof(SnapshotDependency));
+  payload.append(blob);
+  header.payloadHash = ::hashContent(payload);
+
+  // Written alongside & then renamed over the target so that reader(s) never observe a partial snapshot
+  std::filesystem::path tmpFp = snapshotFp;
+  tmpFp += common::concatTo<std::string>(".", std::random_device{}(), ".tmp");
+  std::error_code err;
+  {
+    std::ofstream fs(tmpFp, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fs.is_open()) {
+      errorMessage = common::concatTo<std::string>("Failed to open ", tmpFp.string(), " for writing");
+      return false;
+    }
+
+    fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    fs.write(payload.data(), payload.size());
+    if (!fs.good()) {
+      errorMessage = common::concatTo<std::string>("Failed to write snapshot to ", tmpFp.string());
+      fs.close();
+      std::filesystem::remove(tmpFp, err);
+      return false;
+    }
+  }
+
+  std::filesystem::rename(tmpFp, snapshotFp, err);
+  if (err) {
+    errorMessage = common::concatTo<std::string>("Failed to replace snapshot ", snapshotFp.string(), " with err: ", err.message());
+    std::filesystem::remove(tmpFp, err);
+    return false;
+  }
+
+  return true;
+}
+
+
+/* Private impl. */
+bool wapi::DotEnv::readFile(const std::filesystem::path& fp, uint8_t flags) {
+  m_flags = flags;
+
+  if (!(flags & wapi::DotEnv::NO_CHECK_EXT) && !wapi::DotEnv::IsEnvFile(fp)) {
+    throw std::invalid_argument(common::concatTo<std::string>("Expected .env file type but got ", fp.extension()));
+  }
+
+  auto storage = std::make_shared<wapi::DotEnv::Storage>();
+  storage->isSharedEnvironment = (flags & wapi::DotEnv::SHARED_ENV) != 0;
+  if (flags & wapi::DotEnv::DIAGNOSTICS) {
+    storage->diagnostics = std::make_unique<Diagnostics>();
+  }
+
+  if (flags & wapi::DotEnv::MEMORY_MAP) {
+    // Fallback to reading the file if it can't be mapped
+    std::string errorMessage;
+    storage->mapping.TryOpen(fp, errorMessage);
+  }
+
+  if (!storage->mapping.IsOpen()) {
+    std::ifstream fs(fp, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!fs.is_open()) {
+      return false;
+    }
+
+    // Read as raw UTF-8 bytes in a single request
+    auto& buffer = storage->buffer;
+    buffer.resize(static_cast<size_t>(fs.tellg()));
+    fs.seekg(0);
+    fs.read(buffer.data(), buffer.size());
+    buffer.resize(static_cast<size_t>(fs.gcount()));
+  }
+
+  m_storage = std::move(storage);
+  return true;
+}
+
+void wapi::DotEnv::parseFile(const std::filesystem::path& fp, uint8_t flags /*= 0*/) {
+  if (readFile(fp, flags)) {
+    parseBuffer(*m_storage);
+  }
+}
+
+void wapi::DotEnv::parseBuffer(wapi::DotEnv::Storage& storage) {
+  enum class State : uint8_t {
+    LineStart,  // Skipping leading whitespace, `;` and empty line(s)
+    Key,        // Reading key up until the `=` assignment token
+    ValueStart, // Skipping whitespace following the assignment token
+    Unquoted,   // Reading an unquoted value until EOL or `#`
+    Quoted,     // Reading a (possibly multi-line) quoted value until its closing quote
+    Discard     // Skipping to EOL, i.e. comments, malformed line(s) & trailing content
+  };
+
+  using StructuralIndex = wapi::internal::StructuralIndex;
+  using Placeholder = Interpolator::Placeholder;
+
+  const bool interpolate = !(m_flags & wapi::DotEnv::NO_INTERPOLATE);
+  const std::string_view buffer = storage.View();
+
+  const char* const base = buffer.data();
+  const char* const end = base + buffer.size();
+  const char* it = base;
+
+  // Skip UTF-8 BOM if present
+  if (buffer.starts_with(constants::UTF8_BYTE_ORDER_MARK)) {
+    it += constants::UTF8_BYTE_ORDER_MARK.size();
+  }
+
+  // Runs of ordinary bytes are skipped using the structural bitmaps
+  StructuralIndex index(buffer);
+  const auto seek = [&](uint8_t classes) -> const char* {
+    return base + index.Next(static_cast<size_t>(it - base), classes);
+  };
+
+  const uint8_t interpClasses = interpolate ? StructuralIndex::DOLLAR : 0;
+  const uint8_t unquotedClasses = StructuralIndex::NEWLINE | StructuralIndex::COMMENT | StructuralIndex::ESCAPE | interpClasses;
+  const uint8_t literalClasses = StructuralIndex::QUOTE | StructuralIndex::ESCAPE | StructuralIndex::CARRIAGE_RETURN;
+  const uint8_t quotedClasses = literalClasses | interpClasses;
+
+  State state = State::LineStart;
+  const char* head = it;
+  char quote = 0;
+
+  // Issue(s) are only located when reported, i.e. the line(s) preceding it are counted on demand
+  const bool isStrict = (m_flags & wapi::DotEnv::STRICT) != 0;
+  const bool isTracing = isStrict || storage.diagnostics;
+
+  uint32_t lineNumber = 1;
+  const char* lineHead = base;
+  const char* counted = base;
+
+  const auto report = [&](Issue issue, const char* at) {
+    for (; counted < at; ++counted) {
+      if (*counted == '\n') {
+        lineNumber++;
+        lineHead = counted + 1;
+      }
+    }
+
+    const Diagnostic diagnostic{ lineNumber, static_cast<uint32_t>(at - lineHead) + 1, issue };
+    if (isStrict) {
+      throw std::runtime_error(common::concatTo<std::string>(
+        "Failed to parse .env, found ", wapi::DotEnv::GetIssueName(issue),
+        " at line ", diagnostic.line, ", column ", diagnostic.column
+      ));
+    }
+
+    storage.diagnostics->Push(diagnostic);
+  };
+
+  Reference ref;
+  std::string_view key;
+
+  // Value(s) are viewed from the source unless they require processing,
+  // in which case their literal text is written to `value` & reference(s)
+  // are deferred to the interpolator, which writes the result into the arena
+  std::string value;
+  bool isProcessed = false;
+
+  // Reference(s) are resolved against preceding entries, or deferred until read if lazily interpolated
+  const bool isLazy = (m_flags & wapi::DotEnv::LAZY_INTERP) != 0;
+  Interpolator interpolator(m_entries, storage);
+  std::vector<Placeholder> placeholders;
+
+  // Unquoted value(s) are right-trimmed, excluding interpolated content
+  size_t floor = 0;
+
+  const auto process = [&]() {
+    if (!isProcessed) {
+      value.assign(head, it);
+      isProcessed = true;
+    }
+  };
+
+  const auto commit = [&](std::string_view source) {
+    if (!isProcessed) {
+      m_entries.insert_or_assign(key, source);
+    } else if (placeholders.empty()) {
+      m_entries.insert_or_assign(key, storage.Store(value));
+    } else if (isLazy) {
+      auto data = static_cast<Placeholder*>(storage.arena.allocate(sizeof(Placeholder) * placeholders.size(), alignof(Placeholder)));
+      std::uninitialized_copy(placeholders.begin(), placeholders.end(), data);
+
+      const auto* tmpl = storage.Emplace(Template{ storage.Store(value), std::span<const Placeholder>(data, placeholders.size()) });
+      m_entries.insert_or_assign(key, Entry(std::string_view(), tmpl));
+    } else {
+      m_entries.insert_or_assign(key, interpolator.Render(value, placeholders));
+    }
+
+    placeholders.clear();
+  };
+
+  const auto commitUnquoted = [&]() {
+    if (isProcessed) {
+      while (value.length() > floor && ::isBlankChar(value.back())) {
+        value.pop_back();
+      }
+    }
+
+    commit(::trimRight(head, it));
+  };
+
+  while (it < end) {
+    switch (state) {
+      case State::LineStart: {
+        const char ch = *it;
+        if (ch == '#') {
+          state = State::Discard;
+        } else if (ch != '\n' && ch != ';' && !::isBlankChar(ch)) {
+          head = it;
+          state = State::Key;
+          continue;
+        }
+
+        it++;
+      } break;
+
+      case State::Key: {
+        it = seek(StructuralIndex::NEWLINE | StructuralIndex::ASSIGN);
+        if (it >= end) {
+          break;
+        }
+
+        if (*it == '\n') {
+          if (isTracing) {
+            report(Issue::MalformedAssignment, head);
+          }
+
+          state = State::LineStart;
+        } else {
+          key = ::trimRight(head, it);
+          state = ::isLegalEnvKeyword(key) ? State::ValueStart : State::Discard;
+
+          if (isTracing && state == State::Discard) {
+            report(Issue::IllegalKey, head);
+          }
+        }
+
+        it++;
+      } break;
+
+      case State::ValueStart: {
+        const char ch = *it;
+        if (::isBlankChar(ch)) {
+          it++;
+          break;
+        }
+
+        isProcessed = false;
+        floor = 0;
+
+        if (::isQuoteChar(ch)) {
+          // Parse as quoted, possibly multi-line, key-value
+          //  e.g. KEY='...Value...`, KEY="...Value... \n ... \n ..." etc
+          quote = ch;
+          state = State::Quoted;
+          head = ++it;
+        } else {
+          // Parse as unquoted single-line key-value
+          //  e.g. KEY=...Value...
+          state = State::Unquoted;
+          head = it;
+        }
+      } break;
+
+      case State::Unquoted: {
+        const char* next = seek(unquotedClasses);
+        if (isProcessed) {
+          value.append(it, next);
+        }
+
+        it = next;
+        if (it >= end) {
+          break;
+        }
+
+        const char ch = *it;
+        if (ch == '\n' || ch == '#') {
+          commitUnquoted();
+          state = (ch == '#') ? State::Discard : State::LineStart;
+          it++;
+          break;
+        }
+
+        // Escape sequences aren't processed here but still guard interpolation
+        next = it + 1;
+        if (ch == '\\') {
+          const size_t length = (next < end && *next != '\n' && *next != '#') ? 2 : 1;
+          if (isProcessed) {
+            value.append(it, length);
+          }
+
+          it += length;
+          break;
+        }
+
+        next = ::scanReference(it, end, '#', ref);
+        if (next != it) {
+          process();
+          placeholders.push_back({ value.size(), ref });
+
+          it = next;
+          floor = value.size();
+          break;
+        }
+
+        if (isProcessed) {
+          value.push_back(ch);
+        }
+        it++;
+      } break;
+
+      case State::Quoted: {
+        // Literal (single-quoted) value(s) are left unprocessed
+        const bool isLiteral = quote == '\'';
+
+        const char* next = seek(isLiteral ? literalClasses : quotedClasses);
+        if (isProcessed) {
+          value.append(it, next);
+        }
+
+        it = next;
+        if (it >= end) {
+          break;
+        }
+
+        const char ch = *it;
+        if (ch == quote) {
+          commit(std::string_view(head, it - head));
+          state = State::Discard;
+          it++;
+
+          if (isTracing) {
+            const char* tail = it;
+            while (tail < end && ::isBlankChar(*tail)) {
+              tail++;
+            }
+
+            if (tail < end && *tail != '\n' && *tail != '#') {
+              report(Issue::TrailingContent, tail);
+            }
+          }
+
+          break;
+        }
+
+        next = it + 1;
+        if (ch == '\r' && next < end && *next == '\n') {
+          process();
+          it++;
+          break;
+        }
+
+        if (ch == '\\' && next < end) {
+          if (!isLiteral) {
+            process();
+            ::appendUnescaped(value, *next);
+          } else if (isProcessed) {
+            value.append(it, 2);
+          }
+
+          it += 2;
+          break;
+        }
+
+        if (ch == '$') {
+          next = ::scanReference(it, end, quote, ref);
+          if (next != it) {
+            process();
+            placeholders.push_back({ value.size(), ref });
+            it = next;
+            break;
+          }
+        }
+
+        if (isProcessed) {
+          value.push_back(ch);
+        }
+        it++;
+      } break;
+
+      case State::Discard: {
+        it = seek(StructuralIndex::NEWLINE);
+        if (it < end) {
+          state = State::LineStart;
+          it++;
+        }
+      } break;
+    }
+  }
+
+  // Flush trailing assignment at EOF
+  switch (state) {
+    case State::Key: {
+      if (isTracing) {
+        report(Issue::MalformedAssignment, head);
+      }
+    } break;
+
+    case State::ValueStart: {
+      m_entries.insert_or_assign(key, std::string_view());
+    } break;
+
+    case State::Unquoted: {
+      commitUnquoted();
+    } break;
+
+    case State::Quoted: {
+      if (isTracing) {
+        report(Issue::UnclosedQuote, head - 1);
+      }
+
+      std::string_view source(head, end - head);
+      if (buffer.back() == '\n') {
+        source.remove_suffix(source.empty() ? 0 : 1);
+        if (!value.empty() && value.back() == '\n') {
+          value.pop_back();
+        }
+      }
+      commit(source);
+    } break;
+
+    default:
+      break;
+  }
+}
+
+bool wapi::DotEnv::expandEntry(const wapi::DotEnv::Entry& entry) const {
+  std::scoped_lock lock(m_storage->lock);
+
+  Interpolator interpolator(m_entries, *m_storage);
+  return interpolator.Expand(entry);
+}
+
+auto wapi::DotEnv::describeCycle(std::string_view key) const -> std::string {
+  // Follows unresolved reference(s) from `key` until one of them revisits the path
+  std::scoped_lock lock(m_storage->lock);
+
+  Interpolator interpolator(m_entries, *m_storage);
+  std::vector<std::string_view> path{ key };
+  std::unordered_set<std::string_view> visited{ key };
+
+  while (true) {
+    const auto entry = m_entries.find(path.back());
+    if (entry == m_entries.end() || entry->second.GetStatus() != Entry::CYCLIC) {
+      return std::string();
+    }
+
+    std::string_view next;
+    for (const auto& placeholder : entry->second.source->placeholders) {
+      const Entry* dependency = interpolator.FindDependency(placeholder.ref);
+      if (dependency && dependency->GetStatus() == Entry::CYCLIC) {
+        next = placeholder.ref.name;
+        break;
+      }
+    }
+
+    if (next.empty()) {
+      break;
+    }
+
+    path.push_back(next);
+    if (!visited.insert(next).second) {
+      break;
+    }
+  }
+
+  std::string result;
+  for (size_t i = 0; i < path.size(); ++i) {
+    result.append(i > 0 ? " -> " : "").append(path[i]);
+  }
+
+  return result;
+}
+
+auto wapi::DotEnv::reconcile(const wapi::DotEnv& previous) const -> std::vector<std::string> {
+  // Compares entries against a prior load of the same file, adopting the memoised coercion(s) of
+  // any that are unchanged; lazily interpolated entries are compared by their raw template(s)
+  std::vector<std::string> changed;
+  if (m_storage && previous.m_storage && m_storage->View() == previous.m_storage->View()) {
+    return changed;
+  }
+
+  const auto isSameSource = [](const Entry& lhs, const Entry& rhs) {
+    if (!lhs.source || !rhs.source) {
+      return !lhs.source && !rhs.source && lhs.value == rhs.value;
+    }
+
+    return lhs.source->literal == rhs.source->literal
+      && std::equal(
+        lhs.source->placeholders.begin(), lhs.source->placeholders.end(),
+        rhs.source->placeholders.begin(), rhs.source->placeholders.end(),
+        [](const auto& a, const auto& b) {
+          return a.offset == b.offset
+              && a.ref.expr == b.ref.expr
+              && a.ref.name == b.ref.name
+              && a.ref.defaultValue == b.ref.defaultValue;
+        }
+      );
+  };
+
+  for (const auto& [key, entry] : m_entries) {
+    const auto other = previous.m_entries.find(key);
+    if (other == previous.m_entries.end() || !isSameSource(entry, other->second)) {
+      changed.emplace_back(key);
+    } else if (!entry.source) {
+      entry.Inherit(other->second);
+    }
+  }
+
+  for (const auto& [key, entry] : previous.m_entries) {
+    if (!m_entries.contains(key)) {
+      changed.emplace_back(key);
+    }
+  }
+
+  std::sort(changed.begin(), changed.end());
+  return changed;
+}
+
+bool wapi::DotEnv::tryReadSnapshot(const std::filesystem::path& snapshotFp) {
+  wapi::DotEnv::Storage& storage = *m_storage;
+
+  std::string errorMessage;
+  if (!storage.snapshot.TryOpen(snapshotFp, errorMessage)) {
+    return false;
+  }
+
+  const auto discard = [&]() {
+    storage.references.clear();
+    storage.snapshot.Close();
+    return false;
+  };
+
+  const std::string_view data = storage.snapshot.View();
+  if (data.size() < sizeof(SnapshotHeader)) {
+    return discard();
+  }
+
+  SnapshotHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+
+  const std::string_view source = storage.View();
+  const bool isCurrent = std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0
+    && header.version == SNAPSHOT_VERSION
+    && header.flags == (m_flags & SNAPSHOT_FLAG_MASK)
+    && header.sourceSize == source.size()
+    && header.sourceHash == ::hashContent(source);
+
+  if (!isCurrent) {
+    return discard();
+  }
+
+  const uint64_t entriesOffset = sizeof(SnapshotHeader);
+  const uint64_t dependenciesOffset = entriesOffset + static_cast<uint64_t>(header.entryCount) * sizeof(SnapshotEntry);
+  const uint64_t blobOffset = dependenciesOffset + static_cast<uint64_t>(header.dependencyCount) * sizeof(SnapshotDependency);
+  if (blobOffset > data.size() || data.size() - blobOffset != header.blobSize) {
+    return discard();
+  }
+
+  if (header.payloadHash != ::hashContent(data.substr(entriesOffset))) {
+    return discard();
+  }
+
+  const std::string_view blob = data.substr(blobOffset);
+
+  // Invalidated if any referenced env var has since been set, unset or changed; retained as the
+  // entries' reference(s) so that the snapshot may be saved again
+  for (uint32_t i = 0; i < header.dependencyCount; ++i) {
+    SnapshotDependency dependency;
+    std::memcpy(&dependency, data.data() + dependenciesOffset + i * sizeof(SnapshotDependency), sizeof(dependency));
+    if (!::isInBounds(blob, dependency.nameOffset, dependency.nameLength)) {
+      return discard();
+    }
+
+    const std::string_view name = blob.substr(dependency.nameOffset, dependency.nameLength);
+
+    std::string_view value;
+    const bool isSet = storage.Environment().TryGet(name, value);
+    if (isSet != (dependency.isSet != 0) || (isSet && ::hashContent(value) != dependency.valueHash)) {
+      return discard();
+    }
+
+    storage.references.push_back(name);
+  }
+
+  // Key(s) are searched in place, see `findSnapshotEntry`; only the entries' value(s) are bound, into
+  // a flat array alongside their memoised coercion(s)
+  const std::string_view table = data.substr(entriesOffset, dependenciesOffset - entriesOffset);
+  auto entries = std::make_unique<Entry[]>(header.entryCount);
+  for (uint32_t i = 0; i < header.entryCount; ++i) {
+    const SnapshotEntry entry = ::getSnapshotEntry(table, i);
+    if (!::isInBounds(blob, entry.keyOffset, entry.keyLength) || !::isInBounds(blob, entry.valueOffset, entry.valueLength)) {
+      return discard();
+    }
+
+    entries[i].value = blob.substr(entry.valueOffset, entry.valueLength);
+  }
+
+  storage.snapshotTable = table;
+  storage.snapshotBlob = blob;
+  storage.snapshotEntries = std::move(entries);
+  m_isSnapshot = true;
+
+  return true;
+}
+
+auto wapi::DotEnv::findSnapshotEntry(std::string_view key) const -> const wapi::DotEnv::Entry* {
+  const size_t index = ::searchSnapshot(m_storage->snapshotTable, m_storage->snapshotBlob, key);
+  return index < m_storage->snapshotTable.size() / sizeof(SnapshotEntry) ? &m_storage->snapshotEntries[index] : nullptr;
+}
+
+auto wapi::DotEnv::findSnapshotEntry(std::wstring_view key) const -> const wapi::DotEnv::Entry* {
+  const size_t index = ::searchSnapshot(m_storage->snapshotTable, m_storage->snapshotBlob, key);
+  return index < m_storage->snapshotTable.size() / sizeof(SnapshotEntry) ? &m_storage->snapshotEntries[index] : nullptr;
+}
@@ -0,0 +1,460 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <locale>
+#include <codecvt>
+#include <cwctype>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+
+#include "sailc/wapi/wapi.hpp"
+#include "sailc/common/strutil.hpp"
+#include "sailc/common/constants.hpp"
+
+namespace wapi = saildb::wapi;
+namespace common = saildb::common;
+
+
+
+/************************************************************
+ *                                                          *
+ *                     Legacy DotEnv parser                 *
+ *                                                          *
+ ************************************************************/
+
+// The `std::wifstream` pipeline replaced by the single-pass parser, retained only as a
+// baseline for comparison; behaviour & defect(s) are kept as they were
+namespace legacy {
+
+using EntryMap = std::unordered_map<std::wstring, std::wstring>;
+
+struct InterpToken {
+  std::wstring name;
+  std::wstring defaultValue;
+  size_t start{0};
+  size_t end{0};
+  wapi::DotEnv::ExpansionExpr expr{wapi::DotEnv::ExpansionExpr::None};
+};
+
+bool isLegalEnvChar(wchar_t ch) {
+  return std::iswalnum(ch) || ch == L'_';
+}
+
+bool isLegalEnvKeyword(const std::wstring& key) {
+  if (key.empty() || !std::iswalpha(key.front())) {
+    return false;
+  }
+
+  return std::all_of(key.begin(), key.end(), legacy::isLegalEnvChar);
+}
+
+std::wstring::size_type getClosingQuote(const std::wstring& str, const wchar_t& tag, size_t i = 0) {
+  size_t length = str.length();
+  if (str.empty() || i >= length) {
+    return std::wstring::npos;
+  }
+
+  bool escaped = false;
+  while (i < length) {
+    const wchar_t ch = str.at(i);
+
+    bool isEscSeq = (!escaped && ch == L'\\');
+    if (isEscSeq) {
+      escaped = !escaped;
+    }
+
+    if (!escaped && ch == tag) {
+      return i;
+    }
+
+    escaped = (escaped && !isEscSeq) ? !escaped : escaped;
+    i++;
+  }
+
+  return std::wstring::npos;
+}
+
+size_t unescapeSequence(std::wstring& str, size_t& index) {
+  switch (str.at(index)) {
+    case L'n':
+      str.replace(index - 1, 2, L"\n");
+      break;
+    case L'r':
+      str.replace(index - 1, 2, L"\r");
+      break;
+    case L't':
+      str.replace(index - 1, 2, L"\t");
+      break;
+    case L'b':
+    case L'v':
+    case L'f':
+      str.erase(index - 1, 2);
+      index--;
+      break;
+    default:
+      str.erase(index - 1, 1);
+      break;
+  }
+
+  return str.length();
+}
+
+void unescapeContent(std::wstring& str) {
+  size_t length = str.length();
+  if (length < 2) {
+    return;
+  }
+
+  size_t i = 0;
+  while (i < length) {
+    if (str.at(i) == L'\\') {
+      length = legacy::unescapeSequence(str, ++i);
+      continue;
+    }
+
+    i++;
+  }
+}
+
+bool tryCreateToken(std::wstring& name, size_t& start, size_t& end, InterpToken& token) {
+  auto expr = wapi::DotEnv::ExpansionExpr::None;
+  auto defaultValue = std::wstring();
+
+  auto delim = name.find(L'-');
+  if (delim != std::wstring::npos) {
+    defaultValue = name.substr(delim + 1);
+
+    if (delim > 0 && name.at(delim - 1) == L':') {
+      expr = wapi::DotEnv::ExpansionExpr::SubstituteEmpty;
+      name.erase(delim - 1, name.length());
+    } else {
+      expr = wapi::DotEnv::ExpansionExpr::SubstituteUnset;
+      name.erase(delim, name.length());
+    }
+  }
+
+  name.erase(
+    std::remove_if(name.begin(), name.end(), [](auto ch) { return !legacy::isLegalEnvChar(ch); }),
+    name.end()
+  );
+
+  if (name.length() < 1) {
+    return false;
+  }
+
+  token = { name, defaultValue, start, end, expr };
+  return true;
+}
+
+bool processContent(std::wstring& str, size_t& index, size_t& length, const bool& isQuoted, InterpToken& token) {
+  if (length < 2 || index >= length - 1) {
+    return false;
+  }
+
+  size_t startIndex = 0,
+         endIndex = 0;
+
+  bool inToken = false,
+       escaped = false,
+       requireClosure = false,
+       hasInterpToken = false;
+
+  std::wstring content;
+  while (!hasInterpToken && index < length) {
+    auto chead = str.at(index);
+    bool isEscSeq = (!escaped && chead == L'\\');
+    if (isEscSeq) {
+      escaped = !escaped;
+    }
+
+    if (!inToken) {
+      if (length - index >= 2 && !escaped && chead == L'$') {
+        auto pos = index + 1;
+        if (str.at(pos) != L'{') {
+          startIndex = index;
+          index = pos;
+          inToken = true;
+        } else if (length - pos > 2) {
+          requireClosure = true;
+          startIndex = index;
+          index = ++pos;
+          inToken = true;
+        }
+      } else if (isQuoted && escaped && !isEscSeq) {
+        length = legacy::unescapeSequence(str, index);
+      } else {
+        index++;
+      }
+    } else if (requireClosure && !escaped && chead == L'}') {
+      hasInterpToken = true;
+      endIndex = ++index;
+      break;
+    } else {
+      const bool isLastChar = index >= length - 1;
+      if (isLastChar) {
+        content += chead;
+        index++;
+      }
+
+      hasInterpToken = (isLastChar || std::iswspace(chead));
+      if (hasInterpToken) {
+        endIndex = index;
+        break;
+      }
+
+      content += chead;
+      index++;
+    }
+
+    if (escaped && !isEscSeq) {
+      escaped = !escaped;
+    }
+  }
+
+  hasInterpToken = (hasInterpToken && content.length() > 0);
+  if (hasInterpToken) {
+    return legacy::tryCreateToken(content, startIndex, endIndex, token);
+  }
+
+  return false;
+}
+
+void expandContent(EntryMap& entries, std::wstring& content, const bool& isValueQuoted) {
+  size_t length = content.length();
+  if (length < 2) {
+    return;
+  }
+
+  size_t index = 0;
+  while (index < length) {
+    InterpToken token;
+    if (!legacy::processContent(content, index, length, isValueQuoted, token)) {
+      continue;
+    }
+
+    auto value = std::wstring();
+    bool isSetValue = wapi::tryGetEnvVar(token.name, value);
+    bool isEmptyValue = (!isSetValue || value.empty());
+    if (!isSetValue && entries.contains(token.name)) {
+      value = entries.at(token.name);
+      isSetValue = true;
+      isEmptyValue = value.empty();
+    }
+
+    if (isEmptyValue && !token.defaultValue.empty()) {
+      if (token.expr == wapi::DotEnv::ExpansionExpr::SubstituteEmpty) {
+        value = token.defaultValue;
+      } else if (token.expr == wapi::DotEnv::ExpansionExpr::SubstituteUnset && !isSetValue) {
+        value = token.defaultValue;
+      }
+    }
+
+    content.replace(token.start, token.end - token.start, value);
+    length = content.length();
+  }
+}
+
+EntryMap parseFile(const std::filesystem::path& fp) {
+  static constexpr const std::wstring_view whitespace(L" \t\n\v\r\f;");
+
+  EntryMap entries;
+  std::wifstream ws(fp);
+  if (!ws.is_open()) {
+    return entries;
+  }
+
+  // Decoded as UTF-8, otherwise the "C" locale fails on the fixture's first non-ASCII byte
+  ws.imbue(std::locale(std::locale::classic(), new std::codecvt_utf8<wchar_t>));
+
+  if (ws.peek() == saildb::constants::UNICODE_BYTE_ORDER_MARK) {
+    ws.get();
+  }
+
+  std::wstring line;
+  while (std::getline(ws, line)) {
+    const auto nwsPos = line.find_first_not_of(whitespace);
+    if (nwsPos == std::wstring::npos || line.at(nwsPos) == L'#') {
+      continue;
+    }
+    line.erase(0, nwsPos);
+
+    const auto eqTkPos = line.find(L'=');
+    if (eqTkPos == std::wstring::npos) {
+      continue;
+    }
+
+    auto key = line.substr(0, eqTkPos);
+    common::trimRight(key);
+
+    if (!legacy::isLegalEnvKeyword(key)) {
+      continue;
+    }
+
+    auto val = line.substr(eqTkPos + 1);
+    common::trimLeft(val);
+
+    if (val.length() < 1) {
+      entries.insert_or_assign(key, val);
+      continue;
+    }
+
+    const auto qchar = val.front();
+    bool isSingleQuote = qchar == L'\'';
+    bool isValueQuoted = (isSingleQuote || qchar == L'\"' || qchar == L'`');
+    if (isValueQuoted) {
+      auto vTailPos = legacy::getClosingQuote(val, qchar, 1);
+      if (vTailPos == std::wstring::npos) {
+        std::wstring head;
+        val = val.substr(1);
+
+        while (std::getline(ws, head)) {
+          vTailPos = legacy::getClosingQuote(head, qchar);
+          if (vTailPos != std::wstring::npos) {
+            val += head.length() > 1 ? (L'\n' + head.substr(0, vTailPos)) : L"\n";
+            break;
+          }
+
+          val += L'\n' + head;
+        }
+      } else {
+        val.erase(0, 1);
+        val.erase(vTailPos - 1, val.length());
+      }
+    } else {
+      const auto vTailPos = val.find(L'#');
+      if (vTailPos != std::wstring::npos) {
+        val.erase(vTailPos - 1, val.length());
+      }
+      common::trimRight(val);
+    }
+
+    if (!isValueQuoted || !isSingleQuote) {
+      legacy::expandContent(entries, val, isValueQuoted);
+    } else if (isValueQuoted && !isSingleQuote) {
+      legacy::unescapeContent(val);
+    }
+    entries.insert_or_assign(key, val);
+  }
+
+  return entries;
+}
+
+} // namespace legacy
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Benchmarks                        *
+ *                                                          *
+ ************************************************************/
+
+// Fixture concatenated `copies` time(s); keys repeat, as the legacy parser doesn't terminate
+// on some uniquely keyed copies of the fixture's interpolated value(s)
+const std::filesystem::path& getScaledFixture(int64_t copies) {
+  static std::unordered_map<int64_t, std::filesystem::path> paths;
+
+  auto [it, inserted] = paths.try_emplace(copies);
+  if (inserted) {
+    std::ifstream input("resources/.saildb.env", std::ios::binary);
+    std::ostringstream source;
+    source << input.rdbuf();
+
+    it->second = std::filesystem::temp_directory_path() / ("saildb_bench_" + std::to_string(copies) + ".env");
+
+    std::ofstream output(it->second, std::ios::binary | std::ios::trunc);
+    for (int64_t i = 0; i < copies; ++i) {
+      output << source.str() << '\n';
+    }
+  }
+
+  return it->second;
+}
+
+void BM_LegacyParse(benchmark::State& state) {
+  const std::filesystem::path& fp = ::getScaledFixture(state.range(0));
+  for (auto _ : state) {
+    auto entries = legacy::parseFile(fp);
+    benchmark::DoNotOptimize(entries);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(fp)));
+}
+
+void BM_DotEnvParse(benchmark::State& state) {
+  const std::filesystem::path& fp = ::getScaledFixture(state.range(0));
+  for (auto _ : state) {
+    wapi::DotEnv env(fp);
+    benchmark::DoNotOptimize(env);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(fp)));
+}
+
+void BM_DotEnvParseMapped(benchmark::State& state) {
+  const std::filesystem::path& fp = ::getScaledFixture(state.range(0));
+  for (auto _ : state) {
+    wapi::DotEnv env(fp, wapi::DotEnv::MEMORY_MAP);
+    benchmark::DoNotOptimize(env);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(std::filesystem::file_size(fp)));
+}
+
+// `count` uniquely keyed entries, each referencing the previous one
+const std::filesystem::path& getKeyedFixture(int64_t count) {
+  static std::unordered_map<int64_t, std::filesystem::path> paths;
+
+  auto [it, inserted] = paths.try_emplace(count);
+  if (inserted) {
+    it->second = std::filesystem::temp_directory_path() / ("saildb_bench_keyed_" + std::to_string(count) + ".env");
+
+    std::ofstream output(it->second, std::ios::binary | std::ios::trunc);
+    for (int64_t i = 0; i < count; ++i) {
+      output << "SAILDB_KEY_" << i << "=\"value " << i << (i > 0 ? " ${SAILDB_KEY_0}" : "") << "\"\n";
+    }
+  }
+
+  return it->second;
+}
+
+void BM_DotEnvParseKeyed(benchmark::State& state) {
+  const std::filesystem::path& fp = ::getKeyedFixture(state.range(0));
+  for (auto _ : state) {
+    wapi::DotEnv env(fp);
+    benchmark::DoNotOptimize(env);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Load of a valid snapshot of the same file, incl. a lookup
+void BM_DotEnvSnapshotLoad(benchmark::State& state) {
+  const std::filesystem::path& fp = ::getKeyedFixture(state.range(0));
+
+  std::filesystem::path snapshotFp = fp;
+  snapshotFp += ".bin";
+  wapi::DotEnv(fp, snapshotFp);
+
+  for (auto _ : state) {
+    wapi::DotEnv env(fp, snapshotFp);
+    if (!env.IsFromSnapshot()) {
+      state.SkipWithError("Snapshot wasn't loaded");
+      break;
+    }
+
+    benchmark::DoNotOptimize(env.Contains("SAILDB_KEY_1"));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_LegacyParse)->Arg(1)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DotEnvParse)->Arg(1)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DotEnvParseMapped)->Arg(1)->Arg(2000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DotEnvParseKeyed)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DotEnvSnapshotLoad)->Arg(1000)->Arg(100000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,452 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+#include <type_traits>
+#include <filesystem>
+
+#include "sailc/wapi/wapi.hpp"
+
+namespace wapi = saildb::wapi;
+
+namespace {
+
+constexpr const char* FIXTURE_PATH = "resources/.saildb.env";
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Fixture                          *
+ *                                                          *
+ ************************************************************/
+
+// Pins the behaviour of `resources/.saildb.env`; `valueWithComment` intentionally differs from
+// the legacy parser, which dropped the character preceding an undelimited `#`
+TEST(DotEnvFixtureTest, ParsesEveryEntry) {
+  const std::pair<const char*, const char*> expected[] = {
+    { "test", "hi" },
+    { "value", "hello, world!" },
+    { "otherValue", "1,2, 3" },
+    { "someIntValue", "1" },
+    { "someDoubleValue", "    1.0125 " },
+    { "someLiteralValue", R"(some \'literal\' value)" },
+    { "someUnquotedValue", R"({"test": "value"})" },
+    { "someEscapedQuotedValue", R"({"test": "value"})" },
+    { "someGraveValueWithQuotes", R"({"test": "value"})" },
+    { "multilineValue", "<multiline>\nhello, world!\nwith some {\"json\": \"values\"}\n" },
+    { "specialCharacters", R"(?, - = ! [] / {} \" $)" },
+    { "valueWithComment", "this has [] {} $ chars" },
+    { "stringWithComment", "# not a comment" },
+    { "valueWithMultiComment", "this has [] {} $ chars" },
+    { "valueWithEscapeSeq", R"(no \t unescaping \n here)" },
+    { "stringWithEscapeSeq", "we are... \nmultiline with \ttabs!" },
+    { "someUnescapedLiteralValue", R"(${value}\n & no unescaping \t here!)" },
+    { "backtickAllowEscapeAndInterp", "i can use quotes \" and ', and I can use escape sequences\t-\tlook, tabs!" },
+    { "someShortInterp", "hello, world! b" },
+    { "someInterpValue", "hello, world!" },
+    { "someInterpString", "hello, world!" },
+    { "someInterpUnicodeValue", "\xCE\xB8 Test#ing \xE1\xBA\xBF 1,2, 3" },
+    { "notAnInterpolatedValue", R"(\$hello)" },
+    { "notAnInterpolatedString", "${hello}" },
+    { "valueWithMixedInterpValues", "hello, world!\t1,2, 3 with \xE0\xA4\xB9 utf-8 encoding \xCE\xB8" },
+    { "valueWithDefaultUnset", "hello, world!" },
+    { "valueWithDefaultEmpty", "hello, world!" },
+    { "someMultilineInterpValue", "\nTesting hi across\nlines, including brace-enclosed 1,2, 3\n" },
+  };
+
+  const wapi::DotEnv env{std::filesystem::path(FIXTURE_PATH)};
+  ASSERT_FALSE(env.IsEmpty());
+
+  for (const auto& [key, value] : expected) {
+    std::string result;
+    ASSERT_TRUE(env.TryGet(std::string(key), result)) << key;
+    EXPECT_EQ(result, value) << key;
+  }
+}
+
+TEST(DotEnvFixtureTest, CoercesTypedEntries) {
+  const wapi::DotEnv env{std::filesystem::path(FIXTURE_PATH)};
+
+  EXPECT_EQ(env.Get<int>("someIntValue"), 1);
+  EXPECT_DOUBLE_EQ(env.Get<double>("someDoubleValue"), 1.0125);
+  EXPECT_EQ(env.Get<std::wstring>(L"test"), L"hi");
+  EXPECT_THROW(env.Get<int>("value"), std::runtime_error);
+}
+
+TEST(DotEnvFixtureTest, MatchesAcrossLoadModes) {
+  const wapi::DotEnv buffered{std::filesystem::path(FIXTURE_PATH)};
+  const wapi::DotEnv mapped{std::filesystem::path(FIXTURE_PATH), wapi::DotEnv::MEMORY_MAP};
+  const wapi::DotEnv lazy{std::filesystem::path(FIXTURE_PATH), wapi::DotEnv::LAZY_INTERP};
+
+  for (const char* key : { "multilineValue", "someInterpUnicodeValue", "valueWithMixedInterpValues", "someMultilineInterpValue" }) {
+    const std::string expected = buffered.Get<std::string>(key);
+    EXPECT_EQ(mapped.Get<std::string>(key), expected) << key;
+    EXPECT_EQ(lazy.Get<std::string>(key), expected) << key;
+  }
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Lookup                          *
+ *                                                          *
+ ************************************************************/
+
+TEST(DotEnvLookupTest, DefaultIsReturnedByValue) {
+  const wapi::DotEnv env{std::filesystem::path(FIXTURE_PATH)};
+
+  const std::string fallback = "fallback";
+  static_assert(std::is_same_v<decltype(env.Get("missing", fallback)), std::string>);
+  static_assert(std::is_same_v<decltype(env.Get("missing", std::string("fallback"))), std::string>);
+
+  // Lvalue default(s), incl. the miss, coercion failure & hit path(s)
+  const std::string& missing = env.Get("missing", fallback);
+  const int count = 3;
+  EXPECT_EQ(missing, "fallback");
+  EXPECT_EQ(env.Get("value", fallback), "hello, world!");
+  EXPECT_EQ(env.Get("value", count), 3);
+  EXPECT_EQ(env.Get("someIntValue", count), 1);
+
+  // Rvalue default(s)
+  EXPECT_EQ(env.Get("missing", std::string("fallback")), "fallback");
+  EXPECT_EQ(env.Get(L"test", std::wstring(L"fallback")), L"hi");
+  EXPECT_EQ(env.Get("value", 3), 3);
+  EXPECT_DOUBLE_EQ(env.Get("someDoubleValue", 0.0), 1.0125);
+  EXPECT_EQ(fallback, "fallback");
+}
+
+TEST(DotEnvLookupTest, RvalueDefaultIsMovedOnMiss) {
+  const wapi::DotEnv env{std::filesystem::path(FIXTURE_PATH)};
+
+  std::string fallback(64, 'x');
+  const char* data = fallback.data();
+
+  const std::string result = env.Get("missing", std::move(fallback));
+  EXPECT_EQ(result.data(), data);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Layers                          *
+ *                                                          *
+ ************************************************************/
+
+namespace {
+
+std::filesystem::path writeLayer(const std::string& name, const std::string& content) {
+  const auto path = std::filesystem::temp_directory_path() / ("saildb_layer_" + name + ".env");
+  std::ofstream output(path, std::ios::binary | std::ios::trunc);
+  output << content;
+  return path;
+}
+
+} // namespace
+
+TEST(DotEnvLayersTest, MergesDiagnosticsOfEveryLayer) {
+  const std::vector<std::filesystem::path> layers = {
+    ::writeLayer("base", "A=1\nMALFORMED\nB=2\n"),
+    ::writeLayer("clean", "C=3\n"),
+    ::writeLayer("override", "A=4\n1KEY=5\nD=\"unclosed\n"),
+  };
+
+  const auto env = wapi::DotEnv::FromLayers(layers, wapi::DotEnv::DIAGNOSTICS);
+  EXPECT_EQ(env.Get<int>("A"), 4);
+
+  const auto diagnostics = env.GetDiagnostics();
+  ASSERT_EQ(diagnostics.size(), 3u);
+  EXPECT_EQ(env.GetDiagnosticCount(), 3u);
+
+  EXPECT_EQ(diagnostics[0].layer, 0u);
+  EXPECT_EQ(diagnostics[0].line, 2u);
+  EXPECT_EQ(diagnostics[0].issue, wapi::DotEnv::Issue::MalformedAssignment);
+
+  EXPECT_EQ(diagnostics[1].layer, 2u);
+  EXPECT_EQ(diagnostics[1].line, 2u);
+  EXPECT_EQ(diagnostics[1].issue, wapi::DotEnv::Issue::IllegalKey);
+
+  EXPECT_EQ(diagnostics[2].layer, 2u);
+  EXPECT_EQ(diagnostics[2].issue, wapi::DotEnv::Issue::UnclosedQuote);
+
+  for (const auto& layer : layers) {
+    std::filesystem::remove(layer);
+  }
+}
+
+TEST(DotEnvLayersTest, RetainsMostRecentDiagnosticsAcrossLayers) {
+  std::string malformed;
+  for (size_t i = 0; i < wapi::DotEnv::DIAGNOSTIC_CAPACITY; ++i) {
+    malformed += "MALFORMED\n";
+  }
+
+  const std::vector<std::filesystem::path> layers = {
+    ::writeLayer("first", malformed),
+    ::writeLayer("second", "A=1\nMALFORMED\n"),
+  };
+
+  const auto env = wapi::DotEnv::FromLayers(layers, wapi::DotEnv::DIAGNOSTICS);
+  const auto diagnostics = env.GetDiagnostics();
+
+  EXPECT_EQ(env.GetDiagnosticCount(), wapi::DotEnv::DIAGNOSTIC_CAPACITY + 1);
+  ASSERT_EQ(diagnostics.size(), wapi::DotEnv::DIAGNOSTIC_CAPACITY);
+  EXPECT_EQ(diagnostics.front().layer, 0u);
+  EXPECT_EQ(diagnostics.front().line, 2u);
+  EXPECT_EQ(diagnostics.back().layer, 1u);
+  EXPECT_EQ(diagnostics.back().line, 2u);
+
+  for (const auto& layer : layers) {
+    std::filesystem::remove(layer);
+  }
+}
+
+TEST(DotEnvLayersTest, OmitsDiagnosticsUnlessRequested) {
+  const auto layer = ::writeLayer("silent", "MALFORMED\n");
+
+  const auto env = wapi::DotEnv::FromLayers({ layer });
+  EXPECT_TRUE(env.GetDiagnostics().empty());
+  EXPECT_EQ(env.GetDiagnosticCount(), 0u);
+
+  std::filesystem::remove(layer);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Memory map                        *
+ *                                                          *
+ ************************************************************/
+
+TEST(DotEnvMappedTest, IsUnaffectedByInPlaceWrites) {
+  const auto path = std::filesystem::temp_directory_path() / "saildb_mapped.env";
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output << "A=original\nB=" << std::string(8192, 'b') << "\n";
+  }
+
+  const wapi::DotEnv env{path, wapi::DotEnv::MEMORY_MAP};
+
+  // Rewritten & truncated in place, i.e. without replacing the inode
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::in | std::ios::out);
+    output << "A=modified";
+  }
+  std::filesystem::resize_file(path, 4);
+
+  EXPECT_EQ(env.Get<std::string>("A"), "original");
+  EXPECT_EQ(env.Get<std::string>("B"), std::string(8192, 'b'));
+
+  std::filesystem::remove(path);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Snapshot                         *
+ *                                                          *
+ ************************************************************/
+
+namespace {
+
+class DotEnvSnapshotTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+      const std::string name = std::string("saildb_snapshot_") + info->name();
+
+      m_path = std::filesystem::temp_directory_path() / (name + ".env");
+      m_snapshotPath = std::filesystem::temp_directory_path() / (name + ".bin");
+      std::filesystem::remove(m_snapshotPath);
+
+      ::unsetenv(VARIABLE);
+      write("A=1\nB=\"${A} two\"\nC=${" + std::string(VARIABLE) + ":-unset}\nFLAG=on\n");
+    }
+
+    void TearDown() override {
+      ::unsetenv(VARIABLE);
+
+      std::error_code error;
+      std::filesystem::remove(m_path, error);
+      std::filesystem::remove(m_snapshotPath, error);
+    }
+
+    void write(const std::string& content) {
+      std::ofstream output(m_path, std::ios::binary | std::ios::trunc);
+      output << content;
+    }
+
+    // Loads the source through its snapshot, i.e. creating or refreshing it if it's stale
+    wapi::DotEnv load(uint8_t flags = 0) const {
+      return wapi::DotEnv{m_path, m_snapshotPath, flags};
+    }
+
+  protected:
+    static constexpr const char* VARIABLE = "SAILDB_SNAPSHOT_TEST_VALUE";
+
+    std::filesystem::path m_path;
+    std::filesystem::path m_snapshotPath;
+};
+
+} // namespace
+
+TEST_F(DotEnvSnapshotTest, ServesEntriesFromValidSnapshot) {
+  const wapi::DotEnv parsed = load();
+  EXPECT_FALSE(parsed.IsFromSnapshot());
+  ASSERT_TRUE(std::filesystem::exists(m_snapshotPath));
+
+  const wapi::DotEnv loaded = load();
+  ASSERT_TRUE(loaded.IsFromSnapshot());
+  EXPECT_FALSE(loaded.IsEmpty());
+
+  for (const char* key : { "A", "B", "C", "FLAG" }) {
+    EXPECT_TRUE(loaded.Contains(key)) << key;
+    EXPECT_EQ(loaded.Get<std::string>(key), parsed.Get<std::string>(key)) << key;
+  }
+
+  EXPECT_EQ(loaded.Get<std::string>("B"), "1 two");
+  EXPECT_EQ(loaded.Get<std::string>("C"), "unset");
+  EXPECT_EQ(loaded.Get<int>("A"), 1);
+  EXPECT_TRUE(loaded.Get<bool>("FLAG"));
+  EXPECT_EQ(loaded.Get<std::wstring>(L"B"), L"1 two");
+
+  // Missing key(s) either side of the table & between its entries
+  for (const char* key : { "0", "AA", "Z", "" }) {
+    EXPECT_FALSE(loaded.Contains(key)) << key;
+  }
+  EXPECT_FALSE(loaded.Contains(L"\u00C0"));
+  EXPECT_EQ(loaded.Get("Z", std::string("fallback")), "fallback");
+  EXPECT_THROW(loaded.Get<std::string>("Z"), std::runtime_error);
+}
+
+TEST_F(DotEnvSnapshotTest, SearchesLargeTables) {
+  std::string content;
+  for (int i = 0; i < 1000; ++i) {
+    content += "KEY_" + std::to_string(i) + "=" + std::to_string(i * 7) + "\n";
+  }
+  write(content);
+
+  load();
+  const wapi::DotEnv loaded = load();
+  ASSERT_TRUE(loaded.IsFromSnapshot());
+
+  for (int i = 0; i < 1000; ++i) {
+    const std::string key = "KEY_" + std::to_string(i);
+    ASSERT_EQ(loaded.Get<int>(key), i * 7) << key;
+  }
+  EXPECT_FALSE(loaded.Contains("KEY_1000"));
+}
+
+TEST_F(DotEnvSnapshotTest, IsInvalidatedBySourceChange) {
+  load();
+
+  write("A=2\nB=\"${A} two\"\n");
+  const wapi::DotEnv reparsed = load();
+  EXPECT_FALSE(reparsed.IsFromSnapshot());
+  EXPECT_EQ(reparsed.Get<std::string>("B"), "2 two");
+  EXPECT_FALSE(reparsed.Contains("FLAG"));
+
+  // Refreshed by the re-parse
+  const wapi::DotEnv loaded = load();
+  EXPECT_TRUE(loaded.IsFromSnapshot());
+  EXPECT_EQ(loaded.Get<std::string>("B"), "2 two");
+}
+
+TEST_F(DotEnvSnapshotTest, IsInvalidatedByReferencedEnvChange) {
+  load();
+  ASSERT_TRUE(load().IsFromSnapshot());
+
+  ::setenv(VARIABLE, "set", 1);
+  const wapi::DotEnv reparsed = load();
+  EXPECT_FALSE(reparsed.IsFromSnapshot());
+  EXPECT_EQ(reparsed.Get<std::string>("C"), "set");
+  ASSERT_TRUE(load().IsFromSnapshot());
+
+  ::setenv(VARIABLE, "changed", 1);
+  EXPECT_FALSE(load().IsFromSnapshot());
+  EXPECT_EQ(load().Get<std::string>("C"), "changed");
+
+  ::unsetenv(VARIABLE);
+  EXPECT_FALSE(load().IsFromSnapshot());
+  EXPECT_EQ(load().Get<std::string>("C"), "unset");
+}
+
+TEST_F(DotEnvSnapshotTest, IsInvalidatedByFlagChange) {
+  load();
+
+  const wapi::DotEnv literal = load(wapi::DotEnv::NO_INTERPOLATE);
+  EXPECT_FALSE(literal.IsFromSnapshot());
+  EXPECT_EQ(literal.Get<std::string>("B"), "${A} two");
+
+  const wapi::DotEnv interpolated = load();
+  EXPECT_FALSE(interpolated.IsFromSnapshot());
+  EXPECT_EQ(interpolated.Get<std::string>("B"), "1 two");
+}
+
+TEST_F(DotEnvSnapshotTest, RejectsTruncatedSnapshot) {
+  load();
+
+  const auto size = std::filesystem::file_size(m_snapshotPath);
+  for (const uintmax_t length : { uintmax_t{0}, uintmax_t{16}, size / 2, size - 1 }) {
+    load();
+    std::filesystem::resize_file(m_snapshotPath, length);
+
+    const wapi::DotEnv reparsed = load();
+    EXPECT_FALSE(reparsed.IsFromSnapshot()) << length;
+    EXPECT_EQ(reparsed.Get<std::string>("B"), "1 two") << length;
+  }
+}
+
+TEST_F(DotEnvSnapshotTest, RejectsCorruptSnapshot) {
+  load();
+
+  std::string content;
+  {
+    std::ifstream input(m_snapshotPath, std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  }
+
+  // Magic, entry table & value blob
+  for (const size_t offset : { size_t{0}, size_t{64}, content.size() - 1 }) {
+    std::string corrupt = content;
+    corrupt[offset] ^= 0x5A;
+    {
+      std::ofstream output(m_snapshotPath, std::ios::binary | std::ios::trunc);
+      output << corrupt;
+    }
+
+    const wapi::DotEnv reparsed = load();
+    EXPECT_FALSE(reparsed.IsFromSnapshot()) << offset;
+    EXPECT_EQ(reparsed.Get<std::string>("B"), "1 two") << offset;
+    EXPECT_EQ(reparsed.Get<std::string>("FLAG"), "on") << offset;
+  }
+}
+
+TEST_F(DotEnvSnapshotTest, SavesSnapshotOfSnapshot) {
+  load();
+
+  const wapi::DotEnv loaded = load();
+  ASSERT_TRUE(loaded.IsFromSnapshot());
+
+  const auto copyPath = std::filesystem::path(m_snapshotPath).replace_extension(".copy");
+  std::string errorMessage;
+  ASSERT_TRUE(loaded.TrySaveSnapshot(copyPath, errorMessage)) << errorMessage;
+
+  // Incl. its dependencies, i.e. the copy is still invalidated by the env var
+  const wapi::DotEnv copy{m_path, copyPath};
+  EXPECT_TRUE(copy.IsFromSnapshot());
+  EXPECT_EQ(copy.Get<std::string>("B"), "1 two");
+
+  ::setenv(VARIABLE, "set", 1);
+  EXPECT_FALSE((wapi::DotEnv{m_path, copyPath}).IsFromSnapshot());
+
+  std::filesystem::remove(copyPath);
+}
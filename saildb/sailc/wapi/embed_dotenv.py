@@ -0,0 +1,83 @@
+"""Generates a header declaring a compile-time parsed `saildb::wapi::EmbeddedDotEnv` from a .env file"""
+
+from __future__ import annotations
+
+import re
+import argparse
+
+
+CHUNK_SIZE = 64
+IDENTIFIER = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*$')
+NAMESPACE = re.compile(r'^[A-Za-z_][A-Za-z0-9_]*(::[A-Za-z_][A-Za-z0-9_]*)*$')
+
+
+def escape_chunk(chunk: bytes) -> str:
+  """Escapes a chunk of the source as a narrow string literal, octal escapes are used
+  so that subsequent digit(s) cannot be consumed by the escape sequence"""
+  out = []
+  for byte in chunk:
+    ch = chr(byte)
+    if ch == '\\' or ch == '"':
+      out.append('\\' + ch)
+    elif ch == '?':
+      # Avoid trigraph(s)
+      out.append('\\?')
+    elif 0x20 <= byte < 0x7F:
+      out.append(ch)
+    else:
+      out.append('\\%03o' % byte)
+
+  return '"%s"' % ''.join(out)
+
+
+def render(source: bytes, symbol: str, namespace: str, origin: str) -> str:
+  """Renders the header, splitting the source into adjacent literal(s) so as to
+  remain within the per-literal length limit(s) of MSVC"""
+  if b'\0' in source:
+    raise ValueError('Embedded .env must not contain NUL character(s)')
+
+  chunks = [source[i:i + CHUNK_SIZE] for i in range(0, len(source), CHUNK_SIZE)] or [b'']
+  literal = '\n'.join('  ' + escape_chunk(chunk) for chunk in chunks)
+
+  return (
+    '#pragma once\n'
+    '\n'
+    '// Generated from %s by embed_dotenv.py, do not edit\n'
+    '\n'
+    '#include "sailc/wapi/embedded.hpp"\n'
+    '\n'
+    'namespace %s {\n'
+    '\n'
+    'inline constexpr saildb::wapi::EmbeddedDotEnv<\n'
+    '%s\n'
+    '> %s{};\n'
+    '\n'
+    '} // namespace %s\n'
+  ) % (origin, namespace, literal, symbol, namespace)
+
+
+def main() -> None:
+  parser = argparse.ArgumentParser(description=__doc__)
+  parser.add_argument('src', help='path to the .env file')
+  parser.add_argument('--out', required=True, help='path of the generated header')
+  parser.add_argument('--symbol', required=True, help='name of the declared profile')
+  parser.add_argument('--namespace', default='saildb::profiles', help='enclosing namespace of the profile')
+  parser.add_argument('--origin', default=None, help='source path recorded in the header, defaults to `src`')
+  args = parser.parse_args()
+
+  if not IDENTIFIER.match(args.symbol):
+    parser.error('--symbol must be a valid C++ identifier')
+
+  if not NAMESPACE.match(args.namespace):
+    parser.error('--namespace must be a valid, possibly nested, C++ namespace')
+
+  with open(args.src, 'rb') as f:
+    source = f.read()
+
+  header = render(source, args.symbol, args.namespace, args.origin or args.src)
+  with open(args.out, 'w', encoding='utf-8', newline='\n') as f:
+    f.write(header)
+
+
+if __name__ == '__main__':
+  main()
@@ -0,0 +1,582 @@
+#pragma once
+
+#include "sailc/common/coerce.hpp"
+#include "sailc/common/cstring.hpp"
+
+#include <bit>
+#include <array>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+
+namespace saildb {
+namespace wapi {
+
+/*
+ * String literal usable as a template argument, e.g. `EmbeddedDotEnv<"KEY=VALUE">`
+ */
+template <size_t N>
+struct FixedString {
+  char data[N]{};
+
+  constexpr FixedString(const char (&str)[N]) {
+    std::copy_n(str, N, data);
+  }
+
+  constexpr auto View() const -> std::string_view {
+    return std::string_view(data, N - 1);
+  }
+};
+
+
+namespace internal {
+
+/************************************************************
+ *                                                          *
+ *                      Constexpr parser                    *
+ *                                                          *
+ ************************************************************/
+#pragma region embedded_parser
+
+struct EmbeddedEntry {
+  std::string key;
+  std::string value;
+};
+
+struct EmbeddedRecord {
+  uint32_t keyOffset;
+  uint32_t keyLength;
+  uint32_t valueOffset;
+  uint32_t valueLength;
+};
+
+struct EmbeddedLayout {
+  size_t count;
+  size_t bytes;
+  size_t slots;
+  uint64_t seed;
+};
+
+template <size_t Count, size_t Bytes, size_t Slots>
+struct EmbeddedTable {
+  std::array<char, Bytes> blob{};
+  std::array<EmbeddedRecord, Count> records{};
+  std::array<uint32_t, Slots> slots{}; // Record index + 1, or 0 if vacant
+  uint64_t seed{0};
+};
+
+constexpr bool isEmbeddedBlank(char ch) {
+  return ch == ' ' || ch == '\t' || ch == '\v' || ch == '\f' || ch == '\r';
+}
+
+constexpr bool isEmbeddedLead(char ch) {
+  return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+}
+
+constexpr bool isEmbeddedChar(char ch) {
+  return internal::isEmbeddedLead(ch) || (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+template <typename CharT>
+constexpr auto hashEmbeddedKey(const CharT* key, size_t length, uint64_t seed) -> uint64_t {
+  // Key(s) are ASCII, so wide key(s) hash on their low byte alone
+  uint64_t hash = 0xCBF29CE484222325ull ^ (seed * 0x9E3779B97F4A7C15ull);
+  for (size_t i = 0; i < length; ++i) {
+    hash ^= static_cast<uint8_t>(key[i]);
+    hash *= 0x100000001B3ull;
+  }
+
+  return hash ^ (hash >> 29);
+}
+
+/*
+ * Parses `source` with the same grammar as `DotEnv`, but as if under its
+ * STRICT flag: any malformed line throws & thus fails constant evaluation
+ *
+ *  - Reference(s) resolve against preceding entries only, the process'
+ *    environment isn't available at compile time
+ *  - Redefined key(s) keep their first position & take their last value
+ *
+ */
+constexpr auto parseEmbedded(std::string_view source) -> std::vector<EmbeddedEntry> {
+  std::vector<EmbeddedEntry> entries;
+
+  const size_t size = source.size();
+  const auto find = [&entries](std::string_view name) -> const EmbeddedEntry* {
+    for (const EmbeddedEntry& entry : entries) {
+      if (entry.key == name) {
+        return &entry;
+      }
+    }
+
+    return nullptr;
+  };
+
+  // Appends the `$VAR` or `${VAR[:-|-]default}` reference at `head` to `value`,
+  // returns the position following the reference or `head` if malformed
+  const auto reference = [&](size_t head, char delim, std::string& value) -> size_t {
+    size_t it = head + 1;
+    if (it >= size) {
+      return head;
+    }
+
+    const bool isBraced = source[it] == '{';
+    if (isBraced) {
+      it++;
+    }
+
+    const size_t nameHead = it;
+    while (it < size && internal::isEmbeddedChar(source[it])) {
+      it++;
+    }
+
+    if (it == nameHead) {
+      return head;
+    }
+
+    const std::string_view name = source.substr(nameHead, it - nameHead);
+    const EmbeddedEntry* entry = find(name);
+    if (!isBraced) {
+      value.append(entry ? std::string_view(entry->value) : std::string_view());
+      return it;
+    }
+
+    bool isUnset = false;
+    bool isEmpty = false;
+    if (it + 1 < size && source[it] == ':' && source[it + 1] == '-') {
+      isEmpty = true;
+      it += 2;
+    } else if (it < size && source[it] == '-') {
+      isUnset = true;
+      it++;
+    }
+
+    const size_t defaultHead = it;
+    while (it < size && source[it] != '}') {
+      if (source[it] == '\n' || source[it] == delim) {
+        return head;
+      }
+
+      it += (source[it] == '\\' && it + 1 < size) ? 2 : 1;
+    }
+
+    if (it >= size || (!isUnset && !isEmpty && it != defaultHead)) {
+      return head;
+    }
+
+    if ((isUnset && !entry) || (isEmpty && (!entry || entry->value.empty()))) {
+      value.append(source.substr(defaultHead, it - defaultHead));
+    } else if (entry) {
+      value.append(entry->value);
+    }
+
+    return it + 1;
+  };
+
+  const auto skipLine = [&](size_t it) -> size_t {
+    while (it < size && source[it] != '\n') {
+      it++;
+    }
+
+    return it;
+  };
+
+  size_t it = source.starts_with("\xEF\xBB\xBF") ? 3 : 0;
+  while (it < size) {
+    const char lead = source[it];
+    if (lead == '#') {
+      it = skipLine(it);
+      continue;
+    } else if (lead == '\n' || lead == ';' || internal::isEmbeddedBlank(lead)) {
+      it++;
+      continue;
+    }
+
+    // Key
+    const size_t keyHead = it;
+    while (it < size && source[it] != '\n' && source[it] != '=') {
+      it++;
+    }
+
+    if (it >= size || source[it] == '\n') {
+      throw std::invalid_argument("Failed to parse embedded .env, found malformed assignment");
+    }
+
+    size_t keyTail = it++;
+    while (keyTail > keyHead && internal::isEmbeddedBlank(source[keyTail - 1])) {
+      keyTail--;
+    }
+
+    const std::string_view key = source.substr(keyHead, keyTail - keyHead);
+    if (key.empty() || !internal::isEmbeddedLead(key.front()) || !std::all_of(key.begin(), key.end(), internal::isEmbeddedChar)) {
+      throw std::invalid_argument("Failed to parse embedded .env, found illegal key");
+    }
+
+    while (it < size && internal::isEmbeddedBlank(source[it])) {
+      it++;
+    }
+
+    // Value
+    std::string value;
+    const char quote = it < size ? source[it] : '\0';
+    if (quote == '\'' || quote == '\"' || quote == '`') {
+      const bool isLiteral = quote == '\'';
+
+      it++;
+      while (true) {
+        if (it >= size) {
+          throw std::invalid_argument("Failed to parse embedded .env, found unclosed quote");
+        }
+
+        const char ch = source[it];
+        if (ch == quote) {
+          it++;
+          break;
+        }
+
+        if (ch == '\r' && it + 1 < size && source[it + 1] == '\n') {
+          it++;
+          continue;
+        }
+
+        if (ch == '\\' && it + 1 < size) {
+          const char next = source[it + 1];
+          if (isLiteral) {
+            value.push_back(ch);
+            value.push_back(next);
+          } else if (next == 'n') {
+            value.push_back('\n');
+          } else if (next == 'r') {
+            value.push_back('\r');
+          } else if (next == 't') {
+            value.push_back('\t');
+          } else if (next != 'b' && next != 'v' && next != 'f') {
+            value.push_back(next);
+          }
+
+          it += 2;
+          continue;
+        }
+
+        if (ch == '$' && !isLiteral) {
+          const size_t next = reference(it, quote, value);
+          if (next != it) {
+            it = next;
+            continue;
+          }
+        }
+
+        value.push_back(ch);
+        it++;
+      }
+
+      while (it < size && internal::isEmbeddedBlank(source[it])) {
+        it++;
+      }
+
+      if (it < size && source[it] != '\n' && source[it] != '#') {
+        throw std::invalid_argument("Failed to parse embedded .env, found trailing content");
+      }
+    } else {
+      size_t floor = 0;
+      while (it < size && source[it] != '\n' && source[it] != '#') {
+        const char ch = source[it];
+        if (ch == '\\') {
+          const size_t length = (it + 1 < size && source[it + 1] != '\n' && source[it + 1] != '#') ? 2 : 1;
+          value.append(source.substr(it, length));
+          it += length;
+          continue;
+        }
+
+        if (ch == '$') {
+          const size_t next = reference(it, '#', value);
+          if (next != it) {
+            it = next;
+            floor = value.size();
+            continue;
+          }
+        }
+
+        value.push_back(ch);
+        it++;
+      }
+
+      while (value.size() > floor && internal::isEmbeddedBlank(value.back())) {
+        value.pop_back();
+      }
+    }
+
+    it = skipLine(it);
+
+    auto entry = std::find_if(entries.begin(), entries.end(), [&key](const EmbeddedEntry& e) { return e.key == key; });
+    if (entry != entries.end()) {
+      entry->value = std::move(value);
+    } else {
+      entries.push_back({ std::string(key), std::move(value) });
+    }
+  }
+
+  return entries;
+}
+
+constexpr bool isEmbeddedCollisionFree(const std::vector<EmbeddedEntry>& entries, size_t slots, uint64_t seed) {
+  std::vector<uint8_t> occupied(slots, 0);
+  for (const EmbeddedEntry& entry : entries) {
+    const size_t slot = internal::hashEmbeddedKey(entry.key.data(), entry.key.size(), seed) & (slots - 1);
+    if (occupied[slot]) {
+      return false;
+    }
+
+    occupied[slot] = 1;
+  }
+
+  return true;
+}
+
+constexpr auto measureEmbedded(std::string_view source) -> EmbeddedLayout {
+  const std::vector<EmbeddedEntry> entries = internal::parseEmbedded(source);
+
+  EmbeddedLayout layout{ entries.size(), 0, 0, 0 };
+  for (const EmbeddedEntry& entry : entries) {
+    layout.bytes += entry.key.size() + entry.value.size();
+  }
+
+  // Search for a collision-free seed, widening the table if none is found
+  for (size_t slots = std::bit_ceil(std::max<size_t>(1, entries.size() * 2)); ; slots *= 2) {
+    for (uint64_t seed = 0; seed < 64; ++seed) {
+      if (internal::isEmbeddedCollisionFree(entries, slots, seed)) {
+        layout.slots = slots;
+        layout.seed = seed;
+        return layout;
+      }
+    }
+  }
+}
+
+template <size_t Count, size_t Bytes, size_t Slots>
+constexpr auto buildEmbedded(std::string_view source, uint64_t seed) -> EmbeddedTable<Count, Bytes, Slots> {
+  const std::vector<EmbeddedEntry> entries = internal::parseEmbedded(source);
+
+  EmbeddedTable<Count, Bytes, Slots> table{};
+  table.seed = seed;
+
+  uint32_t offset = 0;
+  for (size_t i = 0; i < Count; ++i) {
+    const EmbeddedEntry& entry = entries[i];
+
+    EmbeddedRecord& record = table.records[i];
+    record.keyOffset = offset;
+    record.keyLength = static_cast<uint32_t>(entry.key.size());
+    std::copy(entry.key.begin(), entry.key.end(), table.blob.begin() + offset);
+    offset += record.keyLength;
+
+    record.valueOffset = offset;
+    record.valueLength = static_cast<uint32_t>(entry.value.size());
+    std::copy(entry.value.begin(), entry.value.end(), table.blob.begin() + offset);
+    offset += record.valueLength;
+
+    const size_t slot = internal::hashEmbeddedKey(entry.key.data(), entry.key.size(), seed) & (Slots - 1);
+    table.slots[slot] = static_cast<uint32_t>(i + 1);
+  }
+
+  return table;
+}
+
+#pragma endregion
+
+} // namespace internal
+
+
+/************************************************************
+ *                                                          *
+ *                     EmbeddedDotEnv                       *
+ *                                                          *
+ ************************************************************/
+#pragma region embedded_decl
+
+/*
+ * DotEnv profile parsed at compile time into a static, perfect-hashed table,
+ * e.g. baked-in default(s) that need no runtime parsing or allocation
+ *
+ *  - Shares the `Get`/`Contains`/`TryGet` interface & coercion(s) of `DotEnv`, see `common::tryCoerce`
+ *  - Malformed line(s) fail compilation, as would `DotEnv::STRICT` at runtime
+ *  - Reference(s) resolve against preceding entries only; see `parseEmbedded`
+ *  - Large profile(s) may exceed the compiler's default constexpr step limit,
+ *    e.g. MSVC's `/constexpr:steps`
+ *
+ * Header(s) may be generated from a `.env` file with `embedded_dot_env` (//saildb:defs.bzl)
+ *
+ */
+template <FixedString Source>
+class EmbeddedDotEnv {
+  public:
+    constexpr EmbeddedDotEnv() = default;
+
+  public:
+    constexpr bool IsEmpty() const;
+    constexpr size_t Size() const;
+
+    template <typename T>
+    constexpr auto Contains(const T& key) const -> bool;
+
+    // Raw value view, usable in constant expression(s)
+    template <typename T>
+    constexpr auto TryGetView(const T& key, std::string_view& value) const -> bool;
+
+    template <typename U, typename T>
+    auto Get(const T& key) const -> U;
+
+    // Yields a copy of `defaultValue` if the key is missing or can't be coerced, i.e. never a reference
+    template <typename U, typename T>
+    auto Get(const T& key, U&& defaultValue) const -> std::remove_cvref_t<U>;
+
+    template <typename T, typename U>
+    auto TryGet(const T& key, U& value) const -> bool;
+
+  private:
+    static constexpr internal::EmbeddedLayout s_layout = internal::measureEmbedded(Source.View());
+    static constexpr auto s_table = internal::buildEmbedded<s_layout.count, s_layout.bytes, s_layout.slots>(Source.View(), s_layout.seed);
+
+  private:
+    template <typename T>
+    static constexpr auto findRecord(const T& key) -> const internal::EmbeddedRecord*;
+
+    static constexpr auto viewOf(uint32_t offset, uint32_t length) -> std::string_view;
+
+    template <typename T>
+    static auto toKeyName(const T& key) -> std::string;
+};
+
+#pragma endregion
+
+
+#pragma region embedded_impl
+
+/* Public */
+template <FixedString Source>
+inline constexpr bool EmbeddedDotEnv<Source>::IsEmpty() const {
+  return s_layout.count == 0;
+}
+
+template <FixedString Source>
+inline constexpr size_t EmbeddedDotEnv<Source>::Size() const {
+  return s_layout.count;
+}
+
+template <FixedString Source>
+template <typename T>
+inline constexpr auto EmbeddedDotEnv<Source>::Contains(const T& key) const -> bool {
+  static_assert((std::is_convertible_v<T, std::string_view> || std::is_convertible_v<T, std::wstring_view>));
+  return EmbeddedDotEnv::findRecord(key) != nullptr;
+}
+
+template <FixedString Source>
+template <typename T>
+inline constexpr auto EmbeddedDotEnv<Source>::TryGetView(const T& key, std::string_view& value) const -> bool {
+  static_assert((std::is_convertible_v<T, std::string_view> || std::is_convertible_v<T, std::wstring_view>));
+
+  const internal::EmbeddedRecord* record = EmbeddedDotEnv::findRecord(key);
+  if (!record) {
+    return false;
+  }
+
+  value = EmbeddedDotEnv::viewOf(record->valueOffset, record->valueLength);
+  return true;
+}
+
+template <FixedString Source>
+template <typename U, typename T>
+inline auto EmbeddedDotEnv<Source>::Get(const T& key) const -> U {
+  std::string_view value;
+  if (!this->TryGetView(key, value)) {
+    throw std::runtime_error(
+      std::string("Key of name '")
+        .append(EmbeddedDotEnv::toKeyName(key))
+        .append("' does not exist")
+    );
+  }
+
+  U result{};
+  if (!common::tryCoerce(value, result)) {
+    common::throwCoercionError<U>(value);
+  }
+
+  return result;
+}
+
+template <FixedString Source>
+template <typename U, typename T>
+inline auto EmbeddedDotEnv<Source>::Get(const T& key, U&& defaultValue) const -> std::remove_cvref_t<U> {
+  std::string_view value;
+  std::remove_cvref_t<U> result{};
+  if (this->TryGetView(key, value) && common::tryCoerce(value, result)) {
+    return result;
+  }
+
+  return std::forward<U>(defaultValue);
+}
+
+template <FixedString Source>
+template <typename T, typename U>
+inline auto EmbeddedDotEnv<Source>::TryGet(const T& key, U& value) const -> bool {
+  std::string_view raw;
+  return this->TryGetView(key, raw) && common::tryCoerce(raw, value);
+}
+
+
+/* Private */
+template <FixedString Source>
+template <typename T>
+inline constexpr auto EmbeddedDotEnv<Source>::findRecord(const T& key) -> const internal::EmbeddedRecord* {
+  if constexpr(s_layout.count == 0) {
+    return nullptr;
+  } else {
+    const auto view = [&key]() {
+      if constexpr(std::is_convertible_v<T, std::string_view>) {
+        return std::string_view(key);
+      } else {
+        return std::wstring_view(key);
+      }
+    }();
+
+    const size_t slot = internal::hashEmbeddedKey(view.data(), view.size(), s_table.seed) & (s_layout.slots - 1);
+    const uint32_t index = s_table.slots[slot];
+    if (index == 0) {
+      return nullptr;
+    }
+
+    const internal::EmbeddedRecord& record = s_table.records[index - 1];
+    const std::string_view candidate = EmbeddedDotEnv::viewOf(record.keyOffset, record.keyLength);
+    const bool isMatch = std::equal(view.begin(), view.end(), candidate.begin(), candidate.end(), [](auto a, char b) {
+      return static_cast<uint32_t>(a) == static_cast<uint8_t>(b);
+    });
+
+    return isMatch ? &record : nullptr;
+  }
+}
+
+template <FixedString Source>
+inline constexpr auto EmbeddedDotEnv<Source>::viewOf(uint32_t offset, uint32_t length) -> std::string_view {
+  return std::string_view(s_table.blob.data() + offset, length);
+}
+
+template <FixedString Source>
+template <typename T>
+inline auto EmbeddedDotEnv<Source>::toKeyName(const T& key) -> std::string {
+  if constexpr(std::is_convertible_v<T, std::string_view>) {
+    return std::string(std::string_view(key));
+  } else {
+    return common::wstr2str(std::wstring(std::wstring_view(key)));
+  }
+}
+
+#pragma endregion
+
+} // namespace wapi
+} // namespace saildb
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+#include <filesystem>
+
+#include "sailc/wapi/wapi.hpp"
+#include "sailc/wapi/embedded.hpp"
+#include "sailc/wapi/fixture_profile.hpp"
+
+namespace wapi = saildb::wapi;
+
+namespace {
+
+constexpr const char* FIXTURE_PATH = "resources/.saildb.env";
+
+constexpr const char* FIXTURE_KEYS[] = {
+  "test", "value", "otherValue", "someIntValue", "someDoubleValue", "someLiteralValue",
+  "someUnquotedValue", "someEscapedQuotedValue", "someGraveValueWithQuotes", "multilineValue",
+  "specialCharacters", "valueWithComment", "stringWithComment", "valueWithMultiComment",
+  "valueWithEscapeSeq", "stringWithEscapeSeq", "someUnescapedLiteralValue",
+  "backtickAllowEscapeAndInterp", "someShortInterp", "someInterpValue", "someInterpString",
+  "someInterpUnicodeValue", "notAnInterpolatedValue", "notAnInterpolatedString",
+  "valueWithMixedInterpValues", "valueWithDefaultUnset", "valueWithDefaultEmpty",
+  "someMultilineInterpValue",
+};
+
+constexpr wapi::EmbeddedDotEnv<"FLAG=on\nCOUNT=300\nNEGATIVE=-1\nHUGE=1e300\nTEXT=hello\n"> TYPED{};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Parity                          *
+ *                                                          *
+ ************************************************************/
+
+// Guards against drift between the constexpr & runtime grammar(s)
+TEST(EmbeddedDotEnvTest, MatchesRuntimeParseOfFixture) {
+  const wapi::DotEnv env{std::filesystem::path(FIXTURE_PATH)};
+  constexpr const auto& embedded = saildb::profiles::FIXTURE;
+
+  EXPECT_EQ(embedded.Size(), std::size(FIXTURE_KEYS));
+  for (const char* key : FIXTURE_KEYS) {
+    ASSERT_TRUE(embedded.Contains(key)) << key;
+    EXPECT_EQ(embedded.Get<std::string>(key), env.Get<std::string>(key)) << key;
+  }
+}
+
+TEST(EmbeddedDotEnvTest, CoercesAsRuntime) {
+  const wapi::DotEnv env{std::filesystem::path(FIXTURE_PATH)};
+  constexpr const auto& embedded = saildb::profiles::FIXTURE;
+
+  EXPECT_EQ(embedded.Get<int>("someIntValue"), env.Get<int>("someIntValue"));
+  EXPECT_DOUBLE_EQ(embedded.Get<double>("someDoubleValue"), env.Get<double>("someDoubleValue"));
+  EXPECT_EQ(embedded.Get<std::wstring>(L"test"), env.Get<std::wstring>(L"test"));
+
+  // Failure(s) & their message(s) are shared
+  for (const char* key : FIXTURE_KEYS) {
+    int runtime{}, compiled{};
+    EXPECT_EQ(embedded.TryGet(key, compiled), env.TryGet(key, runtime)) << key;
+    EXPECT_EQ(compiled, runtime) << key;
+  }
+
+  try {
+    embedded.Get<bool>("value");
+    FAIL() << "Expected coercion of 'value' into boolean to throw";
+  } catch (const std::runtime_error& error) {
+    EXPECT_STREQ(error.what(), "Failed to coerce 'hello, world!' into boolean, expected one of: 1/0, true/false, on/off");
+  }
+}
+
+TEST(EmbeddedDotEnvTest, NarrowsWithinRange) {
+  bool flag{};
+  EXPECT_TRUE(TYPED.TryGet("FLAG", flag));
+  EXPECT_TRUE(flag);
+
+  uint8_t narrow{};
+  EXPECT_FALSE(TYPED.TryGet("COUNT", narrow));
+  EXPECT_EQ(TYPED.Get<uint16_t>("COUNT"), 300);
+
+  uint32_t unsignedValue{};
+  EXPECT_FALSE(TYPED.TryGet("NEGATIVE", unsignedValue));
+  EXPECT_EQ(TYPED.Get<int8_t>("NEGATIVE"), -1);
+
+  float single{};
+  EXPECT_FALSE(TYPED.TryGet("HUGE", single));
+  EXPECT_DOUBLE_EQ(TYPED.Get<double>("HUGE"), 1e300);
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Lookup                          *
+ *                                                          *
+ ************************************************************/
+
+TEST(EmbeddedDotEnvTest, DefaultIsReturnedByValue) {
+  const std::string fallback = "fallback";
+  static_assert(std::is_same_v<decltype(TYPED.Get("MISSING", fallback)), std::string>);
+  static_assert(std::is_same_v<decltype(TYPED.Get("MISSING", std::string("fallback"))), std::string>);
+
+  // Lvalue default(s), incl. the miss, coercion failure & hit path(s)
+  const std::string& missing = TYPED.Get("MISSING", fallback);
+  const int count = 3;
+  EXPECT_EQ(missing, "fallback");
+  EXPECT_EQ(TYPED.Get("TEXT", fallback), "hello");
+  EXPECT_EQ(TYPED.Get("TEXT", count), 3);
+  EXPECT_EQ(TYPED.Get("COUNT", count), 300);
+
+  // Rvalue default(s)
+  EXPECT_EQ(TYPED.Get("MISSING", std::string("fallback")), "fallback");
+  EXPECT_EQ(TYPED.Get(L"TEXT", std::wstring(L"fallback")), L"hello");
+  EXPECT_EQ(fallback, "fallback");
+}
+
+TEST(EmbeddedDotEnvTest, RvalueDefaultIsMovedOnMiss) {
+  std::string fallback(64, 'x');
+  const char* data = fallback.data();
+
+  const std::string result = TYPED.Get("MISSING", std::move(fallback));
+  EXPECT_EQ(result.data(), data);
+}
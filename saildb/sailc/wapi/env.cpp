@@ -0,0 +1,105 @@
+#include "wapi.hpp"
+
+#include <atomic>
+#include <algorithm>
+
+namespace wapi = saildb::wapi;
+
+
+
+/************************************************************
+ *                                                          *
+ *                       EnvSnapshot                        *
+ *                                                          *
+ ************************************************************/
+
+using EnvSnapshot = wapi::EnvSnapshot;
+
+// Env var names are compared case-insensitively on Windows only; fold ASCII
+inline char foldEnvChar(char ch) {
+#ifdef _WIN32
+  return (ch >= 'a' && ch <= 'z') ? static_cast<char>(ch - ('a' - 'A')) : ch;
+#else
+  return ch;
+#endif
+}
+
+static std::atomic<std::shared_ptr<const EnvSnapshot>> s_sharedEnvSnapshot;
+
+
+/* Static impl. */
+std::shared_ptr<const EnvSnapshot> EnvSnapshot::GetShared() {
+  auto snapshot = s_sharedEnvSnapshot.load(std::memory_order_acquire);
+  if (snapshot) {
+    return snapshot;
+  }
+
+  // Racing thread(s) may each capture, only the first to publish is kept
+  std::shared_ptr<const EnvSnapshot> expected;
+  snapshot = EnvSnapshot::Capture();
+  if (!s_sharedEnvSnapshot.compare_exchange_strong(expected, snapshot, std::memory_order_acq_rel)) {
+    return expected;
+  }
+
+  return snapshot;
+}
+
+void EnvSnapshot::InvalidateShared() {
+  s_sharedEnvSnapshot.store(nullptr, std::memory_order_release);
+}
+
+
+/* Public impl. */
+size_t EnvSnapshot::Size() const {
+  return m_variables.size();
+}
+
+bool EnvSnapshot::Contains(std::string_view name) const {
+  return m_variables.contains(name);
+}
+
+bool EnvSnapshot::TryGet(std::string_view name, std::string_view& value) const {
+  const auto variable = m_variables.find(name);
+  if (variable == m_variables.end()) {
+    return false;
+  }
+
+  value = variable->second;
+  return true;
+}
+
+
+/* Private impl. */
+void EnvSnapshot::indexBlock() {
+  const char* it = m_block.data();
+  const char* const end = it + m_block.size();
+
+  while (it < end) {
+    const std::string_view pair(it);
+    it += pair.size() + 1;
+
+    // Hidden per-drive var(s) lead with `=`, e.g. `=C:=C:\...`
+    const size_t separator = pair.find('=', 1);
+    if (separator == std::string_view::npos) {
+      continue;
+    }
+
+    m_variables.try_emplace(pair.substr(0, separator), pair.substr(separator + 1));
+  }
+}
+
+size_t EnvSnapshot::NameHash::operator()(std::string_view name) const noexcept {
+  // FNV-1a over the folded name
+  uint64_t hash = 0xCBF29CE484222325;
+  for (const char ch : name) {
+    hash = (hash ^ static_cast<uint8_t>(::foldEnvChar(ch))) * 0x100000001B3;
+  }
+
+  return static_cast<size_t>(hash);
+}
+
+bool EnvSnapshot::NameEqual::operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, char b) {
+    return ::foldEnvChar(a) == ::foldEnvChar(b);
+  });
+}
@@ -9,6 +9,8 @@
 #include <windows.h>
 #include <ioapiset.h>
 
+#include <utility>
+
 #include "sailc/common/cstring.hpp"
 #include "sailc/common/constants.hpp"
 
@@ -86,3 +88,106 @@ void internal::concatKeywordIdentifier(std::wstring& serviceName, const std::wst
   // See: https://learn.microsoft.com/en-us/windows/win32/api/wincred/ns-wincred-credential_attributew#members
   serviceName.append(1, delimiter).append(keyword);
 }
+
+
+// Impl. MappedFile
+internal::MappedFile::~MappedFile() {
+  Close();
+}
+
+internal::MappedFile::MappedFile(internal::MappedFile&& other) noexcept
+  : m_file(std::exchange(other.m_file, nullptr)), m_mapping(std::exchange(other.m_mapping, nullptr)),
+    m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) { };
+
+internal::MappedFile& internal::MappedFile::operator=(internal::MappedFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    m_file = std::exchange(other.m_file, nullptr);
+    m_mapping = std::exchange(other.m_mapping, nullptr);
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+  }
+
+  return *this;
+}
+
+bool internal::MappedFile::TryOpen(const std::filesystem::path& fp, std::string& errorMessage) {
+  Close();
+
+  // Refuse in-place writes while mapped but allow the file to be replaced by rename
+  HANDLE file = CreateFileW(
+    fp.c_str(),
+    GENERIC_READ,
+    FILE_SHARE_READ | FILE_SHARE_DELETE,
+    NULL,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+    NULL
+  );
+
+  if (file == INVALID_HANDLE_VALUE) {
+    errorMessage = internal::getErrorMessage(GetLastError());
+    return false;
+  }
+  m_file = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    errorMessage = internal::getErrorMessage(GetLastError());
+    Close();
+    return false;
+  }
+
+  // Empty file(s) can't be mapped
+  m_size = static_cast<size_t>(size.QuadPart);
+  if (m_size < 1) {
+    return true;
+  }
+
+  m_mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (m_mapping == NULL) {
+    errorMessage = internal::getErrorMessage(GetLastError());
+    Close();
+    return false;
+  }
+
+  m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_data == nullptr) {
+    errorMessage = internal::getErrorMessage(GetLastError());
+    Close();
+    return false;
+  }
+
+  return true;
+}
+
+void internal::MappedFile::Close() {
+  if (m_data != nullptr) {
+    UnmapViewOfFile(m_data);
+  }
+
+  if (m_mapping != nullptr) {
+    CloseHandle(m_mapping);
+  }
+
+  if (m_file != nullptr) {
+    CloseHandle(m_file);
+  }
+
+  m_file = nullptr;
+  m_mapping = nullptr;
+  m_data = nullptr;
+  m_size = 0;
+}
+
+bool internal::MappedFile::IsOpen() const {
+  return m_file != nullptr;
+}
+
+std::string_view internal::MappedFile::View() const {
+  if (m_data == nullptr) {
+    return std::string_view();
+  }
+
+  return std::string_view(m_data, m_size);
+}
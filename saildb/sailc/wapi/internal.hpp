@@ -2,7 +2,10 @@
 
 #include <string>
 #include <chrono>
+#include <memory>
 #include <cstdint>
+#include <string_view>
+#include <filesystem>
 
 namespace saildb {
 namespace wapi {
@@ -18,6 +21,40 @@ std::wstring getKeywordIdentifier(const std::wstring& serviceName, const std::ws
 
 void concatKeywordIdentifier(std::wstring& serviceName, const std::wstring_view& keyword, wchar_t separator = L'_');
 
+// Read-only view of a file mapped into memory, unmapped on destruction
+//
+//  - Windows denies write(s) to the file for as long as it's mapped
+//  - POSIX has no such share mode; the file is only mapped if it can't be modified in place,
+//    i.e. it's immutable or on a read-only mount, and is otherwise read into an owned buffer
+class MappedFile {
+  public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+  public:
+    bool TryOpen(const std::filesystem::path& fp, std::string& errorMessage);
+    void Close();
+
+    bool IsOpen() const;
+    std::string_view View() const;
+
+  private:
+#ifdef _WIN32
+    void* m_file{nullptr};
+    void* m_mapping{nullptr};
+#else
+    int m_file{-1};
+    std::unique_ptr<char[]> m_buffer;
+#endif
+    const char* m_data{nullptr};
+    size_t m_size{0};
+};
+
 } // namespace internal
 } // namespace wapi
 } // namespace saildb
@@ -0,0 +1,181 @@
+#include "internal.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statvfs.h>
+
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#endif
+
+#include <cerrno>
+#include <utility>
+#include <system_error>
+
+#include "sailc/common/constants.hpp"
+
+namespace internal = saildb::wapi::internal;
+namespace constants = saildb::constants;
+
+std::chrono::system_clock::time_point internal::filetime2timepoint(const int32_t& highWord, const int32_t& lowWord) {
+  std::chrono::file_clock::duration duration{(static_cast<int64_t>(highWord) << 32) | lowWord};
+  duration = constants::FILETIME_EPOCH + duration;
+
+  std::chrono::system_clock::time_point timepoint;
+  return timepoint;
+}
+
+int32_t internal::convertNtStatusToWin32Error(int32_t ntstatus) {
+  // No NTSTATUS on POSIX; status code(s) passed here are already `errno` value(s)
+  return ntstatus;
+}
+
+std::string internal::getErrorMessage(const uint32_t& errorCode, [[maybe_unused]] int16_t languageId /*= 0*/) {
+  const std::string result = std::system_category().message(static_cast<int>(errorCode));
+  if (result.empty()) {
+    return "Unknown error occurred with error code: " + std::to_string(errorCode);
+  }
+
+  return result;
+}
+
+std::wstring internal::getKeywordIdentifier(const std::wstring& serviceName, const std::wstring_view& keyword, wchar_t delimiter) {
+  std::wstring result(serviceName.data(), serviceName.size());
+  result.append(1, delimiter);
+  result.append(keyword);
+
+  return result;
+}
+
+void internal::concatKeywordIdentifier(std::wstring& serviceName, const std::wstring_view& keyword, wchar_t delimiter) {
+  serviceName.append(1, delimiter).append(keyword);
+}
+
+
+// Whether the file's content can't change beneath a mapping of it, i.e. it's on a read-only mount or immutable
+bool isUnmodifiable(int file) {
+  struct statvfs volume;
+  if (fstatvfs(file, &volume) == 0 && (volume.f_flag & ST_RDONLY)) {
+    return true;
+  }
+
+#ifdef __linux__
+  int attributes = 0;
+  if (ioctl(file, FS_IOC_GETFLAGS, &attributes) == 0 && (attributes & FS_IMMUTABLE_FL)) {
+    return true;
+  }
+#endif
+
+  return false;
+}
+
+
+// Impl. MappedFile
+internal::MappedFile::~MappedFile() {
+  Close();
+}
+
+internal::MappedFile::MappedFile(internal::MappedFile&& other) noexcept
+  : m_file(std::exchange(other.m_file, -1)), m_buffer(std::move(other.m_buffer)),
+    m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)) { };
+
+internal::MappedFile& internal::MappedFile::operator=(internal::MappedFile&& other) noexcept {
+  if (this != &other) {
+    Close();
+    m_file = std::exchange(other.m_file, -1);
+    m_buffer = std::move(other.m_buffer);
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+  }
+
+  return *this;
+}
+
+bool internal::MappedFile::TryOpen(const std::filesystem::path& fp, std::string& errorMessage) {
+  Close();
+
+  // The view outlives a rename over the file, as with `FILE_SHARE_DELETE`
+  int file = open(fp.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file < 0) {
+    errorMessage = internal::getErrorMessage(errno);
+    return false;
+  }
+  m_file = file;
+
+  struct stat info;
+  if (fstat(file, &info) != 0) {
+    errorMessage = internal::getErrorMessage(errno);
+    Close();
+    return false;
+  }
+
+  // Empty file(s) can't be mapped
+  m_size = static_cast<size_t>(info.st_size);
+  if (m_size < 1) {
+    return true;
+  }
+
+  // A writer could otherwise change the view(s) handed out from beneath us, or raise SIGBUS by truncating the file
+  if (::isUnmodifiable(file)) {
+    void* view = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (view != MAP_FAILED) {
+      m_data = static_cast<const char*>(view);
+      posix_madvise(view, m_size, POSIX_MADV_SEQUENTIAL);
+      return true;
+    }
+  }
+
+  m_buffer = std::make_unique_for_overwrite<char[]>(m_size);
+
+  size_t length = 0;
+  while (length < m_size) {
+    const ssize_t count = pread(file, m_buffer.get() + length, m_size - length, static_cast<off_t>(length));
+    if (count < 0 && errno == EINTR) {
+      continue;
+    } else if (count < 0) {
+      errorMessage = internal::getErrorMessage(errno);
+      Close();
+      return false;
+    } else if (count == 0) {
+      // Truncated since `fstat`
+      break;
+    }
+
+    length += static_cast<size_t>(count);
+  }
+
+  m_data = m_buffer.get();
+  m_size = length;
+
+  return true;
+}
+
+void internal::MappedFile::Close() {
+  if (m_data != nullptr && m_buffer == nullptr) {
+    munmap(const_cast<char*>(m_data), m_size);
+  }
+
+  if (m_file >= 0) {
+    close(m_file);
+  }
+
+  m_file = -1;
+  m_buffer.reset();
+  m_data = nullptr;
+  m_size = 0;
+}
+
+bool internal::MappedFile::IsOpen() const {
+  return m_file >= 0;
+}
+
+std::string_view internal::MappedFile::View() const {
+  if (m_data == nullptr) {
+    return std::string_view();
+  }
+
+  return std::string_view(m_data, m_size);
+}
@@ -0,0 +1,140 @@
+#include "wapi.hpp"
+
+#include <pwd.h>
+#include <unistd.h>
+#include <sys/utsname.h>
+#if defined(__linux__)
+#include <shadow.h>
+#endif
+
+#include <cerrno>
+#include <vector>
+#include <system_error>
+
+#include "sailc/wapi/internal.hpp"
+
+
+namespace wapi = saildb::wapi;
+namespace common = saildb::common;
+
+
+
+/************************************************************
+ *                                                          *
+ *                          Utils                           *
+ *                                                          *
+ ************************************************************/
+bool tryGetPasswdEntry(struct passwd& entry, std::vector<char>& buf, std::string& errorMessage) {
+  long bufLen = sysconf(_SC_GETPW_R_SIZE_MAX);
+  buf.resize(bufLen > 0 ? static_cast<size_t>(bufLen) : 1024);
+
+  struct passwd* result = nullptr;
+  int status;
+  while ((status = getpwuid_r(geteuid(), &entry, buf.data(), buf.size(), &result)) == ERANGE) {
+    buf.resize(buf.size() * 2);
+  }
+
+  if (result == nullptr) {
+    errorMessage = status != 0
+      ? wapi::internal::getErrorMessage(status)
+      : std::string("Failed to find a passwd entry for the effective user");
+    return false;
+  }
+
+  return true;
+}
+
+bool tryGetNodeName(std::string& nodeName, std::string& errorMessage) {
+  struct utsname info;
+  if (uname(&info) != 0) {
+    errorMessage = wapi::internal::getErrorMessage(errno);
+    return false;
+  }
+
+  nodeName = info.nodename;
+  return true;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                     Users & Sessions                     *
+ *                                                          *
+ ************************************************************/
+
+bool wapi::tryGetUsername(std::string& username, std::string& errorMessage) {
+  struct passwd entry;
+  std::vector<char> buf;
+  if (!::tryGetPasswdEntry(entry, buf, errorMessage)) {
+    return false;
+  }
+
+  username = entry.pw_name;
+  return true;
+}
+
+bool wapi::tryGetDomainStatus(bool& isDomain, [[maybe_unused]] std::string& errorMessage) {
+  // Directory membership (e.g. sssd, winbind) isn't exposed through a portable API;
+  // the host is treated as its own domain, as with a non-domain joined Windows host
+  isDomain = false;
+  return true;
+}
+
+bool wapi::tryGetUsernameAndDomain(std::string& username, std::string& domain, std::string& errorMessage) {
+  if (!tryGetUsername(username, errorMessage)) {
+    return false;
+  }
+
+  return ::tryGetNodeName(domain, errorMessage);
+}
+
+bool wapi::tryGetPasswordChangedTimepoint(std::chrono::system_clock::time_point& timepoint, std::string& errorMessage) {
+  errorMessage.clear();
+
+#if defined(__linux__)
+  std::string username;
+  if (!tryGetUsername(username, errorMessage)) {
+    return false;
+  }
+
+  // Readable by privileged user(s) only; `sp_lstchg` is in days since the epoch
+  struct spwd record;
+  struct spwd* entry = nullptr;
+  std::vector<char> buf(1024);
+
+  int status;
+  while ((status = getspnam_r(username.c_str(), &record, buf.data(), buf.size(), &entry)) == ERANGE) {
+    buf.resize(buf.size() * 2);
+  }
+
+  if (entry == nullptr || entry->sp_lstchg < 0) {
+    errorMessage = status != 0
+      ? wapi::internal::getErrorMessage(status)
+      : std::string("Failed to find the password change date of user '").append(username).append("'");
+    return false;
+  }
+
+  timepoint = std::chrono::system_clock::time_point(std::chrono::days(entry->sp_lstchg));
+  return true;
+#else
+  errorMessage = "Password change date is unavailable on this platform";
+  return false;
+#endif
+}
+
+bool wapi::tryGetSessionInfo(common::Session& session, std::string& errorMessage) {
+  errorMessage.clear();
+
+  if (!tryGetUsernameAndDomain(session.username, session.domainName, errorMessage)) {
+    return false;
+  }
+
+  // Optional; the shadow database is unreadable to most user(s)
+  std::string shadowError;
+  if (!tryGetPasswordChangedTimepoint(session.lastSet, shadowError)) {
+    session.lastSet = std::chrono::system_clock::time_point();
+  }
+
+  return true;
+}
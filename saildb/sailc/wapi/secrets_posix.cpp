@@ -0,0 +1,101 @@
+#include "wapi.hpp"
+
+namespace wapi = saildb::wapi;
+namespace common = saildb::common;
+
+
+
+/************************************************************
+ *                                                          *
+ *                       Credentials                        *
+ *                                                          *
+ ************************************************************/
+
+// Secrets are held by the Windows Credential Manager, which has no portable equivalent;
+// every operation fails with the same error on other platform(s)
+static constexpr const char* UNSUPPORTED_MESSAGE = "Secret storage requires the Windows Credential Manager & is unavailable on this platform";
+
+#pragma region wapi_cred_impl
+
+bool wapi::hasSecret(
+  [[maybe_unused]] const std::string& label,
+  [[maybe_unused]] const std::string& account,
+  [[maybe_unused]] const std::string& datasource,
+  bool& hasSecret,
+  std::string& errorMessage
+) {
+  hasSecret = false;
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::hasAnySecrets([[maybe_unused]] const std::string& label, bool& hasSecrets, std::string& errorMessage) {
+  hasSecrets = false;
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::hasAnySecrets([[maybe_unused]] const std::string& label, [[maybe_unused]] const std::string& datasource, bool& hasSecrets, std::string& errorMessage) {
+  hasSecrets = false;
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::tryListSecrets([[maybe_unused]] const std::string& label, [[maybe_unused]] std::vector<common::Secret>& secrets, std::string& errorMessage) {
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::tryListSecrets([[maybe_unused]] const std::string& label, [[maybe_unused]] const std::string& datasource, [[maybe_unused]] std::vector<common::Secret>& secrets, std::string& errorMessage) {
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::tryCompareSecret(
+  [[maybe_unused]] const std::string& label,
+  [[maybe_unused]] const std::string& account,
+  [[maybe_unused]] const std::string& datasource,
+  [[maybe_unused]] const std::string& secret,
+  bool& isEqual,
+  std::string& errorMessage
+) {
+  isEqual = false;
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::tryGetSecret(
+  [[maybe_unused]] const std::string& label,
+  [[maybe_unused]] const std::string& account,
+  [[maybe_unused]] const std::string& datasource,
+  [[maybe_unused]] std::string& secret,
+  std::string& errorMessage
+) {
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::tryDeleteSecret(
+  [[maybe_unused]] const std::string& label,
+  [[maybe_unused]] const std::string& account,
+  [[maybe_unused]] const std::string& datasource,
+  std::string& errorMessage
+) {
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+bool wapi::tryStoreSecret(
+  [[maybe_unused]] const std::string& label,
+  [[maybe_unused]] const std::string& username,
+  [[maybe_unused]] const std::string& account,
+  [[maybe_unused]] const std::string& datasource,
+  [[maybe_unused]] const std::string& secret,
+  [[maybe_unused]] bool isUserAccount,
+  std::string& errorMessage
+) {
+  errorMessage = UNSUPPORTED_MESSAGE;
+  return false;
+}
+
+#pragma endregion
@@ -0,0 +1,223 @@
+#include "structural.hpp"
+
+#include <bit>
+#include <array>
+#include <cstring>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SAILDB_STRUCTURAL_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(SAILDB_STRUCTURAL_X86) && !defined(_MSC_VER)
+#define SAILDB_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define SAILDB_TARGET_AVX2
+#endif
+
+namespace internal = saildb::wapi::internal;
+
+using StructuralIndex = internal::StructuralIndex;
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Kernels                          *
+ *                                                          *
+ ************************************************************/
+
+static constexpr const size_t BLOCK_SIZE = 64;
+static constexpr const char CLASS_CHARS[] = { '\n', '\r', '=', '#', '\'', '\"', '`', '$', '\\' };
+static constexpr const size_t CLASS_INDICES[] = { 0, 1, 2, 3, 4, 4, 4, 5, 6 };
+
+static constexpr auto CLASS_TABLE = []() {
+  std::array<uint8_t, 256> table{};
+  for (size_t i = 0; i < std::size(CLASS_CHARS); ++i) {
+    table[static_cast<uint8_t>(CLASS_CHARS[i])] = static_cast<uint8_t>(0x1 << CLASS_INDICES[i]);
+  }
+
+  return table;
+}();
+
+
+#ifdef SAILDB_STRUCTURAL_X86
+// SSE2
+inline uint64_t matchSse2(const __m128i* lanes, char ch) {
+  const __m128i needle = _mm_set1_epi8(ch);
+
+  uint64_t result = 0;
+  for (size_t i = 0; i < 4; ++i) {
+    const uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(lanes[i], needle)));
+    result |= static_cast<uint64_t>(bits) << (i * 16);
+  }
+
+  return result;
+}
+
+void scanBlockSse2(const char* block, uint64_t* masks) {
+  const __m128i lanes[4] = {
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)),
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16)),
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32)),
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48)),
+  };
+
+  for (size_t i = 0; i < std::size(CLASS_CHARS); ++i) {
+    masks[CLASS_INDICES[i]] |= ::matchSse2(lanes, CLASS_CHARS[i]);
+  }
+}
+
+
+// AVX2
+SAILDB_TARGET_AVX2 inline uint64_t matchAvx2(const __m256i& lo, const __m256i& hi, char ch) {
+  const __m256i needle = _mm256_set1_epi8(ch);
+  const uint32_t loBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+  const uint32_t hiBits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+
+  return static_cast<uint64_t>(loBits) | (static_cast<uint64_t>(hiBits) << 32);
+}
+
+SAILDB_TARGET_AVX2 void scanBlockAvx2(const char* block, uint64_t* masks) {
+  const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+  for (size_t i = 0; i < std::size(CLASS_CHARS); ++i) {
+    masks[CLASS_INDICES[i]] |= ::matchAvx2(lo, hi, CLASS_CHARS[i]);
+  }
+}
+
+
+// CPU features
+bool hasAvx2Support() {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) {
+    return false;
+  }
+
+  // Requires OS support for saving the YMM register(s)
+  __cpuid(info, 1);
+  const bool hasOsxSave = (info[2] & (0x1 << 27)) != 0;
+  const bool hasAvx = (info[2] & (0x1 << 28)) != 0;
+  if (!hasOsxSave || !hasAvx || (_xgetbv(0) & 0x6) != 0x6) {
+    return false;
+  }
+
+  __cpuidex(info, 7, 0);
+  return (info[1] & (0x1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+
+
+
+/************************************************************
+ *                                                          *
+ *                     StructuralIndex                      *
+ *                                                          *
+ ************************************************************/
+
+// Impl. StructuralIndex
+StructuralIndex::StructuralIndex(std::string_view buffer, StructuralIndex::Kernel kernel /*= Kernel::Auto*/)
+  : m_buffer(buffer), m_kernel(kernel), m_block(std::numeric_limits<size_t>::max())
+{
+  if (m_kernel == Kernel::Auto) {
+    m_kernel = StructuralIndex::GetPreferredKernel();
+  }
+
+  switch (m_kernel) {
+#ifdef SAILDB_STRUCTURAL_X86
+    case Kernel::Avx2:
+      m_scan = ::scanBlockAvx2;
+      break;
+    case Kernel::Sse2:
+      m_scan = ::scanBlockSse2;
+      break;
+#endif
+    default:
+      m_kernel = Kernel::Scalar;
+      m_scan = nullptr;
+      break;
+  }
+}
+
+
+/* Static impl. */
+StructuralIndex::Kernel StructuralIndex::GetPreferredKernel() {
+#ifdef SAILDB_STRUCTURAL_X86
+  static const Kernel kernel = ::hasAvx2Support() ? Kernel::Avx2 : Kernel::Sse2;
+  return kernel;
+#else
+  return Kernel::Scalar;
+#endif
+}
+
+
+/* Public impl. */
+StructuralIndex::Kernel StructuralIndex::GetKernel() const {
+  return m_kernel;
+}
+
+size_t StructuralIndex::Next(size_t offset, uint8_t classes) {
+  const size_t size = m_buffer.size();
+
+  // Building the bitmaps of a block a byte at a time costs more than the seek(s) they save
+  if (m_kernel == Kernel::Scalar) {
+    for (; offset < size; ++offset) {
+      if ((CLASS_TABLE[static_cast<uint8_t>(m_buffer[offset])] & classes) != 0) {
+        return offset;
+      }
+    }
+
+    return size;
+  }
+
+  while (offset < size) {
+    const size_t block = offset / BLOCK_SIZE;
+    if (block != m_block) {
+      loadBlock(block);
+    }
+
+    uint64_t bits = 0;
+    for (uint8_t cls = classes; cls != 0; cls &= (cls - 1)) {
+      bits |= m_masks[std::countr_zero(cls)];
+    }
+
+    bits &= (~uint64_t{0} << (offset % BLOCK_SIZE));
+    if (bits != 0) {
+      return block * BLOCK_SIZE + std::countr_zero(bits);
+    }
+
+    offset = (block + 1) * BLOCK_SIZE;
+  }
+
+  return size;
+}
+
+
+/* Private impl. */
+void StructuralIndex::loadBlock(size_t block) {
+  std::memset(m_masks, 0, sizeof(m_masks));
+  m_block = block;
+
+  const size_t offset = block * BLOCK_SIZE;
+  const size_t length = m_buffer.size() - offset;
+  if (length >= BLOCK_SIZE) {
+    m_scan(m_buffer.data() + offset, m_masks);
+    return;
+  }
+
+  // Pad the trailing block, NUL isn't a member of any class
+  char padded[BLOCK_SIZE]{};
+  std::memcpy(padded, m_buffer.data() + offset, length);
+  m_scan(padded, m_masks);
+}
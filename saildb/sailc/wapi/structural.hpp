@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace saildb {
+namespace wapi {
+namespace internal {
+
+/*
+ * Lazily computes per-64-byte block bitmaps of the characters the DotEnv
+ * parser branches on, so that it can skip over runs of ordinary bytes
+ *
+ *  - Blocks are classified with AVX2 or SSE2 compares where available; the kernel is
+ *    selected at runtime
+ *  - Without a vector kernel, i.e. `Kernel::Scalar`, no bitmaps are built & `Next` seeks
+ *    a byte at a time, as the parser did prior to the index
+ *
+ */
+class StructuralIndex {
+  public:
+    // Character classes
+    static constexpr const uint8_t NEWLINE         = 0x1 << 0; // `\n`
+    static constexpr const uint8_t CARRIAGE_RETURN = 0x1 << 1; // `\r`
+    static constexpr const uint8_t ASSIGN          = 0x1 << 2; // `=`
+    static constexpr const uint8_t COMMENT         = 0x1 << 3; // `#`
+    static constexpr const uint8_t QUOTE           = 0x1 << 4; // `'`, `"` & `\``
+    static constexpr const uint8_t DOLLAR          = 0x1 << 5; // `$`
+    static constexpr const uint8_t ESCAPE          = 0x1 << 6; // `\`
+    static constexpr const size_t CLASS_COUNT      = 7;
+
+    enum class Kernel : uint8_t {
+      Auto,
+      Scalar,
+      Sse2,
+      Avx2
+    };
+
+  public:
+    explicit StructuralIndex(std::string_view buffer, Kernel kernel = Kernel::Auto);
+
+    static Kernel GetPreferredKernel();
+
+  public:
+    Kernel GetKernel() const;
+
+    // Offset of the first char at or after `offset` in any of `classes`, or the buffer size if none
+    size_t Next(size_t offset, uint8_t classes);
+
+  private:
+    using ScanFn = void (*)(const char* block, uint64_t* masks);
+
+    void loadBlock(size_t block);
+
+  private:
+    std::string_view m_buffer;
+    Kernel m_kernel;
+    ScanFn m_scan;
+    size_t m_block;
+    uint64_t m_masks[CLASS_COUNT]{};
+};
+
+} // namespace internal
+} // namespace wapi
+} // namespace saildb
@@ -0,0 +1,106 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <string>
+#include <fstream>
+#include <sstream>
+
+#include "sailc/wapi/structural.hpp"
+
+using StructuralIndex = saildb::wapi::internal::StructuralIndex;
+
+namespace {
+
+constexpr const int64_t FIXTURE_COPIES = 2000;
+
+// Class(es) sought by the parser, i.e. line ends only & every delimiter of an unquoted value
+constexpr const int64_t LINE_CLASSES = StructuralIndex::NEWLINE;
+constexpr const int64_t VALUE_CLASSES = (
+  StructuralIndex::NEWLINE | StructuralIndex::CARRIAGE_RETURN | StructuralIndex::COMMENT |
+  StructuralIndex::QUOTE | StructuralIndex::DOLLAR | StructuralIndex::ESCAPE
+);
+
+// Fixture concatenated `FIXTURE_COPIES` time(s)
+const std::string& getScaledFixture() {
+  static const std::string scaled = []() {
+    std::ifstream input("resources/.saildb.env", std::ios::binary);
+    std::ostringstream source;
+    source << input.rdbuf();
+
+    std::string result;
+    for (int64_t i = 0; i < FIXTURE_COPIES; ++i) {
+      result.append(source.str()).push_back('\n');
+    }
+
+    return result;
+  }();
+
+  return scaled;
+}
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                        Benchmarks                        *
+ *                                                          *
+ ************************************************************/
+
+// Char-at-a-time seek of the parser prior to the structural index, with the same stop(s) as `Next`
+void BM_ByteScan(benchmark::State& state) {
+  const std::string& buffer = ::getScaledFixture();
+  const uint8_t classes = static_cast<uint8_t>(state.range(0));
+
+  std::array<uint8_t, 256> table{};
+  table['\n'] = StructuralIndex::NEWLINE;
+  table['\r'] = StructuralIndex::CARRIAGE_RETURN;
+  table['='] = StructuralIndex::ASSIGN;
+  table['#'] = StructuralIndex::COMMENT;
+  table['\''] = table['\"'] = table['`'] = StructuralIndex::QUOTE;
+  table['$'] = StructuralIndex::DOLLAR;
+  table['\\'] = StructuralIndex::ESCAPE;
+
+  for (auto _ : state) {
+    size_t count = 0;
+    for (size_t offset = 0; offset < buffer.size(); ++offset) {
+      if (table[static_cast<uint8_t>(buffer[offset])] & classes) {
+        count++;
+        benchmark::DoNotOptimize(offset);
+      }
+    }
+
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+
+template <StructuralIndex::Kernel K>
+void BM_StructuralScan(benchmark::State& state) {
+  const std::string& buffer = ::getScaledFixture();
+  const uint8_t classes = static_cast<uint8_t>(state.range(0));
+  if (StructuralIndex(buffer, K).GetKernel() != K || (K == StructuralIndex::Kernel::Avx2 && StructuralIndex::GetPreferredKernel() != K)) {
+    state.SkipWithError("Kernel isn't available");
+    return;
+  }
+
+  for (auto _ : state) {
+    StructuralIndex index(buffer, K);
+
+    size_t count = 0;
+    for (size_t offset = index.Next(0, classes); offset < buffer.size(); offset = index.Next(offset + 1, classes)) {
+      count++;
+    }
+
+    benchmark::DoNotOptimize(count);
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+
+BENCHMARK(BM_ByteScan)->Arg(LINE_CLASSES)->Arg(VALUE_CLASSES);
+BENCHMARK_TEMPLATE(BM_StructuralScan, StructuralIndex::Kernel::Scalar)->Arg(LINE_CLASSES)->Arg(VALUE_CLASSES);
+BENCHMARK_TEMPLATE(BM_StructuralScan, StructuralIndex::Kernel::Sse2)->Arg(LINE_CLASSES)->Arg(VALUE_CLASSES);
+BENCHMARK_TEMPLATE(BM_StructuralScan, StructuralIndex::Kernel::Avx2)->Arg(LINE_CLASSES)->Arg(VALUE_CLASSES);
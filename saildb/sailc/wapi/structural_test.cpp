@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "sailc/wapi/structural.hpp"
+
+using StructuralIndex = saildb::wapi::internal::StructuralIndex;
+
+namespace {
+
+constexpr const uint8_t CLASSES[] = {
+  StructuralIndex::NEWLINE,
+  StructuralIndex::CARRIAGE_RETURN,
+  StructuralIndex::ASSIGN,
+  StructuralIndex::COMMENT,
+  StructuralIndex::QUOTE,
+  StructuralIndex::DOLLAR,
+  StructuralIndex::ESCAPE,
+};
+
+// Byte-at-a-time reference of the class(es) of `ch`
+uint8_t classify(char ch) {
+  switch (ch) {
+    case '\n': return StructuralIndex::NEWLINE;
+    case '\r': return StructuralIndex::CARRIAGE_RETURN;
+    case '=':  return StructuralIndex::ASSIGN;
+    case '#':  return StructuralIndex::COMMENT;
+    case '\'':
+    case '\"':
+    case '`':  return StructuralIndex::QUOTE;
+    case '$':  return StructuralIndex::DOLLAR;
+    case '\\': return StructuralIndex::ESCAPE;
+    default:   return 0;
+  }
+}
+
+// Offset(s) of every char in `classes`, as found by walking the index
+std::vector<size_t> collect(std::string_view buffer, StructuralIndex::Kernel kernel, uint8_t classes) {
+  StructuralIndex index(buffer, kernel);
+
+  std::vector<size_t> offsets;
+  for (size_t offset = index.Next(0, classes); offset < buffer.size(); offset = index.Next(offset + 1, classes)) {
+    offsets.push_back(offset);
+  }
+
+  return offsets;
+}
+
+std::vector<size_t> collectReference(std::string_view buffer, uint8_t classes) {
+  std::vector<size_t> offsets;
+  for (size_t i = 0; i < buffer.size(); ++i) {
+    if (::classify(buffer[i]) & classes) {
+      offsets.push_back(i);
+    }
+  }
+
+  return offsets;
+}
+
+// Random buffer(s) dense in structural char(s), incl. NUL(s) & byte(s) above 0x7F
+std::vector<std::string> makeBuffers() {
+  static constexpr const char ALPHABET[] = "\n\r=#'\"`$\\ aZ_9\t{}";
+
+  std::mt19937 rng(0x5A11DB);
+  std::uniform_int_distribution<int> pick(0, 3);
+  std::uniform_int_distribution<size_t> symbol(0, sizeof(ALPHABET) - 2);
+  std::uniform_int_distribution<int> byte(0, 255);
+
+  std::vector<std::string> buffers;
+  for (size_t size : { 0, 1, 63, 64, 65, 127, 128, 129, 1000, 4096, 65537 }) {
+    std::string buffer(size, '\0');
+    for (char& ch : buffer) {
+      ch = pick(rng) == 0 ? static_cast<char>(byte(rng)) : ALPHABET[symbol(rng)];
+    }
+
+    buffers.push_back(std::move(buffer));
+  }
+
+  return buffers;
+}
+
+class StructuralKernelTest : public ::testing::TestWithParam<StructuralIndex::Kernel> {
+  protected:
+    void SetUp() override {
+      if (StructuralIndex(std::string_view(), GetParam()).GetKernel() != GetParam()) {
+        GTEST_SKIP() << "Kernel isn't available on this target";
+      }
+
+      if (GetParam() == StructuralIndex::Kernel::Avx2 && StructuralIndex::GetPreferredKernel() != StructuralIndex::Kernel::Avx2) {
+        GTEST_SKIP() << "CPU doesn't support AVX2";
+      }
+    }
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Kernels                          *
+ *                                                          *
+ ************************************************************/
+
+TEST_P(StructuralKernelTest, MatchesReferenceOnRandomInput) {
+  for (const std::string& buffer : ::makeBuffers()) {
+    for (uint8_t cls : CLASSES) {
+      EXPECT_EQ(::collect(buffer, GetParam(), cls), ::collectReference(buffer, cls))
+        << "size " << buffer.size() << ", class " << static_cast<int>(cls);
+    }
+
+    const uint8_t all = 0x7F;
+    EXPECT_EQ(::collect(buffer, GetParam(), all), ::collectReference(buffer, all)) << "size " << buffer.size();
+  }
+}
+
+TEST_P(StructuralKernelTest, MatchesScalarKernel) {
+  for (const std::string& buffer : ::makeBuffers()) {
+    for (uint8_t classes = 1; classes < 0x80; ++classes) {
+      ASSERT_EQ(::collect(buffer, GetParam(), classes), ::collect(buffer, StructuralIndex::Kernel::Scalar, classes))
+        << "size " << buffer.size() << ", classes " << static_cast<int>(classes);
+    }
+  }
+}
+
+TEST_P(StructuralKernelTest, SeeksBackwardAcrossBlocks) {
+  std::string buffer(256, 'a');
+  buffer[10] = '=';
+  buffer[200] = '#';
+
+  StructuralIndex index(buffer, GetParam());
+  EXPECT_EQ(index.Next(0, StructuralIndex::COMMENT), 200u);
+  EXPECT_EQ(index.Next(0, StructuralIndex::ASSIGN), 10u);
+  EXPECT_EQ(index.Next(11, StructuralIndex::ASSIGN), buffer.size());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+  Kernels,
+  StructuralKernelTest,
+  ::testing::Values(StructuralIndex::Kernel::Scalar, StructuralIndex::Kernel::Sse2, StructuralIndex::Kernel::Avx2),
+  [](const ::testing::TestParamInfo<StructuralIndex::Kernel>& info) -> std::string {
+    switch (info.param) {
+      case StructuralIndex::Kernel::Sse2: return "Sse2";
+      case StructuralIndex::Kernel::Avx2: return "Avx2";
+      default:                            return "Scalar";
+    }
+  }
+);
@@ -0,0 +1,62 @@
+#include "wapi.hpp"
+
+#include <cstdlib>
+
+extern char** environ;
+
+namespace wapi = saildb::wapi;
+namespace common = saildb::common;
+
+
+
+/************************************************************
+ *                                                          *
+ *                           Sys                            *
+ *                                                          *
+ ************************************************************/
+
+bool wapi::tryGetEnvVar(const std::string& varName, std::string &result) {
+  const char* value = std::getenv(varName.c_str());
+  if (value == nullptr) {
+    return false;
+  }
+
+  result.assign(value);
+  return true;
+}
+
+bool wapi::tryGetEnvVar(const std::wstring& varName, std::wstring &result) {
+  std::string res;
+  if (wapi::tryGetEnvVar(common::wstr2str(varName), res)) {
+    common::str2wstr(res, result);
+    return true;
+  }
+
+  return false;
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                       EnvSnapshot                        *
+ *                                                          *
+ ************************************************************/
+
+using EnvSnapshot = wapi::EnvSnapshot;
+
+
+/* Static impl. */
+std::shared_ptr<const EnvSnapshot> EnvSnapshot::Capture() {
+  auto snapshot = std::shared_ptr<EnvSnapshot>(new EnvSnapshot());
+
+  // `environ` is a NULL terminated array of `NAME=VALUE` string(s), already narrow
+  if (environ != nullptr) {
+    for (char** it = environ; *it != nullptr; ++it) {
+      snapshot->m_block.append(*it).push_back('\0');
+    }
+  }
+
+  snapshot->indexBlock();
+  return snapshot;
+}
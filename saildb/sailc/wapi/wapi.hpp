@@ -1,19 +1,32 @@
 #pragma once
 
 #include "sailc/common/data.hpp"
+#include "sailc/common/coerce.hpp"
 #include "sailc/common/typing.hpp"
 #include "sailc/common/cstring.hpp"
 #include "sailc/common/strutil.hpp"
 
 #include <ios>
+#include <bit>
+#include <cmath>
+#include <atomic>
+#include <limits>
+#include <utility>
 #include <vector>
 #include <chrono>
+#include <memory>
 #include <string>
 #include <sstream>
-#include <cwctype>
+#include <cctype>
 #include <cstddef>
+#include <algorithm>
+#include <string_view>
 #include <stdexcept>
+#include <type_traits>
+#include <mutex>
+#include <thread>
 #include <filesystem>
+#include <functional>
 #include <unordered_map>
 
 namespace common = saildb::common;
@@ -107,11 +120,61 @@ bool tryStoreSecret(
 bool tryGetEnvVar(const std::string& varName, std::string &result);
 bool tryGetEnvVar(const std::wstring& varName, std::wstring &result);
 
+/*
+ * Immutable, hashed copy of the process' environment block
+ *
+ *  - Lookups are served from the copy & are therefore consistent, regardless
+ *    of whether the environment is mutated by other thread(s) once captured
+ *  - Names are compared case-insensitively on Windows, as with `GetEnvironmentVariableW`,
+ *    & case-sensitively elsewhere, as with `getenv`
+ *
+ */
+class EnvSnapshot {
+  public:
+    EnvSnapshot(const EnvSnapshot&) = delete;
+    EnvSnapshot& operator=(const EnvSnapshot&) = delete;
+
+    // Captures a new snapshot of the environment block
+    static std::shared_ptr<const EnvSnapshot> Capture();
+
+    // Process-wide snapshot, captured on first use & reused until invalidated
+    static std::shared_ptr<const EnvSnapshot> GetShared();
+    static void InvalidateShared();
+
+  public:
+    size_t Size() const;
+    bool Contains(std::string_view name) const;
+    bool TryGet(std::string_view name, std::string_view& value) const;
+
+  private:
+    EnvSnapshot() = default;
+
+    void indexBlock();
+
+    struct NameHash {
+      size_t operator()(std::string_view name) const noexcept;
+    };
+
+    struct NameEqual {
+      bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+    };
+
+  private:
+    // UTF-8 `NAME=VALUE` pair(s), each NUL terminated, viewed by `m_variables`
+    std::string m_block;
+    std::unordered_map<std::string_view, std::string_view, NameHash, NameEqual> m_variables;
+};
+
 class DotEnv {
   public:
     // Flags
     static constexpr const uint8_t NO_CHECK_EXT   = 0x1 << 0; // Don't enforce `.env` file ext
     static constexpr const uint8_t NO_INTERPOLATE = 0x1 << 1; // Don't interpolate vars from [ `$VAR` | `${VAR}` ]
+    static constexpr const uint8_t MEMORY_MAP     = 0x1 << 2; // Map the file into memory instead of reading it into a buffer, see `internal::MappedFile`
+    static constexpr const uint8_t LAZY_INTERP    = 0x1 << 3; // Defer interpolation of a value until it's first read
+    static constexpr const uint8_t SHARED_ENV     = 0x1 << 4; // Interpolate against the process-wide env snapshot rather than capturing one per load
+    static constexpr const uint8_t DIAGNOSTICS    = 0x1 << 5; // Record parse issue(s), see `GetDiagnostics`
+    static constexpr const uint8_t STRICT         = 0x1 << 6; // Throw on the first parse issue rather than dropping the line
 
     // Interpolation
     enum ExpansionExpr : uint8_t {
@@ -120,203 +183,536 @@ class DotEnv {
       SubstituteUnset
     };
 
-    struct InterpToken {
-      std::wstring name;
-      std::wstring defaultValue;
-      size_t start;
-      size_t end;
-      ExpansionExpr expr;
-
-      InterpToken(
-        std::wstring tName,
-        std::wstring tValue,
-        size_t tStart,
-        size_t tEnd,
-        ExpansionExpr tExpr
-      );
-
-      InterpToken() = default;
-      InterpToken(InterpToken&& other) = default;
-      InterpToken(const InterpToken& other) = default;
-      InterpToken& operator=(InterpToken& other) = default;
-      InterpToken& operator=(const InterpToken& other) = default;
+    struct Reference {
+      std::string_view name;
+      std::string_view defaultValue;
+      ExpansionExpr expr{ExpansionExpr::None};
+    };
+
+    // Diagnostics
+    enum class Issue : uint8_t {
+      MalformedAssignment, // Line without an assignment token, e.g. `KEY`
+      IllegalKey,          // Key that isn't a legal env var name, e.g. `1KEY=...`
+      UnclosedQuote,       // Quoted value left open at EOF
+      TrailingContent      // Content following a closing quote, e.g. `KEY="..." ...`
+    };
+
+    struct Diagnostic {
+      uint32_t line;
+      uint32_t column;
+      Issue issue;
+      uint32_t layer{0}; // Index of the file within a layered load, see `FromLayers`
     };
 
+    // Only the most recent issue(s) are retained
+    static constexpr const size_t DIAGNOSTIC_CAPACITY = 64;
+
   public:
     DotEnv();
     DotEnv(const std::string& fp, uint8_t flags = 0);
     DotEnv(const std::wstring& fp, uint8_t flags = 0);
     DotEnv(const std::filesystem::path& fp, uint8_t flags = 0);
+
+    // Loads the resolved entries of `fp` from its snapshot if it's still valid, otherwise parses `fp` & refreshes the snapshot
+    DotEnv(const std::filesystem::path& fp, const std::filesystem::path& snapshotFp, uint8_t flags = 0);
     ~DotEnv() = default;
 
     DotEnv(DotEnv const&) = default;
+    DotEnv(DotEnv&&) = default;
     DotEnv &operator=(DotEnv const&) = default;
     DotEnv &operator=(DotEnv&&) = default;
 
     static bool IsEnvFile(const std::filesystem::path& fp);
     static const std::wstring_view GetEnvExtension();
+    static std::string_view GetIssueName(Issue issue);
+
+    // Parses each layer in parallel & merges them in order, i.e. later layer(s) override earlier ones;
+    // reference(s) resolve against the merged entries & missing layer(s) are skipped. Diagnostics of
+    // every layer are retained in layer order, tagged by the layer's index
+    static DotEnv FromLayers(const std::vector<std::filesystem::path>& fps, uint8_t flags = 0);
 
   public:
     bool IsEmpty() const;
     uint8_t GetFlags() const;
 
+    // Whether the entries are served from a snapshot, see `DotEnv(fp, snapshotFp, flags)`
+    bool IsFromSnapshot() const;
+
+    // Retained issue(s) in the order they were found, and the total found incl. those overwritten
+    auto GetDiagnostics() const -> std::vector<Diagnostic>;
+    size_t GetDiagnosticCount() const;
+
+    // Writes the resolved entries to a binary snapshot, see `DotEnv(fp, snapshotFp, flags)`
+    bool TrySaveSnapshot(const std::filesystem::path& snapshotFp, std::string& errorMessage) const;
+
     template <typename T>
     auto Contains(const T& key) const -> bool;
 
     template <typename U, typename T>
     auto Get(const T& key) const -> U;
 
+    // Yields a copy of `defaultValue` if the key is missing or can't be coerced, i.e. never a reference
     template <typename U, typename T>
-    auto Get(const T& key, U&& defaultValue) const -> U;
+    auto Get(const T& key, U&& defaultValue) const -> std::remove_cvref_t<U>;
 
     template <typename T, typename U>
     auto TryGet(const T& key, U& value) const -> bool;
 
   private:
+    friend class DotEnvWatcher;
+
+    // Owns the source bytes & the arena of processed value(s)
+    struct Storage;
+
+    // Resolves a value's reference(s) & splices them into its literal text
+    struct Interpolator;
+
+    // Raw value of a lazily interpolated entry, i.e. its literal text & reference(s)
+    struct Template;
+
+    // Transparent key hashing, permitting lookup by narrow or wide key(s) without conversion;
+    // legal keys are ASCII-only so wide key(s) are compared per code unit
+    struct KeyHash {
+      using is_transparent = void;
+
+      size_t operator()(std::string_view key) const noexcept;
+      size_t operator()(std::wstring_view key) const noexcept;
+
+      template <typename CharT>
+      static size_t hash(const CharT* key, size_t length) noexcept;
+    };
+
+    struct KeyEqual {
+      using is_transparent = void;
+
+      bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+      bool operator()(std::string_view lhs, std::wstring_view rhs) const noexcept;
+      bool operator()(std::wstring_view lhs, std::string_view rhs) const noexcept;
+    };
+
+    // Value of an entry alongside its memoised coercion; only the first kind requested
+    // of an entry is cached, any other kind(s) are parsed on demand
+    struct Entry {
+      static constexpr const uint8_t KIND_BOOLEAN  = 0x1;
+      static constexpr const uint8_t KIND_SIGNED   = 0x2;
+      static constexpr const uint8_t KIND_UNSIGNED = 0x3;
+      static constexpr const uint8_t KIND_FLOATING = 0x4;
+      static constexpr const uint8_t KIND_MASK     = 0x0F;
+      static constexpr const uint8_t INVALID       = 0x1 << 6; // Coercion of the cached kind failed
+      static constexpr const uint8_t BUSY          = 0x1 << 7; // Cache is being written by another thread
+
+      // Interpolation status
+      static constexpr const uint8_t READY         = 0x0;
+      static constexpr const uint8_t PENDING       = 0x1;      // Awaiting expansion of `source`
+      static constexpr const uint8_t CYCLIC        = 0x2;      // Expansion failed, `source` is part of/depends on a cycle
+      static constexpr const uint8_t EXPANDING     = 0x3;      // On the current expansion's path, under the storage's lock
+
+      // Only written by lazy interpolation, under the storage's lock, prior to releasing the status
+      mutable std::string_view value;
+      const Template* source{nullptr};
+
+      Entry(std::string_view entryValue = std::string_view(), const Template* entrySource = nullptr);
+      Entry(const Entry& other);
+      Entry& operator=(const Entry& other);
+
+      bool IsReady() const;
+      uint8_t GetStatus() const;
+      void SetStatus(uint8_t status) const;
+
+      // Adopts the memoised coercion of an entry with the same value, if any
+      void Inherit(const Entry& other) const;
+
+      template <typename V>
+      auto Memoise(uint8_t kind, V& result, bool (*parse)(std::string_view, V&)) const -> bool;
+
+      private:
+        mutable std::atomic<uint8_t> m_state{0};
+        mutable std::atomic<uint8_t> m_status{READY};
+        mutable std::atomic<uint64_t> m_payload{0};
+    };
+
+    using EntryMap = std::unordered_map<std::string_view, Entry, KeyHash, KeyEqual>;
+
+    bool readFile(const std::filesystem::path& fp, uint8_t flags);
     void parseFile(const std::filesystem::path& fp, uint8_t flags = 0);
-    void expandContent(std::wstring& content, const bool& isValueQuoted);
+    void parseBuffer(Storage& storage);
+    bool tryReadSnapshot(const std::filesystem::path& snapshotFp);
 
-    bool coerceIntoBoolean(std::wstring value) const;
+    bool expandEntry(const Entry& entry) const;
+    auto reconcile(const DotEnv& previous) const -> std::vector<std::string>;
+    auto describeCycle(std::string_view key) const -> std::string;
 
-    template<typename T>
-    auto coerceIntoType(const std::wstring& value) const -> T;
+    template <typename T>
+    auto findEntry(const T& key) const -> const Entry*;
+
+    // Binary search of a snapshot's sorted entry table, in place
+    auto findSnapshotEntry(std::string_view key) const -> const Entry*;
+    auto findSnapshotEntry(std::wstring_view key) const -> const Entry*;
+
+    template <typename U>
+    auto tryCoerce(const Entry& entry, U& result) const -> bool;
+
+    template <typename T>
+    static constexpr auto toKeyView(const T& key);
+
+    template <typename T>
+    static auto toKeyName(const T& key) -> std::string;
 
   private:
-    std::unordered_map<std::wstring, std::wstring> m_entries;
+    // Entries view into `m_storage`, which is immutable once parsed & shared between copies
+    std::shared_ptr<Storage> m_storage;
+    EntryMap m_entries;
     uint8_t m_flags{0};
+
+    // Entries of a snapshot load are looked up in its table, `m_entries` is left empty
+    bool m_isSnapshot{false};
 };
 
 
 /* Public */
 template <typename T>
 inline auto DotEnv::Contains(const T& key) const -> bool {
-  static_assert((std::is_convertible_v<T, std::string> || std::is_convertible_v<T, std::wstring>));
-  if constexpr(std::is_same_v<T, std::string>) {
-    return m_entries.contains(common::str2wstr(key));
-  } else if constexpr(std::is_convertible_v<T, std::string>) {
-    return m_entries.contains(common::str2wstr(std::string(key)));
-  } else if constexpr(std::is_same_v<T, std::wstring>) {
-    return m_entries.contains(key);
-  } else if constexpr(std::is_convertible_v<T, std::wstring>) {
-    return m_entries.contains(std::wstring(key));
-  }
+  static_assert((std::is_convertible_v<T, std::string_view> || std::is_convertible_v<T, std::wstring_view>));
+  return this->findEntry(key) != nullptr;
 }
 
 template <typename U, typename T>
 inline auto DotEnv::Get(const T& key) const -> U {
-	static_assert((std::is_convertible_v<T, std::string> || std::is_convertible_v<T, std::wstring>));
-
-  std::wstring keyname;
-  if constexpr(std::is_same_v<T, std::string>) {
-    keyname = common::str2wstr(key);
-  } else if constexpr(std::is_convertible_v<T, std::string>) {
-    keyname = common::str2wstr(std::string(key));
-  } else if constexpr(std::is_same_v<T, std::wstring>) {
-    keyname = key;
-  } else if constexpr(std::is_convertible_v<T, std::wstring>) {
-    keyname = { key };
-  }
+  static_assert((std::is_convertible_v<T, std::string_view> || std::is_convertible_v<T, std::wstring_view>));
 
-  const auto entry = m_entries.find(keyname);
-  if (entry == m_entries.end()) {
+  const Entry* entry = this->findEntry(key);
+  if (!entry) {
     throw std::runtime_error(
       std::string("Key of name '")
-        .append(common::wstr2str(keyname))
+        .append(DotEnv::toKeyName(key))
         .append("' does not exist")
     );
   }
 
-  auto value = entry->second;
-  if constexpr(std::is_same_v<U, std::string> || std::is_convertible_v<U, std::string_view>) {
-    return common::wstr2str(value);
-  } else if constexpr(std::is_same_v<U, std::wstring> || std::is_convertible_v<U, std::wstring_view>) {
-    return value;
-  } else if constexpr(std::is_same_v<U, bool>) {
-    return this->coerceIntoBoolean(value);
-  } else {
-    return this->coerceIntoType<U>(value);
+  if (!entry->IsReady() && !this->expandEntry(*entry)) {
+    throw std::runtime_error(
+      std::string("Failed to interpolate key '")
+        .append(DotEnv::toKeyName(key))
+        .append("', found cyclic reference: ")
+        .append(this->describeCycle(DotEnv::toKeyName(key)))
+    );
+  }
+
+  U result{};
+  if (!this->tryCoerce(*entry, result)) {
+    common::throwCoercionError<U>(entry->value);
   }
+
+  return result;
 }
 
 template <typename U, typename T>
-inline auto DotEnv::Get(const T& key, U&& defaultValue) const -> U {
-	static_assert((std::is_convertible_v<T, std::string> || std::is_convertible_v<T, std::wstring>));
+inline auto DotEnv::Get(const T& key, U&& defaultValue) const -> std::remove_cvref_t<U> {
+  static_assert((std::is_convertible_v<T, std::string_view> || std::is_convertible_v<T, std::wstring_view>));
 
-  try {
-    return this->Get<U>(key);
-  } catch (std::runtime_error& err) {
-    return defaultValue;
+  std::remove_cvref_t<U> result{};
+  const Entry* entry = this->findEntry(key);
+  if (!entry || (!entry->IsReady() && !this->expandEntry(*entry))) {
+    return std::forward<U>(defaultValue);
   }
+
+  if (this->tryCoerce(*entry, result)) {
+    return result;
+  }
+
+  return std::forward<U>(defaultValue);
 }
 
 template <typename T, typename U>
 inline auto DotEnv::TryGet(const T& key, U& value) const -> bool {
-	static_assert((std::is_convertible_v<T, std::string> || std::is_convertible_v<T, std::wstring>));
+  static_assert((std::is_convertible_v<T, std::string_view> || std::is_convertible_v<T, std::wstring_view>));
 
-  try {
-    value = this->Get<U>(key);
-  } catch (std::runtime_error& err) {
+  const Entry* entry = this->findEntry(key);
+  if (!entry || (!entry->IsReady() && !this->expandEntry(*entry))) {
     return false;
   }
 
-  return true;
+  return this->tryCoerce(*entry, value);
 }
 
 
 /* Private */
-inline bool DotEnv::coerceIntoBoolean(std::wstring value) const {
-  static constexpr const char* expectedValues = "1/0, true/false, on/off"; 
-  static const std::unordered_map<std::wstring, bool> booleanMap{
-    { L"true", true }, { L"false", false },
-    {   L"on", true }, {   L"off", false }
-  };
-
-  common::trim(value);
-  std::transform(value.begin(), value.end(), value.begin(), std::towlower);
-
-  if (value.length() == 1) {
-    switch (value.front()) {
-      case L'1':
-        return true;
-      case L'0':
-        return false;
-      default:
-        break;
+inline DotEnv::Entry::Entry(std::string_view entryValue /*= std::string_view()*/, const Template* entrySource /*= nullptr*/)
+  : value(entryValue), source(entrySource), m_status(entrySource ? PENDING : READY) { };
+
+inline DotEnv::Entry::Entry(const DotEnv::Entry& other)
+  : source(other.source)
+{
+  m_status.store(other.m_status.load(std::memory_order_acquire), std::memory_order_relaxed);
+  value = other.value;
+
+  const uint8_t state = other.m_state.load(std::memory_order_acquire);
+  if (!(state & BUSY)) {
+    m_payload.store(other.m_payload.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_state.store(state, std::memory_order_relaxed);
+  }
+}
+
+inline DotEnv::Entry& DotEnv::Entry::operator=(const DotEnv::Entry& other) {
+  if (this != &other) {
+    m_status.store(other.m_status.load(std::memory_order_acquire), std::memory_order_relaxed);
+    source = other.source;
+    value = other.value;
+
+    const uint8_t state = other.m_state.load(std::memory_order_acquire);
+    m_payload.store(other.m_payload.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_state.store((state & BUSY) ? 0 : state, std::memory_order_release);
+  }
+
+  return *this;
+}
+
+inline void DotEnv::Entry::Inherit(const DotEnv::Entry& other) const {
+  const uint8_t state = other.m_state.load(std::memory_order_acquire);
+  if (state == 0 || (state & BUSY)) {
+    return;
+  }
+
+  uint8_t expected = 0;
+  if (m_state.compare_exchange_strong(expected, BUSY, std::memory_order_acquire)) {
+    m_payload.store(other.m_payload.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    m_state.store(state, std::memory_order_release);
+  }
+}
+
+inline bool DotEnv::Entry::IsReady() const {
+  return m_status.load(std::memory_order_acquire) == READY;
+}
+
+inline uint8_t DotEnv::Entry::GetStatus() const {
+  return m_status.load(std::memory_order_acquire);
+}
+
+inline void DotEnv::Entry::SetStatus(uint8_t status) const {
+  m_status.store(status, std::memory_order_release);
+}
+
+template <typename V>
+inline auto DotEnv::Entry::Memoise(uint8_t kind, V& result, bool (*parse)(std::string_view, V&)) const -> bool {
+  static_assert((std::is_same_v<V, bool> || std::is_same_v<V, int64_t> || std::is_same_v<V, uint64_t> || std::is_same_v<V, double>));
+
+  const uint8_t state = m_state.load(std::memory_order_acquire);
+  if ((state & KIND_MASK) == kind && !(state & BUSY)) {
+    if (state & INVALID) {
+      return false;
     }
-  } else {
-    const auto mapped = booleanMap.find(value);
-    if (mapped != booleanMap.end()) {
-      return mapped->second;
+
+    const uint64_t payload = m_payload.load(std::memory_order_relaxed);
+    if constexpr(std::is_same_v<V, double>) {
+      result = std::bit_cast<double>(payload);
+    } else {
+      result = static_cast<V>(payload);
+    }
+
+    return true;
+  }
+
+  V parsed{};
+  const bool success = parse(value, parsed);
+
+  // Claim the empty cache; the payload is written once & never replaced
+  uint8_t expected = 0;
+  if (state == 0 && m_state.compare_exchange_strong(expected, BUSY, std::memory_order_acquire)) {
+    if (success) {
+      if constexpr(std::is_same_v<V, double>) {
+        m_payload.store(std::bit_cast<uint64_t>(parsed), std::memory_order_relaxed);
+      } else {
+        m_payload.store(static_cast<uint64_t>(parsed), std::memory_order_relaxed);
+      }
+    }
+
+    m_state.store(success ? kind : (kind | INVALID), std::memory_order_release);
+  }
+
+  if (success) {
+    result = parsed;
+  }
+
+  return success;
+}
+
+template <typename CharT>
+inline size_t DotEnv::KeyHash::hash(const CharT* key, size_t length) noexcept {
+  // Word-at-a-time over the key's bytes; wide key(s) contribute the low byte of each code unit
+  // so that ASCII key(s) hash identically regardless of their width
+  constexpr uint64_t K0 = 0x9E3779B97F4A7C15;
+  constexpr uint64_t K1 = 0xBF58476D1CE4E5B9;
+
+  uint64_t hash = K0 ^ length;
+  for (size_t i = 0; i < length; i += 8) {
+    uint64_t word = 0;
+    const size_t count = std::min<size_t>(8, length - i);
+    for (size_t j = 0; j < count; ++j) {
+      word |= static_cast<uint64_t>(static_cast<uint8_t>(key[i + j])) << (j * 8);
     }
+
+    hash = std::rotl(hash ^ (word * K0), 31) * K1;
   }
 
-  throw std::runtime_error(
-    std::string("Failed to coerce '")
-      .append(common::wstr2str(value))
-      .append("' into boolean, expected one of: ")
-      .append(expectedValues)
-  );
+  hash ^= hash >> 29;
+  hash *= K1;
+  hash ^= hash >> 32;
+  return static_cast<size_t>(hash);
 }
 
-template<typename T>
-inline auto DotEnv::coerceIntoType(const std::wstring& value) const -> T {
-  try {
-    T result{};
-    auto stream = std::wistringstream{value};
-    stream.exceptions(std::ios::failbit);
-    stream >> result;
+inline size_t DotEnv::KeyHash::operator()(std::string_view key) const noexcept {
+  return KeyHash::hash(key.data(), key.size());
+}
 
-    return result;
-  } catch (std::exception& err) {
-    throw std::runtime_error(
-      std::string("Failed to coerce '")
-        .append(common::wstr2str(value))
-        .append("' into ")
-        .append(common::getTypeName<T>())
-    );
+inline size_t DotEnv::KeyHash::operator()(std::wstring_view key) const noexcept {
+  return KeyHash::hash(key.data(), key.size());
+}
+
+inline bool DotEnv::KeyEqual::operator()(std::string_view lhs, std::string_view rhs) const noexcept {
+  return lhs == rhs;
+}
+
+inline bool DotEnv::KeyEqual::operator()(std::string_view lhs, std::wstring_view rhs) const noexcept {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](char a, wchar_t b) {
+    return static_cast<uint32_t>(b) < 0x80 && static_cast<wchar_t>(a) == b;
+  });
+}
+
+inline bool DotEnv::KeyEqual::operator()(std::wstring_view lhs, std::string_view rhs) const noexcept {
+  return (*this)(rhs, lhs);
+}
+
+template <typename T>
+inline auto DotEnv::findEntry(const T& key) const -> const Entry* {
+  if (m_isSnapshot) {
+    return this->findSnapshotEntry(DotEnv::toKeyView(key));
+  }
+
+  const auto entry = m_entries.find(DotEnv::toKeyView(key));
+  return entry != m_entries.end() ? &entry->second : nullptr;
+}
+
+template <typename U>
+inline auto DotEnv::tryCoerce(const DotEnv::Entry& entry, U& result) const -> bool {
+  // Parsing is shared with `EmbeddedDotEnv`; only the entry's memoisation of the scalar is added
+  return common::tryCoerce(entry.value, result, [&entry](std::string_view, auto& parsed) {
+    using V = std::remove_cvref_t<decltype(parsed)>;
+
+    constexpr uint8_t kind = std::is_same_v<V, bool>     ? Entry::KIND_BOOLEAN
+                           : std::is_same_v<V, int64_t>  ? Entry::KIND_SIGNED
+                           : std::is_same_v<V, uint64_t> ? Entry::KIND_UNSIGNED
+                           : Entry::KIND_FLOATING;
+
+    return entry.Memoise(kind, parsed, &common::tryParseScalar<V>);
+  });
+}
+
+template <typename T>
+inline constexpr auto DotEnv::toKeyView(const T& key) {
+  if constexpr(std::is_convertible_v<T, std::string_view>) {
+    return std::string_view(key);
+  } else {
+    return std::wstring_view(key);
   }
 }
 
+template <typename T>
+inline auto DotEnv::toKeyName(const T& key) -> std::string {
+  if constexpr(std::is_convertible_v<T, std::string_view>) {
+    return std::string(DotEnv::toKeyView(key));
+  } else {
+    return common::wstr2str(std::wstring(DotEnv::toKeyView(key)));
+  }
+}
+
+
+/*
+ * Watches a DotEnv file & atomically publishes a new, immutable snapshot of
+ * it whenever its content changes, e.g. following credential rotation(s)
+ *
+ *  - Readers never wait on a reload; a snapshot remains valid for as long
+ *    as it's held, regardless of any later publication(s)
+ *  - Unchanged entries carry their memoised coercion(s) across reload(s)
+ *  - Change(s) are detected through inotify & are therefore Linux-only;
+ *    `Reload` may be called directly elsewhere
+ *
+ */
+class DotEnvWatcher {
+  public:
+    struct Change {
+      uint64_t generation;
+      std::vector<std::string> keys; // Key(s) added, removed or modified
+    };
+
+    // Snapshot alongside the generation it was published as
+    struct Generation {
+      uint64_t number{0};
+      std::shared_ptr<const DotEnv> snapshot;
+    };
+
+    using Callback = std::function<void(const std::shared_ptr<const DotEnv>& snapshot, const Change& change)>;
+
+  public:
+    DotEnvWatcher(const std::filesystem::path& fp, uint8_t flags = 0);
+    ~DotEnvWatcher();
+
+    DotEnvWatcher(DotEnvWatcher const&) = delete;
+    DotEnvWatcher &operator=(DotEnvWatcher const&) = delete;
+
+  public:
+    bool TryStart(std::string& errorMessage);
+    void Stop();
+    bool IsWatching() const;
+
+    // Re-reads the file, publishing a new generation if any of its entries changed
+    bool Reload();
+
+    // Current snapshot & its generation, published together; separate calls to `GetGeneration` &
+    // `GetSnapshot` may observe different publication(s)
+    Generation GetCurrent() const;
+    uint64_t GetGeneration() const;
+    std::shared_ptr<const DotEnv> GetSnapshot() const;
+
+    size_t Subscribe(Callback callback);
+    void Unsubscribe(size_t id);
+
+    template <typename U, typename T>
+    auto Get(const T& key) const -> U;
+
+    template <typename U, typename T>
+    auto Get(const T& key, U&& defaultValue) const -> std::remove_cvref_t<U>;
+
+  private:
+    void watch(int handle);
+
+  private:
+    std::filesystem::path m_path;
+    uint8_t m_flags;
+
+    std::atomic<std::shared_ptr<const Generation>> m_current;
+
+    // Serialises reload(s) & publication
+    std::mutex m_reloadLock;
+
+    std::mutex m_callbackLock;
+    std::vector<std::pair<size_t, Callback>> m_callbacks;
+    size_t m_nextCallbackId{0};
+
+    std::thread m_thread;
+    std::atomic<bool> m_isWatching{false};
+    int m_stopHandle{-1};
+};
+
+template <typename U, typename T>
+inline auto DotEnvWatcher::Get(const T& key) const -> U {
+  return this->GetSnapshot()->template Get<U>(key);
+}
+
+template <typename U, typename T>
+inline auto DotEnvWatcher::Get(const T& key, U&& defaultValue) const -> std::remove_cvref_t<U> {
+  return this->GetSnapshot()->Get(key, std::forward<U>(defaultValue));
+}
+
 #pragma endregion
 
 } // namespace wapi
@@ -0,0 +1,259 @@
+#include "wapi.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#endif
+
+namespace wapi = saildb::wapi;
+
+using DotEnvWatcher = wapi::DotEnvWatcher;
+
+
+
+/************************************************************
+ *                                                          *
+ *                      DotEnvWatcher                       *
+ *                                                          *
+ ************************************************************/
+
+#ifdef __linux__
+inline bool isSameFile(const struct stat& lhs, const struct stat& rhs) {
+  return lhs.st_dev == rhs.st_dev
+      && lhs.st_ino == rhs.st_ino
+      && lhs.st_size == rhs.st_size
+      && lhs.st_mtim.tv_sec == rhs.st_mtim.tv_sec
+      && lhs.st_mtim.tv_nsec == rhs.st_mtim.tv_nsec;
+}
+#endif
+
+
+// Impl. DotEnvWatcher
+DotEnvWatcher::DotEnvWatcher(const std::filesystem::path& fp, uint8_t flags /*= 0*/)
+  : m_path(fp), m_flags(flags)
+{
+  m_current.store(std::make_shared<const Generation>(Generation{ 0, std::make_shared<const wapi::DotEnv>(fp, flags) }));
+}
+
+DotEnvWatcher::~DotEnvWatcher() {
+  this->Stop();
+}
+
+
+/* Public impl. */
+bool DotEnvWatcher::TryStart(std::string& errorMessage) {
+#ifdef __linux__
+  if (m_thread.joinable()) {
+    if (m_isWatching.load(std::memory_order_acquire)) {
+      return true;
+    }
+
+    // The watch thread exited on an error, release its handle(s) before restarting it
+    this->Stop();
+  }
+
+  m_stopHandle = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (m_stopHandle < 0) {
+    errorMessage = common::concatTo<std::string>("Failed to create stop event with err: ", std::strerror(errno));
+    return false;
+  }
+
+  const int handle = ::inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+  if (handle < 0) {
+    errorMessage = common::concatTo<std::string>("Failed to initialise inotify with err: ", std::strerror(errno));
+    ::close(m_stopHandle);
+    m_stopHandle = -1;
+    return false;
+  }
+
+  // Watch the parent directory since rotation(s) commonly replace the file, e.g. by rename or symlink swap;
+  // only completed write(s) are observed, a file that's still being written may lack some of its entries
+  const auto directory = m_path.has_parent_path() ? m_path.parent_path() : std::filesystem::path(".");
+  const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO;
+  if (::inotify_add_watch(handle, directory.c_str(), mask) < 0) {
+    errorMessage = common::concatTo<std::string>("Failed to watch ", directory.string(), " with err: ", std::strerror(errno));
+    ::close(handle);
+    ::close(m_stopHandle);
+    m_stopHandle = -1;
+    return false;
+  }
+
+  m_isWatching.store(true, std::memory_order_release);
+  m_thread = std::thread(&DotEnvWatcher::watch, this, handle);
+  return true;
+#else
+  errorMessage = "Watching DotEnv file(s) is only supported on Linux";
+  return false;
+#endif
+}
+
+void DotEnvWatcher::Stop() {
+  if (!m_thread.joinable()) {
+    return;
+  }
+
+#ifdef __linux__
+  const uint64_t signal = 1;
+  [[maybe_unused]] const auto written = ::write(m_stopHandle, &signal, sizeof(signal));
+#endif
+
+  m_thread.join();
+  m_isWatching.store(false, std::memory_order_release);
+
+#ifdef __linux__
+  ::close(m_stopHandle);
+  m_stopHandle = -1;
+#endif
+}
+
+bool DotEnvWatcher::IsWatching() const {
+  return m_isWatching.load(std::memory_order_acquire);
+}
+
+bool DotEnvWatcher::Reload() {
+  std::scoped_lock lock(m_reloadLock);
+
+  std::shared_ptr<wapi::DotEnv> next;
+  try {
+    next = std::make_shared<wapi::DotEnv>(m_path, m_flags);
+  } catch (const std::exception&) {
+    return false;
+  }
+
+  // Keep the current snapshot if the file couldn't be read, e.g. whilst it's being replaced
+  if (!next->m_storage) {
+    return false;
+  }
+
+  const std::shared_ptr<const Generation> current = m_current.load(std::memory_order_acquire);
+
+  auto keys = next->reconcile(*current->snapshot);
+  if (keys.empty()) {
+    return false;
+  }
+
+  // Published as one immutable pair so that reader(s) never observe a snapshot with another's generation
+  const uint64_t generation = current->number + 1;
+  const std::shared_ptr<const wapi::DotEnv> snapshot = std::move(next);
+  m_current.store(std::make_shared<const Generation>(Generation{ generation, snapshot }), std::memory_order_release);
+
+  // Callback(s) are invoked in generation order on the reloading thread
+  std::vector<Callback> callbacks;
+  {
+    std::scoped_lock callbackLock(m_callbackLock);
+    for (const auto& [id, callback] : m_callbacks) {
+      callbacks.push_back(callback);
+    }
+  }
+
+  const Change change{ generation, std::move(keys) };
+  for (const auto& callback : callbacks) {
+    callback(snapshot, change);
+  }
+
+  return true;
+}
+
+DotEnvWatcher::Generation DotEnvWatcher::GetCurrent() const {
+  return *m_current.load(std::memory_order_acquire);
+}
+
+uint64_t DotEnvWatcher::GetGeneration() const {
+  return m_current.load(std::memory_order_acquire)->number;
+}
+
+std::shared_ptr<const wapi::DotEnv> DotEnvWatcher::GetSnapshot() const {
+  return m_current.load(std::memory_order_acquire)->snapshot;
+}
+
+size_t DotEnvWatcher::Subscribe(DotEnvWatcher::Callback callback) {
+  std::scoped_lock lock(m_callbackLock);
+
+  const size_t id = m_nextCallbackId++;
+  m_callbacks.emplace_back(id, std::move(callback));
+  return id;
+}
+
+void DotEnvWatcher::Unsubscribe(size_t id) {
+  std::scoped_lock lock(m_callbackLock);
+
+  std::erase_if(m_callbacks, [id](const auto& callback) {
+    return callback.first == id;
+  });
+}
+
+
+/* Private impl. */
+void DotEnvWatcher::watch(int handle) {
+#ifdef __linux__
+  // Event(s) of the file are only used as a wake-up, its identity determines whether it's reloaded
+  struct stat last{};
+  alignas(struct inotify_event) char events[4096];
+
+  const std::string filename = m_path.filename().string();
+
+  pollfd handles[2] = {
+    { handle, POLLIN, 0 },
+    { m_stopHandle, POLLIN, 0 },
+  };
+
+  while (true) {
+    if (::poll(handles, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+
+      break;
+    }
+
+    if (handles[1].revents != 0) {
+      break;
+    }
+
+    bool isTouched = false;
+    ssize_t length;
+    while ((length = ::read(handle, events, sizeof(events))) > 0) {
+      for (ssize_t offset = 0; offset < length;) {
+        const auto* event = reinterpret_cast<const struct inotify_event*>(events + offset);
+        offset += sizeof(struct inotify_event) + event->len;
+
+        // Event(s) may have been dropped on overflow, the file is checked regardless
+        if ((event->mask & IN_Q_OVERFLOW) || (event->len > 0 && filename == event->name)) {
+          isTouched = true;
+        }
+      }
+    }
+
+    if (length < 0 && errno != EAGAIN && errno != EINTR) {
+      break;
+    }
+
+    if (!isTouched) {
+      continue;
+    }
+
+    // Missing whilst mid-rotation, await its replacement
+    struct stat current{};
+    if (::stat(m_path.c_str(), &current) != 0 || ::isSameFile(current, last)) {
+      continue;
+    }
+
+    last = current;
+    try {
+      this->Reload();
+    } catch (const std::exception&) {
+      // Sink callback failure(s), they mustn't terminate the watcher
+    }
+  }
+
+  // Cleared on every exit, incl. failure(s) of `poll` or `read`, so that `TryStart` may restart it
+  m_isWatching.store(false, std::memory_order_release);
+  ::close(handle);
+#endif
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <fstream>
+#include <filesystem>
+#include <type_traits>
+
+#include "sailc/wapi/wapi.hpp"
+
+namespace wapi = saildb::wapi;
+
+namespace {
+
+class DotEnvWatcherTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+      const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+      m_path = std::filesystem::temp_directory_path() / (std::string("saildb_watch_") + info->name() + ".env");
+      write(0);
+    }
+
+    void TearDown() override {
+      std::error_code error;
+      std::filesystem::remove(m_path, error);
+    }
+
+    // Every entry holds the generation it was written for
+    void write(uint64_t generation) {
+      std::ofstream output(m_path, std::ios::binary | std::ios::trunc);
+      output << "GENERATION=" << generation << "\nOTHER=" << generation << "\n";
+    }
+
+    // Starts watching, or skips the test where it's unsupported
+    void start(wapi::DotEnvWatcher& watcher) {
+      std::string errorMessage;
+      if (!watcher.TryStart(errorMessage)) {
+        GTEST_SKIP() << errorMessage;
+      }
+    }
+
+    static bool awaitGeneration(const wapi::DotEnvWatcher& watcher, uint64_t generation) {
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while (watcher.GetGeneration() < generation) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          return false;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+
+      return true;
+    }
+
+  protected:
+    std::filesystem::path m_path;
+};
+
+} // namespace
+
+
+
+/************************************************************
+ *                                                          *
+ *                      DotEnvWatcher                       *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(DotEnvWatcherTest, ReloadPublishesSnapshotWithItsGeneration) {
+  wapi::DotEnvWatcher watcher(m_path);
+  EXPECT_EQ(watcher.GetGeneration(), 0u);
+  EXPECT_FALSE(watcher.Reload());
+
+  write(1);
+  ASSERT_TRUE(watcher.Reload());
+
+  const wapi::DotEnvWatcher::Generation current = watcher.GetCurrent();
+  EXPECT_EQ(current.number, 1u);
+  EXPECT_EQ(current.snapshot->Get<uint64_t>("GENERATION"), 1u);
+}
+
+TEST_F(DotEnvWatcherTest, ReaderNeverPairsSnapshotWithAnotherGeneration) {
+  wapi::DotEnvWatcher watcher(m_path);
+
+  std::atomic<bool> isDone{false};
+  std::atomic<size_t> mismatches{0};
+  std::thread reader([&]() {
+    while (!isDone.load(std::memory_order_acquire)) {
+      const auto current = watcher.GetCurrent();
+      if (current.snapshot->Get<uint64_t>("GENERATION") != current.number) {
+        mismatches.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  });
+
+  for (uint64_t generation = 1; generation <= 200; ++generation) {
+    write(generation);
+    ASSERT_TRUE(watcher.Reload());
+  }
+
+  isDone.store(true, std::memory_order_release);
+  reader.join();
+
+  EXPECT_EQ(mismatches.load(), 0u);
+  EXPECT_EQ(watcher.GetGeneration(), 200u);
+}
+
+TEST_F(DotEnvWatcherTest, DefaultIsReturnedByValue) {
+  wapi::DotEnvWatcher watcher(m_path);
+
+  const std::string fallback = "fallback";
+  static_assert(std::is_same_v<decltype(watcher.Get("MISSING", fallback)), std::string>);
+
+  EXPECT_EQ(watcher.Get("MISSING", fallback), "fallback");
+  EXPECT_EQ(watcher.Get("OTHER", fallback), "0");
+  EXPECT_EQ(watcher.Get("MISSING", std::string("fallback")), "fallback");
+}
+
+
+
+/************************************************************
+ *                                                          *
+ *                         Watching                         *
+ *                                                          *
+ ************************************************************/
+
+TEST_F(DotEnvWatcherTest, WaitsForWriteToComplete) {
+  wapi::DotEnvWatcher watcher(m_path);
+  start(watcher);
+  if (HasFatalFailure() || IsSkipped()) {
+    return;
+  }
+
+  // Recreated, i.e. the file is created & written across several write(s) before it's closed
+  std::filesystem::remove(m_path);
+  {
+    std::ofstream output(m_path, std::ios::binary | std::ios::trunc);
+    output << "GENERATION=1\n" << std::flush;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(watcher.GetGeneration(), 0u);
+
+    output << "OTHER=1\n";
+  }
+
+  ASSERT_TRUE(awaitGeneration(watcher, 1));
+  EXPECT_EQ(watcher.GetGeneration(), 1u);
+  EXPECT_EQ(watcher.Get<uint64_t>("OTHER"), 1u);
+}
+
+TEST_F(DotEnvWatcherTest, IgnoresOtherFilesInDirectory) {
+  wapi::DotEnvWatcher watcher(m_path);
+  start(watcher);
+  if (HasFatalFailure() || IsSkipped()) {
+    return;
+  }
+
+  const auto sibling = std::filesystem::path(m_path).replace_extension(".sibling");
+  {
+    std::ofstream output(sibling, std::ios::binary | std::ios::trunc);
+    output << "GENERATION=1\n";
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_EQ(watcher.GetGeneration(), 0u);
+
+  std::filesystem::remove(sibling);
+}
+
+TEST_F(DotEnvWatcherTest, RestartsOnceStopped) {
+  wapi::DotEnvWatcher watcher(m_path);
+  start(watcher);
+  if (HasFatalFailure() || IsSkipped()) {
+    return;
+  }
+
+  watcher.Stop();
+  EXPECT_FALSE(watcher.IsWatching());
+
+  start(watcher);
+  EXPECT_TRUE(watcher.IsWatching());
+
+  write(1);
+  ASSERT_TRUE(awaitGeneration(watcher, 1));
+  EXPECT_EQ(watcher.Get<uint64_t>("OTHER"), 1u);
+}
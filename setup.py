@@ -13,6 +13,7 @@ from setuptools.command import build_ext
 
 PKG_ROOT = os.path.dirname(os.path.abspath(__file__))
 PKG_NAME = 'saildb'
+IS_WINDOWS = sys.platform == 'win32'
 
 def get_pkg_version(pkg: str) -> str:
   """Attempt to read the pkg version from the package"""
@@ -60,13 +61,13 @@ class BuildPkgExtension(build_ext.build_ext):
     ]
 
     for library_dir in self.library_dirs:
-      bazel_argv.append('--linkopt=/LIBPATH:' + library_dir)
+      bazel_argv.append(('--linkopt=/LIBPATH:' if IS_WINDOWS else '--linkopt=-L') + library_dir)
 
     self.spawn(bazel_argv)
 
     ext_bazel_bin_path = os.path.join(
       self.build_temp, 'bazel-bin',
-      ext.relpath, ext.target_name + '.pyd'
+      ext.relpath, ext.target_name + ('.pyd' if IS_WINDOWS else '.so')
     )
 
     ext_dest_path = self.get_ext_fullpath(ext.name)